@@ -18,6 +18,7 @@
 #include "vtkDataObjectTreeIterator.h"
 #include "vtkInformation.h"
 #include "vtkMultiPieceDataSet.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVDataInformation.h"
@@ -26,21 +27,59 @@
 #include "vtkUniformGrid.h"
 #include "vtkUniformGridAMR.h"
 
+#include <map>
 #include <string>
 #include <vector>
 
 vtkStandardNewMacro(vtkPVCompositeDataInformation);
 
+namespace
+{
+// State of a child in the serialized stream.
+enum
+{
+  CHILD_EMPTY = 0,
+  CHILD_FULL = 1,
+  CHILD_UNCHANGED = 2
+};
+
+// 64-bit FNV-1a hash of a serialized child. Never returns 0, which is used to
+// indicate an unknown hash.
+vtkTypeUInt64 vtkComputeHash(const unsigned char* data, size_t length)
+{
+  vtkTypeUInt64 hash = 14695981039346656037ULL;
+  for (size_t cc = 0; cc < length; ++cc)
+  {
+    hash ^= static_cast<vtkTypeUInt64>(data[cc]);
+    hash *= 1099511628211ULL;
+  }
+  return hash == 0 ? 1 : hash;
+}
+}
+
 struct vtkPVCompositeDataInformationInternals
 {
   struct vtkNode
   {
     vtkSmartPointer<vtkPVDataInformation> Info;
     std::string Name;
+    // Hash of the serialized Info, as received from the server. 0 if unknown.
+    vtkTypeUInt64 Hash;
+    vtkNode()
+      : Hash(0)
+    {
+    }
   };
   typedef std::vector<vtkNode> VectorOfDataInformation;
 
   VectorOfDataInformation ChildrenInformation;
+
+  // Children retained from the previous gather, used to patch in the children
+  // the server reports as unchanged. Used on the client side.
+  VectorOfDataInformation IncrementalBase;
+
+  // Hashes for the children the client already has. Used on the server side.
+  std::map<unsigned int, vtkTypeUInt64> KnownHashes;
 };
 
 //----------------------------------------------------------------------------
@@ -165,6 +204,7 @@ const char* vtkPVCompositeDataInformation::GetName(unsigned int idx)
 void vtkPVCompositeDataInformation::CopyFromObject(vtkObject* object)
 {
   this->Initialize();
+  this->ClearIncrementalBase();
 
   vtkCompositeDataSet* cds = vtkCompositeDataSet::SafeDownCast(object);
   if (!cds)
@@ -366,7 +406,21 @@ void vtkPVCompositeDataInformation::CopyToStream(vtkClientServerStream* css)
     size_t length;
     const unsigned char* data;
     dcss.GetData(&data, &length);
-    *css << vtkClientServerStream::InsertArray(data, static_cast<int>(length));
+
+    vtkTypeUInt64 hash = dataInf ? vtkComputeHash(data, length) : 0;
+    std::map<unsigned int, vtkTypeUInt64>::const_iterator known =
+      this->Internal->KnownHashes.find(i);
+    if (hash != 0 && known != this->Internal->KnownHashes.end() && known->second == hash)
+    {
+      // the receiver already has this child, skip sending it again.
+      *css << hash << static_cast<int>(CHILD_UNCHANGED)
+           << vtkClientServerStream::InsertArray(data, 0);
+    }
+    else
+    {
+      *css << hash << static_cast<int>(dataInf ? CHILD_FULL : CHILD_EMPTY)
+           << vtkClientServerStream::InsertArray(data, static_cast<int>(length));
+    }
   }
   *css << numChildren; // DONE marker
   *css << vtkClientServerStream::End;
@@ -434,11 +488,41 @@ void vtkPVCompositeDataInformation::CopyFromStream(const vtkClientServerStream*
     }
     this->Internal->ChildrenInformation[childIdx].Name = name ? name : "";
 
+    msgIdx++;
+    vtkTypeUInt64 hash;
+    if (!css->GetArgument(0, msgIdx, &hash))
+    {
+      vtkErrorMacro("Error parsing the hash for the block.");
+      return;
+    }
+    this->Internal->ChildrenInformation[childIdx].Hash = hash;
+
+    msgIdx++;
+    int state;
+    if (!css->GetArgument(0, msgIdx, &state))
+    {
+      vtkErrorMacro("Error parsing the state for the block.");
+      return;
+    }
+
     vtkTypeUInt32 length;
     std::vector<unsigned char> data;
     vtkClientServerStream dcss;
 
     msgIdx++;
+    if (state == CHILD_UNCHANGED)
+    {
+      vtkPVCompositeDataInformationInternals::VectorOfDataInformation& base =
+        this->Internal->IncrementalBase;
+      if (childIdx >= base.size() || base[childIdx].Hash != hash || !base[childIdx].Info)
+      {
+        vtkErrorMacro("Block " << childIdx << " reported as unchanged, but is not available.");
+        return;
+      }
+      this->Internal->ChildrenInformation[childIdx].Info = base[childIdx].Info;
+      continue;
+    }
+
     // Data information.
     if (!css->GetArgumentLength(0, msgIdx, &length))
     {
@@ -459,4 +543,56 @@ void vtkPVCompositeDataInformation::CopyFromStream(const vtkClientServerStream*
       this->Internal->ChildrenInformation[childIdx].Info = dataInf;
     }
   }
+  this->ClearIncrementalBase();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataInformation::RetainChildrenForIncrementalGather()
+{
+  this->Internal->IncrementalBase.clear();
+  this->Internal->IncrementalBase.swap(this->Internal->ChildrenInformation);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataInformation::ClearIncrementalBase()
+{
+  this->Internal->IncrementalBase.clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataInformation::CopyKnownHashesToStream(vtkMultiProcessStream& str)
+{
+  vtkPVCompositeDataInformationInternals::VectorOfDataInformation& base =
+    this->Internal->IncrementalBase;
+
+  unsigned int count = 0;
+  for (size_t cc = 0; cc < base.size(); ++cc)
+  {
+    count += (base[cc].Hash != 0 && base[cc].Info) ? 1 : 0;
+  }
+
+  str << count;
+  for (size_t cc = 0; cc < base.size(); ++cc)
+  {
+    if (base[cc].Hash != 0 && base[cc].Info)
+    {
+      str << static_cast<unsigned int>(cc) << base[cc].Hash;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataInformation::CopyKnownHashesFromStream(vtkMultiProcessStream& str)
+{
+  this->Internal->KnownHashes.clear();
+
+  unsigned int count;
+  str >> count;
+  for (unsigned int cc = 0; cc < count; ++cc)
+  {
+    unsigned int childIdx;
+    vtkTypeUInt64 hash;
+    str >> childIdx >> hash;
+    this->Internal->KnownHashes[childIdx] = hash;
+  }
 }
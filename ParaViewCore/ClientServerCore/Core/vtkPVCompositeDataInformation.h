@@ -132,6 +132,22 @@ protected:
   friend class vtkPVDataInformation;
   vtkPVDataInformation* GetDataInformationForCompositeIndex(int* index);
 
+  //@{
+  /**
+   * Support for incremental gathering, see
+   * vtkPVDataInformation::PrepareForIncrementalGather().
+   * RetainChildrenForIncrementalGather() moves the current children aside so
+   * that CopyFromStream() can reuse the ones the server reports as unchanged.
+   * CopyKnownHashesToStream() serializes the content hashes of these children
+   * for the server, which uses them in CopyToStream() to skip children whose
+   * content did not change.
+   */
+  void RetainChildrenForIncrementalGather();
+  void ClearIncrementalBase();
+  void CopyKnownHashesToStream(vtkMultiProcessStream&);
+  void CopyKnownHashesFromStream(vtkMultiProcessStream&);
+  //@}
+
 private:
   vtkPVCompositeDataInformationInternals* Internal;
 
@@ -141,6 +141,7 @@ vtkPVDataInformation::~vtkPVDataInformation()
 void vtkPVDataInformation::CopyParametersToStream(vtkMultiProcessStream& str)
 {
   str << 828792 << this->PortNumber;
+  this->CompositeDataInformation->CopyKnownHashesToStream(str);
 }
 
 //----------------------------------------------------------------------------
@@ -151,7 +152,15 @@ void vtkPVDataInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
   if (magic_number != 828792)
   {
     vtkErrorMacro("Magic number mismatch.");
+    return;
   }
+  this->CompositeDataInformation->CopyKnownHashesFromStream(str);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataInformation::PrepareForIncrementalGather()
+{
+  this->CompositeDataInformation->RetainChildrenForIncrementalGather();
 }
 
 //----------------------------------------------------------------------------
@@ -730,6 +739,9 @@ void vtkPVDataInformation::CopyFromHyperTreeGrid(vtkHyperTreeGrid* data)
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyFromObject(vtkObject* object)
 {
+  // the information is gathered locally, nothing to patch incrementally.
+  this->CompositeDataInformation->ClearIncrementalBase();
+
   vtkDataObject* dobj = vtkDataObject::SafeDownCast(object);
   vtkInformation* info = NULL;
   // Handle the case where the a vtkAlgorithmOutput is passed instead of
@@ -1619,6 +1631,7 @@ void vtkPVDataInformation::CopyFromStream(const vtkClientServerStream* css)
   else
   {
     this->CompositeDataInformation->Initialize();
+    this->CompositeDataInformation->ClearIncrementalBase();
   }
   CSS_GET_CUR_INDEX()++;
 
@@ -118,6 +118,20 @@ public:
    */
   void Initialize();
 
+  /**
+   * Prepare for an incremental gather of the information. The composite
+   * children currently held by this object (typically from the previous
+   * gather) are retained, and their content hashes are sent along with the
+   * next gather request by CopyParametersToStream(). The server then skips the
+   * children whose content did not change and CopyFromStream() reuses the
+   * retained ones for those. Children are compared at the top-level of the
+   * composite tree, i.e. a change in a nested block re-sends the enclosing
+   * top-level block. This only affects information transferred to the
+   * client; the retained children are released by the next CopyFromStream()
+   * or CopyFromObject().
+   */
+  void PrepareForIncrementalGather();
+
   //@{
   /**
    * Access to information.
@@ -69,6 +69,7 @@ vtkPVOptions::vtkPVOptions()
   this->EGLDeviceIndex = -1;
   this->ConnectID = 0;
   this->LogFileName = 0;
+  this->TraceEventsFileName = 0;
   this->StereoType = 0;
   this->SetStereoType("Anaglyph");
   this->Timeout = 0;
@@ -96,6 +97,7 @@ vtkPVOptions::~vtkPVOptions()
   this->SetHostName(0);
   this->SetServersFileName(0);
   this->SetLogFileName(0);
+  this->SetTraceEventsFileName(0);
   this->SetStereoType(0);
   this->SetParaViewDataName(0);
   this->SetServerURL(0);
@@ -143,6 +145,11 @@ void vtkPVOptions::Initialize()
   this->AddArgument(
     "--cslog", 0, &this->LogFileName, "ClientServerStream log file.", vtkPVOptions::ALLPROCESS);
 
+  this->AddArgument("--trace-events", 0, &this->TraceEventsFileName,
+    "Record the execution of the pipelines, data movement and compositing on all processes "
+    "and write it to the given file, in the Chrome trace-event format, when exiting.",
+    vtkPVOptions::ALLPROCESS);
+
   this->AddBooleanArgument("--multi-clients", 0, &this->MultiClientMode,
     "Allow server to keep listening for several clients to"
     "connect to it and share the same visualization session.",
@@ -515,6 +522,8 @@ void vtkPVOptions::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ServersFileName: " << (this->ServersFileName ? this->ServersFileName : "(none)")
      << endl;
   os << indent << "LogFileName: " << (this->LogFileName ? this->LogFileName : "(none)") << endl;
+  os << indent << "TraceEventsFileName: "
+     << (this->TraceEventsFileName ? this->TraceEventsFileName : "(none)") << endl;
   os << indent << "SymmetricMPIMode: " << this->SymmetricMPIMode << endl;
   os << indent << "ServerURL: " << (this->ServerURL ? this->ServerURL : "(none)") << endl;
   os << indent << "EnableStreaming:" << (this->EnableStreaming ? "yes" : "no") << endl;
@@ -107,6 +107,15 @@ public:
   vtkGetStringMacro(LogFileName);
   //@}
 
+  //@{
+  /**
+   * File to write the execution trace to, as Chrome trace-event JSON, when
+   * exiting. Tracing is enabled when set. See vtkPVExecutionTracer.
+   */
+  vtkSetStringMacro(TraceEventsFileName);
+  vtkGetStringMacro(TraceEventsFileName);
+  //@}
+
   //@{
   /**
    * vtkPVProcessModule needs to set this.
@@ -345,6 +354,7 @@ private:
   int UseRenderingGroup;
   int Timeout;
   char* LogFileName;
+  char* TraceEventsFileName;
   int TellVersion;
   char* StereoType;
   int EnableStreaming;
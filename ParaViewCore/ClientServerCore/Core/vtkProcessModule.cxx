@@ -29,6 +29,7 @@
 #include "vtkOutputWindow.h"
 #include "vtkPSystemTools.h"
 #include "vtkPVConfig.h"
+#include "vtkPVExecutionTracer.h"
 #include "vtkPVOptions.h"
 #include "vtkPolyData.h"
 #include "vtkSessionIterator.h"
@@ -295,6 +296,14 @@ bool vtkProcessModule::Finalize()
     vtkProcessModule::Singleton->Internals->Sessions.clear();
 
     vtkProcessModule::Singleton->InvokeEvent(vtkCommand::ExitEvent);
+
+    // All processes get here, hence it's safe to gather the trace events.
+    vtkPVOptions* options = vtkProcessModule::Singleton->GetOptions();
+    if (options && options->GetTraceEventsFileName())
+    {
+      vtkPVExecutionTracer::Write(
+        options->GetTraceEventsFileName(), vtkProcessModule::GlobalController);
+    }
   }
 
   // destroy the process-module.
@@ -536,6 +545,10 @@ void vtkProcessModule::SetOptions(vtkPVOptions* options)
   if (options)
   {
     this->SetSymmetricMPIMode(options->GetSymmetricMPIMode() != 0);
+    if (options->GetTraceEventsFileName())
+    {
+      vtkPVExecutionTracer::SetEnabled(true);
+    }
   }
 }
 
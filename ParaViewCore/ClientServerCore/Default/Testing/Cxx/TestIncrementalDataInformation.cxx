@@ -0,0 +1,115 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestIncrementalDataInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkClientServerStream.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
+#include "vtkPVCompositeDataInformation.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> GetSphere(int resolution)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(resolution);
+  sphere->Update();
+  return sphere->GetOutput();
+}
+
+// Simulates a client-server round trip of the information: `client` sends its
+// parameters, the "server" gathers `data` and replies. Returns the size of the
+// reply.
+size_t Gather(vtkPVDataInformation* client, vtkDataObject* data, bool incremental)
+{
+  if (incremental)
+  {
+    client->PrepareForIncrementalGather();
+  }
+  client->Initialize();
+
+  vtkMultiProcessStream params;
+  client->CopyParametersToStream(params);
+
+  vtkNew<vtkPVDataInformation> server;
+  server->CopyParametersFromStream(params);
+  server->CopyFromObject(data);
+
+  vtkClientServerStream css;
+  server->CopyToStream(&css);
+  client->CopyFromStream(&css);
+
+  const unsigned char* rawdata;
+  size_t length;
+  css.GetData(&rawdata, &length);
+  return length;
+}
+}
+
+int TestIncrementalDataInformation(int, char* [])
+{
+  const int numBlocks = 20;
+  vtkNew<vtkMultiBlockDataSet> data;
+  for (int cc = 0; cc < numBlocks; ++cc)
+  {
+    data->SetBlock(cc, GetSphere(8));
+  }
+
+  vtkNew<vtkPVDataInformation> client;
+  size_t fullSize = Gather(client.Get(), data.Get(), false);
+  vtkTypeInt64 numCells = client->GetNumberOfCells();
+
+  // Nothing changed: no block should be sent again.
+  size_t noChangeSize = Gather(client.Get(), data.Get(), true);
+  if (noChangeSize >= fullSize / 2)
+  {
+    cerr << "ERROR: unchanged blocks were transferred again (" << noChangeSize << " vs. "
+         << fullSize << " bytes)." << endl;
+    return EXIT_FAILURE;
+  }
+  if (client->GetNumberOfCells() != numCells ||
+    client->GetCompositeDataInformation()->GetNumberOfChildren() !=
+      static_cast<unsigned int>(numBlocks))
+  {
+    cerr << "ERROR: incremental information does not match the full information." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Change a single block: only that one should be updated.
+  data->SetBlock(3, GetSphere(16));
+  vtkNew<vtkPVDataInformation> reference;
+  Gather(reference.Get(), data.Get(), false);
+  Gather(client.Get(), data.Get(), true);
+
+  for (int cc = 0; cc < numBlocks; ++cc)
+  {
+    vtkPVDataInformation* a = client->GetCompositeDataInformation()->GetDataInformation(cc);
+    vtkPVDataInformation* b = reference->GetCompositeDataInformation()->GetDataInformation(cc);
+    if (!a || !b || a->GetNumberOfCells() != b->GetNumberOfCells())
+    {
+      cerr << "ERROR: mismatch in block " << cc << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (client->GetNumberOfCells() != reference->GetNumberOfCells())
+  {
+    cerr << "ERROR: mismatch in number of cells." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
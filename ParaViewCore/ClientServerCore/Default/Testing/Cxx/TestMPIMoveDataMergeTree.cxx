@@ -0,0 +1,91 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestMPIMoveDataMergeTree.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that gathering polydata on process 0 through the merge tree of
+// vtkMPIMoveData gives the same result as the direct gather.
+
+#include "vtkMPIController.h"
+#include "vtkMPIMoveData.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> Collect(vtkPolyData* piece, int fanIn)
+{
+  vtkMPIMoveData::SetMergeFanIn(fanIn);
+  vtkNew<vtkMPIMoveData> move;
+  move->SetInputData(piece);
+  move->SetMoveModeToCollect();
+  move->SetOutputDataType(VTK_POLY_DATA);
+  move->Update();
+  vtkMPIMoveData::SetMergeFanIn(0);
+  return vtkPolyData::SafeDownCast(move->GetOutputDataObject(0));
+}
+
+bool SamePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < a->GetNumberOfPoints(); ++cc)
+  {
+    double pa[3], pb[3];
+    a->GetPoint(cc, pa);
+    b->GetPoint(cc, pb);
+    if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestMPIMoveDataMergeTree(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller.Get());
+
+  int myId = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(2.0 * myId, 0, 0);
+  sphere->SetThetaResolution(8 + myId);
+  sphere->Update();
+
+  vtkSmartPointer<vtkPolyData> reference = Collect(sphere->GetOutput(), 0);
+  int status = 1;
+  for (int fanIn = 2; fanIn < numProcs; ++fanIn)
+  {
+    vtkSmartPointer<vtkPolyData> merged = Collect(sphere->GetOutput(), fanIn);
+    if (myId == 0 && (!reference || !merged || !SamePolyData(reference, merged)))
+    {
+      cerr << "ERROR: merge tree with a fan-in of " << fanIn
+           << " differs from the direct gather." << endl;
+      status = 0;
+    }
+  }
+  controller->Broadcast(&status, 1, 0);
+
+  vtkMultiProcessController::SetGlobalController(NULL);
+  controller->Finalize();
+  return status ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,202 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestMPIMoveDataStreamToClient.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the pieces vtkMPIMoveData streams from the merge tree of the
+// data server to the client are merged by the client in the same polydata as
+// the one gathered on process 0 and sent at once. The last process plays the
+// client, connected to process 0 through a socket, and the other processes
+// are the data server.
+
+#include "vtkClientSocket.h"
+#include "vtkMPIController.h"
+#include "vtkMPIMoveData.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkProcessGroup.h"
+#include "vtkServerSocket.h"
+#include "vtkSmartPointer.h"
+#include "vtkSocketCommunicator.h"
+#include "vtkSocketController.h"
+#include "vtkSphereSource.h"
+
+namespace
+{
+const int PORT_TAG = 23500;
+
+// Connects the client to process 0 of the data server, the same way the
+// client of ParaView connects to a server.
+vtkSmartPointer<vtkSocketController> Connect(vtkMultiProcessController* controller, int clientId)
+{
+  vtkSmartPointer<vtkSocketController> result;
+  vtkClientSocket* socket = NULL;
+  int myId = controller->GetLocalProcessId();
+  if (myId == 0)
+  {
+    vtkNew<vtkServerSocket> server;
+    int port = server->CreateServer(0) == 0 ? server->GetServerPort() : -1;
+    controller->Send(&port, 1, clientId, PORT_TAG);
+    if (port > 0)
+    {
+      socket = server->WaitForConnection(60000);
+    }
+  }
+  else if (myId == clientId)
+  {
+    int port = -1;
+    controller->Receive(&port, 1, 0, PORT_TAG);
+    socket = vtkClientSocket::New();
+    if (port <= 0 || socket->ConnectToServer("localhost", port) != 0)
+    {
+      socket->Delete();
+      socket = NULL;
+    }
+  }
+  if (socket)
+  {
+    result = vtkSmartPointer<vtkSocketController>::New();
+    vtkSocketCommunicator* comm = vtkSocketCommunicator::SafeDownCast(result->GetCommunicator());
+    comm->SetSocket(socket);
+    socket->Delete();
+    if (!comm->Handshake())
+    {
+      result = NULL;
+    }
+  }
+  return result;
+}
+
+// Delivers the pieces of the data server to the client, and returns what the
+// client receives.
+vtkSmartPointer<vtkPolyData> Deliver(vtkMultiProcessController* dataServer,
+  vtkSocketController* socket, vtkPolyData* piece, int fanIn)
+{
+  vtkMPIMoveData::SetMergeFanIn(fanIn);
+  vtkNew<vtkMPIMoveData> move;
+  move->SetController(dataServer);
+  if (dataServer)
+  {
+    move->SetInputData(piece);
+    move->SetServerToDataServer();
+  }
+  else
+  {
+    move->SetServerToClient();
+  }
+  // Like in ParaView, only process 0 of the data server has a connection.
+  move->SetClientDataServerSocketController(socket);
+  move->SetMoveModeToCollect();
+  move->SetOutputDataType(VTK_POLY_DATA);
+  move->Update();
+  vtkMPIMoveData::SetMergeFanIn(0);
+  return vtkPolyData::SafeDownCast(move->GetOutputDataObject(0));
+}
+
+bool SamePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < a->GetNumberOfPoints(); ++cc)
+  {
+    double pa[3], pb[3];
+    a->GetPoint(cc, pa);
+    b->GetPoint(cc, pb);
+    if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestMPIMoveDataStreamToClient(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller.Get());
+
+  int myId = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+  int clientId = numProcs - 1;
+
+  // The merge tree needs more data server processes than its fan-in.
+  int status = numProcs >= 4 ? 1 : 0;
+  if (!status && myId == 0)
+  {
+    cerr << "ERROR: the test needs at least 4 processes." << endl;
+  }
+
+  vtkNew<vtkProcessGroup> group;
+  group->Initialize(controller.Get());
+  group->RemoveProcessId(clientId);
+  vtkSmartPointer<vtkMultiProcessController> dataServer;
+  dataServer.TakeReference(controller->CreateSubController(group.Get()));
+
+  vtkSmartPointer<vtkSocketController> socket;
+  if (status)
+  {
+    socket = Connect(controller.Get(), clientId);
+    if ((myId == 0 || myId == clientId) && !socket)
+    {
+      cerr << "ERROR: process " << myId << " failed to connect the client." << endl;
+      status = 0;
+    }
+  }
+  int allStatus = 0;
+  controller->AllReduce(&status, &allStatus, 1, vtkCommunicator::MIN_OP);
+  status = allStatus;
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(2.0 * myId, 0, 0);
+  sphere->SetThetaResolution(8 + myId);
+  sphere->Update();
+
+  if (status)
+  {
+    // Without a merge tree, process 0 gathers the pieces and sends them at once.
+    vtkSmartPointer<vtkPolyData> reference = Deliver(dataServer, socket, sphere->GetOutput(), 0);
+    if (myId == clientId && (!reference || reference->GetNumberOfPoints() == 0))
+    {
+      cerr << "ERROR: the client did not receive the gathered pieces." << endl;
+      status = 0;
+    }
+    for (int fanIn = 2; fanIn < numProcs - 1; ++fanIn)
+    {
+      vtkSmartPointer<vtkPolyData> streamed =
+        Deliver(dataServer, socket, sphere->GetOutput(), fanIn);
+      if (myId == clientId && status && (!streamed || !SamePolyData(reference, streamed)))
+      {
+        cerr << "ERROR: the pieces streamed with a fan-in of " << fanIn
+             << " differ from the gathered ones." << endl;
+        status = 0;
+      }
+      if (myId == 0 && streamed && streamed->GetNumberOfPoints() != 0)
+      {
+        cerr << "ERROR: process 0 kept the pieces streamed to the client." << endl;
+        status = 0;
+      }
+    }
+    controller->AllReduce(&status, &allStatus, 1, vtkCommunicator::MIN_OP);
+    status = allStatus;
+  }
+
+  socket = NULL;
+  dataServer = NULL;
+  vtkMultiProcessController::SetGlobalController(NULL);
+  controller->Finalize();
+  return status ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestMultiBlockStreamingPriorityQueue.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCamera.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiBlockStreamingPriorityQueue.h"
+#include "vtkNew.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                        \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Blocks, by flat index: 1 is large and off-screen, 2 is small and at the
+// center of the view, 3 is of medium size and off-screen.
+const double BlockBounds[3][6] = { { 50, 60, -5, 5, -5, 5 }, { -0.5, 0.5, -0.5, 0.5, -0.5, 0.5 },
+  { -60, -55, -2, 2, -2, 2 } };
+
+void SetupMetaData(vtkMultiBlockDataSet* metadata)
+{
+  metadata->SetNumberOfBlocks(3);
+  for (unsigned int cc = 0; cc < 3; ++cc)
+  {
+    metadata->GetMetaData(cc)->Set(vtkStreamingDemandDrivenPipeline::BOUNDS(), BlockBounds[cc], 6);
+  }
+}
+
+void GetViewPlanes(double planes[24])
+{
+  vtkNew<vtkCamera> camera;
+  camera->SetPosition(0, 0, 10);
+  camera->SetFocalPoint(0, 0, 0);
+  camera->SetClippingRange(1, 100);
+  camera->GetFrustumPlanes(1.0, planes);
+}
+
+bool TestIsStreamable()
+{
+  TASSERT(!vtkMultiBlockStreamingPriorityQueue::IsStreamable(NULL));
+
+  vtkNew<vtkMultiBlockDataSet> metadata;
+  TASSERT(!vtkMultiBlockStreamingPriorityQueue::IsStreamable(metadata.Get()));
+
+  SetupMetaData(metadata.Get());
+  TASSERT(vtkMultiBlockStreamingPriorityQueue::IsStreamable(metadata.Get()));
+
+  // every leaf must have bounds.
+  metadata->SetNumberOfBlocks(4);
+  TASSERT(!vtkMultiBlockStreamingPriorityQueue::IsStreamable(metadata.Get()));
+  return true;
+}
+
+// Without view planes, larger blocks come first.
+bool TestSizeOrder()
+{
+  vtkNew<vtkMultiBlockDataSet> metadata;
+  SetupMetaData(metadata.Get());
+  vtkNew<vtkMultiBlockStreamingPriorityQueue> queue;
+  queue->SetController(NULL);
+  queue->Initialize(metadata.Get());
+
+  double bounds[6];
+  queue->GetBounds(bounds);
+  TASSERT(bounds[0] == -60 && bounds[1] == 60 && bounds[2] == -5 && bounds[3] == 5);
+
+  TASSERT(!queue->IsEmpty() && queue->Pop() == 1);
+  TASSERT(!queue->IsEmpty() && queue->Pop() == 3);
+  TASSERT(!queue->IsEmpty() && queue->Pop() == 2);
+  TASSERT(queue->IsEmpty());
+  return true;
+}
+
+// With view planes, the visible block comes first whatever its size, and the
+// blocks already popped are not inserted again.
+bool TestCoverageOrder()
+{
+  vtkNew<vtkMultiBlockDataSet> metadata;
+  SetupMetaData(metadata.Get());
+  double planes[24];
+  GetViewPlanes(planes);
+
+  vtkNew<vtkMultiBlockStreamingPriorityQueue> queue;
+  queue->SetController(NULL);
+  queue->Initialize(metadata.Get());
+  queue->Update(planes);
+  TASSERT(queue->Pop() == 2);
+
+  queue->Initialize(metadata.Get());
+  TASSERT(queue->Pop() == 1);
+  queue->Update(planes);
+  TASSERT(queue->Pop() == 2);
+  TASSERT(queue->Pop() == 3);
+  TASSERT(queue->IsEmpty());
+
+  // Initialize() starts over.
+  queue->Initialize(metadata.Get());
+  TASSERT(queue->Pop() == 1);
+  return true;
+}
+}
+
+int TestMultiBlockStreamingPriorityQueue(int, char* [])
+{
+  if (!TestIsStreamable() || !TestSizeOrder() || !TestCoverageOrder())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
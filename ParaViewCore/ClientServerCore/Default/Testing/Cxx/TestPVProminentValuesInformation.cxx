@@ -0,0 +1,191 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVProminentValuesInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkClientServerStream.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPVProminentValuesInformation.h"
+#include "vtkSmartPointer.h"
+#include "vtkVariant.h"
+
+#include <cmath>
+#include <set>
+#include <vector>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                        \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+typedef std::set<std::vector<double> > ValueSet;
+
+void SetParameters(vtkPVProminentValuesInformation* info, int numComps, bool useSketches)
+{
+  info->SetFieldAssociation("POINTS");
+  info->SetFieldName("values");
+  info->SetNumberOfComponents(numComps);
+  info->SetFraction(0.1);
+  info->SetUncertainty(0.);
+  info->SetForce(true);
+  info->SetUseSketches(useSketches);
+}
+
+ValueSet GetValues(vtkPVProminentValuesInformation* info, int component)
+{
+  ValueSet values;
+  vtkSmartPointer<vtkAbstractArray> array;
+  array.TakeReference(info->GetProminentComponentValues(component));
+  if (array)
+  {
+    const int nc = array->GetNumberOfComponents();
+    for (vtkIdType t = 0; t < array->GetNumberOfTuples(); ++t)
+    {
+      std::vector<double> tuple(nc);
+      for (int c = 0; c < nc; ++c)
+      {
+        tuple[c] = array->GetVariantValue(t * nc + c).ToDouble();
+      }
+      values.insert(tuple);
+    }
+  }
+  return values;
+}
+
+// Summarizes `array` as a single process would, and as `numPieces` processes
+// streaming their summaries to the root, which merges them, would.
+void Summarize(vtkDataArray* array, int numPieces, bool useSketches,
+  vtkPVProminentValuesInformation* single, vtkPVProminentValuesInformation* gathered)
+{
+  const int nc = array->GetNumberOfComponents();
+  SetParameters(single, nc, useSketches);
+  single->CopyDistinctValuesFromObject(array);
+
+  SetParameters(gathered, nc, useSketches);
+  const vtkIdType numTuples = array->GetNumberOfTuples();
+  for (int piece = 0; piece < numPieces; ++piece)
+  {
+    const vtkIdType begin = numTuples * piece / numPieces;
+    const vtkIdType end = numTuples * (piece + 1) / numPieces;
+    vtkSmartPointer<vtkDataArray> part;
+    part.TakeReference(array->NewInstance());
+    part->SetNumberOfComponents(nc);
+    part->SetNumberOfTuples(end - begin);
+    for (vtkIdType t = begin; t < end; ++t)
+    {
+      part->SetTuple(t - begin, t, array);
+    }
+
+    vtkNew<vtkPVProminentValuesInformation> local;
+    SetParameters(local.Get(), nc, useSketches);
+    local->CopyDistinctValuesFromObject(part);
+    vtkClientServerStream css;
+    local->CopyToStream(&css);
+    vtkNew<vtkPVProminentValuesInformation> received;
+    received->CopyFromStream(&css);
+    gathered->AddInformation(received.Get());
+  }
+}
+
+// An array taking on few values must give the same result with sketches
+// as with the lists of distinct values, per component and per tuple.
+bool TestDiscrete()
+{
+  vtkNew<vtkIntArray> array;
+  array->SetNumberOfComponents(2);
+  array->SetNumberOfTuples(100000);
+  for (vtkIdType t = 0; t < array->GetNumberOfTuples(); ++t)
+  {
+    array->SetTypedComponent(t, 0, static_cast<int>(t % 5));
+    array->SetTypedComponent(t, 1, static_cast<int>(10 * (t % 3)));
+  }
+
+  vtkNew<vtkPVProminentValuesInformation> exact;
+  vtkNew<vtkPVProminentValuesInformation> exactGathered;
+  Summarize(array.Get(), 3, false, exact.Get(), exactGathered.Get());
+  vtkNew<vtkPVProminentValuesInformation> sketched;
+  vtkNew<vtkPVProminentValuesInformation> sketchedGathered;
+  Summarize(array.Get(), 3, true, sketched.Get(), sketchedGathered.Get());
+
+  TASSERT(exact->GetValid() && sketched->GetValid() && sketchedGathered->GetValid());
+  TASSERT(GetValues(sketched.Get(), 0).size() == 5);
+  TASSERT(GetValues(sketched.Get(), 1).size() == 3);
+  TASSERT(GetValues(sketched.Get(), -1).size() == 15);
+  for (int c = -1; c < 2; ++c)
+  {
+    TASSERT(GetValues(sketched.Get(), c) == GetValues(exact.Get(), c));
+    TASSERT(GetValues(sketchedGathered.Get(), c) == GetValues(exactGathered.Get(), c));
+    TASSERT(GetValues(sketchedGathered.Get(), c) == GetValues(sketched.Get(), c));
+  }
+  TASSERT(sketched->GetNumberOfDistinctValues(0) == 5);
+  TASSERT(sketched->GetNumberOfDistinctValues(1) == 3);
+  TASSERT(sketched->GetNumberOfDistinctValues(-1) == 15);
+  TASSERT(sketchedGathered->GetNumberOfDistinctValues(-1) == 15);
+  return true;
+}
+
+// An array taking on far more values than the sketches can hold: the values
+// making up more than Fraction of the array must still be found, and the
+// number of distinct values estimated.
+bool TestBeyondCapacity()
+{
+  const vtkIdType numTuples = 200000;
+  vtkNew<vtkDoubleArray> array;
+  array->SetNumberOfTuples(numTuples);
+  vtkIdType numNoise = 0;
+  for (vtkIdType t = 0; t < numTuples; ++t)
+  {
+    // 1, 2 and 3 each make up 20% of the array, all other values are unique.
+    const int slot = static_cast<int>(t % 5);
+    array->SetValue(t, slot < 3 ? slot + 1 : 1000. + numNoise++);
+  }
+  const double numDistinct = static_cast<double>(numNoise + 3);
+
+  vtkNew<vtkPVProminentValuesInformation> single;
+  vtkNew<vtkPVProminentValuesInformation> gathered;
+  Summarize(array.Get(), 4, true, single.Get(), gathered.Get());
+
+  ValueSet expected;
+  for (int value = 1; value <= 3; ++value)
+  {
+    expected.insert(std::vector<double>(1, value));
+  }
+  TASSERT(single->GetValid() && gathered->GetValid());
+  TASSERT(GetValues(single.Get(), 0) == expected);
+  TASSERT(GetValues(gathered.Get(), 0) == expected);
+  TASSERT(std::abs(single->GetNumberOfDistinctValues(0) - numDistinct) < 0.05 * numDistinct);
+  TASSERT(gathered->GetNumberOfDistinctValues(0) == single->GetNumberOfDistinctValues(0));
+
+  // Without Force, there are too many values for the information to be valid.
+  vtkNew<vtkPVProminentValuesInformation> unforced;
+  SetParameters(unforced.Get(), 1, true);
+  unforced->SetForce(false);
+  unforced->CopyDistinctValuesFromObject(array.Get());
+  TASSERT(!unforced->GetValid());
+  return true;
+}
+}
+
+int TestPVProminentValuesInformation(int, char* [])
+{
+  if (!TestDiscrete() || !TestBeyondCapacity())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -15,6 +15,7 @@
 #include "vtkCacheSizeKeeper.h"
 
 #include "vtkObjectFactory.h"
+#include "vtkPVCacheKeeper.h"
 #include "vtkSmartPointer.h"
 
 //----------------------------------------------------------------------------
@@ -50,11 +51,37 @@ vtkCacheSizeKeeper::vtkCacheSizeKeeper()
   this->CacheSize = 0;
   this->CacheFull = 0;
   this->CacheLimit = 100 * 1024; // 100 MBs.
+  this->EvictionPolicy = NO_EVICTION;
+  this->CompressEvictedEntries = false;
+  this->SpillDirectory = NULL;
+  this->SpillLimit = 0;
+  this->SpillSize = 0;
+  this->AccessTime = 0;
 }
 
 //-----------------------------------------------------------------------------
 vtkCacheSizeKeeper::~vtkCacheSizeKeeper()
 {
+  this->SetSpillDirectory(NULL);
+}
+
+//-----------------------------------------------------------------------------
+int vtkCacheSizeKeeper::ReleaseCacheMemory()
+{
+  if (this->EvictionPolicy == NO_EVICTION)
+  {
+    return 0;
+  }
+  return vtkPVCacheKeeper::ReleaseCacheMemory(this);
+}
+
+//-----------------------------------------------------------------------------
+void vtkCacheSizeKeeper::RemoveCacheEntries(int count)
+{
+  if (this->EvictionPolicy != NO_EVICTION && count > 0)
+  {
+    vtkPVCacheKeeper::RemoveCacheEntries(this, count);
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -64,4 +91,10 @@ void vtkCacheSizeKeeper::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "CacheSize: " << this->CacheSize << endl;
   os << indent << "CacheFull: " << this->CacheFull << endl;
   os << indent << "CacheLimit: " << this->CacheLimit << endl;
+  os << indent << "EvictionPolicy: " << this->EvictionPolicy << endl;
+  os << indent << "CompressEvictedEntries: " << this->CompressEvictedEntries << endl;
+  os << indent << "SpillDirectory: " << (this->SpillDirectory ? this->SpillDirectory : "(none)")
+     << endl;
+  os << indent << "SpillLimit: " << this->SpillLimit << endl;
+  os << indent << "SpillSize: " << this->SpillSize << endl;
 }
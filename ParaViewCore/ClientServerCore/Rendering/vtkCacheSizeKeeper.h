@@ -19,6 +19,16 @@
  *
  * vtkCacheSizeKeeper keeps track of the amount of memory cached
  * by several vtkPVUpdateSuppressor objects.
+ *
+ * The EvictionPolicy determines what happens when the cache size exceeds the
+ * CacheLimit. With NO_EVICTION, the cache is marked full and no more data is
+ * cached. Otherwise, vtkPVView::Update() calls ReleaseCacheMemory() and
+ * RemoveCacheEntries() to bring the cache back under the limit by evicting
+ * the least recently (LEAST_RECENTLY_USED) or least frequently
+ * (LEAST_FREQUENTLY_USED) used entries of all the vtkPVCacheKeeper instances
+ * that report to this keeper. Before being removed, evicted entries are
+ * compressed in memory if CompressEvictedEntries is set, then written to
+ * SpillDirectory if it is set, up to SpillLimit.
 */
 
 #ifndef vtkCacheSizeKeeper_h
@@ -88,6 +98,87 @@ public:
   vtkSetMacro(CacheFull, int);
   //@}
 
+  enum EvictionPolicies
+  {
+    NO_EVICTION = 0,
+    LEAST_RECENTLY_USED = 1,
+    LEAST_FREQUENTLY_USED = 2
+  };
+
+  //@{
+  /**
+   * Get/Set the policy used to pick the cache entries to evict when the cache
+   * size exceeds the limit. Default is NO_EVICTION: when an animation is looped,
+   * evicting the least recently used entries would evict each geometry just
+   * before it is needed again.
+   */
+  vtkSetClampMacro(EvictionPolicy, int, NO_EVICTION, LEAST_FREQUENTLY_USED);
+  vtkGetMacro(EvictionPolicy, int);
+  //@}
+
+  //@{
+  /**
+   * When set, evicted entries are first kept compressed in memory. Default is
+   * false.
+   */
+  vtkSetMacro(CompressEvictedEntries, bool);
+  vtkGetMacro(CompressEvictedEntries, bool);
+  vtkBooleanMacro(CompressEvictedEntries, bool);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the local directory evicted entries are written to. Entries are
+   * only discarded when the files written to that directory exceed
+   * SpillLimit. Default is NULL, i.e. evicted entries are discarded.
+   */
+  vtkSetStringMacro(SpillDirectory);
+  vtkGetStringMacro(SpillDirectory);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the maximum size of the files written to SpillDirectory (in
+   * kbytes). 0 means unlimited. Default is 0.
+   */
+  vtkSetMacro(SpillLimit, unsigned long);
+  vtkGetMacro(SpillLimit, unsigned long);
+  //@}
+
+  //@{
+  /**
+   * Report increase/decrease in size of the files written to SpillDirectory
+   * (in kbytes).
+   */
+  void AddSpillSize(unsigned long kbytes) { this->SpillSize += kbytes; }
+  void FreeSpillSize(unsigned long kbytes)
+  {
+    this->SpillSize = (this->SpillSize > kbytes) ? (this->SpillSize - kbytes) : 0;
+  }
+  vtkGetMacro(SpillSize, unsigned long);
+  //@}
+
+  /**
+   * Compresses or spills cache entries, following the eviction policy, until
+   * the cache size is under the limit. Returns the number of entries that
+   * still need to be removed for the cache size and the spill size to be
+   * under their limits. Since the entries to remove must be the same on all
+   * processes, the result should be reduced over all processes before being
+   * passed to RemoveCacheEntries().
+   */
+  int ReleaseCacheMemory();
+
+  /**
+   * Removes \c count cache entries, following the eviction policy.
+   */
+  void RemoveCacheEntries(int count);
+
+  /**
+   * Returns a new, monotonically increasing, access time. Used by
+   * vtkPVCacheKeeper to order its entries.
+   */
+  vtkTypeUInt64 GetNextAccessTime() { return ++this->AccessTime; }
+
 protected:
   static vtkCacheSizeKeeper* New();
   vtkCacheSizeKeeper();
@@ -96,6 +187,12 @@ protected:
   unsigned long CacheSize;
   unsigned long CacheLimit;
   int CacheFull;
+  int EvictionPolicy;
+  bool CompressEvictedEntries;
+  char* SpillDirectory;
+  unsigned long SpillLimit;
+  unsigned long SpillSize;
+  vtkTypeUInt64 AccessTime;
 
 private:
   vtkCacheSizeKeeper(const vtkCacheSizeKeeper&) = delete;
@@ -156,6 +156,11 @@ public:
    */
   virtual bool Export(vtkCSVExporter* vtkNotUsed(exporter)) { return false; }
 
+  /**
+   * Returns the cache keeper used to cache data for animation playback.
+   */
+  vtkPVCacheKeeper* GetCacheKeeper() VTK_OVERRIDE { return this->CacheKeeper; }
+
 protected:
   vtkChartRepresentation();
   ~vtkChartRepresentation() override;
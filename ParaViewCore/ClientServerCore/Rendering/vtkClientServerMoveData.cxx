@@ -15,6 +15,7 @@
 #include "vtkClientServerMoveData.h"
 
 #include "vtkCharArray.h"
+#include "vtkCommunicator.h"
 #include "vtkDataObject.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkGenericDataObjectReader.h"
@@ -23,7 +24,9 @@
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVExecutionTracer.h"
 #include "vtkPVSession.h"
 #include "vtkPolyData.h"
 #include "vtkProcessModule.h"
@@ -31,8 +34,83 @@
 #include "vtkSelectionSerializer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnstructuredGrid.h"
+#include "vtkZLibDataCompressor.h"
 
 #include <sstream>
+#include <vector>
+
+namespace
+{
+// Amount of data moved by this process, recorded when tracing. The serialized
+// size is not known here, the memory size of the data is a close estimate.
+double vtkBytesSent = 0.0;
+double vtkBytesReceived = 0.0;
+
+// Sends a header with the type of the data object, its marshaled size and its
+// compressed size, followed by the compressed bytes. A negative type stands
+// for no data.
+int vtkSendCompressed(vtkDataObject* data, vtkMultiProcessController* controller, int tag)
+{
+  vtkIdType header[3] = { -1, 0, 0 };
+  vtkNew<vtkCharArray> buffer;
+  std::vector<unsigned char> compressed;
+  if (data && vtkCommunicator::MarshalDataObject(data, buffer.GetPointer()))
+  {
+    header[0] = data->GetDataObjectType();
+    header[1] = buffer->GetNumberOfTuples();
+    if (header[1] > 0)
+    {
+      vtkNew<vtkZLibDataCompressor> compressor;
+      compressed.resize(compressor->GetMaximumCompressionSpace(header[1]));
+      header[2] = static_cast<vtkIdType>(
+        compressor->Compress(reinterpret_cast<unsigned char*>(buffer->GetPointer(0)), header[1],
+          &compressed[0], compressed.size()));
+      if (header[2] == 0)
+      {
+        header[0] = -1;
+        header[1] = 0;
+      }
+    }
+  }
+
+  if (!controller->Send(header, 3, 1, tag))
+  {
+    return 0;
+  }
+  return header[2] > 0
+    ? controller->Send(reinterpret_cast<char*>(&compressed[0]), header[2], 1, tag)
+    : 1;
+}
+
+vtkDataObject* vtkReceiveCompressed(vtkMultiProcessController* controller, int tag)
+{
+  vtkIdType header[3] = { -1, 0, 0 };
+  if (!controller->Receive(header, 3, 1, tag) || header[0] < 0)
+  {
+    return NULL;
+  }
+  vtkDataObject* data = vtkDataObjectTypes::NewDataObject(static_cast<int>(header[0]));
+  if (!data || header[1] == 0)
+  {
+    return data;
+  }
+
+  std::vector<unsigned char> compressed(header[2]);
+  controller->Receive(reinterpret_cast<char*>(&compressed[0]), header[2], 1, tag);
+  vtkNew<vtkCharArray> buffer;
+  buffer->SetNumberOfTuples(header[1]);
+  vtkNew<vtkZLibDataCompressor> compressor;
+  if (compressor->Uncompress(&compressed[0], compressed.size(),
+        reinterpret_cast<unsigned char*>(buffer->GetPointer(0)),
+        static_cast<size_t>(header[1])) != static_cast<size_t>(header[1]) ||
+    !vtkCommunicator::UnMarshalDataObject(buffer.GetPointer(), data))
+  {
+    data->Delete();
+    return NULL;
+  }
+  return data;
+}
+}
 
 vtkStandardNewMacro(vtkClientServerMoveData);
 vtkCxxSetObjectMacro(vtkClientServerMoveData, Controller, vtkMultiProcessController);
@@ -48,6 +126,7 @@ vtkClientServerMoveData::vtkClientServerMoveData()
   this->WholeExtent[5] = -1;
   this->Controller = 0;
   this->ProcessType = AUTO;
+  this->Compression = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -184,6 +263,13 @@ int vtkClientServerMoveData::RequestData(
 //-----------------------------------------------------------------------------
 int vtkClientServerMoveData::SendData(vtkDataObject* input, vtkMultiProcessController* controller)
 {
+  if (input && vtkPVExecutionTracer::GetEnabled())
+  {
+    vtkBytesSent += 1024.0 * input->GetActualMemorySize();
+    vtkPVExecutionTracer::AddCounter(
+      "data movement", "vtkClientServerMoveData bytes sent", vtkBytesSent);
+  }
+
   // This is a server root node.
   // If it is a selection, use the XML serializer.
   // Otherwise, use the communicator.
@@ -210,6 +296,10 @@ int vtkClientServerMoveData::SendData(vtkDataObject* input, vtkMultiProcessContr
     }
   }
 
+  if (this->Compression)
+  {
+    return vtkSendCompressed(input, controller, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  }
   return controller->Send(input, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
 }
 
@@ -237,10 +327,21 @@ vtkDataObject* vtkClientServerMoveData::ReceiveData(vtkMultiProcessController* c
     delete[] xml;
     data = sel;
   }
+  else if (this->Compression)
+  {
+    data = vtkReceiveCompressed(controller, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  }
   else
   {
     data = controller->ReceiveDataObject(1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
   }
+
+  if (data && vtkPVExecutionTracer::GetEnabled())
+  {
+    vtkBytesReceived += 1024.0 * data->GetActualMemorySize();
+    vtkPVExecutionTracer::AddCounter(
+      "data movement", "vtkClientServerMoveData bytes received", vtkBytesReceived);
+  }
   return data;
 }
 
@@ -254,4 +355,5 @@ void vtkClientServerMoveData::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "OutputDataType: " << this->OutputDataType << endl;
   os << indent << "ProcessType: " << this->ProcessType << endl;
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "Compression: " << this->Compression << endl;
 }
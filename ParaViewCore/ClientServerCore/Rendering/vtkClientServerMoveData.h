@@ -88,6 +88,18 @@ public:
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   //@}
 
+  //@{
+  /**
+   * When set, data objects other than selections are marshaled and compressed
+   * with zlib before being sent to the client. This reduces the amount of data
+   * moved for large tables at the cost of some time spent compressing. The
+   * server and the client must use the same value. Off by default.
+   */
+  vtkSetMacro(Compression, bool);
+  vtkGetMacro(Compression, bool);
+  vtkBooleanMacro(Compression, bool);
+  //@}
+
   enum ProcessTypes
   {
     AUTO = 0,
@@ -127,6 +139,7 @@ protected:
   int WholeExtent[6];
   int ProcessType;
   vtkMultiProcessController* Controller;
+  bool Compression;
 
 private:
   vtkClientServerMoveData(const vtkClientServerMoveData&) = delete;
@@ -159,6 +159,13 @@ vtkPVDataRepresentation* vtkCompositeRepresentation::GetActiveRepresentation()
   return NULL;
 }
 
+//----------------------------------------------------------------------------
+vtkPVCacheKeeper* vtkCompositeRepresentation::GetCacheKeeper()
+{
+  vtkPVDataRepresentation* repr = this->GetActiveRepresentation();
+  return repr ? repr->GetCacheKeeper() : NULL;
+}
+
 //----------------------------------------------------------------------------
 int vtkCompositeRepresentation::FillInputPortInformation(int, vtkInformation* info)
 {
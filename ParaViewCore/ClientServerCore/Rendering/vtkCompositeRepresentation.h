@@ -74,6 +74,11 @@ public:
    */
   vtkPVDataRepresentation* GetActiveRepresentation();
 
+  /**
+   * Overridden to return the cache keeper of the active representation.
+   */
+  vtkPVCacheKeeper* GetCacheKeeper() VTK_OVERRIDE;
+
   //@{
   /**
    * Overridden to simply pass the input to the internal representations. We
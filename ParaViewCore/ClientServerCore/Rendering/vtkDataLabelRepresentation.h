@@ -130,6 +130,11 @@ public:
   int ProcessViewRequest(vtkInformationRequestKey* request_type, vtkInformation* inInfo,
     vtkInformation* outInfo) VTK_OVERRIDE;
 
+  /**
+   * Returns the cache keeper used to cache data for animation playback.
+   */
+  vtkPVCacheKeeper* GetCacheKeeper() VTK_OVERRIDE { return this->CacheKeeper; }
+
 protected:
   vtkDataLabelRepresentation();
   ~vtkDataLabelRepresentation() override;
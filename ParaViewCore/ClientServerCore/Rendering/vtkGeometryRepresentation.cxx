@@ -16,11 +16,14 @@
 #include "vtkGeometryRepresentationInternal.h"
 
 #include "vtkAlgorithmOutput.h"
+#include "vtkAppendCompositeDataLeaves.h"
 #include "vtkBoundingBox.h"
 #include "vtkCallbackCommand.h"
 #include "vtkCommand.h"
 #include "vtkCompositeDataDisplayAttributes.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkCompositePolyDataMapper2.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -28,6 +31,7 @@
 #include "vtkMatrix4x4.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiBlockDataSetAlgorithm.h"
+#include "vtkMultiBlockStreamingPriorityQueue.h"
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
@@ -36,6 +40,7 @@
 #include "vtkPVGeometryFilter.h"
 #include "vtkPVLODActor.h"
 #include "vtkPVRenderView.h"
+#include "vtkPVStreamingMacros.h"
 #include "vtkPVTrivialProducer.h"
 #include "vtkPVUpdateSuppressor.h"
 #include "vtkPointData.h"
@@ -45,8 +50,10 @@
 #include "vtkSelection.h"
 #include "vtkSelectionConverter.h"
 #include "vtkSelectionNode.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
+#include "vtkUnsignedIntArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #ifdef PARAVIEW_USE_OSPRAY
@@ -56,6 +63,7 @@
 #include <vtk_jsoncpp.h>
 #include <vtksys/SystemTools.hxx>
 
+#include <assert.h>
 #include <memory>
 #include <tuple>
 #include <vector>
@@ -101,6 +109,30 @@ protected:
 vtkStandardNewMacro(vtkGeometryRepresentationMultiBlockMaker);
 
 //*****************************************************************************
+namespace
+{
+// Sets the process ids generated by a vtkPVGeometryFilter to procId.
+void vtkGeometryRepresentationSetProcessIds(vtkDataObject* dobj, int procId)
+{
+  if (vtkCompositeDataSet* cd = vtkCompositeDataSet::SafeDownCast(dobj))
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(cd->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      vtkGeometryRepresentationSetProcessIds(iter->GetCurrentDataObject(), procId);
+    }
+    return;
+  }
+  vtkDataSet* ds = vtkDataSet::SafeDownCast(dobj);
+  vtkUnsignedIntArray* ids =
+    ds ? vtkUnsignedIntArray::SafeDownCast(ds->GetPointData()->GetArray("vtkProcessId")) : NULL;
+  if (ids)
+  {
+    ids->FillComponent(0, procId);
+  }
+}
+}
 
 vtkStandardNewMacro(vtkGeometryRepresentation);
 //----------------------------------------------------------------------------
@@ -201,6 +233,13 @@ vtkGeometryRepresentation::vtkGeometryRepresentation()
 
   this->UseShaderReplacements = false;
   this->ShaderReplacementsString = "";
+
+  this->StreamingCapablePipeline = false;
+  this->InStreamingUpdate = false;
+  this->StreamingRequestSize = 4;
+  this->PriorityQueue = vtkMultiBlockStreamingPriorityQueue::New();
+  this->RenderedDataTime = 0;
+  this->StreamedDataTime = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -215,6 +254,7 @@ vtkGeometryRepresentation::~vtkGeometryRepresentation()
   this->LODMapper->Delete();
   this->Actor->Delete();
   this->Property->Delete();
+  this->PriorityQueue->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -335,6 +375,9 @@ int vtkGeometryRepresentation::ProcessViewRequest(
     vtkNew<vtkMatrix4x4> matrix;
     this->Actor->GetMatrix(matrix.GetPointer());
     vtkPVRenderView::SetGeometryBounds(inInfo, this->VisibleDataBounds, matrix.GetPointer());
+
+    // Let the view know if the remaining blocks can be streamed.
+    vtkPVRenderView::SetStreamable(inInfo, this, this->StreamingCapablePipeline);
   }
   else if (request_type == vtkPVView::REQUEST_UPDATE_LOD())
   {
@@ -380,7 +423,20 @@ int vtkGeometryRepresentation::ProcessViewRequest(
   {
     vtkAlgorithmOutput* producerPort = vtkPVRenderView::GetPieceProducer(inInfo, this);
     vtkAlgorithmOutput* producerPortLOD = vtkPVRenderView::GetPieceProducerLOD(inInfo, this);
-    this->Mapper->SetInputConnection(0, producerPort);
+    if (this->RenderedData && this->GetDeliveredDataTime(inInfo) != this->RenderedDataTime)
+    {
+      // the data was delivered again, without the blocks streamed since.
+      this->RenderedData = NULL;
+    }
+    if (this->RenderedData)
+    {
+      // render the delivered data merged with the blocks streamed since.
+      this->Mapper->SetInputDataObject(0, this->RenderedData);
+    }
+    else
+    {
+      this->Mapper->SetInputConnection(0, producerPort);
+    }
     this->LODMapper->SetInputConnection(0, producerPortLOD);
 
     // This is called just before the vtk-level render. In this pass, we simply
@@ -389,7 +445,8 @@ int vtkGeometryRepresentation::ProcessViewRequest(
     this->Actor->SetEnableLOD(lod ? 1 : 0);
     this->UpdateColoringParameters();
 
-    auto data = producerPort->GetProducer()->GetOutputDataObject(0);
+    auto data = this->RenderedData ? this->RenderedData.GetPointer()
+                                   : producerPort->GetProducer()->GetOutputDataObject(0);
     if (this->BlockAttributeTime < data->GetMTime() || this->BlockAttrChanged)
     {
       this->UpdateBlockAttributes(this->Mapper);
@@ -408,6 +465,57 @@ int vtkGeometryRepresentation::ProcessViewRequest(
       this->UpdateBlockAttrLOD = false;
     }
   }
+  else if (request_type == vtkPVRenderView::REQUEST_STREAMING_UPDATE())
+  {
+    if (this->StreamingCapablePipeline)
+    {
+      const vtkMTimeType deliveredTime = this->GetDeliveredDataTime(inInfo);
+      if (deliveredTime != this->StreamedDataTime)
+      {
+        // the data was delivered again, be it after the representation
+        // executed or not (e.g. when the data distribution mode changed). The
+        // rendering processes lost the blocks streamed so far, hence start
+        // streaming all over again. Delivery happens on all processes, so they
+        // all agree on the queue.
+        this->StreamedDataTime = deliveredTime;
+        this->PriorityQueue->Initialize(this->StreamingMetaData);
+        this->PopStreamingRequest();
+      }
+
+      double view_planes[24];
+      inInfo->Get(vtkPVRenderView::VIEW_PLANES(), view_planes);
+      if (this->StreamingUpdate(view_planes))
+      {
+        // give the view the blocks just produced so it can deliver them to the
+        // rendering nodes.
+        vtkPVRenderView::SetNextStreamedPiece(inInfo, this, this->ProcessedPiece);
+      }
+    }
+  }
+  else if (request_type == vtkPVRenderView::REQUEST_PROCESS_STREAMED_PIECE())
+  {
+    vtkDataObject* piece = vtkPVRenderView::GetCurrentStreamedPiece(inInfo, this);
+    if (piece)
+    {
+      const vtkMTimeType deliveredTime = this->GetDeliveredDataTime(inInfo);
+      if (this->RenderedData == NULL || deliveredTime != this->RenderedDataTime)
+      {
+        vtkAlgorithmOutput* producerPort = vtkPVRenderView::GetPieceProducer(inInfo, this);
+        this->RenderedData = producerPort->GetProducer()->GetOutputDataObject(0);
+        this->RenderedDataTime = deliveredTime;
+      }
+      vtkStreamingStatusMacro(<< this << ": received new blocks.");
+
+      // merge with what we are already rendering.
+      vtkNew<vtkAppendCompositeDataLeaves> appender;
+      appender->AddInputDataObject(piece);
+      appender->AddInputDataObject(this->RenderedData);
+      appender->Update();
+
+      this->RenderedData = appender->GetOutputDataObject(0);
+      this->Mapper->SetInputDataObject(0, this->RenderedData);
+    }
+  }
 
   return 1;
 }
@@ -440,17 +548,162 @@ int vtkGeometryRepresentation::RequestUpdateExtent(
         ghostLevels += vtkProcessModule::GetNumberOfGhostLevelsToRequest(inInfo);
       }
       inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(), ghostLevels);
+
+      if (this->StreamingCapablePipeline)
+      {
+        if (!this->InStreamingUpdate)
+        {
+          // the input changed, start streaming all over again.
+          // the meta-data is kept to start over when the data is delivered again.
+          this->StreamingMetaData = vtkMultiBlockDataSet::SafeDownCast(
+            inInfo->Get(vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA()));
+          this->PriorityQueue->Initialize(this->StreamingMetaData);
+          this->PopStreamingRequest();
+        }
+
+        vtkStreamingStatusMacro(<< this << ": requesting " << this->StreamingRequest.size()
+                                << " blocks.");
+        // an empty request is valid: this process has no blocks left to load
+        // but must still execute along with the others.
+        int dummy = 0;
+        inInfo->Set(vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS(), 1);
+        inInfo->Set(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES(),
+          this->StreamingRequest.empty() ? &dummy : &this->StreamingRequest[0],
+          static_cast<int>(this->StreamingRequest.size()));
+      }
+      else
+      {
+        // let the source deliver whatever is the default.
+        inInfo->Remove(vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS());
+        inInfo->Remove(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES());
+      }
     }
   }
 
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkGeometryRepresentation::RequestInformation(
+  vtkInformation* rqst, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // The pipeline is streaming capable if it provides the bounds of every block
+  // as meta-data, since we can then request arbitrary blocks by priority. AMR
+  // datasets are left to the AMR representations.
+  this->StreamingCapablePipeline = false;
+  if (inputVector[0]->GetNumberOfInformationObjects() == 1 && vtkPVView::GetEnableStreaming() &&
+    this->SupportsBlockStreaming() && vtkPVGeometryFilter::SafeDownCast(this->GeometryFilter))
+  {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    if (inInfo->Has(vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA()))
+    {
+      this->StreamingCapablePipeline =
+        vtkMultiBlockStreamingPriorityQueue::IsStreamable(vtkMultiBlockDataSet::SafeDownCast(
+          inInfo->Get(vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA())));
+    }
+  }
+
+  vtkStreamingStatusMacro(<< this << ": streaming capable input pipeline? "
+                          << (this->StreamingCapablePipeline ? "yes" : "no"));
+  return this->Superclass::RequestInformation(rqst, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::PopStreamingRequest()
+{
+  this->StreamingRequest.clear();
+  for (int cc = 0; cc < this->StreamingRequestSize && !this->PriorityQueue->IsEmpty(); cc++)
+  {
+    unsigned int cid = this->PriorityQueue->Pop();
+    if (cid != VTK_UNSIGNED_INT_MAX)
+    {
+      this->StreamingRequest.push_back(static_cast<int>(cid));
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkMTimeType vtkGeometryRepresentation::GetDeliveredDataTime(vtkInformation* inInfo)
+{
+  vtkAlgorithmOutput* producerPort = vtkPVRenderView::GetPieceProducer(inInfo, this);
+  vtkDataObject* delivered =
+    producerPort ? producerPort->GetProducer()->GetOutputDataObject(0) : NULL;
+  return delivered ? delivered->GetMTime() : 0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkGeometryRepresentation::StreamingUpdate(const double view_planes[24])
+{
+  assert(this->InStreamingUpdate == false);
+
+  // all processes share the same queue, hence they all agree on whether to
+  // execute or not.
+  if (this->PriorityQueue->IsEmpty())
+  {
+    return false;
+  }
+
+  vtkStreamingStatusMacro(<< this << ": doing streaming-update.");
+  this->PriorityQueue->Update(view_planes);
+  this->PopStreamingRequest();
+
+  this->InStreamingUpdate = true;
+
+  // This ensures that the representation re-executes.
+  this->MarkModified();
+  this->Update();
+
+  this->InStreamingUpdate = false;
+  return true;
+}
+
 //----------------------------------------------------------------------------
 int vtkGeometryRepresentation::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
 
+  if (this->InStreamingUpdate)
+  {
+    // Extract the surface of the blocks just loaded, leaving the cache keeper
+    // and the internal pipeline, which hold the data delivered first, alone.
+    this->ProcessedPiece = NULL;
+    vtkPVGeometryFilter* geomFilter = vtkPVGeometryFilter::SafeDownCast(this->GeometryFilter);
+    vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
+    if (geomFilter && input)
+    {
+      vtkNew<vtkPVGeometryFilter> pieceFilter;
+      pieceFilter->SetController(NULL);
+      pieceFilter->SetUseOutline(geomFilter->GetUseOutline());
+      pieceFilter->SetGenerateFeatureEdges(geomFilter->GetGenerateFeatureEdges());
+      pieceFilter->SetBlockColorsDistinctValues(geomFilter->GetBlockColorsDistinctValues());
+      pieceFilter->SetUseStrips(geomFilter->GetUseStrips());
+      pieceFilter->SetForceUseStrips(geomFilter->GetForceUseStrips());
+      pieceFilter->SetGenerateCellNormals(geomFilter->GetGenerateCellNormals());
+      pieceFilter->SetTriangulate(geomFilter->GetTriangulate());
+      pieceFilter->SetNonlinearSubdivisionLevel(geomFilter->GetNonlinearSubdivisionLevel());
+      pieceFilter->SetPassThroughCellIds(geomFilter->GetPassThroughCellIds());
+      pieceFilter->SetPassThroughPointIds(geomFilter->GetPassThroughPointIds());
+      pieceFilter->SetGenerateProcessIds(geomFilter->GetGenerateProcessIds());
+      pieceFilter->SetInputData(input);
+      pieceFilter->Update();
+      this->ProcessedPiece = pieceFilter->GetOutputDataObject(0);
+      // The piece filter has no controller, so as not to communicate with
+      // processes that have nothing to stream, hence it numbers all the
+      // points as process 0.
+      vtkMultiProcessController* controller = geomFilter->GetController();
+      if (geomFilter->GetGenerateProcessIds() && controller)
+      {
+        vtkGeometryRepresentationSetProcessIds(
+          this->ProcessedPiece, controller->GetLocalProcessId());
+      }
+    }
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  // the delivered data is about to change, forget the blocks streamed so far.
+  this->RenderedData = NULL;
+  this->ProcessedPiece = NULL;
+
   // Pass caching information to the cache keeper.
   this->CacheKeeper->SetCachingEnabled(this->GetUseCache());
   this->CacheKeeper->SetCacheTime(this->GetCacheKey());
@@ -1155,6 +1408,19 @@ void vtkGeometryRepresentation::ComputeVisibleDataBounds()
       }
     }
     this->GetBounds(dataObject, this->VisibleDataBounds, cdAttributes);
+    if (this->StreamingCapablePipeline)
+    {
+      // include the blocks yet to be streamed so the camera fits all the data.
+      double bounds[6];
+      this->PriorityQueue->GetBounds(bounds);
+      vtkBoundingBox bbox;
+      bbox.AddBounds(this->VisibleDataBounds);
+      bbox.AddBounds(bounds);
+      if (bbox.IsValid())
+      {
+        bbox.GetBounds(this->VisibleDataBounds);
+      }
+    }
     this->VisibleDataBoundsTime.Modified();
   }
 }
@@ -29,15 +29,19 @@
 #define vtkGeometryRepresentation_h
 #include <array>         // needed for array
 #include <unordered_map> // needed for unordered_map
+#include <vector>        // needed for vector
 
 #include "vtkPVClientServerCoreRenderingModule.h" // needed for exports
 #include "vtkPVDataRepresentation.h"
-#include "vtkProperty.h" // needed for VTK_POINTS etc.
+#include "vtkProperty.h"     // needed for VTK_POINTS etc.
+#include "vtkSmartPointer.h" // needed for vtkSmartPointer
 
 class vtkCallbackCommand;
 class vtkCompositeDataDisplayAttributes;
 class vtkCompositePolyDataMapper2;
 class vtkMapper;
+class vtkMultiBlockDataSet;
+class vtkMultiBlockStreamingPriorityQueue;
 class vtkPiecewiseFunction;
 class vtkPVCacheKeeper;
 class vtkPVGeometryFilter;
@@ -303,6 +307,30 @@ public:
    */
   virtual void SetShaderReplacements(const char*);
 
+  /**
+   * Returns the cache keeper used to cache data for animation playback.
+   */
+  vtkPVCacheKeeper* GetCacheKeeper() VTK_OVERRIDE { return this->CacheKeeper; }
+
+  //@{
+  /**
+   * When the input pipeline provides the bounds of the blocks of a
+   * vtkMultiBlockDataSet as vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA()
+   * and streaming is enabled (see vtkPVView::SetEnableStreaming), the blocks are
+   * requested a few at a time, most visible on screen first, and are rendered as
+   * they arrive. This sets the number of blocks each process requests in every
+   * streaming pass. Default is 4.
+   */
+  vtkSetClampMacro(StreamingRequestSize, int, 1, 10000);
+  vtkGetMacro(StreamingRequestSize, int);
+  //@}
+
+  /**
+   * Returns true if the input pipeline supports block streaming. Only valid on
+   * processes that have the input data.
+   */
+  vtkGetMacro(StreamingCapablePipeline, bool);
+
 protected:
   vtkGeometryRepresentation();
   ~vtkGeometryRepresentation() override;
@@ -333,11 +361,44 @@ protected:
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) VTK_OVERRIDE;
 
   /**
-   * Overridden to request correct ghost-level to avoid internal surfaces.
+   * Overridden to request correct ghost-level to avoid internal surfaces and,
+   * when streaming, the blocks to load.
    */
   int RequestUpdateExtent(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) VTK_OVERRIDE;
 
+  /**
+   * Overridden to determine if the input pipeline supports block streaming.
+   */
+  int RequestInformation(vtkInformation* rqst, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) VTK_OVERRIDE;
+
+  /**
+   * Subclasses rendering the geometry with additional mappers, that would not
+   * see the streamed blocks, should override this to return false.
+   */
+  virtual bool SupportsBlockStreaming() { return true; }
+
+  /**
+   * Called in REQUEST_STREAMING_UPDATE pass to produce the next blocks to
+   * stream. Returns true if there were blocks left to stream.
+   */
+  bool StreamingUpdate(const double view_planes[24]);
+
+  /**
+   * Pops the blocks to request in the next streaming pass from the priority
+   * queue into StreamingRequest.
+   */
+  void PopStreamingRequest();
+
+  /**
+   * Returns the modification time of the data delivered to this process, or 0
+   * if none was. The delivered data only has the blocks loaded when the
+   * representation executed, hence whenever this changes, the blocks streamed
+   * since must be forgotten and streamed again.
+   */
+  vtkMTimeType GetDeliveredDataTime(vtkInformation* inInfo);
+
   /**
    * Adds the representation to the view.  This is called from
    * vtkView::AddRepresentation().  Subclasses should override this method.
@@ -425,6 +486,17 @@ protected:
   std::unordered_map<unsigned int, double> BlockOpacities;
   std::unordered_map<unsigned int, std::array<double, 3> > BlockColors;
 
+  bool StreamingCapablePipeline;
+  bool InStreamingUpdate;
+  int StreamingRequestSize;
+  std::vector<int> StreamingRequest;
+  vtkMultiBlockStreamingPriorityQueue* PriorityQueue;
+  vtkSmartPointer<vtkDataObject> ProcessedPiece;
+  vtkSmartPointer<vtkDataObject> RenderedData;
+  vtkSmartPointer<vtkMultiBlockDataSet> StreamingMetaData;
+  vtkMTimeType RenderedDataTime;
+  vtkMTimeType StreamedDataTime;
+
 private:
   vtkGeometryRepresentation(const vtkGeometryRepresentation&) = delete;
   void operator=(const vtkGeometryRepresentation&) = delete;
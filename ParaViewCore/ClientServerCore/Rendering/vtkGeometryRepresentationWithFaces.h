@@ -101,6 +101,11 @@ protected:
    */
   void UpdateColoringParameters() VTK_OVERRIDE;
 
+  /**
+   * The backface mapper would not see the streamed blocks.
+   */
+  bool SupportsBlockStreaming() VTK_OVERRIDE { return false; }
+
   vtkMapper* BackfaceMapper;
   vtkMapper* LODBackfaceMapper;
   vtkPVLODActor* BackfaceActor;
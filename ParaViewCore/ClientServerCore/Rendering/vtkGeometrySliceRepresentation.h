@@ -67,6 +67,11 @@ protected:
   bool AddToView(vtkView* view) VTK_OVERRIDE;
   bool RemoveFromView(vtkView* view) VTK_OVERRIDE;
 
+  /**
+   * Slices are computed from the whole input, hence are not streamed.
+   */
+  bool SupportsBlockStreaming() VTK_OVERRIDE { return false; }
+
 private:
   vtkGeometrySliceRepresentation(const vtkGeometrySliceRepresentation&) = delete;
   void operator=(const vtkGeometrySliceRepresentation&) = delete;
@@ -146,6 +146,11 @@ protected:
 
   bool IsCached(double cache_key) VTK_OVERRIDE;
 
+  /**
+   * The glyph mapper would not see the streamed blocks.
+   */
+  bool SupportsBlockStreaming() VTK_OVERRIDE { return false; }
+
   vtkAlgorithm* GlyphMultiBlockMaker;
   vtkPVCacheKeeper* GlyphCacheKeeper;
 
@@ -140,6 +140,11 @@ public:
    */
   vtkPVLODActor* GetActor() { return this->Actor; }
 
+  /**
+   * Returns the cache keeper used to cache data for animation playback.
+   */
+  vtkPVCacheKeeper* GetCacheKeeper() VTK_OVERRIDE { return this->CacheKeeper; }
+
 protected:
   vtkImageSliceRepresentation();
   ~vtkImageSliceRepresentation() override;
@@ -115,6 +115,11 @@ public:
    */
   vtkPVLODVolume* GetActor() { return this->Actor; }
 
+  /**
+   * Returns the cache keeper used to cache data for animation playback.
+   */
+  vtkPVCacheKeeper* GetCacheKeeper() VTK_OVERRIDE { return this->CacheKeeper; }
+
 protected:
   vtkImageVolumeRepresentation();
   ~vtkImageVolumeRepresentation() override;
@@ -37,6 +37,7 @@
 #include "vtkOutlineFilter.h"
 #include "vtkOverlappingAMR.h"
 #include "vtkPVConfig.h"
+#include "vtkPVExecutionTracer.h"
 #include "vtkPVSession.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
@@ -63,9 +64,21 @@
 #include <vector>
 
 bool vtkMPIMoveData::UseZLibCompression = false;
+int vtkMPIMoveData::MergeFanIn = 0;
 
 namespace
 {
+// Amount of data moved by this process, recorded when tracing.
+double vtkBytesMarshaled = 0.0;
+double vtkBytesReconstructed = 0.0;
+
+// Tags used to send pieces up the merge tree.
+enum
+{
+  MERGE_LENGTH_TAG = 23500,
+  MERGE_DATA_TAG = 23501
+};
+
 bool vtkMPIMoveDataMerge(
   std::vector<vtkSmartPointer<vtkDataObject> >& pieces, vtkDataObject* result)
 {
@@ -194,6 +207,25 @@ bool vtkMPIMoveData::GetUseZLibCompression()
   return vtkMPIMoveData::UseZLibCompression;
 }
 
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetMergeFanIn(int fanIn)
+{
+  vtkMPIMoveData::MergeFanIn = fanIn;
+}
+
+//----------------------------------------------------------------------------
+int vtkMPIMoveData::GetMergeFanIn()
+{
+  return vtkMPIMoveData::MergeFanIn;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMPIMoveData::UseMergeTree()
+{
+  return vtkMPIMoveData::MergeFanIn >= 2 && this->Controller &&
+    this->Controller->GetNumberOfProcesses() > vtkMPIMoveData::MergeFanIn;
+}
+
 //----------------------------------------------------------------------------
 int vtkMPIMoveData::FillInputPortInformation(int, vtkInformation* info)
 {
@@ -515,8 +547,7 @@ int vtkMPIMoveData::RequestData(
   {
     if (this->Server == vtkMPIMoveData::DATA_SERVER)
     {
-      this->DataServerGatherToZero(input, output);
-      this->DataServerSendToClient(output);
+      this->DataServerGatherToClient(input, output);
       return 1;
     }
     if (this->Server == vtkMPIMoveData::CLIENT)
@@ -536,8 +567,7 @@ int vtkMPIMoveData::RequestData(
       if (this->Server == vtkMPIMoveData::DATA_SERVER)
       {
         vtkDataObject* tmp = input->NewInstance();
-        this->DataServerGatherToZero(input, tmp);
-        this->DataServerSendToClient(tmp);
+        this->DataServerGatherToClient(input, tmp);
         tmp->Delete();
         tmp = NULL;
         output->ShallowCopy(input);
@@ -561,8 +591,7 @@ int vtkMPIMoveData::RequestData(
         output->Initialize();
 
         // Collect to client.
-        this->DataServerGatherToZero(input, output);
-        this->DataServerSendToClient(output);
+        this->DataServerGatherToClient(input, output);
         output->Initialize();
         return 1;
       }
@@ -710,6 +739,11 @@ void vtkMPIMoveData::DataServerGatherToZero(vtkDataObject* input, vtkDataObject*
     }
     return;
   }
+  if (this->UseMergeTree())
+  {
+    this->DataServerMergeToZero(input, output, false);
+    return;
+  }
 
   vtkTimerLog::MarkStartEvent("Dataserver gathering to 0");
 
@@ -777,6 +811,156 @@ void vtkMPIMoveData::DataServerGatherToZero(vtkDataObject* input, vtkDataObject*
   vtkTimerLog::MarkEndEvent("Dataserver gathering to 0");
 }
 
+//-----------------------------------------------------------------------------
+// Gathers the data on process 0 and sends it to the client, when process 0
+// does not need the gathered data itself.
+void vtkMPIMoveData::DataServerGatherToClient(vtkDataObject* input, vtkDataObject* output)
+{
+  if (this->ClientDataServerSocketController && !this->SkipDataServerGatherToZero &&
+    this->UseMergeTree())
+  {
+    this->DataServerMergeToZero(input, output, true);
+    return;
+  }
+  this->DataServerGatherToZero(input, output);
+  this->DataServerSendToClient(output);
+}
+
+//-----------------------------------------------------------------------------
+// The processes at level l of the merge tree are the multiples of
+// MergeFanIn^l. At each level, a process receives the pieces of its (up to)
+// MergeFanIn - 1 children, MergeFanIn^l apart, and merges them with its own,
+// until it sends the result to its parent. The pieces travel marshaled.
+// When streamToClient is true, process 0 forwards the pieces to the client
+// instead of merging them, and its output is left empty.
+void vtkMPIMoveData::DataServerMergeToZero(
+  vtkDataObject* input, vtkDataObject* output, bool streamToClient)
+{
+  const int fanIn = vtkMPIMoveData::MergeFanIn;
+  const int numProcs = this->Controller->GetNumberOfProcesses();
+  const int myId = this->Controller->GetLocalProcessId();
+
+  vtkTimerLog::MarkStartEvent("Dataserver merging to 0");
+
+  // We are responsible for deleting the buffer. One data set, one buffer.
+  this->ClearBuffer();
+  this->MarshalDataToBuffer(input);
+  vtkIdType pieceLength = this->BufferTotalLength;
+  char* piece = this->Buffers;
+  this->Buffers = NULL;
+  this->ClearBuffer();
+
+  if (myId == 0 && streamToClient)
+  {
+    // Send our piece right away, then the ones of the children as they come,
+    // the smaller subtrees, which complete first, first. A negative number
+    // of buffers tells the client that they are streamed.
+    vtkTimerLog::MarkStartEvent("Dataserver streaming to client");
+    std::vector<int> children;
+    for (int stride = 1; stride < numProcs; stride *= fanIn)
+    {
+      for (int cc = 1; cc < fanIn && cc * stride < numProcs; ++cc)
+      {
+        children.push_back(cc * stride);
+      }
+    }
+    vtkMultiProcessController* client = this->ClientDataServerSocketController;
+    int numberOfPieces = -static_cast<int>(children.size() + 1);
+    client->Send(&numberOfPieces, 1, 1, 23490);
+    client->Send(&pieceLength, 1, 1, 23491);
+    client->Send(piece, pieceLength, 1, 23492);
+    delete[] piece;
+    for (size_t cc = 0; cc < children.size(); ++cc)
+    {
+      this->Controller->Receive(&pieceLength, 1, children[cc], MERGE_LENGTH_TAG);
+      piece = new char[pieceLength];
+      this->Controller->Receive(piece, pieceLength, children[cc], MERGE_DATA_TAG);
+      client->Send(&pieceLength, 1, 1, 23491);
+      client->Send(piece, pieceLength, 1, 23492);
+      delete[] piece;
+    }
+    output->Initialize();
+    vtkTimerLog::MarkEndEvent("Dataserver streaming to client");
+    vtkTimerLog::MarkEndEvent("Dataserver merging to 0");
+    return;
+  }
+
+  int level = 0;
+  for (int stride = 1; stride < numProcs; stride *= fanIn, ++level)
+  {
+    int span = stride * fanIn;
+    if (myId % span != 0)
+    {
+      int parent = myId - myId % span;
+      this->Controller->Send(&pieceLength, 1, parent, MERGE_LENGTH_TAG);
+      this->Controller->Send(piece, pieceLength, parent, MERGE_DATA_TAG);
+      break;
+    }
+
+    std::vector<int> children;
+    for (int child = myId + stride; child < myId + span && child < numProcs; child += stride)
+    {
+      children.push_back(child);
+    }
+    if (children.empty())
+    {
+      continue;
+    }
+
+    std::ostringstream event;
+    event << "Dataserver merging level " << level;
+    vtkTimerLog::MarkStartEvent(event.str().c_str());
+
+    // Receive the pieces of the children after our own.
+    this->NumberOfBuffers = static_cast<int>(children.size()) + 1;
+    this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
+    this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
+    this->BufferLengths[0] = pieceLength;
+    for (size_t cc = 0; cc < children.size(); ++cc)
+    {
+      this->Controller->Receive(this->BufferLengths + cc + 1, 1, children[cc], MERGE_LENGTH_TAG);
+    }
+    this->BufferTotalLength = 0;
+    for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
+    {
+      this->BufferOffsets[idx] = this->BufferTotalLength;
+      this->BufferTotalLength += this->BufferLengths[idx];
+    }
+    this->Buffers = new char[this->BufferTotalLength];
+    memcpy(this->Buffers, piece, pieceLength);
+    delete[] piece;
+    piece = NULL;
+    for (size_t cc = 0; cc < children.size(); ++cc)
+    {
+      this->Controller->Receive(this->Buffers + this->BufferOffsets[cc + 1],
+        this->BufferLengths[cc + 1], children[cc], MERGE_DATA_TAG);
+    }
+
+    vtkSmartPointer<vtkDataObject> merged;
+    merged.TakeReference(output->NewInstance());
+    this->ReconstructDataFromBuffer(merged);
+    this->ClearBuffer();
+
+    if (span >= numProcs)
+    {
+      // Only process 0 reaches the last level.
+      output->ShallowCopy(merged);
+    }
+    else
+    {
+      this->MarshalDataToBuffer(merged);
+      pieceLength = this->BufferTotalLength;
+      piece = this->Buffers;
+      this->Buffers = NULL;
+      this->ClearBuffer();
+    }
+    vtkTimerLog::MarkEndEvent(event.str().c_str());
+  }
+  delete[] piece;
+
+  vtkTimerLog::MarkEndEvent("Dataserver merging to 0");
+}
+
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::DataServerSendToRenderServer(vtkDataObject* output)
 {
@@ -930,6 +1114,32 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
 
   this->ClearBuffer();
   com->Receive(&(this->NumberOfBuffers), 1, 1, 23490);
+  if (this->NumberOfBuffers < 0)
+  {
+    // The data server streams the pieces of its merge tree one at a time,
+    // decode each one as it arrives and merge them at the end.
+    int numberOfPieces = -this->NumberOfBuffers;
+    std::vector<vtkSmartPointer<vtkDataObject> > pieces;
+    for (int cc = 0; cc < numberOfPieces; ++cc)
+    {
+      this->ClearBuffer();
+      this->NumberOfBuffers = 1;
+      this->BufferLengths = new vtkIdType[1];
+      this->BufferOffsets = new vtkIdType[1];
+      this->BufferOffsets[0] = 0;
+      com->Receive(this->BufferLengths, 1, 1, 23491);
+      this->BufferTotalLength = this->BufferLengths[0];
+      this->Buffers = new char[this->BufferTotalLength];
+      com->Receive(this->Buffers, this->BufferTotalLength, 1, 23492);
+      vtkSmartPointer<vtkDataObject> piece;
+      piece.TakeReference(output->NewInstance());
+      this->ReconstructDataFromBuffer(piece);
+      pieces.push_back(piece);
+    }
+    this->ClearBuffer();
+    vtkMPIMoveDataMerge(pieces, output);
+    return;
+  }
   this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
   com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, 23491);
   // Compute additional buffer information.
@@ -1103,6 +1313,13 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
 
   writer->Delete();
   writer = 0;
+
+  if (vtkPVExecutionTracer::GetEnabled())
+  {
+    vtkBytesMarshaled += this->BufferTotalLength;
+    vtkPVExecutionTracer::AddCounter(
+      "data movement", "vtkMPIMoveData bytes marshaled", vtkBytesMarshaled);
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -1114,6 +1331,13 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
     return;
   }
 
+  if (vtkPVExecutionTracer::GetEnabled())
+  {
+    vtkBytesReconstructed += this->BufferTotalLength;
+    vtkPVExecutionTracer::AddCounter(
+      "data movement", "vtkMPIMoveData bytes reconstructed", vtkBytesReconstructed);
+  }
+
   bool is_image_data = data->IsA("vtkImageData") != 0;
   std::vector<vtkSmartPointer<vtkDataObject> > pieces;
 
@@ -1207,6 +1431,7 @@ void vtkMPIMoveData::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Server: " << this->Server << endl;
   os << indent << "MoveMode: " << this->MoveMode << endl;
   os << indent << "SkipDataServerGatherToZero: " << this->SkipDataServerGatherToZero << endl;
+  os << indent << "MergeFanIn: " << vtkMPIMoveData::MergeFanIn << endl;
   os << indent << "OutputDataType: ";
   if (this->OutputDataType == VTK_POLY_DATA)
   {
@@ -113,6 +113,24 @@ public:
   static bool GetUseZLibCompression();
   //@}
 
+  //@{
+  /**
+   * Set the fan-in of the tree used to gather the data of the data server
+   * processes on process 0, i.e. the maximum number of pieces a process
+   * merges at each level of the tree. This bounds the memory and append time
+   * on process 0, which otherwise receives and appends the pieces of all the
+   * processes at once. When the gathered data is only delivered to the
+   * client, process 0 does not merge it: it forwards the pieces to the client
+   * as they arrive, overlapping the transfer with the merges still running on
+   * the other processes, and the client appends them. The time spent at each
+   * level is recorded with vtkTimerLog, hence reported by
+   * vtkPVTimerInformation. 0, the default, disables the tree; so does any
+   * value not smaller than the number of processes.
+   */
+  static void SetMergeFanIn(int fanIn);
+  static int GetMergeFanIn();
+  //@}
+
   /**
    * vtkMPIMoveData doesn't necessarily generate a valid output data on all the
    * involved processes (depending on the MoveMode and Server ivars). This
@@ -156,6 +174,9 @@ protected:
   void DataServerAllToN(vtkDataObject* inData, vtkDataObject* outData, int n);
   void DataServerGatherAll(vtkDataObject* input, vtkDataObject* output);
   void DataServerGatherToZero(vtkDataObject* input, vtkDataObject* output);
+  void DataServerGatherToClient(vtkDataObject* input, vtkDataObject* output);
+  void DataServerMergeToZero(vtkDataObject* input, vtkDataObject* output, bool streamToClient);
+  bool UseMergeTree();
   void DataServerSendToRenderServer(vtkDataObject* output);
   void RenderServerReceiveFromDataServer(vtkDataObject* output);
   void DataServerZeroSendToRenderServerZero(vtkDataObject* data);
@@ -196,6 +217,7 @@ private:
   void operator=(const vtkMPIMoveData&) = delete;
 
   static bool UseZLibCompression;
+  static int MergeFanIn;
 };
 
 #endif
@@ -0,0 +1,196 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkMultiBlockStreamingPriorityQueue.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMultiBlockStreamingPriorityQueue.h"
+
+#include "vtkBoundingBox.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkInformation.h"
+#include "vtkMath.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStreamingPriorityQueue.h"
+
+#include <assert.h>
+#include <vector>
+
+class vtkMultiBlockStreamingPriorityQueue::vtkInternals
+{
+public:
+  vtkStreamingPriorityQueue<> PriorityQueue;
+  vtkBoundingBox Bounds;
+};
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Returns the bounds of the leaf the iterator points to, if any.
+bool vtkGetLeafBounds(vtkCompositeDataIterator* iter, double bounds[6])
+{
+  if (!iter->HasCurrentMetaData())
+  {
+    return false;
+  }
+  vtkInformation* info = iter->GetCurrentMetaData();
+  if (!info->Has(vtkStreamingDemandDrivenPipeline::BOUNDS()))
+  {
+    return false;
+  }
+  info->Get(vtkStreamingDemandDrivenPipeline::BOUNDS(), bounds);
+  return vtkMath::AreBoundsInitialized(bounds) != 0;
+}
+}
+
+vtkStandardNewMacro(vtkMultiBlockStreamingPriorityQueue);
+vtkCxxSetObjectMacro(vtkMultiBlockStreamingPriorityQueue, Controller, vtkMultiProcessController);
+//----------------------------------------------------------------------------
+vtkMultiBlockStreamingPriorityQueue::vtkMultiBlockStreamingPriorityQueue()
+{
+  this->Internals = new vtkInternals();
+  this->Controller = 0;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+}
+
+//----------------------------------------------------------------------------
+vtkMultiBlockStreamingPriorityQueue::~vtkMultiBlockStreamingPriorityQueue()
+{
+  delete this->Internals;
+  this->Internals = 0;
+  this->SetController(0);
+}
+
+//----------------------------------------------------------------------------
+bool vtkMultiBlockStreamingPriorityQueue::IsStreamable(vtkMultiBlockDataSet* metadata)
+{
+  if (!metadata)
+  {
+    return false;
+  }
+
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(metadata->NewIterator());
+  iter->SkipEmptyNodesOff();
+  bool hasLeaves = false;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    double bounds[6];
+    if (!vtkGetLeafBounds(iter, bounds))
+    {
+      return false;
+    }
+    hasLeaves = true;
+  }
+  return hasLeaves;
+}
+
+//----------------------------------------------------------------------------
+void vtkMultiBlockStreamingPriorityQueue::Initialize(vtkMultiBlockDataSet* metadata)
+{
+  delete this->Internals;
+  this->Internals = new vtkInternals();
+  if (!metadata)
+  {
+    return;
+  }
+
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(metadata->NewIterator());
+  iter->SkipEmptyNodesOff();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    double block_bounds[6];
+    if (!vtkGetLeafBounds(iter, block_bounds))
+    {
+      continue;
+    }
+
+    vtkStreamingPriorityQueueItem item;
+    item.Identifier = iter->GetCurrentFlatIndex();
+    item.Bounds.SetBounds(block_bounds);
+
+    // default priority is to prefer larger blocks. Thus even without
+    // view-planes we have reasonable priority.
+    item.Priority = item.Bounds.GetDiagonalLength();
+    this->Internals->PriorityQueue.push(item);
+    this->Internals->Bounds.AddBox(item.Bounds);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkMultiBlockStreamingPriorityQueue::IsEmpty()
+{
+  return this->Internals->PriorityQueue.empty();
+}
+
+//----------------------------------------------------------------------------
+unsigned int vtkMultiBlockStreamingPriorityQueue::Pop()
+{
+  if (this->IsEmpty())
+  {
+    vtkErrorMacro("Queue is empty!");
+    return VTK_UNSIGNED_INT_MAX;
+  }
+
+  int num_procs = this->Controller ? this->Controller->GetNumberOfProcesses() : 1;
+  int myid = this->Controller ? this->Controller->GetLocalProcessId() : 0;
+  assert(myid < num_procs);
+
+  // unlike AMR, blocks are not nested, so processes left without a block when
+  // the queue empties out must not request one already delivered.
+  std::vector<unsigned int> items(num_procs, VTK_UNSIGNED_INT_MAX);
+  for (int cc = 0; cc < num_procs && !this->Internals->PriorityQueue.empty(); cc++)
+  {
+    items[cc] = this->Internals->PriorityQueue.top().Identifier;
+    this->Internals->PriorityQueue.pop();
+  }
+  return items[myid];
+}
+
+//----------------------------------------------------------------------------
+void vtkMultiBlockStreamingPriorityQueue::Update(const double view_planes[24])
+{
+  double clamp_bounds[6];
+  vtkMath::UninitializeBounds(clamp_bounds);
+  this->Update(view_planes, clamp_bounds);
+}
+
+//----------------------------------------------------------------------------
+void vtkMultiBlockStreamingPriorityQueue::Update(
+  const double view_planes[24], const double clamp_bounds[6])
+{
+  this->Internals->PriorityQueue.UpdatePriorities(view_planes, clamp_bounds);
+}
+
+//----------------------------------------------------------------------------
+void vtkMultiBlockStreamingPriorityQueue::GetBounds(double bounds[6])
+{
+  if (this->Internals->Bounds.IsValid())
+  {
+    this->Internals->Bounds.GetBounds(bounds);
+  }
+  else
+  {
+    vtkMath::UninitializeBounds(bounds);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkMultiBlockStreamingPriorityQueue::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Controller: " << this->Controller << endl;
+}
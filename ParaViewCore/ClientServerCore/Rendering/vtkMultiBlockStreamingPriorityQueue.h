@@ -0,0 +1,116 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkMultiBlockStreamingPriorityQueue.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkMultiBlockStreamingPriorityQueue
+ * @brief   implements a coverage based priority queue for the blocks of a
+ * vtkMultiBlockDataSet.
+ *
+ * vtkMultiBlockStreamingPriorityQueue is used by representations supporting
+ * streaming of multiblock datasets to determine the order in which blocks are
+ * requested. It relies on the meta-data provided by the input pipeline as
+ * vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA(), which must give the
+ * bounds of every leaf, as vtkStreamingDemandDrivenPipeline::BOUNDS().
+ *
+ * Blocks are identified by their flat (composite) index. Until view planes are
+ * provided, larger blocks come first, so that the overall shape of the dataset
+ * shows up early. Once Update() is called, blocks are prioritized by their
+ * screen coverage, using the same heuristic as vtkAMRStreamingPriorityQueue.
+ * @sa
+ * vtkAMRStreamingPriorityQueue, vtkGeometryRepresentation.
+*/
+
+#ifndef vtkMultiBlockStreamingPriorityQueue_h
+#define vtkMultiBlockStreamingPriorityQueue_h
+
+#include "vtkObject.h"
+#include "vtkPVClientServerCoreRenderingModule.h" // for export macros
+
+class vtkMultiBlockDataSet;
+class vtkMultiProcessController;
+
+class VTKPVCLIENTSERVERCORERENDERING_EXPORT vtkMultiBlockStreamingPriorityQueue : public vtkObject
+{
+public:
+  static vtkMultiBlockStreamingPriorityQueue* New();
+  vtkTypeMacro(vtkMultiBlockStreamingPriorityQueue, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) VTK_OVERRIDE;
+
+  //@{
+  /**
+   * If the controller is specified, the queue can be used in parallel. So long
+   * as Initialize(), Update() and Pop() methods are called on all processes
+   * and all processes get the same meta-data and view_planes, the blocks are
+   * distributed among the processes.
+   * By default, this is set to the
+   * vtkMultiProcessController::GetGlobalController();
+   */
+  void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  //@}
+
+  /**
+   * Returns true if the meta-data has at least one leaf and provides the
+   * bounds of all of them, i.e. if it can be used to initialize the queue.
+   */
+  static bool IsStreamable(vtkMultiBlockDataSet* metadata);
+
+  /**
+   * Initializes the queue with the leaves of the meta-data. All information
+   * about items in the queue is lost.
+   */
+  void Initialize(vtkMultiBlockDataSet* metadata);
+
+  //@{
+  /**
+   * Updates the priorities of blocks based on the new view frustum planes.
+   * Blocks "popped" from the queue are not reinserted in the queue.
+   */
+  void Update(const double view_planes[24], const double clamp_bounds[6]);
+  void Update(const double view_planes[24]);
+  //@}
+
+  /**
+   * Returns if the queue is empty.
+   */
+  bool IsEmpty();
+
+  /**
+   * Pops and returns the composite id of the block at the top of the queue for
+   * this process. Returns VTK_UNSIGNED_INT_MAX when the queue empties out
+   * before this process gets a block.
+   */
+  unsigned int Pop();
+
+  /**
+   * Returns the bounds of all the blocks given to the most recent call to
+   * Initialize().
+   */
+  void GetBounds(double bounds[6]);
+
+protected:
+  vtkMultiBlockStreamingPriorityQueue();
+  ~vtkMultiBlockStreamingPriorityQueue() override;
+
+  vtkMultiProcessController* Controller;
+
+private:
+  vtkMultiBlockStreamingPriorityQueue(const vtkMultiBlockStreamingPriorityQueue&) = delete;
+  void operator=(const vtkMultiBlockStreamingPriorityQueue&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
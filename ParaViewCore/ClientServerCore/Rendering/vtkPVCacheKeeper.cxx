@@ -15,17 +15,363 @@
 #include "vtkPVCacheKeeper.h"
 
 #include "vtkCacheSizeKeeper.h"
+#include "vtkCharArray.h"
+#include "vtkCommunicator.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkDataObject.h"
+#include "vtkDataObjectTree.h"
+#include "vtkDataObjectTypes.h"
+#include "vtkFieldData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVCacheKeeperPipeline.h"
 #include "vtkProcessModule.h"
 #include "vtkSmartPointer.h"
+#include "vtk_zlib.h"
 
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <fstream>
 #include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+// Serialized form of a cached data object, used for the entries that are
+// compressed or written to disk. Composite datasets are stored as their
+// structure, kept in memory, and one buffer per leaf.
+class vtkCachePayload
+{
+public:
+  vtkSmartPointer<vtkCompositeDataSet> Structure;
+  std::vector<int> Types;               // leaf data object types, -1 for empty leaves.
+  std::vector<vtkTypeUInt64> Sizes;     // uncompressed buffer sizes.
+  std::vector<vtkTypeUInt64> FileSizes; // buffer sizes in the spill file.
+  std::vector<std::vector<char> > Buffers;
+  bool Compressed;
+
+  vtkCachePayload()
+    : Compressed(false)
+  {
+  }
+
+  bool Serialize(vtkDataObject* dobj)
+  {
+    this->Clear();
+    vtkCompositeDataSet* cd = vtkCompositeDataSet::SafeDownCast(dobj);
+    if (!cd)
+    {
+      return this->AddLeaf(dobj);
+    }
+    // Only trees can be rebuilt from their structure and leaves.
+    if (!vtkDataObjectTree::SafeDownCast(cd))
+    {
+      return false;
+    }
+    this->Structure.TakeReference(cd->NewInstance());
+    this->Structure->CopyStructure(cd);
+    this->Structure->GetFieldData()->ShallowCopy(cd->GetFieldData());
+
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(cd->NewIterator());
+    iter->SkipEmptyNodesOff();
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      if (!this->AddLeaf(iter->GetCurrentDataObject()))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  vtkSmartPointer<vtkDataObject> Deserialize()
+  {
+    if (!this->Structure)
+    {
+      if (this->Types.size() != 1)
+      {
+        return NULL;
+      }
+      return this->GetLeaf(0);
+    }
+    vtkSmartPointer<vtkCompositeDataSet> result;
+    result.TakeReference(this->Structure->NewInstance());
+    result->CopyStructure(this->Structure);
+    result->GetFieldData()->ShallowCopy(this->Structure->GetFieldData());
+
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(result->NewIterator());
+    iter->SkipEmptyNodesOff();
+    size_t index = 0;
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++index)
+    {
+      if (index >= this->Types.size())
+      {
+        return NULL;
+      }
+      vtkSmartPointer<vtkDataObject> leaf = this->GetLeaf(index);
+      if (this->Types[index] >= 0 && !leaf)
+      {
+        return NULL;
+      }
+      result->SetDataSet(iter, leaf);
+    }
+    if (index != this->Types.size())
+    {
+      return NULL;
+    }
+    return result;
+  }
+
+  bool Compress()
+  {
+    std::vector<std::vector<char> > compressed(this->Buffers.size());
+    for (size_t cc = 0; cc < this->Buffers.size(); ++cc)
+    {
+      const std::vector<char>& in = this->Buffers[cc];
+      if (in.empty())
+      {
+        continue;
+      }
+      uLongf length = compressBound(static_cast<uLong>(in.size()));
+      compressed[cc].resize(length);
+      if (compress2(reinterpret_cast<Bytef*>(&compressed[cc][0]), &length,
+            reinterpret_cast<const Bytef*>(&in[0]), static_cast<uLong>(in.size()),
+            Z_BEST_SPEED) != Z_OK)
+      {
+        return false;
+      }
+      compressed[cc].resize(length);
+      std::vector<char>(compressed[cc]).swap(compressed[cc]);
+    }
+    this->Buffers.swap(compressed);
+    this->Compressed = true;
+    return true;
+  }
+
+  bool Decompress()
+  {
+    if (!this->Compressed)
+    {
+      return true;
+    }
+    std::vector<std::vector<char> > decompressed(this->Buffers.size());
+    for (size_t cc = 0; cc < this->Buffers.size(); ++cc)
+    {
+      const std::vector<char>& in = this->Buffers[cc];
+      if (in.empty())
+      {
+        continue;
+      }
+      uLongf length = static_cast<uLongf>(this->Sizes[cc]);
+      decompressed[cc].resize(length);
+      if (uncompress(reinterpret_cast<Bytef*>(&decompressed[cc][0]), &length,
+            reinterpret_cast<const Bytef*>(&in[0]), static_cast<uLong>(in.size())) != Z_OK ||
+        length != this->Sizes[cc])
+      {
+        return false;
+      }
+    }
+    this->Buffers.swap(decompressed);
+    this->Compressed = false;
+    return true;
+  }
+
+  // Writes the buffers back to back and releases them.
+  bool Write(const std::string& fname)
+  {
+    std::ofstream file(fname.c_str(), std::ios::out | std::ios::binary);
+    this->FileSizes.resize(this->Buffers.size());
+    for (size_t cc = 0; file && cc < this->Buffers.size(); ++cc)
+    {
+      this->FileSizes[cc] = this->Buffers[cc].size();
+      if (!this->Buffers[cc].empty())
+      {
+        file.write(&this->Buffers[cc][0], this->Buffers[cc].size());
+      }
+    }
+    file.close();
+    if (!file)
+    {
+      return false;
+    }
+    std::vector<std::vector<char> >(this->Buffers.size()).swap(this->Buffers);
+    return true;
+  }
+
+  bool Read(const std::string& fname)
+  {
+    std::ifstream file(fname.c_str(), std::ios::in | std::ios::binary);
+    for (size_t cc = 0; file && cc < this->FileSizes.size(); ++cc)
+    {
+      this->Buffers[cc].resize(this->FileSizes[cc]);
+      if (!this->Buffers[cc].empty())
+      {
+        file.read(&this->Buffers[cc][0], this->Buffers[cc].size());
+      }
+    }
+    return !file.fail();
+  }
+
+  // Size of the buffers, in kbytes.
+  unsigned long GetBuffersSize() const
+  {
+    size_t size = 0;
+    for (size_t cc = 0; cc < this->Buffers.size(); ++cc)
+    {
+      size += this->Buffers[cc].capacity();
+    }
+    return static_cast<unsigned long>(size / 1024 + 1);
+  }
+
+  // Size of the spill file, in kbytes.
+  unsigned long GetFileSize() const
+  {
+    vtkTypeUInt64 size = 0;
+    for (size_t cc = 0; cc < this->FileSizes.size(); ++cc)
+    {
+      size += this->FileSizes[cc];
+    }
+    return static_cast<unsigned long>(size / 1024 + 1);
+  }
+
+  void Clear()
+  {
+    this->Structure = NULL;
+    this->Types.clear();
+    this->Sizes.clear();
+    this->FileSizes.clear();
+    this->Buffers.clear();
+    this->Compressed = false;
+  }
+
+private:
+  bool AddLeaf(vtkDataObject* dobj)
+  {
+    this->Types.push_back(dobj ? dobj->GetDataObjectType() : -1);
+    this->Buffers.push_back(std::vector<char>());
+    if (dobj)
+    {
+      vtkNew<vtkCharArray> buffer;
+      if (!vtkCommunicator::MarshalDataObject(dobj, buffer.GetPointer()))
+      {
+        return false;
+      }
+      const char* data = buffer->GetPointer(0);
+      this->Buffers.back().assign(data, data + buffer->GetNumberOfValues());
+    }
+    this->Sizes.push_back(this->Buffers.back().size());
+    return true;
+  }
+
+  vtkSmartPointer<vtkDataObject> GetLeaf(size_t index)
+  {
+    if (this->Types[index] < 0 || this->Buffers[index].empty())
+    {
+      return NULL;
+    }
+    vtkSmartPointer<vtkDataObject> leaf;
+    leaf.TakeReference(vtkDataObjectTypes::NewDataObject(this->Types[index]));
+    vtkNew<vtkCharArray> buffer;
+    buffer->SetArray(&this->Buffers[index][0], static_cast<vtkIdType>(this->Buffers[index].size()),
+      /*save=*/1);
+    if (!leaf || !vtkCommunicator::UnMarshalDataObject(buffer.GetPointer(), leaf))
+    {
+      return NULL;
+    }
+    return leaf;
+  }
+};
+
+class vtkCacheEntry
+{
+public:
+  enum States
+  {
+    IN_MEMORY,
+    COMPRESSED,
+    SPILLED
+  };
+  int State;
+  vtkSmartPointer<vtkDataObject> Data;
+  vtkCachePayload Payload;
+  std::string FileName;
+  unsigned long MemorySize; // kbytes reported to the vtkCacheSizeKeeper.
+  unsigned long SpillSize;  // kbytes.
+  vtkTypeUInt64 LastAccess;
+  vtkTypeUInt64 NumberOfAccesses;
+
+  vtkCacheEntry()
+    : State(IN_MEMORY)
+    , MemorySize(0)
+    , SpillSize(0)
+    , LastAccess(0)
+    , NumberOfAccesses(0)
+  {
+  }
+};
+
+// Eviction candidate, across all vtkPVCacheKeeper instances.
+struct vtkCacheCandidate
+{
+  vtkPVCacheKeeper* Keeper;
+  double CacheTime;
+  const vtkCacheEntry* Entry;
+};
+
+struct vtkLeastRecentlyUsed
+{
+  bool operator()(const vtkCacheCandidate& a, const vtkCacheCandidate& b) const
+  {
+    return a.Entry->LastAccess < b.Entry->LastAccess;
+  }
+};
+
+struct vtkLeastFrequentlyUsed
+{
+  bool operator()(const vtkCacheCandidate& a, const vtkCacheCandidate& b) const
+  {
+    if (a.Entry->NumberOfAccesses != b.Entry->NumberOfAccesses)
+    {
+      return a.Entry->NumberOfAccesses < b.Entry->NumberOfAccesses;
+    }
+    return a.Entry->LastAccess < b.Entry->LastAccess;
+  }
+};
+
+// All vtkPVCacheKeeper instances, used to enforce the cache limits globally.
+std::set<vtkPVCacheKeeper*>& GetInstances()
+{
+  static std::set<vtkPVCacheKeeper*> instances;
+  return instances;
+}
+
+std::string GetSpillFileName(const char* directory)
+{
+  static unsigned int counter = 0;
+  std::ostringstream name;
+  name << directory << "/pvcache-" << getpid() << "-" << (++counter) << ".bin";
+  return name.str();
+}
+}
+
 //----------------------------------------------------------------------------
-class vtkPVCacheKeeper::vtkCacheMap : public std::map<double, vtkSmartPointer<vtkDataObject> >
+class vtkPVCacheKeeper::vtkCacheMap : public std::map<double, vtkCacheEntry>
 {
 public:
   unsigned long GetActualMemorySize()
@@ -34,14 +380,56 @@ public:
     vtkCacheMap::iterator iter;
     for (iter = this->begin(); iter != this->end(); ++iter)
     {
-      actual_size += iter->second.GetPointer()->GetActualMemorySize();
+      actual_size += iter->second.MemorySize;
     }
     return actual_size;
   }
+
+  unsigned long GetSpillSize()
+  {
+    unsigned long spill_size = 0;
+    vtkCacheMap::iterator iter;
+    for (iter = this->begin(); iter != this->end(); ++iter)
+    {
+      spill_size += iter->second.SpillSize;
+    }
+    return spill_size;
+  }
+
+  // Returns the candidates for eviction among the entries of all keepers
+  // reporting to sizeKeeper, sorted following the eviction policy.
+  static std::vector<vtkCacheCandidate> GetCandidates(vtkCacheSizeKeeper* sizeKeeper)
+  {
+    std::vector<vtkCacheCandidate> candidates;
+    std::set<vtkPVCacheKeeper*>::iterator kiter;
+    for (kiter = GetInstances().begin(); kiter != GetInstances().end(); ++kiter)
+    {
+      if ((*kiter)->CacheSizeKeeper != sizeKeeper)
+      {
+        continue;
+      }
+      vtkCacheMap* cache = (*kiter)->Cache;
+      for (vtkCacheMap::iterator iter = cache->begin(); iter != cache->end(); ++iter)
+      {
+        vtkCacheCandidate candidate = { *kiter, iter->first, &iter->second };
+        candidates.push_back(candidate);
+      }
+    }
+    // Access times are unique, hence the order does not depend on the order
+    // of the instances, which may differ between processes.
+    if (sizeKeeper->GetEvictionPolicy() == vtkCacheSizeKeeper::LEAST_FREQUENTLY_USED)
+    {
+      std::sort(candidates.begin(), candidates.end(), vtkLeastFrequentlyUsed());
+    }
+    else
+    {
+      std::sort(candidates.begin(), candidates.end(), vtkLeastRecentlyUsed());
+    }
+    return candidates;
+  }
 };
 
 vtkStandardNewMacro(vtkPVCacheKeeper);
-vtkCxxSetObjectMacro(vtkPVCacheKeeper, CacheSizeKeeper, vtkCacheSizeKeeper);
 //----------------------------------------------------------------------------
 int vtkPVCacheKeeper::CacheHit = 0;
 int vtkPVCacheKeeper::CacheMiss = 0;
@@ -54,12 +442,17 @@ vtkPVCacheKeeper::vtkPVCacheKeeper()
   this->CacheTime = 0.0;
   this->CachingEnabled = true;
   this->CacheSizeKeeper = 0;
+  this->NumberOfCacheHits = 0;
+  this->NumberOfCacheMisses = 0;
+  this->NumberOfCacheEvictions = 0;
   this->SetCacheSizeKeeper(vtkCacheSizeKeeper::GetInstance());
+  GetInstances().insert(this);
 }
 
 //----------------------------------------------------------------------------
 vtkPVCacheKeeper::~vtkPVCacheKeeper()
 {
+  GetInstances().erase(this);
   this->RemoveAllCaches();
 
   // Unset cache keeper only after having cleared the cache.
@@ -69,16 +462,55 @@ vtkPVCacheKeeper::~vtkPVCacheKeeper()
   this->Cache = 0;
 }
 
+//----------------------------------------------------------------------------
+void vtkPVCacheKeeper::SetCacheSizeKeeper(vtkCacheSizeKeeper* keeper)
+{
+  if (this->CacheSizeKeeper == keeper)
+  {
+    return;
+  }
+  // The cached entries are accounted for by the current keeper.
+  if (!this->Cache->empty())
+  {
+    this->RemoveAllCaches();
+  }
+  if (this->CacheSizeKeeper)
+  {
+    this->CacheSizeKeeper->UnRegister(this);
+  }
+  this->CacheSizeKeeper = keeper;
+  if (this->CacheSizeKeeper)
+  {
+    this->CacheSizeKeeper->Register(this);
+  }
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVCacheKeeper::RemoveAllCaches()
 {
   // cout << this << " RemoveAllCaches" << endl;
   unsigned long freed_size = this->Cache->GetActualMemorySize();
+  unsigned long freed_spill_size = this->Cache->GetSpillSize();
+  for (vtkCacheMap::iterator iter = this->Cache->begin(); iter != this->Cache->end(); ++iter)
+  {
+    if (!iter->second.FileName.empty())
+    {
+      vtksys::SystemTools::RemoveFile(iter->second.FileName);
+    }
+  }
   this->Cache->clear();
-  if (freed_size > 0 && this->CacheSizeKeeper)
+  if (this->CacheSizeKeeper)
   {
     // Tell the cache size keeper about the newly freed memory size.
-    this->CacheSizeKeeper->FreeCacheSize(freed_size);
+    if (freed_size > 0)
+    {
+      this->CacheSizeKeeper->FreeCacheSize(freed_size);
+    }
+    if (freed_spill_size > 0)
+    {
+      this->CacheSizeKeeper->FreeSpillSize(freed_spill_size);
+    }
   }
 
   ++vtkPVCacheKeeper::CacheClears;
@@ -101,18 +533,238 @@ bool vtkPVCacheKeeper::SaveData(vtkDataObject* output)
     vtkSmartPointer<vtkDataObject> cache;
     cache.TakeReference(output->NewInstance());
     cache->ShallowCopy(output);
-    (*this->Cache)[this->CacheTime] = cache;
 
+    // Replace any previous entry for this time.
+    if (this->IsCached(this->CacheTime))
+    {
+      this->RemoveEntry(this->CacheTime);
+    }
+
+    vtkCacheEntry& entry = (*this->Cache)[this->CacheTime];
+    entry.Data = cache;
+    entry.MemorySize = cache->GetActualMemorySize();
+    entry.NumberOfAccesses = 1;
     if (this->CacheSizeKeeper)
     {
+      entry.LastAccess = this->CacheSizeKeeper->GetNextAccessTime();
+
       // Register used cache size.
-      this->CacheSizeKeeper->AddCacheSize(cache->GetActualMemorySize());
+      this->CacheSizeKeeper->AddCacheSize(entry.MemorySize);
     }
     return true;
   }
   return false;
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVCacheKeeper::CompressEntry(double cacheTime)
+{
+  vtkCacheMap::iterator iter = this->Cache->find(cacheTime);
+  if (iter == this->Cache->end() || iter->second.State != vtkCacheEntry::IN_MEMORY)
+  {
+    return false;
+  }
+  vtkCacheEntry& entry = iter->second;
+  if (!entry.Payload.Serialize(entry.Data) || !entry.Payload.Compress())
+  {
+    entry.Payload.Clear();
+    return false;
+  }
+  unsigned long size = entry.Payload.GetBuffersSize();
+  if (size >= entry.MemorySize)
+  {
+    // Not worth it.
+    entry.Payload.Clear();
+    return false;
+  }
+  entry.Data = NULL;
+  entry.State = vtkCacheEntry::COMPRESSED;
+  if (this->CacheSizeKeeper)
+  {
+    this->CacheSizeKeeper->FreeCacheSize(entry.MemorySize - size);
+  }
+  entry.MemorySize = size;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVCacheKeeper::SpillEntry(double cacheTime)
+{
+  vtkCacheMap::iterator iter = this->Cache->find(cacheTime);
+  const char* directory = this->CacheSizeKeeper ? this->CacheSizeKeeper->GetSpillDirectory() : NULL;
+  if (iter == this->Cache->end() || iter->second.State == vtkCacheEntry::SPILLED || !directory ||
+    !*directory)
+  {
+    return false;
+  }
+  vtkCacheEntry& entry = iter->second;
+  if (entry.State == vtkCacheEntry::IN_MEMORY && !entry.Payload.Serialize(entry.Data))
+  {
+    entry.Payload.Clear();
+    return false;
+  }
+  std::string fname = GetSpillFileName(directory);
+  if (!entry.Payload.Write(fname))
+  {
+    vtkErrorMacro("Failed to write cache entry to '" << fname.c_str() << "'.");
+    vtksys::SystemTools::RemoveFile(fname);
+    if (entry.State == vtkCacheEntry::IN_MEMORY)
+    {
+      entry.Payload.Clear();
+    }
+    return false;
+  }
+  entry.Data = NULL;
+  entry.State = vtkCacheEntry::SPILLED;
+  entry.FileName = fname;
+  entry.SpillSize = entry.Payload.GetFileSize();
+  if (this->CacheSizeKeeper)
+  {
+    this->CacheSizeKeeper->FreeCacheSize(entry.MemorySize);
+    this->CacheSizeKeeper->AddSpillSize(entry.SpillSize);
+  }
+  entry.MemorySize = 0;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCacheKeeper::RemoveEntry(double cacheTime)
+{
+  vtkCacheMap::iterator iter = this->Cache->find(cacheTime);
+  if (iter == this->Cache->end())
+  {
+    return;
+  }
+  vtkCacheEntry& entry = iter->second;
+  if (!entry.FileName.empty())
+  {
+    vtksys::SystemTools::RemoveFile(entry.FileName);
+  }
+  if (this->CacheSizeKeeper)
+  {
+    this->CacheSizeKeeper->FreeCacheSize(entry.MemorySize);
+    this->CacheSizeKeeper->FreeSpillSize(entry.SpillSize);
+  }
+  this->Cache->erase(iter);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVCacheKeeper::RestoreEntry(double cacheTime)
+{
+  vtkCacheMap::iterator iter = this->Cache->find(cacheTime);
+  if (iter == this->Cache->end())
+  {
+    return false;
+  }
+  vtkCacheEntry& entry = iter->second;
+  if (entry.State == vtkCacheEntry::IN_MEMORY)
+  {
+    return true;
+  }
+  if (entry.State == vtkCacheEntry::SPILLED && !entry.Payload.Read(entry.FileName))
+  {
+    vtkWarningMacro("Failed to read cache entry from '" << entry.FileName.c_str() << "'.");
+    return false;
+  }
+  if (!entry.Payload.Decompress())
+  {
+    vtkWarningMacro("Failed to decompress cache entry.");
+    return false;
+  }
+  vtkSmartPointer<vtkDataObject> data = entry.Payload.Deserialize();
+  if (!data)
+  {
+    vtkWarningMacro("Failed to restore cache entry.");
+    return false;
+  }
+  if (!entry.FileName.empty())
+  {
+    vtksys::SystemTools::RemoveFile(entry.FileName);
+    entry.FileName.clear();
+  }
+  entry.Payload.Clear();
+  entry.Data = data;
+  entry.State = vtkCacheEntry::IN_MEMORY;
+  unsigned long size = data->GetActualMemorySize();
+  if (this->CacheSizeKeeper)
+  {
+    this->CacheSizeKeeper->FreeCacheSize(entry.MemorySize);
+    this->CacheSizeKeeper->FreeSpillSize(entry.SpillSize);
+    this->CacheSizeKeeper->AddCacheSize(size);
+  }
+  entry.MemorySize = size;
+  entry.SpillSize = 0;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVCacheKeeper::PrepareEntry(double cacheTime)
+{
+  if (!this->IsCached(cacheTime))
+  {
+    return false;
+  }
+  if (!this->RestoreEntry(cacheTime))
+  {
+    vtkWarningMacro("Dropping cache entry " << cacheTime << ", it will be produced again.");
+    this->RemoveEntry(cacheTime);
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVCacheKeeper::ReleaseCacheMemory(vtkCacheSizeKeeper* sizeKeeper)
+{
+  std::vector<vtkCacheCandidate> candidates = vtkCacheMap::GetCandidates(sizeKeeper);
+  std::vector<vtkCacheCandidate>::iterator iter;
+
+  // First compress entries, then write them to disk, following the eviction
+  // policy, until the cache is small enough.
+  if (sizeKeeper->GetCompressEvictedEntries())
+  {
+    for (iter = candidates.begin();
+         iter != candidates.end() && sizeKeeper->GetCacheSize() > sizeKeeper->GetCacheLimit();
+         ++iter)
+    {
+      iter->Keeper->CompressEntry(iter->CacheTime);
+    }
+  }
+  const unsigned long spillLimit = sizeKeeper->GetSpillLimit();
+  for (iter = candidates.begin();
+       iter != candidates.end() && sizeKeeper->GetCacheSize() > sizeKeeper->GetCacheLimit() &&
+       (spillLimit == 0 || sizeKeeper->GetSpillSize() < spillLimit);
+       ++iter)
+  {
+    iter->Keeper->SpillEntry(iter->CacheTime);
+  }
+
+  // Count the entries that must be removed, in order, for both the cache and
+  // the spilled entries to be under their limits.
+  unsigned long cacheSize = sizeKeeper->GetCacheSize();
+  unsigned long spillSize = sizeKeeper->GetSpillSize();
+  int count = 0;
+  for (iter = candidates.begin(); iter != candidates.end() &&
+       (cacheSize > sizeKeeper->GetCacheLimit() || (spillLimit > 0 && spillSize > spillLimit));
+       ++iter, ++count)
+  {
+    cacheSize -= std::min(cacheSize, iter->Entry->MemorySize);
+    spillSize -= std::min(spillSize, iter->Entry->SpillSize);
+  }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCacheKeeper::RemoveCacheEntries(vtkCacheSizeKeeper* sizeKeeper, int count)
+{
+  std::vector<vtkCacheCandidate> candidates = vtkCacheMap::GetCandidates(sizeKeeper);
+  for (size_t cc = 0; cc < candidates.size() && static_cast<int>(cc) < count; ++cc)
+  {
+    candidates[cc].Keeper->RemoveEntry(candidates[cc].CacheTime);
+    candidates[cc].Keeper->NumberOfCacheEvictions++;
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkExecutive* vtkPVCacheKeeper::CreateDefaultExecutive()
 {
@@ -163,11 +815,21 @@ int vtkPVCacheKeeper::RequestData(vtkInformation* vtkNotUsed(reqInfo),
 
   if (this->CachingEnabled)
   {
-    if (this->IsCached(this->CacheTime))
+    // The executive prepared the entry before shunting the upstream updates,
+    // so an entry that could not be restored is no longer cached and the
+    // input is up-to-date.
+    if (this->PrepareEntry(this->CacheTime))
     {
-      output->ShallowCopy((*this->Cache)[this->CacheTime]);
+      vtkCacheEntry& entry = (*this->Cache)[this->CacheTime];
+      output->ShallowCopy(entry.Data);
+      entry.NumberOfAccesses++;
+      if (this->CacheSizeKeeper)
+      {
+        entry.LastAccess = this->CacheSizeKeeper->GetNextAccessTime();
+      }
       // cout << this << " using Cache: " << this->CacheTime << endl;
       vtkPVCacheKeeper::CacheHit++;
+      this->NumberOfCacheHits++;
     }
     else
     {
@@ -175,6 +837,7 @@ int vtkPVCacheKeeper::RequestData(vtkInformation* vtkNotUsed(reqInfo),
       this->SaveData(output);
       // cout << this << " Saving cache: " << this->CacheTime << endl;
       vtkPVCacheKeeper::CacheMiss++;
+      this->NumberOfCacheMisses++;
     }
   }
   else
@@ -219,8 +882,40 @@ int vtkPVCacheKeeper::GetCacheClears()
   return vtkPVCacheKeeper::CacheClears;
 }
 
+//----------------------------------------------------------------------------
+void vtkPVCacheKeeper::ResetCacheStatistics()
+{
+  this->NumberOfCacheHits = 0;
+  this->NumberOfCacheMisses = 0;
+  this->NumberOfCacheEvictions = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVCacheKeeper::GetNumberOfCachedEntries()
+{
+  return static_cast<vtkIdType>(this->Cache->size());
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPVCacheKeeper::GetCacheMemorySize()
+{
+  return this->Cache->GetActualMemorySize();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPVCacheKeeper::GetCacheSpillSize()
+{
+  return this->Cache->GetSpillSize();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVCacheKeeper::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CachingEnabled: " << this->CachingEnabled << endl;
+  os << indent << "CacheTime: " << this->CacheTime << endl;
+  os << indent << "NumberOfCachedEntries: " << this->GetNumberOfCachedEntries() << endl;
+  os << indent << "NumberOfCacheHits: " << this->NumberOfCacheHits << endl;
+  os << indent << "NumberOfCacheMisses: " << this->NumberOfCacheMisses << endl;
+  os << indent << "NumberOfCacheEvictions: " << this->NumberOfCacheEvictions << endl;
 }
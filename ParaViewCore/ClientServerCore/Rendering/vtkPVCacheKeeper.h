@@ -22,6 +22,12 @@
  * then this filter shuts the update request, otherwise propagates the update
  * and then cache the result for later use.  The current time step is set using
  * SetCacheTime().
+ *
+ * Cache entries are evicted following the policy of the vtkCacheSizeKeeper
+ * this filter reports to (see vtkCacheSizeKeeper::SetEvictionPolicy).
+ * Evicted entries may be kept compressed in memory or written to disk, in
+ * which case they are still reported as cached and are restored when
+ * accessed.
  * @sa
  * vtkPVCacheKeeperPipeline
 */
@@ -62,6 +68,15 @@ public:
   virtual bool IsCached(double cacheTime);
   virtual bool IsCached() { return this->IsCached(this->CacheTime); }
 
+  /**
+   * Makes the entry for \c cacheTime ready to be used, restoring it if it was
+   * compressed or written to disk. An entry that cannot be restored is
+   * dropped, with a warning, so that the data is produced again upstream.
+   * Returns true if the entry is cached and ready. The executive calls it
+   * before shunting upstream updates.
+   */
+  bool PrepareEntry(double cacheTime);
+
   //@{
   /**
    * Get/Set if caching is enabled. Default is true.
@@ -84,6 +99,33 @@ public:
   static int GetCacheClears();
   //@}
 
+  //@{
+  /**
+   * Statistics for this instance: number of cache hits, misses and evictions,
+   * i.e. entries removed to enforce the cache limits, since the last call to
+   * ResetCacheStatistics().
+   */
+  vtkGetMacro(NumberOfCacheHits, vtkIdType);
+  vtkGetMacro(NumberOfCacheMisses, vtkIdType);
+  vtkGetMacro(NumberOfCacheEvictions, vtkIdType);
+  void ResetCacheStatistics();
+  //@}
+
+  /**
+   * Returns the number of cached entries, including those that are
+   * compressed or written to disk.
+   */
+  vtkIdType GetNumberOfCachedEntries();
+
+  //@{
+  /**
+   * Returns the memory used by the cached entries and the size of the entries
+   * written to disk (in kbytes).
+   */
+  unsigned long GetCacheMemorySize();
+  unsigned long GetCacheSpillSize();
+  //@}
+
 protected:
   vtkPVCacheKeeper();
   ~vtkPVCacheKeeper() override;
@@ -109,9 +151,38 @@ protected:
    */
   virtual bool SaveData(vtkDataObject*);
 
+  //@{
+  /**
+   * Compress, spill or remove the given entry. Returns false if nothing was
+   * done.
+   */
+  bool CompressEntry(double cacheTime);
+  bool SpillEntry(double cacheTime);
+  void RemoveEntry(double cacheTime);
+  //@}
+
+  /**
+   * Restores an entry that was compressed or written to disk. Returns false
+   * on failure.
+   */
+  bool RestoreEntry(double cacheTime);
+
+  //@{
+  /**
+   * Enforce the limits of the vtkCacheSizeKeeper over all vtkPVCacheKeeper
+   * instances that report to it. See vtkCacheSizeKeeper::ReleaseCacheMemory.
+   */
+  static int ReleaseCacheMemory(vtkCacheSizeKeeper*);
+  static void RemoveCacheEntries(vtkCacheSizeKeeper*, int count);
+  friend class vtkCacheSizeKeeper;
+  //@}
+
   bool CachingEnabled;
   double CacheTime;
   vtkCacheSizeKeeper* CacheSizeKeeper;
+  vtkIdType NumberOfCacheHits;
+  vtkIdType NumberOfCacheMisses;
+  vtkIdType NumberOfCacheEvictions;
 
 private:
   vtkPVCacheKeeper(const vtkPVCacheKeeper&) = delete;
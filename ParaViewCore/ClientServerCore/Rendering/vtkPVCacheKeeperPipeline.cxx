@@ -32,7 +32,7 @@ vtkPVCacheKeeperPipeline::~vtkPVCacheKeeperPipeline()
 int vtkPVCacheKeeperPipeline::ForwardUpstream(int i, int j, vtkInformation* request)
 {
   vtkPVCacheKeeper* keeper = vtkPVCacheKeeper::SafeDownCast(this->Algorithm);
-  if (keeper && keeper->GetCachingEnabled() && keeper->IsCached())
+  if (keeper && keeper->GetCachingEnabled() && keeper->PrepareEntry(keeper->GetCacheTime()))
   {
     // shunt upstream updates when using cache.
     return 1;
@@ -45,7 +45,7 @@ int vtkPVCacheKeeperPipeline::ForwardUpstream(int i, int j, vtkInformation* requ
 int vtkPVCacheKeeperPipeline::ForwardUpstream(vtkInformation* request)
 {
   vtkPVCacheKeeper* keeper = vtkPVCacheKeeper::SafeDownCast(this->Algorithm);
-  if (keeper && keeper->GetCachingEnabled() && keeper->IsCached())
+  if (keeper && keeper->GetCachingEnabled() && keeper->PrepareEntry(keeper->GetCacheTime()))
   {
     // shunt upstream updates when using cache.
     return 1;
@@ -17,13 +17,22 @@
 #include "vtkCacheSizeKeeper.h"
 #include "vtkClientServerStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVCacheKeeper.h"
+#include "vtkPVDataRepresentation.h"
 #include "vtkProcessModule.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkPVCacheSizeInformation);
 //-----------------------------------------------------------------------------
 vtkPVCacheSizeInformation::vtkPVCacheSizeInformation()
 {
   this->CacheSize = 0;
+  this->SpillSize = 0;
+  this->NumberOfCachedEntries = 0;
+  this->NumberOfCacheHits = 0;
+  this->NumberOfCacheMisses = 0;
+  this->NumberOfCacheEvictions = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -34,6 +43,27 @@ vtkPVCacheSizeInformation::~vtkPVCacheSizeInformation()
 //-----------------------------------------------------------------------------
 void vtkPVCacheSizeInformation::CopyFromObject(vtkObject* obj)
 {
+  vtkPVCacheKeeper* keeper = vtkPVCacheKeeper::SafeDownCast(obj);
+  if (vtkPVDataRepresentation* repr = vtkPVDataRepresentation::SafeDownCast(obj))
+  {
+    keeper = repr->GetCacheKeeper();
+    if (!keeper)
+    {
+      // the representation does not cache anything.
+      return;
+    }
+  }
+  if (keeper)
+  {
+    this->CacheSize = keeper->GetCacheMemorySize();
+    this->SpillSize = keeper->GetCacheSpillSize();
+    this->NumberOfCachedEntries = keeper->GetNumberOfCachedEntries();
+    this->NumberOfCacheHits = keeper->GetNumberOfCacheHits();
+    this->NumberOfCacheMisses = keeper->GetNumberOfCacheMisses();
+    this->NumberOfCacheEvictions = keeper->GetNumberOfCacheEvictions();
+    return;
+  }
+
   vtkCacheSizeKeeper* csk = vtkCacheSizeKeeper::SafeDownCast(obj);
 #ifdef FIXME
   vtkProcessModule* pm = vtkProcessModule::SafeDownCast(obj);
@@ -48,20 +78,28 @@ void vtkPVCacheSizeInformation::CopyFromObject(vtkObject* obj)
     return;
   }
   this->CacheSize = csk->GetCacheSize();
+  this->SpillSize = csk->GetSpillSize();
 }
 
 //-----------------------------------------------------------------------------
 void vtkPVCacheSizeInformation::CopyToStream(vtkClientServerStream* stream)
 {
   stream->Reset();
-  *stream << vtkClientServerStream::Reply << this->CacheSize << vtkClientServerStream::End;
+  *stream << vtkClientServerStream::Reply << this->CacheSize << this->SpillSize
+          << this->NumberOfCachedEntries << this->NumberOfCacheHits << this->NumberOfCacheMisses
+          << this->NumberOfCacheEvictions << vtkClientServerStream::End;
 }
 
 //-----------------------------------------------------------------------------
 void vtkPVCacheSizeInformation::CopyFromStream(const vtkClientServerStream* stream)
 {
   this->CacheSize = 0;
-  if (!stream->GetArgument(0, 0, &this->CacheSize))
+  if (!stream->GetArgument(0, 0, &this->CacheSize) ||
+    !stream->GetArgument(0, 1, &this->SpillSize) ||
+    !stream->GetArgument(0, 2, &this->NumberOfCachedEntries) ||
+    !stream->GetArgument(0, 3, &this->NumberOfCacheHits) ||
+    !stream->GetArgument(0, 4, &this->NumberOfCacheMisses) ||
+    !stream->GetArgument(0, 5, &this->NumberOfCacheEvictions))
   {
     vtkErrorMacro("Error parsing CacheSize.");
   }
@@ -76,7 +114,13 @@ void vtkPVCacheSizeInformation::AddInformation(vtkPVInformation* info)
     vtkErrorMacro("AddInformation needs vtkPVCacheSizeInformation.");
     return;
   }
-  this->CacheSize = (cinfo->CacheSize > this->CacheSize) ? cinfo->CacheSize : this->CacheSize;
+  this->CacheSize = std::max(cinfo->CacheSize, this->CacheSize);
+  this->SpillSize = std::max(cinfo->SpillSize, this->SpillSize);
+  this->NumberOfCachedEntries = std::max(cinfo->NumberOfCachedEntries, this->NumberOfCachedEntries);
+  this->NumberOfCacheHits = std::max(cinfo->NumberOfCacheHits, this->NumberOfCacheHits);
+  this->NumberOfCacheMisses = std::max(cinfo->NumberOfCacheMisses, this->NumberOfCacheMisses);
+  this->NumberOfCacheEvictions =
+    std::max(cinfo->NumberOfCacheEvictions, this->NumberOfCacheEvictions);
 }
 
 //-----------------------------------------------------------------------------
@@ -84,4 +128,9 @@ void vtkPVCacheSizeInformation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "CacheSize: " << this->CacheSize << endl;
+  os << indent << "SpillSize: " << this->SpillSize << endl;
+  os << indent << "NumberOfCachedEntries: " << this->NumberOfCachedEntries << endl;
+  os << indent << "NumberOfCacheHits: " << this->NumberOfCacheHits << endl;
+  os << indent << "NumberOfCacheMisses: " << this->NumberOfCacheMisses << endl;
+  os << indent << "NumberOfCacheEvictions: " << this->NumberOfCacheEvictions << endl;
 }
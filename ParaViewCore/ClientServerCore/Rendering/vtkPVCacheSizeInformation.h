@@ -18,6 +18,11 @@
  * collect cache size information from a vtkCacheSizeKeeper.
  *
  * Gather information about cache size from vtkCacheSizeKeeper.
+ *
+ * When gathered from a vtkPVCacheKeeper or from a representation (see
+ * vtkPVDataRepresentation::GetCacheKeeper), the information is restricted to
+ * that cache and includes its hit, miss and eviction counts. When merging
+ * information from several processes, the largest values are kept.
 */
 
 #ifndef vtkPVCacheSizeInformation_h
@@ -54,11 +59,32 @@ public:
   vtkGetMacro(CacheSize, unsigned long);
   vtkSetMacro(CacheSize, unsigned long);
 
+  /**
+   * Size of the cache entries written to disk (in kbytes).
+   */
+  vtkGetMacro(SpillSize, unsigned long);
+
+  //@{
+  /**
+   * Cache statistics. Only available when gathered from a vtkPVCacheKeeper
+   * or a representation.
+   */
+  vtkGetMacro(NumberOfCachedEntries, vtkIdType);
+  vtkGetMacro(NumberOfCacheHits, vtkIdType);
+  vtkGetMacro(NumberOfCacheMisses, vtkIdType);
+  vtkGetMacro(NumberOfCacheEvictions, vtkIdType);
+  //@}
+
 protected:
   vtkPVCacheSizeInformation();
   ~vtkPVCacheSizeInformation() override;
 
   unsigned long CacheSize;
+  unsigned long SpillSize;
+  vtkIdType NumberOfCachedEntries;
+  vtkIdType NumberOfCacheHits;
+  vtkIdType NumberOfCacheMisses;
+  vtkIdType NumberOfCacheEvictions;
 
 private:
   vtkPVCacheSizeInformation(const vtkPVCacheSizeInformation&) = delete;
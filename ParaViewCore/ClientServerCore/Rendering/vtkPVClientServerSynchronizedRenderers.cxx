@@ -15,7 +15,9 @@
 =========================================================================*/
 #include "vtkPVClientServerSynchronizedRenderers.h"
 
+#include "vtkCompositeMultiProcessController.h"
 #include "vtkLZ4Compressor.h"
+#include "vtkLZ4DeltaCompressor.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLRenderer.h"
@@ -37,6 +39,7 @@ vtkPVClientServerSynchronizedRenderers::vtkPVClientServerSynchronizedRenderers()
   : Compressor(NULL)
   , LossLessCompression(true)
   , NVPipeSupport(false)
+  , KeyFrameRequested(false)
 {
   this->ConfigureCompressor("vtkLZ4Compressor 0 3");
 }
@@ -47,6 +50,16 @@ vtkPVClientServerSynchronizedRenderers::~vtkPVClientServerSynchronizedRenderers(
   this->SetCompressor(NULL);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::MasterStartRender()
+{
+  this->Superclass::MasterStartRender();
+
+  int keyFrameRequested = this->KeyFrameRequested ? 1 : 0;
+  this->ParallelController->Send(&keyFrameRequested, 1, 1, 0x023431);
+  this->KeyFrameRequested = false;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
 {
@@ -66,8 +79,16 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
       vtkUnsignedCharArray* data = vtkUnsignedCharArray::New();
       this->ParallelController->Receive(data, 1, 0x023430);
       this->Compressor->SetImageResolution(header[1], header[2]);
-      this->Decompress(data, rawImage.GetRawPtr());
+      const bool decoded = this->Decompress(data, rawImage.GetRawPtr());
       data->Delete();
+      if (!decoded)
+      {
+        // don't paste garbage on screen, and ask the server for an image that
+        // does not depend on the ones we failed to decode.
+        rawImage.MarkInValid();
+        this->KeyFrameRequested = true;
+        return;
+      }
     }
     else
     {
@@ -82,6 +103,14 @@ void vtkPVClientServerSynchronizedRenderers::SlaveStartRender()
 {
   this->Superclass::SlaveStartRender();
 
+  int keyFrameRequested = 0;
+  this->ParallelController->Receive(&keyFrameRequested, 1, 1, 0x023431);
+  vtkLZ4DeltaCompressor* deltaCompressor = vtkLZ4DeltaCompressor::SafeDownCast(this->Compressor);
+  if (keyFrameRequested && deltaCompressor)
+  {
+    deltaCompressor->ForceKeyFrame();
+  }
+
   // In client-server mode, we want all the server ranks to simply render using
   // a black background. That makes it easier to blend the image we obtain from
   // the server rank on top of the background rendered locally on the client.
@@ -116,6 +145,16 @@ void vtkPVClientServerSynchronizedRenderers::SlaveEndRender()
   {
     if (this->Compressor)
     {
+      // With multiple clients connected, frames are delivered to whichever
+      // client is active, hence they cannot be deltas of the previous frame.
+      vtkLZ4DeltaCompressor* deltaCompressor =
+        vtkLZ4DeltaCompressor::SafeDownCast(this->Compressor);
+      vtkCompositeMultiProcessController* collaboration =
+        vtkCompositeMultiProcessController::SafeDownCast(this->ParallelController);
+      if (deltaCompressor && collaboration && collaboration->GetNumberOfControllers() > 1)
+      {
+        deltaCompressor->ForceKeyFrame();
+      }
       this->Compressor->SetImageResolution(header[1], header[2]);
       this->ParallelController->Send(this->Compress(rawImage.GetRawPtr()), 1, 0x023430);
     }
@@ -145,7 +184,7 @@ vtkUnsignedCharArray* vtkPVClientServerSynchronizedRenderers::Compress(vtkUnsign
 }
 
 //----------------------------------------------------------------------------
-void vtkPVClientServerSynchronizedRenderers::Decompress(
+bool vtkPVClientServerSynchronizedRenderers::Decompress(
   vtkUnsignedCharArray* data, vtkUnsignedCharArray* outputBuffer)
 {
   if (this->Compressor)
@@ -156,12 +195,13 @@ void vtkPVClientServerSynchronizedRenderers::Decompress(
     if (this->Compressor->Decompress() == 0)
     {
       vtkErrorMacro("Image de-compression failed!");
+      return false;
     }
+    return true;
   }
-  else
-  {
-    vtkErrorMacro("No compressor present.");
-  }
+
+  vtkErrorMacro("No compressor present.");
+  return false;
 }
 
 //----------------------------------------------------------------------------
@@ -175,7 +215,7 @@ void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* str
   std::string className;
   iss >> className;
   // Allocate the desired compressor unless we have one in hand.
-  if (this->Compressor == nullptr || !this->Compressor->IsA(className.c_str()))
+  if (this->Compressor == nullptr || className != this->Compressor->GetClassName())
   {
     vtkImageCompressor* comp = 0;
     if (className == "vtkSquirtCompressor")
@@ -190,6 +230,10 @@ void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* str
     {
       comp = vtkLZ4Compressor::New();
     }
+    else if (className == "vtkLZ4DeltaCompressor")
+    {
+      comp = vtkLZ4DeltaCompressor::New();
+    }
     else if (className == "vtkNvPipeCompressor" && this->NVPipeSupport)
     {
 #ifdef PARAVIEW_ENABLE_NVPIPE
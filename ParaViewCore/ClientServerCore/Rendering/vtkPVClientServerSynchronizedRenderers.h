@@ -79,7 +79,18 @@ protected:
   //@}
 
   vtkUnsignedCharArray* Compress(vtkUnsignedCharArray*);
-  void Decompress(vtkUnsignedCharArray* input, vtkUnsignedCharArray* outputBuffer);
+
+  /**
+   * Decompresses `input` into `outputBuffer`. Returns false on failure.
+   */
+  bool Decompress(vtkUnsignedCharArray* input, vtkUnsignedCharArray* outputBuffer);
+
+  /**
+   * Overridden to tell the server whether the client failed to decode the
+   * last image. With vtkLZ4DeltaCompressor, the server then sends a key frame
+   * since the following deltas cannot be decoded either.
+   */
+  void MasterStartRender() VTK_OVERRIDE;
 
   void MasterEndRender() VTK_OVERRIDE;
   void SlaveStartRender() VTK_OVERRIDE;
@@ -89,6 +100,12 @@ protected:
   bool LossLessCompression;
   bool NVPipeSupport;
 
+  /**
+   * Set on the client when an image could not be decoded, until the server
+   * has been asked for a key frame.
+   */
+  bool KeyFrameRequested;
+
 private:
   vtkPVClientServerSynchronizedRenderers(const vtkPVClientServerSynchronizedRenderers&) = delete;
   void operator=(const vtkPVClientServerSynchronizedRenderers&) = delete;
@@ -118,9 +118,18 @@ public:
     // example.
     vtkSmartPointer<vtkDataObject> RedistributedDataObject;
 
+    // Kept across data changes to reuse its redistribution plan when only
+    // the attributes changed.
+    vtkSmartPointer<vtkOrderedCompositeDistributor> Redistributor;
+
     // Data object for a streamed piece.
     vtkSmartPointer<vtkDataObject> StreamedPiece;
 
+    // Hash of the geometry of the delivered data, see GetGeometryHash().
+    vtkWeakPointer<vtkDataObject> HashedDataObject;
+    vtkMTimeType HashedDataTime;
+    vtkTypeUInt64 GeometryHash;
+
     vtkMTimeType TimeStamp;
     vtkMTimeType ActualMemorySize;
 
@@ -139,7 +148,11 @@ public:
       , DataObject{}
       , DeliveredDataObjects{}
       , RedistributedDataObject{}
+      , Redistributor{}
       , StreamedPiece{}
+      , HashedDataObject{}
+      , HashedDataTime(0)
+      , GeometryHash(0)
       , TimeStamp(0)
       , ActualMemorySize(0)
       , CloneDataToAllNodes(false)
@@ -244,14 +257,25 @@ public:
 
         vtkTimerLog::FormatAndMarkEvent("do-redistribution: %s", debugName.c_str());
 
-        vtkNew<vtkOrderedCompositeDistributor> redistributor;
-        redistributor->SetController(vtkMultiProcessController::GetGlobalController());
+        if (this->Redistributor == nullptr)
+        {
+          this->Redistributor = vtkSmartPointer<vtkOrderedCompositeDistributor>::New();
+          this->Redistributor->SetController(vtkMultiProcessController::GetGlobalController());
+          this->Redistributor->SetPassThrough(0);
+          this->Redistributor->SetReuseRedistributionPlan(true);
+        }
+        vtkOrderedCompositeDistributor* redistributor = this->Redistributor;
         redistributor->SetInputData(deliveredDataObject);
+        redistributor->SetInputGeometryHash(this->GetGeometryHash(real_mode));
         redistributor->SetPKdTree(tree);
-        redistributor->SetPassThrough(0);
         redistributor->SetBoundaryMode(this->RedistributionMode);
         redistributor->Update();
-        this->RedistributedDataObject = redistributor->GetOutputDataObject(0);
+
+        // the redistributor reuses its output, hence shallow copy it so that
+        // the redistributed data is replaced rather than modified in place.
+        this->RedistributedDataObject.TakeReference(
+          redistributor->GetOutputDataObject(0)->NewInstance());
+        this->RedistributedDataObject->ShallowCopy(redistributor->GetOutputDataObject(0));
         return true;
       }
 
@@ -261,7 +285,11 @@ public:
     /**
      * cleanup the redistributed data object, on demand.
      */
-    void ClearRedistributedData() { this->RedistributedDataObject = nullptr; }
+    void ClearRedistributedData()
+    {
+      this->RedistributedDataObject = nullptr;
+      this->Redistributor = nullptr;
+    }
 
     vtkDataObject* GetDeliveredDataObject(int data_distribution_mode) const
     {
@@ -314,6 +342,24 @@ public:
       }
       return vtkMTimeType{ 0 };
     }
+    /**
+     * Returns vtkOrderedCompositeDistributor::ComputeGeometryHash() of the data
+     * delivered for the data_distribution_mode. The hash is cached and only
+     * computed again when that data changed.
+     */
+    vtkTypeUInt64 GetGeometryHash(int data_distribution_mode)
+    {
+      vtkDataObject* dobj = this->GetDeliveredDataObject(data_distribution_mode);
+      const vtkMTimeType dataTime = dobj ? dobj->GetMTime() : 0;
+      if (dobj != this->HashedDataObject || dataTime != this->HashedDataTime)
+      {
+        this->HashedDataObject = dobj;
+        this->HashedDataTime = dataTime;
+        this->GeometryHash = vtkOrderedCompositeDistributor::ComputeGeometryHash(dobj);
+      }
+      return this->GeometryHash;
+    }
+
     void SetNextStreamedPiece(vtkDataObject* data) { this->StreamedPiece = data; }
     vtkDataObject* GetStreamedPiece() { return this->StreamedPiece; }
 
@@ -793,8 +839,10 @@ void vtkPVDataDeliveryManager::RedistributeDataForOrderedCompositing(bool use_lo
         }
         else if (item.Redistributable)
         {
-          token_stream << "b" << iter->first.first << "=" << item.GetTimeStamp() << ","
-                       << item.GetDeliveryTimeStamp(mode);
+          // only the geometry matters for the kd-tree, hashing it avoids
+          // regenerating the kd-tree, and redistributing the data from scratch,
+          // when only scalars changed.
+          token_stream << "b" << iter->first.first << "=" << item.GetGeometryHash(mode);
           // cout << "redistribute: ";
           // cout << this->GetRepresentation(iter->first.first)->GetDebugName() << "("
           // <<iter->first.second<<") = "
@@ -805,7 +853,15 @@ void vtkPVDataDeliveryManager::RedistributeDataForOrderedCompositing(bool use_lo
       }
     }
 
-    if (this->LastCutsGeneratorToken != token_stream.str())
+    // generating the kd-tree is collective, all processes must agree.
+    int changed = this->LastCutsGeneratorToken != token_stream.str() ? 1 : 0;
+    if (auto controller = vtkMultiProcessController::GetGlobalController())
+    {
+      int anyChanged = changed;
+      controller->AllReduce(&changed, &anyChanged, 1, vtkCommunicator::MAX_OP);
+      changed = anyChanged;
+    }
+    if (changed)
     {
       vtkTimerLogScope tlevent("regenerate kd-tree");
       cutsGenerator->GenerateKdTree();
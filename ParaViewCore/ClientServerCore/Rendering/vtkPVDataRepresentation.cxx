@@ -21,6 +21,7 @@
 #include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVCacheKeeper.h"
 #include "vtkPVCompositeDataPipeline.h"
 #include "vtkPVDataRepresentationPipeline.h"
 #include "vtkPVTrivialProducer.h"
@@ -185,6 +186,12 @@ bool vtkPVDataRepresentation::GetUsingCacheForUpdate()
 {
   if (this->GetUseCache())
   {
+    // restores the entry now, before the upstream updates are shunted, so
+    // that an entry which cannot be restored is produced again instead.
+    if (vtkPVCacheKeeper* keeper = this->GetCacheKeeper())
+    {
+      keeper->PrepareEntry(this->GetCacheKey());
+    }
     return this->IsCached(this->GetCacheKey());
   }
 
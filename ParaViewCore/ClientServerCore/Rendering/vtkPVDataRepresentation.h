@@ -30,6 +30,7 @@
 #include <string>                                 // needed for string
 
 class vtkInformationRequestKey;
+class vtkPVCacheKeeper;
 
 class VTKPVCLIENTSERVERCORERENDERING_EXPORT vtkPVDataRepresentation : public vtkDataRepresentation
 {
@@ -148,6 +149,13 @@ public:
    */
   bool GetUsingCacheForUpdate();
 
+  /**
+   * Returns the cache keeper used by this representation to cache data for
+   * animation playback, if any. This is used to report cache statistics per
+   * representation (see vtkPVCacheSizeInformation). Default returns NULL.
+   */
+  virtual vtkPVCacheKeeper* GetCacheKeeper() { return NULL; }
+
   vtkGetMacro(NeedUpdate, bool);
 
   //@{
@@ -16,11 +16,13 @@
 
 #include "vtkAbstractArray.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkClientServerStream.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkExecutive.h"
@@ -34,12 +36,18 @@
 #include "vtkPVDataRepresentation.h"
 #include "vtkPVPostFilter.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkVariant.h"
 #include "vtkVariantArray.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
 #include <map>
 #include <set>
 #include <sstream>
@@ -50,6 +58,332 @@
 namespace
 {
 typedef std::map<int, std::set<std::vector<vtkVariant> > > vtkInternalDistinctValuesBase;
+
+// The HyperLogLog estimates use 2^12 registers, for a standard error of about
+// 1.6% on the number of distinct values.
+const int VTK_PROMINENT_HLL_PRECISION = 12;
+const int VTK_PROMINENT_HLL_SIZE = 1 << VTK_PROMINENT_HLL_PRECISION;
+
+// Bounds on the number of values kept by the frequent-value summaries.
+const std::size_t VTK_PROMINENT_SKETCH_MIN_CAPACITY = 1024;
+const std::size_t VTK_PROMINENT_SKETCH_MAX_CAPACITY = 65536;
+
+bool DefaultUseSketches = false;
+
+//----------------------------------------------------------------------------
+inline vtkTypeUInt64 vtkProminentMix(vtkTypeUInt64 x)
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+//----------------------------------------------------------------------------
+inline vtkTypeUInt64 vtkProminentHash(double value)
+{
+  if (value != value)
+  {
+    return vtkProminentMix(0x7ff8000000000000ULL);
+  }
+  // 0 and -0 are the same value.
+  value = (value == 0. ? 0. : value);
+  vtkTypeUInt64 bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return vtkProminentMix(bits);
+}
+
+//----------------------------------------------------------------------------
+inline vtkTypeUInt64 vtkProminentHash(const vtkVariant& value)
+{
+  if (value.IsNumeric())
+  {
+    return vtkProminentHash(value.ToDouble());
+  }
+  // FNV-1a on the string representation.
+  vtkStdString str = value.ToString();
+  vtkTypeUInt64 hash = 14695981039346656037ULL;
+  for (std::string::size_type cc = 0; cc < str.size(); ++cc)
+  {
+    hash ^= static_cast<unsigned char>(str[cc]);
+    hash *= 1099511628211ULL;
+  }
+  return vtkProminentMix(hash);
+}
+
+//----------------------------------------------------------------------------
+inline vtkTypeUInt64 vtkProminentCombine(vtkTypeUInt64 seed, vtkTypeUInt64 hash)
+{
+  return vtkProminentMix(seed ^ (hash + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+}
+
+//----------------------------------------------------------------------------
+// Orders tuples of doubles, NaNs last, so that NaN is a value like the others.
+struct vtkProminentDoubleLess
+{
+  static bool Less(double a, double b) { return a == a && (b != b || a < b); }
+
+  bool operator()(const std::vector<double>& a, const std::vector<double>& b) const
+  {
+    return std::lexicographical_compare(
+      a.begin(), a.end(), b.begin(), b.end(), &vtkProminentDoubleLess::Less);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Mergeable summary of the values of an array component, or of its tuples:
+// HyperLogLog registers estimating the number of distinct values and a
+// Misra-Gries summary of the most frequent values. The summary keeps at most
+// Capacity values. Each time a value does not fit, one occurrence of every
+// value counted is discarded along with it, hence the counts underestimate the
+// frequencies by at most Offset, and the summary is exact when Offset is 0.
+template <typename KeyT, typename LessT = std::less<KeyT> >
+class vtkProminentValuesSketch
+{
+public:
+  struct Counter
+  {
+    vtkIdType Count;
+    // index of a tuple taking on the value, when summarizing an array.
+    vtkIdType Representative;
+  };
+  typedef std::map<KeyT, Counter, LessT> CounterMap;
+
+  vtkProminentValuesSketch(std::size_t capacity = VTK_PROMINENT_SKETCH_MIN_CAPACITY)
+    : Registers(VTK_PROMINENT_HLL_SIZE, 0)
+    , Capacity(capacity)
+    , Total(0)
+    , Offset(0)
+  {
+  }
+
+  void Add(const KeyT& key, vtkTypeUInt64 hash, vtkIdType representative)
+  {
+    this->AddHash(hash);
+    ++this->Total;
+    typename CounterMap::iterator iter = this->Counters.lower_bound(key);
+    if (iter != this->Counters.end() && !this->Counters.key_comp()(key, iter->first))
+    {
+      ++iter->second.Count;
+    }
+    else if (this->Counters.size() < this->Capacity)
+    {
+      Counter counter = { 1, representative };
+      this->Counters.insert(iter, std::make_pair(key, counter));
+    }
+    else
+    {
+      // discarding an occurrence of all values costs O(Capacity) but removes
+      // Capacity + 1 occurrences, hence O(1) per value overall.
+      ++this->Offset;
+      for (iter = this->Counters.begin(); iter != this->Counters.end();)
+      {
+        if (--iter->second.Count == 0)
+        {
+          this->Counters.erase(iter++);
+        }
+        else
+        {
+          ++iter;
+        }
+      }
+    }
+  }
+
+  void Merge(const vtkProminentValuesSketch& other)
+  {
+    for (int cc = 0; cc < VTK_PROMINENT_HLL_SIZE; ++cc)
+    {
+      this->Registers[cc] = std::max(this->Registers[cc], other.Registers[cc]);
+    }
+    this->Total += other.Total;
+    this->Offset += other.Offset;
+    typename CounterMap::const_iterator oiter;
+    for (oiter = other.Counters.begin(); oiter != other.Counters.end(); ++oiter)
+    {
+      typename CounterMap::iterator iter = this->Counters.lower_bound(oiter->first);
+      if (iter != this->Counters.end() && !this->Counters.key_comp()(oiter->first, iter->first))
+      {
+        iter->second.Count += oiter->second.Count;
+      }
+      else
+      {
+        this->Counters.insert(iter, *oiter);
+      }
+    }
+    if (this->Counters.size() <= this->Capacity)
+    {
+      return;
+    }
+
+    // Discard as many occurrences of all values as the (Capacity + 1)-th
+    // largest count, which leaves at most Capacity values.
+    std::vector<vtkIdType> counts;
+    counts.reserve(this->Counters.size());
+    typename CounterMap::iterator iter;
+    for (iter = this->Counters.begin(); iter != this->Counters.end(); ++iter)
+    {
+      counts.push_back(iter->second.Count);
+    }
+    std::nth_element(counts.begin(), counts.begin() + this->Capacity, counts.end(),
+      std::greater<vtkIdType>());
+    vtkIdType discarded = counts[this->Capacity];
+    this->Offset += discarded;
+    for (iter = this->Counters.begin(); iter != this->Counters.end();)
+    {
+      if ((iter->second.Count -= discarded) <= 0)
+      {
+        this->Counters.erase(iter++);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+  }
+
+  bool IsExact() const { return this->Offset == 0; }
+
+  vtkIdType GetNumberOfDistinctValues() const
+  {
+    vtkIdType numberOfCounters = static_cast<vtkIdType>(this->Counters.size());
+    if (this->IsExact())
+    {
+      return numberOfCounters;
+    }
+    double sum = 0.;
+    int zeros = 0;
+    for (int cc = 0; cc < VTK_PROMINENT_HLL_SIZE; ++cc)
+    {
+      sum += std::ldexp(1., -static_cast<int>(this->Registers[cc]));
+      zeros += (this->Registers[cc] == 0 ? 1 : 0);
+    }
+    const double m = VTK_PROMINENT_HLL_SIZE;
+    double estimate = 0.7213 / (1. + 1.079 / m) * m * m / sum;
+    if (estimate <= 2.5 * m && zeros > 0)
+    {
+      // linear counting is more accurate for small cardinalities.
+      estimate = m * std::log(m / zeros);
+    }
+    return std::max(numberOfCounters, static_cast<vtkIdType>(estimate + 0.5));
+  }
+
+  std::vector<unsigned char> Registers;
+  CounterMap Counters;
+  std::size_t Capacity;
+  vtkIdType Total;
+  vtkIdType Offset;
+
+private:
+  void AddHash(vtkTypeUInt64 hash)
+  {
+    int index = static_cast<int>(hash >> (64 - VTK_PROMINENT_HLL_PRECISION));
+    // the guard bit bounds the rank when the remaining bits are all zero.
+    vtkTypeUInt64 rest =
+      (hash << VTK_PROMINENT_HLL_PRECISION) | (1ULL << (VTK_PROMINENT_HLL_PRECISION - 1));
+    unsigned char rank = 1;
+    while (!(rest & (1ULL << 63)))
+    {
+      rest <<= 1;
+      ++rank;
+    }
+    this->Registers[index] = std::max(this->Registers[index], rank);
+  }
+};
+
+typedef vtkProminentValuesSketch<std::vector<double>, vtkProminentDoubleLess> vtkNumericSketch;
+typedef vtkProminentValuesSketch<std::vector<vtkVariant> > vtkVariantSketch;
+typedef std::map<int, vtkVariantSketch> vtkInternalSketchesBase;
+
+//----------------------------------------------------------------------------
+// Summarizes the components of a data array, followed by its tuples when it
+// has several components, with one sketch per component and per thread.
+template <typename ArrayT>
+struct vtkProminentValuesSketcher
+{
+  ArrayT* Array;
+  int NumberOfComponents;
+  std::size_t Capacity;
+  vtkSMPThreadLocal<std::vector<vtkNumericSketch> > Sketches;
+
+  vtkProminentValuesSketcher(ArrayT* array, int numComps, std::size_t capacity)
+    : Array(array)
+    , NumberOfComponents(numComps)
+    , Capacity(capacity)
+  {
+  }
+
+  void Initialize()
+  {
+    int numSketches = this->NumberOfComponents + (this->NumberOfComponents > 1 ? 1 : 0);
+    this->Sketches.Local().assign(numSketches, vtkNumericSketch(this->Capacity));
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkDataArrayAccessor<ArrayT> accessor(this->Array);
+    std::vector<vtkNumericSketch>& sketches = this->Sketches.Local();
+    const int numComps = this->NumberOfComponents;
+    std::vector<double> tuple(numComps);
+    std::vector<double> value(1);
+    for (vtkIdType tt = begin; tt < end; ++tt)
+    {
+      vtkTypeUInt64 tupleHash = 0;
+      for (int cc = 0; cc < numComps; ++cc)
+      {
+        value[0] = tuple[cc] = static_cast<double>(accessor.Get(tt, cc));
+        vtkTypeUInt64 hash = vtkProminentHash(value[0]);
+        sketches[cc].Add(value, hash, tt);
+        tupleHash = vtkProminentCombine(tupleHash, hash);
+      }
+      if (numComps > 1)
+      {
+        sketches[numComps].Add(tuple, tupleHash, tt);
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+//----------------------------------------------------------------------------
+struct vtkProminentValuesSketchWorker
+{
+  int NumberOfComponents;
+  std::size_t Capacity;
+  std::vector<vtkNumericSketch> Result;
+
+  vtkProminentValuesSketchWorker(int numComps, std::size_t capacity)
+    : NumberOfComponents(numComps)
+    , Capacity(capacity)
+  {
+  }
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    vtkProminentValuesSketcher<ArrayT> sketcher(array, this->NumberOfComponents, this->Capacity);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), sketcher);
+
+    this->Result.clear();
+    typedef typename vtkSMPThreadLocal<std::vector<vtkNumericSketch> >::iterator SketchesIterator;
+    for (SketchesIterator iter = sketcher.Sketches.begin(); iter != sketcher.Sketches.end();
+         ++iter)
+    {
+      if (this->Result.empty())
+      {
+        this->Result.swap(*iter);
+        continue;
+      }
+      for (std::size_t cc = 0; cc < this->Result.size(); ++cc)
+      {
+        this->Result[cc].Merge((*iter)[cc]);
+      }
+    }
+  }
+};
 }
 
 class vtkPVProminentValuesInformation::vtkInternalDistinctValues
@@ -57,6 +391,10 @@ class vtkPVProminentValuesInformation::vtkInternalDistinctValues
 {
 };
 
+class vtkPVProminentValuesInformation::vtkInternalSketches : public vtkInternalSketchesBase
+{
+};
+
 vtkStandardNewMacro(vtkPVProminentValuesInformation);
 
 //----------------------------------------------------------------------------
@@ -66,10 +404,12 @@ vtkPVProminentValuesInformation::vtkPVProminentValuesInformation()
   this->FieldName = 0;
   this->FieldAssociation = 0;
   this->DistinctValues = 0;
+  this->Sketches = 0;
   this->InitializeParameters();
   this->Initialize();
   this->Force = false;
   this->Valid = true;
+  this->UseSketches = false;
 }
 
 //----------------------------------------------------------------------------
@@ -98,6 +438,20 @@ void vtkPVProminentValuesInformation::Initialize()
     delete this->DistinctValues;
     this->DistinctValues = 0;
   }
+  delete this->Sketches;
+  this->Sketches = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProminentValuesInformation::SetDefaultUseSketches(bool val)
+{
+  DefaultUseSketches = val;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVProminentValuesInformation::GetDefaultUseSketches()
+{
+  return DefaultUseSketches;
 }
 
 //----------------------------------------------------------------------------
@@ -142,6 +496,17 @@ void vtkPVProminentValuesInformation::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << "Fraction: " << this->Fraction << endl;
   os << "Uncertainty: " << this->Uncertainty << endl;
+  os << "UseSketches: " << this->UseSketches << endl;
+  if (this->Sketches)
+  {
+    for (vtkInternalSketches::iterator sit = this->Sketches->begin(); sit != this->Sketches->end();
+         ++sit)
+    {
+      os << i2 << "Component " << sit->first << " sketch: "
+         << sit->second.GetNumberOfDistinctValues() << " distinct values"
+         << (sit->second.IsExact() ? "" : " (estimated)") << endl;
+    }
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -156,6 +521,10 @@ void vtkPVProminentValuesInformation::SetNumberOfComponents(int numComps)
   {
     this->DistinctValues->clear();
   }
+  if (this->Sketches)
+  {
+    this->Sketches->clear();
+  }
   if (numComps <= 0)
   {
     this->NumberOfComponents = 0;
@@ -182,6 +551,21 @@ void vtkPVProminentValuesInformation::DeepCopy(vtkPVProminentValuesInformation*
     }
     *this->DistinctValues = *info->DistinctValues;
   }
+
+  // Copy the sketches the values were extracted from.
+  if (this->Sketches && !info->Sketches)
+  {
+    delete this->Sketches;
+    this->Sketches = 0;
+  }
+  else if (info->Sketches)
+  {
+    if (!this->Sketches)
+    {
+      this->Sketches = new vtkInternalSketches;
+    }
+    *this->Sketches = *info->Sketches;
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -251,6 +635,7 @@ void vtkPVProminentValuesInformation::DeepCopyParameters(vtkPVProminentValuesInf
   this->Uncertainty = other->Uncertainty;
   this->Force = other->Force;
   this->Valid = other->Valid;
+  this->UseSketches = other->UseSketches;
 }
 
 //----------------------------------------------------------------------------
@@ -344,6 +729,11 @@ void vtkPVProminentValuesInformation::CopyDistinctValuesFromObject(vtkAbstractAr
   // from a discrete set or a continuum).
   // When there is more than 1 component, we also test whether the
   // tuples themselves behave discretely.
+  if (this->UseSketches)
+  {
+    this->CopySketchesFromObject(array);
+    return;
+  }
   if (this->DistinctValues)
   {
     this->DistinctValues->clear();
@@ -400,6 +790,184 @@ void vtkPVProminentValuesInformation::CopyDistinctValuesFromObject(vtkAbstractAr
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVProminentValuesInformation::CopySketchesFromObject(vtkAbstractArray* array)
+{
+  if (this->Sketches)
+  {
+    this->Sketches->clear();
+  }
+  else
+  {
+    this->Sketches = new vtkInternalSketches;
+  }
+  int nc = this->GetNumberOfComponents();
+  if (nc <= 0 || array->GetNumberOfComponents() != nc)
+  {
+    this->UpdateDistinctValuesFromSketches();
+    this->Valid = false;
+    return;
+  }
+
+  // Keep enough values for those making up Fraction of the array to be found.
+  std::size_t capacity = VTK_PROMINENT_SKETCH_MIN_CAPACITY;
+  if (this->Fraction > 0.)
+  {
+    capacity = static_cast<std::size_t>(std::min(
+      std::ceil(2. / this->Fraction), static_cast<double>(VTK_PROMINENT_SKETCH_MAX_CAPACITY)));
+    capacity = std::max(capacity, VTK_PROMINENT_SKETCH_MIN_CAPACITY);
+  }
+
+  vtkIdType numTuples = array->GetNumberOfTuples();
+  if (vtkDataArray* dataArray = vtkDataArray::FastDownCast(array))
+  {
+    vtkProminentValuesSketchWorker worker(nc, capacity);
+    if (!vtkArrayDispatch::Dispatch::Execute(dataArray, worker))
+    {
+      // fallback to the vtkDataArray API for arrays not covered by the dispatch.
+      worker(dataArray);
+    }
+
+    // Key the summaries on the values as the array stores them, so that they
+    // can be merged with those of other arrays.
+    for (int c = (nc > 1 ? -1 : 0); c < nc; ++c)
+    {
+      vtkVariantSketch& sketch = (*this->Sketches)[c];
+      sketch.Capacity = capacity;
+      if (worker.Result.empty())
+      {
+        continue;
+      }
+      const vtkNumericSketch& local = worker.Result[c < 0 ? nc : c];
+      sketch.Registers = local.Registers;
+      sketch.Total = local.Total;
+      sketch.Offset = local.Offset;
+      int tupleSize = c < 0 ? nc : 1;
+      std::vector<vtkVariant> tuple(tupleSize);
+      vtkNumericSketch::CounterMap::const_iterator iter;
+      for (iter = local.Counters.begin(); iter != local.Counters.end(); ++iter)
+      {
+        vtkIdType first = iter->second.Representative * nc + (c < 0 ? 0 : c);
+        for (int i = 0; i < tupleSize; ++i)
+        {
+          tuple[i] = array->GetVariantValue(first + i);
+        }
+        vtkVariantSketch::Counter counter = { iter->second.Count, -1 };
+        sketch.Counters.insert(sketch.Counters.end(), std::make_pair(tuple, counter));
+      }
+    }
+  }
+  else
+  {
+    // Other arrays, e.g. string arrays, are summarized serially.
+    std::vector<vtkVariant> tuple(nc);
+    std::vector<vtkVariant> value(1);
+    for (int c = (nc > 1 ? -1 : 0); c < nc; ++c)
+    {
+      (*this->Sketches)[c].Capacity = capacity;
+    }
+    for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+      vtkTypeUInt64 tupleHash = 0;
+      for (int c = 0; c < nc; ++c)
+      {
+        value[0] = tuple[c] = array->GetVariantValue(t * nc + c);
+        vtkTypeUInt64 hash = vtkProminentHash(value[0]);
+        (*this->Sketches)[c].Add(value, hash, t);
+        tupleHash = vtkProminentCombine(tupleHash, hash);
+      }
+      if (nc > 1)
+      {
+        (*this->Sketches)[-1].Add(tuple, tupleHash, t);
+      }
+    }
+  }
+  this->UpdateDistinctValuesFromSketches();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProminentValuesInformation::AddSketches(vtkPVProminentValuesInformation* info)
+{
+  if (!info->Sketches || !this->Sketches)
+  { // Some information is uninitialized; do nothing.
+    return;
+  }
+
+  vtkInternalSketches::iterator sit;
+  for (sit = info->Sketches->begin(); sit != info->Sketches->end(); ++sit)
+  {
+    vtkInternalSketches::iterator target = this->Sketches->find(sit->first);
+    if (target == this->Sketches->end())
+    {
+      this->Sketches->insert(*sit);
+    }
+    else
+    {
+      target->second.Merge(sit->second);
+    }
+  }
+  this->UpdateDistinctValuesFromSketches();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProminentValuesInformation::UpdateDistinctValuesFromSketches()
+{
+  if (this->DistinctValues)
+  {
+    this->DistinctValues->clear();
+  }
+  else
+  {
+    this->DistinctValues = new vtkInternalDistinctValues;
+  }
+  this->Valid = true;
+  if (!this->Sketches)
+  {
+    return;
+  }
+
+  vtkInternalSketches::iterator sit;
+  for (sit = this->Sketches->begin(); sit != this->Sketches->end(); ++sit)
+  {
+    const vtkVariantSketch& sketch = sit->second;
+    if (sketch.IsExact())
+    {
+      // Same as listing the distinct values.
+      if (sketch.Counters.empty() ||
+        (sketch.Counters.size() > vtkAbstractArray::MAX_DISCRETE_VALUES && !this->Force))
+      {
+        this->Valid = false;
+        continue;
+      }
+      std::set<std::vector<vtkVariant> >& compDistincts((*this->DistinctValues)[sit->first]);
+      vtkVariantSketch::CounterMap::const_iterator iter;
+      for (iter = sketch.Counters.begin(); iter != sketch.Counters.end(); ++iter)
+      {
+        compDistincts.insert(compDistincts.end(), iter->first);
+      }
+    }
+    else if (this->Force)
+    {
+      // Report the values that may make up Fraction of the array, given that
+      // their counts are underestimated by at most Offset.
+      double threshold = std::max(this->Fraction, 0.) * sketch.Total - sketch.Offset;
+      std::set<std::vector<vtkVariant> >& compDistincts((*this->DistinctValues)[sit->first]);
+      vtkVariantSketch::CounterMap::const_iterator iter;
+      for (iter = sketch.Counters.begin(); iter != sketch.Counters.end(); ++iter)
+      {
+        if (iter->second.Count >= threshold)
+        {
+          compDistincts.insert(compDistincts.end(), iter->first);
+        }
+      }
+    }
+    else
+    {
+      this->Valid = false;
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVProminentValuesInformation::AddInformation(vtkPVInformation* info)
 {
@@ -419,6 +987,12 @@ void vtkPVProminentValuesInformation::AddInformation(vtkPVInformation* info)
     // If this object is uninitialized, copy.
     this->DeepCopy(aInfo);
   }
+  else if (this->UseSketches)
+  {
+    // The validity follows from the merged sketches.
+    this->AddSketches(aInfo);
+    return;
+  }
   else
   {
     // Add unique values to our own.
@@ -436,7 +1010,39 @@ void vtkPVProminentValuesInformation::CopyToStream(vtkClientServerStream* css)
   // Copy parameter values to stream.
   *css << this->PortNumber << std::string(this->FieldAssociation) << std::string(this->FieldName)
        << this->NumberOfComponents << this->Fraction << this->Uncertainty << this->Force
-       << this->Valid;
+       << this->Valid << this->UseSketches;
+
+  if (this->UseSketches)
+  {
+    // Send the sketches, from which the values are extracted, so that they
+    // can be merged further.
+    int numberOfSketches = static_cast<int>(this->Sketches ? this->Sketches->size() : 0);
+    *css << numberOfSketches;
+    if (numberOfSketches)
+    {
+      vtkInternalSketches::iterator sit;
+      for (sit = this->Sketches->begin(); sit != this->Sketches->end(); ++sit)
+      {
+        const vtkVariantSketch& sketch = sit->second;
+        *css << sit->first << static_cast<vtkTypeUInt64>(sketch.Capacity)
+             << static_cast<vtkTypeInt64>(sketch.Total) << static_cast<vtkTypeInt64>(sketch.Offset)
+             << vtkClientServerStream::InsertArray(&sketch.Registers[0], VTK_PROMINENT_HLL_SIZE)
+             << static_cast<unsigned>(sketch.Counters.size());
+        vtkVariantSketch::CounterMap::const_iterator iter;
+        for (iter = sketch.Counters.begin(); iter != sketch.Counters.end(); ++iter)
+        {
+          *css << static_cast<vtkTypeInt64>(iter->second.Count);
+          std::vector<vtkVariant>::const_iterator vit;
+          for (vit = iter->first.begin(); vit != iter->first.end(); ++vit)
+          {
+            *css << *vit;
+          }
+        }
+      }
+    }
+    *css << vtkClientServerStream::End;
+    return;
+  }
 
   // Now copy results to stream.
   int numberOfDistinctValueComponents =
@@ -521,6 +1127,18 @@ void vtkPVProminentValuesInformation::CopyFromStream(const vtkClientServerStream
     return;
   }
 
+  if (!css->GetArgument(0, pos++, &this->UseSketches))
+  {
+    vtkErrorMacro("Error parsing sketches flag from message.");
+    return;
+  }
+
+  if (this->UseSketches)
+  {
+    this->CopySketchesFromStream(css, pos);
+    return;
+  }
+
   int numberOfDistinctValueComponents;
   if (!css->GetArgument(0, pos++, &numberOfDistinctValueComponents))
   {
@@ -562,7 +1180,7 @@ void vtkPVProminentValuesInformation::CopyFromStream(const vtkClientServerStream
       {
         for (int k = 0; k < tupleSize; ++k)
         {
-          if (!css->GetArgument(0, pos, &tuple[k]))
+          if (!css->GetArgument(0, pos++, &tuple[k]))
           {
             vtkErrorMacro("Error decoding the " << k << "-th entry of the " << j
                                                 << "-th unique tuple for component " << i);
@@ -575,6 +1193,72 @@ void vtkPVProminentValuesInformation::CopyFromStream(const vtkClientServerStream
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVProminentValuesInformation::CopySketchesFromStream(
+  const vtkClientServerStream* css, int pos)
+{
+  int numberOfSketches;
+  if (!css->GetArgument(0, pos++, &numberOfSketches))
+  {
+    vtkErrorMacro("Error parsing the number of sketches from message.");
+    return;
+  }
+  if (this->Sketches)
+  {
+    this->Sketches->clear();
+  }
+  else
+  {
+    this->Sketches = new vtkInternalSketches;
+  }
+  for (int i = 0; i < numberOfSketches; ++i)
+  {
+    int component;
+    vtkTypeUInt64 capacity;
+    vtkTypeInt64 total;
+    vtkTypeInt64 offset;
+    unsigned numberOfCounters;
+    vtkVariantSketch sketch;
+    if (!css->GetArgument(0, pos++, &component) || !css->GetArgument(0, pos++, &capacity) ||
+      !css->GetArgument(0, pos++, &total) || !css->GetArgument(0, pos++, &offset) ||
+      !css->GetArgument(0, pos++, &sketch.Registers[0], VTK_PROMINENT_HLL_SIZE) ||
+      !css->GetArgument(0, pos++, &numberOfCounters))
+    {
+      vtkErrorMacro("Error decoding the " << i << "-th sketch.");
+      return;
+    }
+    sketch.Capacity = static_cast<std::size_t>(capacity);
+    sketch.Total = static_cast<vtkIdType>(total);
+    sketch.Offset = static_cast<vtkIdType>(offset);
+    int tupleSize = (component < 0 ? this->NumberOfComponents : 1);
+    std::vector<vtkVariant> tuple(tupleSize);
+    for (unsigned j = 0; j < numberOfCounters; ++j)
+    {
+      vtkTypeInt64 count;
+      if (!css->GetArgument(0, pos++, &count))
+      {
+        vtkErrorMacro("Error decoding the count of the " << j << "-th value of sketch " << i);
+        return;
+      }
+      for (int k = 0; k < tupleSize; ++k)
+      {
+        if (!css->GetArgument(0, pos++, &tuple[k]))
+        {
+          vtkErrorMacro("Error decoding the " << k << "-th entry of the " << j
+                                              << "-th value of sketch " << i);
+          return;
+        }
+      }
+      vtkVariantSketch::Counter counter = { static_cast<vtkIdType>(count), -1 };
+      sketch.Counters.insert(sketch.Counters.end(), std::make_pair(tuple, counter));
+    }
+    (*this->Sketches)[component] = sketch;
+  }
+
+  // The validity was streamed along but follows from the sketches anyway.
+  this->UpdateDistinctValuesFromSketches();
+}
+
 #define VTK_PROMINENT_MAGIC_NUMBER 573167
 //-----------------------------------------------------------------------------
 void vtkPVProminentValuesInformation::CopyParametersToStream(vtkMultiProcessStream& mps)
@@ -583,7 +1267,7 @@ void vtkPVProminentValuesInformation::CopyParametersToStream(vtkMultiProcessStre
   vtkTypeUInt32 magic_number = VTK_PROMINENT_MAGIC_NUMBER;
   mps << magic_number << this->PortNumber << std::string(this->FieldAssociation)
       << std::string(this->FieldName) << this->NumberOfComponents << this->Fraction
-      << this->Uncertainty << this->Force << this->Valid;
+      << this->Uncertainty << this->Force << this->Valid << this->UseSketches;
 }
 
 //-----------------------------------------------------------------------------
@@ -594,7 +1278,7 @@ void vtkPVProminentValuesInformation::CopyParametersFromStream(vtkMultiProcessSt
   std::string fieldAssoc;
   std::string fieldName;
   mps >> magic_number >> this->PortNumber >> fieldAssoc >> fieldName >> this->NumberOfComponents >>
-    this->Fraction >> this->Uncertainty >> this->Force >> this->Valid;
+    this->Fraction >> this->Uncertainty >> this->Force >> this->Valid >> this->UseSketches;
   if (magic_number != VTK_PROMINENT_MAGIC_NUMBER)
   {
     vtkErrorMacro("Magic number mismatch.");
@@ -671,3 +1355,18 @@ vtkAbstractArray* vtkPVProminentValuesInformation::GetProminentComponentValues(i
   }
   return va;
 }
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkPVProminentValuesInformation::GetNumberOfDistinctValues(int component)
+{
+  if (component < 0 && this->NumberOfComponents == 1)
+  {
+    component = 0;
+  }
+  vtkInternalSketches::iterator sit;
+  if (!this->Sketches || (sit = this->Sketches->find(component)) == this->Sketches->end())
+  {
+    return -1;
+  }
+  return sit->second.GetNumberOfDistinctValues();
+}
@@ -26,7 +26,13 @@
  * given confidence that dictates the number of samples required), then
  * the prominent values are also made available.
  *
- * This class uses vtkAbstractArray::GetProminentComponentValues().
+ * This class uses vtkAbstractArray::GetProminentComponentValues(), unless
+ * UseSketches is on. In that case each process summarizes the array in a
+ * single threaded pass into a HyperLogLog estimate of its number of distinct
+ * values and a Misra-Gries summary of its most frequent values, which are
+ * merged instead of the lists of distinct values. Summaries of arrays taking
+ * on few distinct values are exact, hence the results are the same as without
+ * sketches for discrete arrays.
 */
 
 #ifndef vtkPVProminentValuesInformation_h
@@ -115,6 +121,29 @@ public:
    */
   vtkSetMacro(Force, bool);
   vtkGetMacro(Force, bool);
+  //@}
+
+  //@{
+  /**
+   * Set/get whether fixed-size sketches are gathered instead of the lists of
+   * distinct values. The summaries keep max(1024, 2 / Fraction) values, up to
+   * 65536. When an array takes on more values than that, the information is
+   * only valid if Force is set, and the values whose estimated frequency
+   * reaches Fraction are reported as prominent. Default is false.
+   */
+  vtkSetMacro(UseSketches, bool);
+  vtkGetMacro(UseSketches, bool);
+  vtkBooleanMacro(UseSketches, bool);
+  //@}
+
+  //@{
+  /**
+   * Set/get the value of UseSketches that clients should request by default.
+   * Default is false.
+   */
+  static void SetDefaultUseSketches(bool val);
+  static bool GetDefaultUseSketches();
+  //@}
 
   //@{
   /**
@@ -197,6 +226,14 @@ public:
    */
   vtkAbstractArray* GetProminentComponentValues(int component);
 
+  /**
+   * Returns the number of distinct values of an array component, or of its
+   * tuples when passing -1, as summarized by the sketches. It is exact when
+   * the array takes on few values and estimated, to within a few percent,
+   * otherwise. Returns -1 when UseSketches is off or nothing was gathered.
+   */
+  vtkIdType GetNumberOfDistinctValues(int component);
+
 protected:
   vtkPVProminentValuesInformation();
   ~vtkPVProminentValuesInformation() override;
@@ -204,6 +241,10 @@ protected:
   void DeepCopyParameters(vtkPVProminentValuesInformation* other);
   void CopyFromCompositeDataSet(vtkCompositeDataSet*);
   void CopyFromLeafDataObject(vtkDataObject*);
+  void CopySketchesFromObject(vtkAbstractArray*);
+  void CopySketchesFromStream(const vtkClientServerStream*, int pos);
+  void AddSketches(vtkPVProminentValuesInformation*);
+  void UpdateDistinctValuesFromSketches();
 
   /// Information parameters
   //@{
@@ -215,6 +256,7 @@ protected:
   double Uncertainty;
   bool Force;
   bool Valid;
+  bool UseSketches;
   //@}
 
   /// Information results
@@ -223,6 +265,9 @@ protected:
   class vtkInternalDistinctValues;
   vtkInternalDistinctValues* DistinctValues;
 
+  class vtkInternalSketches;
+  vtkInternalSketches* Sketches;
+
   //@}
 
   vtkPVProminentValuesInformation(const vtkPVProminentValuesInformation&) = delete;
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkPVRenderViewSettings.h"
 
+#include "vtkMPIMoveData.h"
 #include "vtkMapper.h"
 #include "vtkObjectFactory.h"
 
@@ -97,8 +98,25 @@ void vtkPVRenderViewSettings::SetZShift(double val)
   this->Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVRenderViewSettings::SetGatherMergeFanIn(int fanIn)
+{
+  if (vtkMPIMoveData::GetMergeFanIn() != fanIn)
+  {
+    vtkMPIMoveData::SetMergeFanIn(fanIn);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVRenderViewSettings::GetGatherMergeFanIn()
+{
+  return vtkMPIMoveData::GetMergeFanIn();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderViewSettings::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "GatherMergeFanIn: " << this->GetGatherMergeFanIn() << endl;
 }
@@ -92,6 +92,16 @@ public:
   vtkGetMacro(PointPickingRadius, int);
   //@}
 
+  //@{
+  /**
+   * Set the fan-in of the tree used to gather data on the root server process
+   * to deliver it to the client. 0 gathers it directly. Forwarded to
+   * vtkMPIMoveData::SetMergeFanIn.
+   */
+  void SetGatherMergeFanIn(int fanIn);
+  int GetGatherMergeFanIn();
+  //@}
+
   //@{
   /**
    * EXPERIMENTAL: Add ability to disable IceT.
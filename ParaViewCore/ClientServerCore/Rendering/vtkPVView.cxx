@@ -297,13 +297,26 @@ void vtkPVView::Update()
   if (this->GetUseCache())
   {
     vtkCacheSizeKeeper* cacheSizeKeeper = vtkCacheSizeKeeper::GetInstance();
-    unsigned int cache_full = 0;
-    if (cacheSizeKeeper->GetCacheSize() > cacheSizeKeeper->GetCacheLimit())
+    if (cacheSizeKeeper->GetEvictionPolicy() == vtkCacheSizeKeeper::NO_EVICTION)
     {
-      cache_full = 1;
+      unsigned int cache_full = 0;
+      if (cacheSizeKeeper->GetCacheSize() > cacheSizeKeeper->GetCacheLimit())
+      {
+        cache_full = 1;
+      }
+      this->SynchronizedWindows->SynchronizeSize(cache_full);
+      cacheSizeKeeper->SetCacheFull(cache_full > 0);
+    }
+    else
+    {
+      // Evict cache entries to stay under the limit. The evicted entries must
+      // be the same on all processes, otherwise they would not agree on what
+      // is cached.
+      vtkIdType count = cacheSizeKeeper->ReleaseCacheMemory();
+      this->SynchronizedWindows->Reduce(count, vtkPVSynchronizedRenderWindows::MAX_OP);
+      cacheSizeKeeper->RemoveCacheEntries(static_cast<int>(count));
+      cacheSizeKeeper->SetCacheFull(0);
     }
-    this->SynchronizedWindows->SynchronizeSize(cache_full);
-    cacheSizeKeeper->SetCacheFull(cache_full > 0);
   }
 
   this->CallProcessViewRequest(
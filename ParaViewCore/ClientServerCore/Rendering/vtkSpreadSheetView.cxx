@@ -27,9 +27,11 @@
 #include "vtkMemberFunctionCommand.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVMergeTables.h"
 #include "vtkPVSynchronizedRenderWindows.h"
+#include "vtkPassArrays.h"
 #include "vtkProcessModule.h"
 #include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
@@ -82,6 +84,22 @@ struct OrderByNames : std::binary_function<vtkAbstractArray*, vtkAbstractArray*,
   }
 };
 
+/// returns true for the columns needed to map rows back to the data, e.g. to
+/// select them, which are delivered even when hidden.
+bool is_id_column(const char* name)
+{
+  const char* ids[] = { "vtkOriginalProcessIds", "vtkCompositeIndexArray", "vtkOriginalIndices",
+    NULL };
+  for (int cc = 0; ids[cc] != NULL; ++cc)
+  {
+    if (strcmp(name, ids[cc]) == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 /// internal function to convert any array's name to a user friendly name.
 const char* get_userfriendly_name(
   const char* name, vtkSpreadSheetView* self, bool* converted = nullptr)
@@ -199,6 +217,11 @@ class vtkSpreadSheetView::vtkInternals
   public:
     vtkSmartPointer<vtkTable> Dataobject;
     vtkTimeStamp RecentUseTime;
+    // columns left out by the server, sorted.
+    std::vector<std::string> SkippedColumns;
+    // index in Dataobject of each column in ColumnMetaData, -1 when skipped.
+    // Empty when the block has all the columns.
+    std::vector<vtkIdType> ColumnIndices;
   };
 
   typedef std::map<vtkIdType, CacheInfo> CacheType;
@@ -210,6 +233,77 @@ public:
     this->CachedBlocks.clear();
     this->ColumnMetaData.clear();
     this->ColumnIndexMap.clear();
+    this->SkippedColumns.clear();
+    this->SkippedColumnsDirty = true;
+    this->LastRequestedBlock = -1;
+  }
+
+  /**
+   * Updates the list of columns the server can leave out of the blocks, i.e.
+   * the hidden ones, and discards the cached blocks that lack a column which
+   * is now visible. The columns are only known once a full block has been
+   * fetched, so the first block always has all the columns.
+   */
+  void UpdateSkippedColumns(vtkSpreadSheetView* self)
+  {
+    if (!this->SkippedColumnsDirty)
+    {
+      return;
+    }
+    this->SkippedColumnsDirty = false;
+
+    std::set<std::string> skipped;
+    for (const auto& tuple : this->ColumnMetaData)
+    {
+      const char* name = std::get<0>(tuple).c_str();
+      if (!self->IsColumnInternal(name) && !is_id_column(name) &&
+        (self->IsColumnHiddenByName(name) ||
+            self->IsColumnHiddenByLabel(self->GetColumnLabel(name))))
+      {
+        skipped.insert(name);
+      }
+    }
+    this->SkippedColumns.assign(skipped.begin(), skipped.end());
+
+    for (auto iter = this->CachedBlocks.begin(); iter != this->CachedBlocks.end();)
+    {
+      const auto& blockSkipped = iter->second.SkippedColumns;
+      if (std::includes(this->SkippedColumns.begin(), this->SkippedColumns.end(),
+            blockSkipped.begin(), blockSkipped.end()))
+      {
+        ++iter;
+      }
+      else
+      {
+        iter = this->CachedBlocks.erase(iter);
+      }
+    }
+  }
+
+  const std::vector<std::string>& GetSkippedColumns() const { return this->SkippedColumns; }
+
+  bool IsCached(vtkIdType blockId) const
+  {
+    return this->CachedBlocks.find(blockId) != this->CachedBlocks.end();
+  }
+
+  /**
+   * Returns the index in the cached block of the column at the given index in
+   * the view, or -1 if the block does not have it.
+   */
+  vtkIdType GetColumnIndex(vtkIdType blockId, vtkIdType col) const
+  {
+    CacheType::const_iterator iter = this->CachedBlocks.find(blockId);
+    if (iter == this->CachedBlocks.end())
+    {
+      return -1;
+    }
+    const auto& indices = iter->second.ColumnIndices;
+    if (indices.empty())
+    {
+      return col;
+    }
+    return (col >= 0 && col < static_cast<vtkIdType>(indices.size())) ? indices[col] : -1;
   }
 
   vtkIdType GetNumberOfColumns(vtkSpreadSheetView* self)
@@ -253,7 +347,7 @@ public:
     return NULL;
   }
 
-  void AddToCache(vtkIdType blockId, vtkTable* data, vtkIdType max)
+  vtkTable* AddToCache(vtkIdType blockId, vtkTable* data, vtkIdType max)
   {
     CacheType::iterator iter = this->CachedBlocks.find(blockId);
     if (iter != this->CachedBlocks.end())
@@ -261,7 +355,7 @@ public:
       this->CachedBlocks.erase(iter);
     }
 
-    if (static_cast<vtkIdType>(this->CachedBlocks.size()) == max)
+    while (!this->CachedBlocks.empty() && static_cast<vtkIdType>(this->CachedBlocks.size()) >= max)
     {
       // remove least-recent-used block.
       iter = this->CachedBlocks.begin();
@@ -297,13 +391,28 @@ public:
     info.Dataobject = clone;
     clone->FastDelete();
     info.RecentUseTime.Modified();
-    this->CachedBlocks[blockId] = info;
-    this->MostRecentlyAccessedBlock = blockId;
 
-    if (this->CachedBlocks.size() == 1)
+    if (this->ColumnMetaData.empty())
     {
       this->UpdateColumnMetaData(clone);
+      this->SkippedColumnsDirty = true;
     }
+    else if (!this->SkippedColumns.empty())
+    {
+      info.SkippedColumns = this->SkippedColumns;
+      info.ColumnIndices.resize(this->ColumnMetaData.size(), -1);
+      for (vtkIdType cc = 0, max_cc = clone->GetNumberOfColumns(); cc < max_cc; ++cc)
+      {
+        auto citer = this->ColumnIndexMap.find(clone->GetColumn(cc)->GetName());
+        if (citer != this->ColumnIndexMap.end())
+        {
+          info.ColumnIndices[citer->second] = cc;
+        }
+      }
+    }
+    this->CachedBlocks[blockId] = info;
+    this->MostRecentlyAccessedBlock = blockId;
+    return clone;
   }
 
   /**
@@ -330,11 +439,15 @@ public:
   }
 
   vtkIdType MostRecentlyAccessedBlock;
+  vtkIdType LastRequestedBlock;
   vtkWeakPointer<vtkSpreadSheetRepresentation> ActiveRepresentation;
   vtkCommand* Observer;
 
   std::set<std::string> HiddenColumnsByName;
   std::set<std::string> HiddenColumnsByLabel;
+
+  std::vector<std::string> SkippedColumns;
+  bool SkippedColumnsDirty;
 };
 
 namespace
@@ -345,11 +458,17 @@ void FetchRMI(void* localArg, void* remoteArg, int remoteArgLength, int)
   stream.SetRawData(reinterpret_cast<unsigned char*>(remoteArg), remoteArgLength);
   unsigned int id = 0;
   int blockid = -1;
-  stream >> id >> blockid;
+  int numSkipped = 0;
+  stream >> id >> blockid >> numSkipped;
+  std::vector<std::string> skipped(numSkipped);
+  for (int cc = 0; cc < numSkipped; ++cc)
+  {
+    stream >> skipped[cc];
+  }
   vtkSpreadSheetView* self = reinterpret_cast<vtkSpreadSheetView*>(localArg);
   if (self->GetIdentifier() == id)
   {
-    self->FetchBlockCallback(blockid);
+    self->FetchBlockCallback(blockid, skipped);
   }
 }
 void FetchRMIBogus(void*, void*, int, int)
@@ -429,11 +548,18 @@ vtkSpreadSheetView::vtkSpreadSheetView()
 
   this->DeliveryFilter = vtkClientServerMoveData::New();
   this->DeliveryFilter->SetOutputDataType(VTK_TABLE);
+  this->DeliveryFilter->SetCompression(true);
 
   this->ReductionFilter->SetInputConnection(this->TableStreamer->GetOutputPort());
 
   this->Internals = new vtkInternals();
   this->Internals->MostRecentlyAccessedBlock = -1;
+  this->Internals->LastRequestedBlock = -1;
+  this->Internals->SkippedColumnsDirty = true;
+  this->CacheSize = 10;
+  this->NumberOfPrefetchBlocks = 1;
+  this->NumberOfCacheHits = 0;
+  this->NumberOfCacheMisses = 0;
 
   this->Internals->Observer =
     vtkMakeMemberFunctionCommand(*this, &vtkSpreadSheetView::OnRepresentationUpdated);
@@ -485,6 +611,7 @@ void vtkSpreadSheetView::HideColumnByName(const char* columnName)
   {
     auto& internals = *this->Internals;
     internals.HiddenColumnsByName.insert(columnName);
+    internals.SkippedColumnsDirty = true;
   }
 }
 
@@ -493,6 +620,7 @@ void vtkSpreadSheetView::ClearHiddenColumnsByName()
 {
   auto& internals = *this->Internals;
   internals.HiddenColumnsByName.clear();
+  internals.SkippedColumnsDirty = true;
 }
 
 //----------------------------------------------------------------------------
@@ -511,6 +639,7 @@ void vtkSpreadSheetView::HideColumnByLabel(const char* columnLabel)
   {
     auto& internals = *this->Internals;
     internals.HiddenColumnsByLabel.insert(columnLabel);
+    internals.SkippedColumnsDirty = true;
   }
 }
 
@@ -519,6 +648,7 @@ void vtkSpreadSheetView::ClearHiddenColumnsByLabel()
 {
   auto& internals = *this->Internals;
   internals.HiddenColumnsByLabel.clear();
+  internals.SkippedColumnsDirty = true;
 }
 
 //----------------------------------------------------------------------------
@@ -560,6 +690,10 @@ bool vtkSpreadSheetView::IsColumnInternal(const char* columnName)
 void vtkSpreadSheetView::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheSize: " << this->CacheSize << endl;
+  os << indent << "NumberOfPrefetchBlocks: " << this->NumberOfPrefetchBlocks << endl;
+  os << indent << "NumberOfCacheHits: " << this->NumberOfCacheHits << endl;
+  os << indent << "NumberOfCacheMisses: " << this->NumberOfCacheMisses << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -663,18 +797,82 @@ void vtkSpreadSheetView::OnRepresentationUpdated()
 //----------------------------------------------------------------------------
 vtkTable* vtkSpreadSheetView::FetchBlock(vtkIdType blockindex)
 {
+  this->Internals->UpdateSkippedColumns(this);
   vtkTable* block = this->Internals->GetDataObject(blockindex);
+  if (blockindex != this->Internals->LastRequestedBlock)
+  {
+    this->Internals->LastRequestedBlock = blockindex;
+    if (block)
+    {
+      this->NumberOfCacheHits++;
+    }
+    else
+    {
+      this->NumberOfCacheMisses++;
+    }
+  }
   if (!block)
   {
-    block = this->FetchBlockCallback(blockindex);
-    this->Internals->AddToCache(blockindex, block, 10);
+    block = this->FetchBlockCallback(blockindex, this->Internals->GetSkippedColumns());
+    block = this->Internals->AddToCache(blockindex, block, this->CacheSize);
     this->InvokeEvent(vtkCommand::UpdateEvent, &blockindex);
   }
   return block;
 }
 
 //----------------------------------------------------------------------------
-vtkTable* vtkSpreadSheetView::FetchBlockCallback(vtkIdType blockindex)
+bool vtkSpreadSheetView::PrefetchBlocks(vtkIdType firstRow, vtkIdType lastRow)
+{
+  const vtkIdType blockSize = this->TableStreamer->GetBlockSize();
+  if (!this->Internals->ActiveRepresentation || this->NumberOfRows <= 0 || blockSize <= 0 ||
+    firstRow < 0 || lastRow < firstRow)
+  {
+    return false;
+  }
+
+  // keep the visible blocks, at most two, in the cache.
+  const vtkIdType count = std::min(this->NumberOfPrefetchBlocks, (this->CacheSize - 2) / 2);
+  const vtkIdType lastBlock = (this->NumberOfRows - 1) / blockSize;
+  const vtkIdType first = std::min(firstRow, this->NumberOfRows - 1) / blockSize;
+  const vtkIdType last = std::min(lastRow, this->NumberOfRows - 1) / blockSize;
+
+  this->Internals->UpdateSkippedColumns(this);
+  for (vtkIdType cc = 1; cc <= count; ++cc)
+  {
+    // users scroll down more often than up, look after the visible rows first.
+    const vtkIdType candidates[2] = { last + cc, first - cc };
+    for (int kk = 0; kk < 2; ++kk)
+    {
+      const vtkIdType blockindex = candidates[kk];
+      if (blockindex >= 0 && blockindex <= lastBlock && !this->Internals->IsCached(blockindex))
+      {
+        vtkTable* block =
+          this->FetchBlockCallback(blockindex, this->Internals->GetSkippedColumns());
+        this->Internals->AddToCache(blockindex, block, this->CacheSize);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+double vtkSpreadSheetView::GetCacheHitRate()
+{
+  const vtkIdType requests = this->NumberOfCacheHits + this->NumberOfCacheMisses;
+  return requests > 0 ? static_cast<double>(this->NumberOfCacheHits) / requests : 0.0;
+}
+
+//----------------------------------------------------------------------------
+void vtkSpreadSheetView::ResetCacheStatistics()
+{
+  this->NumberOfCacheHits = 0;
+  this->NumberOfCacheMisses = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkTable* vtkSpreadSheetView::FetchBlockCallback(
+  vtkIdType blockindex, const std::vector<std::string>& skipped)
 {
   // Sanity Check
   if (!this->Internals->ActiveRepresentation)
@@ -684,9 +882,32 @@ vtkTable* vtkSpreadSheetView::FetchBlockCallback(vtkIdType blockindex)
 
   // cout << "FetchBlockCallback" << endl;
   vtkMultiProcessStream stream;
-  stream << this->Identifier << static_cast<int>(blockindex);
+  stream << this->Identifier << static_cast<int>(blockindex) << static_cast<int>(skipped.size());
+  for (const auto& name : skipped)
+  {
+    stream << name;
+  }
   this->SynchronizedWindows->TriggerRMI(stream, FETCH_BLOCK_TAG);
 
+  // leave the hidden columns out on each process, before they are gathered and
+  // delivered to the client.
+  if (skipped.empty())
+  {
+    this->ReductionFilter->SetPreGatherHelper(NULL);
+  }
+  else
+  {
+    vtkNew<vtkPassArrays> passArrays;
+    passArrays->RemoveArraysOn();
+    passArrays->UseFieldTypesOn();
+    passArrays->AddFieldType(vtkDataObject::ROW);
+    for (const auto& name : skipped)
+    {
+      passArrays->AddArray(vtkDataObject::ROW, name.c_str());
+    }
+    this->ReductionFilter->SetPreGatherHelper(passArrays.GetPointer());
+  }
+
   this->TableStreamer->SetBlock(blockindex);
   this->TableStreamer->Modified();
   this->TableSelectionMarker->SetFieldAssociation(this->FieldAssociation);
@@ -740,7 +961,8 @@ vtkVariant vtkSpreadSheetView::GetValue(vtkIdType row, vtkIdType col)
   vtkIdType blockIndex = row / blockSize;
   vtkTable* block = this->FetchBlock(blockIndex);
   vtkIdType blockOffset = row - (blockIndex * blockSize);
-  return block->GetValue(blockOffset, col);
+  vtkIdType blockCol = this->Internals->GetColumnIndex(blockIndex, col);
+  return blockCol >= 0 ? block->GetValue(blockOffset, blockCol) : vtkVariant();
 }
 
 //----------------------------------------------------------------------------
@@ -774,6 +996,7 @@ bool vtkSpreadSheetView::IsAvailable(vtkIdType row)
 {
   vtkIdType blockSize = this->TableStreamer->GetBlockSize();
   vtkIdType blockIndex = row / blockSize;
+  this->Internals->UpdateSkippedColumns(this);
   return this->Internals->GetDataObject(blockIndex) != NULL;
 }
 
@@ -28,6 +28,7 @@
 #include "vtkPVView.h"
 
 #include <string> // for std::string
+#include <vector> // for std::vector
 
 class vtkCSVExporter;
 class vtkClientServerMoveData;
@@ -202,8 +203,55 @@ public:
    */
   void ClearCache();
 
+  //@{
+  /**
+   * Get/Set the maximum number of blocks kept on the client. When the cache is
+   * full, the least recently used block is discarded. 10 by default.
+   * \note CallOnClient
+   */
+  vtkSetClampMacro(CacheSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(CacheSize, int);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the number of blocks on each side of the visible rows that
+   * `PrefetchBlocks` fetches ahead of time. 0 disables prefetching. It is
+   * limited so that the prefetched and the visible blocks fit in the cache.
+   * 1 by default.
+   * \note CallOnClient
+   */
+  vtkSetClampMacro(NumberOfPrefetchBlocks, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPrefetchBlocks, int);
+  //@}
+
+  /**
+   * Fetches the first block, among the `NumberOfPrefetchBlocks` blocks after
+   * and before the ones holding the rows in [firstRow, lastRow], that is not
+   * cached yet, nearest blocks first. Returns true if a block was fetched, in
+   * which case the application should call this method again when idle until
+   * it returns false. Prefetched blocks are not counted as cache misses.
+   * \note CallOnClient
+   */
+  bool PrefetchBlocks(vtkIdType firstRow, vtkIdType lastRow);
+
+  //@{
+  /**
+   * Statistics of the block cache, to help choose the `BlockSize`. A hit is a
+   * request for a block that is cached and a miss one that had to be fetched
+   * from the server. Consecutive requests for the same block count once.
+   * `GetCacheHitRate` returns the ratio of hits to requests, or 0 when no
+   * block has been requested since the last `ResetCacheStatistics`.
+   * \note CallOnClient
+   */
+  vtkGetMacro(NumberOfCacheHits, vtkIdType);
+  vtkGetMacro(NumberOfCacheMisses, vtkIdType);
+  double GetCacheHitRate();
+  void ResetCacheStatistics();
+  //@}
+
   // INTERNAL METHOD. Don't call directly.
-  vtkTable* FetchBlockCallback(vtkIdType blockindex);
+  vtkTable* FetchBlockCallback(vtkIdType blockindex, const std::vector<std::string>& skipped);
 
 protected:
   vtkSpreadSheetView();
@@ -228,6 +276,10 @@ protected:
   vtkReductionFilter* ReductionFilter;
   vtkClientServerMoveData* DeliveryFilter;
   vtkIdType NumberOfRows;
+  int CacheSize;
+  int NumberOfPrefetchBlocks;
+  vtkIdType NumberOfCacheHits;
+  vtkIdType NumberOfCacheMisses;
 
   enum
   {
@@ -130,6 +130,11 @@ public:
   vtkGetMacro(UseDataPartitions, bool);
   //@}
 
+  /**
+   * Returns the cache keeper used to cache data for animation playback.
+   */
+  vtkPVCacheKeeper* GetCacheKeeper() VTK_OVERRIDE { return this->CacheKeeper; }
+
 protected:
   vtkUnstructuredGridVolumeRepresentation();
   ~vtkUnstructuredGridVolumeRepresentation() override;
@@ -4,8 +4,12 @@
 #include "vtkStringArray.h"
 #include "vtkVariantArray.h"
 
+#include <vector>
+
 static double dblIni[] = { 904., 906., 917. };
 static const char* strIni[] = { "901", "Turbo", "Targa" };
+static const int bigSize = 2048;
+static double bigIni[bigSize];
 
 template <class T>
 struct Help
@@ -105,6 +109,17 @@ void do_store(vtkClientServerStream& css)
   vtkVariant varInvalid;
   css << varInvalid;
 
+  // Test arrays large enough to be referenced rather than copied.
+  for (int i = 0; i < bigSize; ++i)
+  {
+    bigIni[i] = 0.5 * i;
+  }
+  css.InsertArrayReference(vtkClientServerStream::InsertArray(bigIni, bigSize));
+  vtkNew<vtkDoubleArray> bigArr;
+  bigArr->SetArray(bigIni, bigSize, 1);
+  vtkVariant varBigArr(bigArr.GetPointer());
+  css << varBigArr;
+
   css << "123";
   {
     vtkClientServerStream nested;
@@ -257,6 +272,23 @@ bool do_check(vtkClientServerStream& css)
       return false;
     }
   }
+  {
+    double big[bigSize];
+    if (!css.GetArgument(0, arg++, big, bigSize) || big[bigSize - 1] != bigIni[bigSize - 1])
+    {
+      return false;
+    }
+    vtkVariant varOut;
+    vtkDoubleArray* bigArr;
+    if (!css.GetArgument(0, arg, &varOut) ||
+      !(bigArr = vtkDoubleArray::SafeDownCast(varOut.ToArray())) ||
+      bigArr->GetNumberOfTuples() != bigSize || bigArr->GetValue(1) != bigIni[1] ||
+      bigArr->GetValue(bigSize - 1) != bigIni[bigSize - 1])
+    {
+      cout << "Large array variant was not retrieved correctly\n";
+      return false;
+    }
+  }
   {
     const char* s;
     if (!css.GetArgument(0, arg++, &s) || strcmp(s, "123") != 0)
@@ -285,6 +317,41 @@ bool do_test()
   vtkClientServerStream css1;
   do_store(css1);
 
+  // Assemble the stream from its segments, before anything flattens it.
+  // The large array, inserted directly and through a vtkVariant, must be
+  // referenced by the segments rather than copied into the stream.
+  vtkClientServerStream css6;
+  {
+    std::vector<unsigned char> data;
+    int numReferences = 0;
+    for (int i = 0; i < css1.GetNumberOfDataSegments(); ++i)
+    {
+      const unsigned char* segment;
+      size_t length;
+      if (!css1.GetDataSegment(i, &segment, &length))
+      {
+        cerr << "FAILED: GetDataSegment failed." << endl;
+        return false;
+      }
+      if (segment == reinterpret_cast<const unsigned char*>(bigIni) &&
+        length == sizeof(bigIni))
+      {
+        ++numReferences;
+      }
+      data.insert(data.end(), segment, segment + length);
+    }
+    if (numReferences != 2)
+    {
+      cerr << "FAILED: the large array was copied into the stream." << endl;
+      return false;
+    }
+    if (css1.GetNumberOfDataSegments() < 3 || !css6.SetData(&data[0], data.size()))
+    {
+      cerr << "FAILED: stream segments could not be assembled." << endl;
+      return false;
+    }
+  }
+
   // Cover stream print code.
   cout << "-----------------------------------------------------------\n";
   css1.Print(cout);
@@ -341,6 +408,11 @@ bool do_test()
     cerr << "FAILED: (Get/Set)Data did not copy stream properly." << endl;
     return false;
   }
+  if (!do_check(css6))
+  {
+    cerr << "FAILED: GetDataSegment did not copy stream properly." << endl;
+    return false;
+  }
   return true;
 }
 
@@ -134,6 +134,7 @@ class vtkClientServerStreamInternals
 public:
   vtkClientServerStreamInternals(vtkObjectBase* owner)
     : Objects(owner)
+    , ExternalSize(0)
   {
   }
   vtkClientServerStreamInternals(const vtkClientServerStreamInternals& r, vtkObjectBase* owner)
@@ -141,6 +142,8 @@ public:
     , ValueOffsets(r.ValueOffsets)
     , MessageIndexes(r.MessageIndexes)
     , Objects(r.Objects, owner)
+    , Segments(r.Segments)
+    , ExternalSize(r.ExternalSize)
     , StartIndex(r.StartIndex)
     , Invalid(r.Invalid)
     , String(r.String)
@@ -225,6 +228,52 @@ public:
   };
   ObjectsType Objects;
 
+  // Array data referenced by the stream instead of being copied into
+  // Data.  Each segment is logically inserted in Data before the byte at
+  // Position.  ValueOffsets are logical offsets, i.e. they account for the
+  // external segments.
+  struct SegmentType
+  {
+    DataType::size_type Position;
+    const unsigned char* Data;
+    size_t Size;
+    vtkSmartPointer<vtkObjectBase> Holder;
+  };
+  typedef std::vector<SegmentType> SegmentsType;
+  SegmentsType Segments;
+
+  // Total size of the external segments.
+  size_t ExternalSize;
+
+  // Logical size of the stream.
+  DataType::difference_type GetSize() const
+  {
+    return static_cast<DataType::difference_type>(this->Data.size() + this->ExternalSize);
+  }
+
+  // Copy the external segments into Data.  After this, logical and
+  // physical offsets are the same.
+  void Flatten()
+  {
+    if (this->Segments.empty())
+    {
+      return;
+    }
+    DataType flat;
+    flat.reserve(this->Data.size() + this->ExternalSize);
+    DataType::size_type pos = 0;
+    for (SegmentsType::iterator i = this->Segments.begin(); i != this->Segments.end(); ++i)
+    {
+      flat.insert(flat.end(), this->Data.begin() + pos, this->Data.begin() + i->Position);
+      flat.insert(flat.end(), i->Data, i->Data + i->Size);
+      pos = i->Position;
+    }
+    flat.insert(flat.end(), this->Data.begin() + pos, this->Data.end());
+    flat.swap(this->Data);
+    this->Segments.clear();
+    this->ExternalSize = 0;
+  }
+
   // Index into ValueOffsets where the last Command started.  Used to
   // detect valid message completion.
   static const ValueOffsetsType::size_type InvalidStartIndex;
@@ -323,6 +372,8 @@ void vtkClientServerStream::Reset()
   this->Internal->MessageIndexes.erase(
     this->Internal->MessageIndexes.begin(), this->Internal->MessageIndexes.end());
   this->Internal->Objects.Clear();
+  this->Internal->Segments.clear();
+  this->Internal->ExternalSize = 0;
 
   // No message has yet been started.
   this->Internal->Invalid = 0;
@@ -353,7 +404,7 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
   this->Internal->StartIndex = this->Internal->ValueOffsets.size();
 
   // The command counts as the first value in the message.
-  this->Internal->ValueOffsets.push_back(this->Internal->Data.end() - this->Internal->Data.begin());
+  this->Internal->ValueOffsets.push_back(this->Internal->GetSize());
 
   // Store the command in the stream.
   vtkTypeUInt32 data = static_cast<vtkTypeUInt32>(t);
@@ -384,7 +435,7 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
 
   // All values write their type first.  Mark the start of this type
   // and optional value.
-  this->Internal->ValueOffsets.push_back(this->Internal->Data.end() - this->Internal->Data.begin());
+  this->Internal->ValueOffsets.push_back(this->Internal->GetSize());
 
   // Store the type in the stream.
   vtkTypeUInt32 data = static_cast<vtkTypeUInt32>(t);
@@ -397,8 +448,7 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
   if (a.Data && a.Size)
   {
     // Mark the start of this type and optional value.
-    this->Internal->ValueOffsets.push_back(
-      this->Internal->Data.end() - this->Internal->Data.begin());
+    this->Internal->ValueOffsets.push_back(this->Internal->GetSize());
 
     // If the argument is a vtk_object_pointer, we need to store a
     // reference to the object.
@@ -434,6 +484,31 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
   return *this;
 }
 
+//----------------------------------------------------------------------------
+vtkClientServerStream& vtkClientServerStream::InsertArrayReference(
+  const vtkClientServerStream::Array& a, vtkObjectBase* holder)
+{
+  // Referencing small arrays is not worth the bookkeeping.
+  const size_t minimumReferenceSize = 4096;
+  if (a.Size < minimumReferenceSize || a.Type == vtkClientServerStream::string_value)
+  {
+    return *this << a;
+  }
+
+  // Store the array type and length, then reference the data.
+  *this << a.Type;
+  this->Write(&a.Length, sizeof(a.Length));
+
+  vtkClientServerStreamInternals::SegmentType segment;
+  segment.Position = this->Internal->Data.size();
+  segment.Data = static_cast<const unsigned char*>(a.Data);
+  segment.Size = a.Size;
+  segment.Holder = holder;
+  this->Internal->Segments.push_back(segment);
+  this->Internal->ExternalSize += a.Size;
+  return *this;
+}
+
 //----------------------------------------------------------------------------
 vtkClientServerStream& vtkClientServerStream::operator<<(const vtkClientServerStream& css)
 {
@@ -519,6 +594,23 @@ vtkClientServerStream& vtkClientServerStream::operator<<(const vtkVariant& val)
         vtkTypeInt32 numComponents = array->GetNumberOfComponents();
         vtkTypeInt64 numTuples = array->GetNumberOfTuples();
         (*this) << arrayType << numComponents << numTuples;
+
+        // Numeric arrays with the standard memory layout are encoded as a
+        // single array value that references the array memory.
+        vtkIdType numValues = numComponents * numTuples;
+        if (array->IsNumeric() && arrayType != VTK_BIT && array->HasStandardMemoryLayout() &&
+          numValues <= VTK_INT_MAX)
+        {
+          switch (arrayType)
+          {
+            vtkTemplateMacro(this->InsertArrayReference(
+              vtkClientServerStream::InsertArray(
+                static_cast<const VTK_TT*>(array->GetVoidPointer(0)), static_cast<int>(numValues)),
+              array));
+          }
+          break;
+        }
+
         vtkArrayIterator* iter = array->NewIterator();
         switch (array->GetDataType())
         {
@@ -1345,6 +1437,25 @@ int vtkClientServerStream::GetArgument(int message, int& argument, vtkVariant* v
           return 1;
         array->SetNumberOfComponents(numComponents);
         array->SetNumberOfTuples(numTuples);
+
+        // Numeric arrays may be encoded as a single array value.
+        vtkTypeUInt32 length;
+        if (array->IsNumeric() && arrayType != VTK_BIT &&
+          this->GetArgumentLength(message, argument, &length))
+        {
+          if (length != static_cast<vtkTypeUInt32>(numComponents * numTuples))
+          {
+            return 0;
+          }
+          switch (arrayType)
+          {
+            vtkTemplateMacro(result = this->GetArgument(message, argument++,
+                               static_cast<VTK_TT*>(array->GetVoidPointer(0)), length));
+          }
+          *value = array.GetPointer();
+          break;
+        }
+
         switch (arrayType)
         {
           vtkExtraExtendedTemplateMacro(
@@ -1423,6 +1534,7 @@ int vtkClientServerStream::GetData(const unsigned char** data, size_t* length) c
   // Do not return data unless stream is valid.
   if (!this->Internal->Invalid)
   {
+    this->Internal->Flatten();
     if (data)
     {
       *data = &*this->Internal->Data.begin();
@@ -1449,6 +1561,46 @@ int vtkClientServerStream::GetData(const unsigned char** data, size_t* length) c
   }
 }
 
+//----------------------------------------------------------------------------
+int vtkClientServerStream::GetNumberOfDataSegments() const
+{
+  if (this->Internal->Invalid)
+  {
+    return 0;
+  }
+  // Data is split around each external segment.
+  return static_cast<int>(2 * this->Internal->Segments.size() + 1);
+}
+
+//----------------------------------------------------------------------------
+int vtkClientServerStream::GetDataSegment(
+  int index, const unsigned char** data, size_t* length) const
+{
+  if (index < 0 || index >= this->GetNumberOfDataSegments())
+  {
+    return 0;
+  }
+
+  const vtkClientServerStreamInternals::SegmentsType& segments = this->Internal->Segments;
+  const vtkClientServerStreamInternals::DataType& buffer = this->Internal->Data;
+  const size_t segment = static_cast<size_t>(index / 2);
+  if (index % 2 == 1)
+  {
+    // An external segment.
+    *data = segments[segment].Data;
+    *length = segments[segment].Size;
+  }
+  else
+  {
+    // The part of Data between two external segments.
+    const size_t begin = segment == 0 ? 0 : segments[segment - 1].Position;
+    const size_t end = segment < segments.size() ? segments[segment].Position : buffer.size();
+    *data = buffer.empty() ? 0 : &buffer[0] + begin;
+    *length = end - begin;
+  }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkClientServerStream::SetData(const unsigned char* data, size_t length)
 {
@@ -1811,6 +1963,7 @@ const unsigned char* vtkClientServerStream::GetValue(int message, int value) con
       this->Internal->MessageIndexes[message];
 
     // Return a pointer to the value-th value in the message.
+    this->Internal->Flatten();
     const unsigned char* data = &*this->Internal->Data.begin();
     return data + this->Internal->ValueOffsets[index + value];
   }
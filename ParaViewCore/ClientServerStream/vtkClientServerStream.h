@@ -248,10 +248,25 @@ public:
    * Get a pointer to the stream data and its length.  The values are
    * suitable for passing to another stream's SetData method, but are
    * invalidated when any further writing to the stream is done.
-   * Returns whether the stream is currently valid.
+   * Returns whether the stream is currently valid.  If the stream
+   * references external array data (see InsertArrayReference), the data
+   * is copied into the stream first.
    */
   int GetData(const unsigned char** data, size_t* length) const;
 
+  //@{
+  /**
+   * Access the stream data as a list of segments whose concatenation is
+   * the data returned by GetData.  Unlike GetData, this does not copy
+   * arrays inserted by reference into the stream, hence it is the
+   * preferred way to send a stream.  GetNumberOfDataSegments returns 0
+   * if the stream is invalid.  The pointers are invalidated when any
+   * further writing to or reading from the stream is done.
+   */
+  int GetNumberOfDataSegments() const;
+  int GetDataSegment(int index, const unsigned char** data, size_t* length) const;
+  //@}
+
   //--------------------------------------------------------------------------
   // Stream writing methods:
 
@@ -336,6 +351,18 @@ public:
   static vtkClientServerStream::Array InsertArray(const double*, int);
   //@}
 
+  /**
+   * Insert an array into the stream without copying its data.  The
+   * stream only references the memory, which must remain valid and
+   * unchanged until the stream is reset, destroyed or read from.  If
+   * \c holder is not NULL, the stream keeps a reference to it until
+   * then, which is the way to keep the memory of a vtkAbstractArray
+   * alive.  Arrays smaller than a few kilobytes and strings are simply
+   * copied.
+   */
+  vtkClientServerStream& InsertArrayReference(
+    const vtkClientServerStream::Array& a, vtkObjectBase* holder = 0);
+
   /**
    * Construct the entire stream from the given data.  This destroys
    * any data already in the stream.  Returns whether the stream is
@@ -21,6 +21,7 @@
 vtkStandardNewMacro(vtkPVXMLElement);
 
 #include <ctype.h>
+#include <cstring>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -735,6 +736,164 @@ void vtkPVXMLElement::CopyAttributesTo(vtkPVXMLElement* other)
     this->Internal->CharacterData.c_str(), static_cast<int>(this->Internal->CharacterData.size()));
 }
 
+//----------------------------------------------------------------------------
+// Strings and counts of the binary form are prefixed or stored as unsigned
+// 32 bit little-endian integers, so that the form does not depend on the
+// machine.
+static void vtkPVXMLSaveBinary(std::string& buffer, vtkTypeUInt32 value)
+{
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    buffer.push_back(static_cast<char>((value >> (8 * cc)) & 0xff));
+  }
+}
+
+//----------------------------------------------------------------------------
+static void vtkPVXMLSaveBinary(std::string& buffer, const char* str, size_t length)
+{
+  vtkPVXMLSaveBinary(buffer, static_cast<vtkTypeUInt32>(length));
+  buffer.append(str, length);
+}
+
+//----------------------------------------------------------------------------
+static bool vtkPVXMLLoadBinary(
+  const char* buffer, size_t length, size_t& position, vtkTypeUInt32& value)
+{
+  if (length - position < 4)
+  {
+    return false;
+  }
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(buffer + position);
+  value = 0;
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    value |= static_cast<vtkTypeUInt32>(bytes[cc]) << (8 * cc);
+  }
+  position += 4;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+static bool vtkPVXMLLoadBinary(
+  const char* buffer, size_t length, size_t& position, std::string& str)
+{
+  vtkTypeUInt32 size;
+  if (!vtkPVXMLLoadBinary(buffer, length, position, size) || length - position < size)
+  {
+    return false;
+  }
+  str.assign(buffer + position, size);
+  position += size;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVXMLElement::SaveBinary(std::string& buffer)
+{
+  // The name and the id are stored with a leading byte telling whether they
+  // are set.
+  const char* strs[2] = { this->Name, this->Id };
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    buffer.push_back(strs[cc] ? 1 : 0);
+    if (strs[cc])
+    {
+      vtkPVXMLSaveBinary(buffer, strs[cc], strlen(strs[cc]));
+    }
+  }
+
+  size_t numAttributes = this->Internal->AttributeNames.size();
+  vtkPVXMLSaveBinary(buffer, static_cast<vtkTypeUInt32>(numAttributes));
+  for (size_t i = 0; i < numAttributes; ++i)
+  {
+    const std::string& name = this->Internal->AttributeNames[i];
+    const std::string& value = this->Internal->AttributeValues[i];
+    vtkPVXMLSaveBinary(buffer, name.c_str(), name.size());
+    vtkPVXMLSaveBinary(buffer, value.c_str(), value.size());
+  }
+  vtkPVXMLSaveBinary(
+    buffer, this->Internal->CharacterData.c_str(), this->Internal->CharacterData.size());
+
+  vtkPVXMLSaveBinary(buffer, static_cast<vtkTypeUInt32>(this->Internal->NestedElements.size()));
+  vtkPVXMLElementInternals::VectorOfElements::iterator iter;
+  for (iter = this->Internal->NestedElements.begin(); iter != this->Internal->NestedElements.end();
+       ++iter)
+  {
+    (*iter)->SaveBinary(buffer);
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkPVXMLElement* vtkPVXMLElement::NewFromBinary(
+  const char* buffer, size_t length, size_t& position)
+{
+  if (position > length)
+  {
+    return NULL;
+  }
+
+  vtkSmartPointer<vtkPVXMLElement> element = vtkSmartPointer<vtkPVXMLElement>::New();
+  std::string str;
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    if (position == length)
+    {
+      return NULL;
+    }
+    if (buffer[position++])
+    {
+      if (!vtkPVXMLLoadBinary(buffer, length, position, str))
+      {
+        return NULL;
+      }
+      if (cc == 0)
+      {
+        element->SetName(str.c_str());
+      }
+      else
+      {
+        element->SetId(str.c_str());
+      }
+    }
+  }
+
+  vtkTypeUInt32 count;
+  if (!vtkPVXMLLoadBinary(buffer, length, position, count))
+  {
+    return NULL;
+  }
+  vtkPVXMLElementInternals* internal = element->Internal;
+  for (vtkTypeUInt32 i = 0; i < count; ++i)
+  {
+    internal->AttributeNames.push_back(std::string());
+    internal->AttributeValues.push_back(std::string());
+    if (!vtkPVXMLLoadBinary(buffer, length, position, internal->AttributeNames.back()) ||
+      !vtkPVXMLLoadBinary(buffer, length, position, internal->AttributeValues.back()))
+    {
+      return NULL;
+    }
+  }
+  if (!vtkPVXMLLoadBinary(buffer, length, position, internal->CharacterData) ||
+    !vtkPVXMLLoadBinary(buffer, length, position, count))
+  {
+    return NULL;
+  }
+
+  for (vtkTypeUInt32 i = 0; i < count; ++i)
+  {
+    vtkPVXMLElement* nested = vtkPVXMLElement::NewFromBinary(buffer, length, position);
+    if (!nested)
+    {
+      return NULL;
+    }
+    element->AddNestedElement(nested);
+    nested->Delete();
+  }
+
+  element->Register(NULL);
+  return element;
+}
+
 //----------------------------------------------------------------------------
 bool vtkPVXMLElement::Equals(vtkPVXMLElement* other)
 {
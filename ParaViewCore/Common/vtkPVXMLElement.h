@@ -257,6 +257,22 @@ public:
    */
   void CopyAttributesTo(vtkPVXMLElement* other);
 
+  /**
+   * Appends a compact binary form of this element and its nested elements to
+   * `buffer`. NewFromBinary() restores it much faster than parsing the XML.
+   * The form does not depend on the byte order of the machine.
+   */
+  void SaveBinary(std::string& buffer);
+
+  /**
+   * Creates an element from the binary form written by SaveBinary() at
+   * `position` in `buffer`, which holds `length` bytes, and advances
+   * `position` past it. Returns NULL if the buffer is malformed. The caller
+   * must Delete() the returned element.
+   */
+  VTK_NEWINSTANCE
+  static vtkPVXMLElement* NewFromBinary(const char* buffer, size_t length, size_t& position);
+
 protected:
   vtkPVXMLElement();
   ~vtkPVXMLElement() override;
@@ -5,6 +5,7 @@ vtk_module(vtkPVServerImplementationCore
     vtkPVClientServerCoreCore
     vtkprotobuf
   PRIVATE_DEPENDS
+    vtkIOCore
     vtksys
   TEST_LABELS
     PARAVIEW
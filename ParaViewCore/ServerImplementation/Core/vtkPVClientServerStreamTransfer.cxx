@@ -0,0 +1,195 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVClientServerStreamTransfer.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVClientServerStreamTransfer.h"
+
+#include "vtkClientServerStream.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+
+#include <vector>
+
+namespace
+{
+void GetSegmentSizes(const vtkClientServerStream& stream, std::vector<vtkIdType>& sizes)
+{
+  const int numSegments = stream.GetNumberOfDataSegments();
+  sizes.resize(numSegments);
+  for (int cc = 0; cc < numSegments; ++cc)
+  {
+    const unsigned char* data;
+    size_t length;
+    stream.GetDataSegment(cc, &data, &length);
+    sizes[cc] = static_cast<vtkIdType>(length);
+  }
+}
+
+vtkIdType GetTotalSize(const std::vector<vtkIdType>& sizes)
+{
+  vtkIdType total = 0;
+  for (size_t cc = 0; cc < sizes.size(); ++cc)
+  {
+    total += sizes[cc];
+  }
+  return total;
+}
+}
+
+vtkStandardNewMacro(vtkPVClientServerStreamTransfer);
+//----------------------------------------------------------------------------
+vtkPVClientServerStreamTransfer::vtkPVClientServerStreamTransfer()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVClientServerStreamTransfer::~vtkPVClientServerStreamTransfer()
+{
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVClientServerStreamTransfer::Send(const vtkClientServerStream& stream,
+  vtkMultiProcessController* controller, int remoteId, int tag)
+{
+  std::vector<vtkIdType> sizes;
+  GetSegmentSizes(stream, sizes);
+
+  vtkIdType numSegments = static_cast<vtkIdType>(sizes.size());
+  if (!controller->Send(&numSegments, 1, remoteId, tag))
+  {
+    return false;
+  }
+  if (numSegments == 0)
+  {
+    return true;
+  }
+  if (!controller->Send(&sizes[0], numSegments, remoteId, tag))
+  {
+    return false;
+  }
+  for (int cc = 0; cc < static_cast<int>(numSegments); ++cc)
+  {
+    const unsigned char* data;
+    size_t length;
+    stream.GetDataSegment(cc, &data, &length);
+    if (length > 0 && !controller->Send(data, static_cast<vtkIdType>(length), remoteId, tag))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVClientServerStreamTransfer::Receive(vtkClientServerStream& stream,
+  vtkMultiProcessController* controller, int remoteId, int tag)
+{
+  stream.Reset();
+
+  vtkIdType numSegments = 0;
+  if (!controller->Receive(&numSegments, 1, remoteId, tag))
+  {
+    return false;
+  }
+  if (numSegments == 0)
+  {
+    return true;
+  }
+  std::vector<vtkIdType> sizes(numSegments);
+  if (!controller->Receive(&sizes[0], numSegments, remoteId, tag))
+  {
+    return false;
+  }
+
+  // Receive all segments straight into a single buffer.
+  std::vector<unsigned char> buffer(GetTotalSize(sizes));
+  vtkIdType offset = 0;
+  for (vtkIdType cc = 0; cc < numSegments; ++cc)
+  {
+    if (sizes[cc] > 0 && !controller->Receive(&buffer[offset], sizes[cc], remoteId, tag))
+    {
+      return false;
+    }
+    offset += sizes[cc];
+  }
+  return buffer.empty() || stream.SetData(&buffer[0], buffer.size()) != 0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVClientServerStreamTransfer::Broadcast(
+  vtkClientServerStream& stream, vtkMultiProcessController* controller, int rootId)
+{
+  const bool isRoot = (controller->GetLocalProcessId() == rootId);
+
+  std::vector<vtkIdType> sizes;
+  if (isRoot)
+  {
+    GetSegmentSizes(stream, sizes);
+  }
+  vtkIdType numSegments = static_cast<vtkIdType>(sizes.size());
+  if (!controller->Broadcast(&numSegments, 1, rootId))
+  {
+    return false;
+  }
+  if (numSegments == 0)
+  {
+    if (!isRoot)
+    {
+      stream.Reset();
+    }
+    return true;
+  }
+  sizes.resize(numSegments);
+  if (!controller->Broadcast(&sizes[0], numSegments, rootId))
+  {
+    return false;
+  }
+
+  std::vector<unsigned char> buffer;
+  if (!isRoot)
+  {
+    buffer.resize(GetTotalSize(sizes));
+  }
+  vtkIdType offset = 0;
+  for (vtkIdType cc = 0; cc < numSegments; ++cc)
+  {
+    if (sizes[cc] == 0)
+    {
+      continue;
+    }
+    unsigned char* data;
+    if (isRoot)
+    {
+      const unsigned char* segment;
+      size_t length;
+      stream.GetDataSegment(static_cast<int>(cc), &segment, &length);
+      data = const_cast<unsigned char*>(segment);
+    }
+    else
+    {
+      data = &buffer[offset];
+    }
+    if (!controller->Broadcast(data, sizes[cc], rootId))
+    {
+      return false;
+    }
+    offset += sizes[cc];
+  }
+  return isRoot || buffer.empty() || stream.SetData(&buffer[0], buffer.size()) != 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerStreamTransfer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
@@ -0,0 +1,75 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVClientServerStreamTransfer.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVClientServerStreamTransfer
+ * @brief   sends vtkClientServerStream instances without flattening them.
+ *
+ * vtkPVClientServerStreamTransfer provides methods to send, receive and
+ * broadcast a vtkClientServerStream using a vtkMultiProcessController. The
+ * stream is transferred segment by segment (see
+ * vtkClientServerStream::GetDataSegment), hence arrays inserted in the stream
+ * by reference are sent straight from their own memory instead of being
+ * copied into the stream first. The receiving end gets a regular stream.
+ *
+ * The segment sizes are sent ahead of the data, so a stream sent with Send()
+ * must be received with Receive(), and Broadcast() must be called on all
+ * ranks.
+*/
+
+#ifndef vtkPVClientServerStreamTransfer_h
+#define vtkPVClientServerStreamTransfer_h
+
+#include "vtkObject.h"
+#include "vtkPVServerImplementationCoreModule.h" //needed for exports
+
+class vtkClientServerStream;
+class vtkMultiProcessController;
+
+class VTKPVSERVERIMPLEMENTATIONCORE_EXPORT vtkPVClientServerStreamTransfer : public vtkObject
+{
+public:
+  static vtkPVClientServerStreamTransfer* New();
+  vtkTypeMacro(vtkPVClientServerStreamTransfer, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) VTK_OVERRIDE;
+
+  //@{
+  /**
+   * Send/Receive a stream to/from the given process. Returns false if the
+   * communication failed or, for Receive, if the received stream is
+   * invalid.
+   */
+  static bool Send(const vtkClientServerStream& stream, vtkMultiProcessController* controller,
+    int remoteId, int tag);
+  static bool Receive(vtkClientServerStream& stream, vtkMultiProcessController* controller,
+    int remoteId, int tag);
+  //@}
+
+  /**
+   * Broadcast the stream on the root process to all other processes. On
+   * non-root processes, \c stream is replaced by the received stream.
+   */
+  static bool Broadcast(
+    vtkClientServerStream& stream, vtkMultiProcessController* controller, int rootId);
+
+protected:
+  vtkPVClientServerStreamTransfer();
+  ~vtkPVClientServerStreamTransfer() override;
+
+private:
+  vtkPVClientServerStreamTransfer(const vtkPVClientServerStreamTransfer&) = delete;
+  void operator=(const vtkPVClientServerStreamTransfer&) = delete;
+};
+
+#endif
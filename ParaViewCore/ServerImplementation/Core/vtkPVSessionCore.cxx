@@ -24,6 +24,7 @@
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVClientServerStreamTransfer.h"
 #include "vtkPVInformation.h"
 #include "vtkPVInstantiator.h"
 #include "vtkPVOptions.h"
@@ -36,11 +37,15 @@
 #include "vtkSMMessage.h"
 #include "vtkSmartPointer.h"
 
+#include <vtksys/SystemTools.hxx>
+
 #include <assert.h>
+#include <string.h>
 #include <fstream>
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #define LOG(x)                                                                                     \
   if (this->LogStream)                                                                             \
@@ -78,6 +83,9 @@ void RMICallback(
       break;
   }
 }
+
+// -1 indicates the mode has not been initialized from the environment yet.
+int InformationReductionMode = -1;
 };
 //****************************************************************************/
 //                        Internal Class
@@ -584,10 +592,6 @@ void vtkPVSessionCore::ExecuteStream(
     {
       // Forward the message to the satellites if the object is expected to exist
       // on the satellites.
-      size_t byte_size;
-      const unsigned char* raw_data;
-      stream.GetData(&raw_data, &byte_size);
-
       // FIXME: There's one flaw in this logic. If a object is to be created on
       // DATA_SERVER_ROOT, but on all RENDER_SERVER nodes, then in render-server
       // configuration, the message will end up being send to all data-server
@@ -595,11 +599,11 @@ void vtkPVSessionCore::ExecuteStream(
       // and we should fix this.
       unsigned char type = EXECUTE_STREAM;
       this->ParallelController->TriggerRMIOnAllChildren(&type, 1, ROOT_SATELLITE_RMI_TAG);
-      int size[2];
-      size[0] = static_cast<int>(byte_size);
-      size[1] = (ignore_errors ? 1 : 0);
-      this->ParallelController->Broadcast(size, 2, 0);
-      this->ParallelController->Broadcast(const_cast<unsigned char*>(raw_data), size[0], 0);
+      int ignore = (ignore_errors ? 1 : 0);
+      this->ParallelController->Broadcast(&ignore, 1, 0);
+      // the stream is left unchanged on the root process.
+      vtkPVClientServerStreamTransfer::Broadcast(
+        const_cast<vtkClientServerStream&>(stream), this->ParallelController, 0);
     }
   }
 
@@ -609,15 +613,12 @@ void vtkPVSessionCore::ExecuteStream(
 //----------------------------------------------------------------------------
 void vtkPVSessionCore::ExecuteStreamSatelliteCallback()
 {
-  int byte_size[2] = { 0, 0 };
-  this->ParallelController->Broadcast(byte_size, 2, 0);
-  unsigned char* raw_data = new unsigned char[byte_size[0] + 1];
-  this->ParallelController->Broadcast(raw_data, byte_size[0], 0);
+  int ignore = 0;
+  this->ParallelController->Broadcast(&ignore, 1, 0);
 
   vtkClientServerStream stream;
-  stream.SetData(raw_data, byte_size[0]);
-  this->ExecuteStreamInternal(stream, byte_size[1] != 0);
-  delete[] raw_data;
+  vtkPVClientServerStreamTransfer::Broadcast(stream, this->ParallelController, 0);
+  this->ExecuteStreamInternal(stream, ignore != 0);
 }
 
 //----------------------------------------------------------------------------
@@ -846,7 +847,8 @@ bool vtkPVSessionCore::GatherInformation(
     this->ParallelController->TriggerRMIOnAllChildren(&type, 1, ROOT_SATELLITE_RMI_TAG);
 
     vtkMultiProcessStream stream;
-    stream << information->GetClassName() << globalid;
+    stream << information->GetClassName() << globalid
+           << vtkPVSessionCore::GetInformationReductionMode();
 
     // serialize information parameters so all processes have the same ivars.
     information->CopyParametersToStream(stream);
@@ -854,7 +856,7 @@ bool vtkPVSessionCore::GatherInformation(
     this->ParallelController->Broadcast(stream, 0);
   }
 
-  return this->CollectInformation(information);
+  return this->CollectInformation(information, vtkPVSessionCore::GetInformationReductionMode());
 }
 
 //----------------------------------------------------------------------------
@@ -865,7 +867,8 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
 
   std::string classname;
   vtkTypeUInt32 globalid;
-  stream >> classname >> globalid;
+  int mode;
+  stream >> classname >> globalid >> mode;
 
   vtkSmartPointer<vtkObject> o;
   o.TakeReference(vtkPVInstantiator::CreateInstance(classname.c_str()));
@@ -874,13 +877,13 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
   {
     info->CopyParametersFromStream(stream);
     this->GatherInformationInternal(info, globalid);
-    this->CollectInformation(info);
+    this->CollectInformation(info, mode);
   }
   else
   {
     vtkErrorMacro("Could not gather information on Satellite.");
     // let the parent know, otherwise root will hang.
-    this->CollectInformation(NULL);
+    this->CollectInformation(NULL, mode);
   }
 }
 
@@ -894,21 +897,32 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
     }                                                                                              \
   }
 
-bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
+bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info, int mode)
 {
   // Sanity checks
   assert("pre: NULL PV information!" && (info != NULL));
 
-  // STEP 0: temporary variables
-  int rank = this->ParallelController->GetLocalProcessId();
-  int nranks = this->ParallelController->GetNumberOfProcesses();
-
-  if (nranks == 1)
+  if (this->ParallelController->GetNumberOfProcesses() == 1)
   {
     /* short-circuit */
     return true;
   }
 
+  bool status = (mode == TREE_REDUCTION) ? this->TreeReduceInformation(info)
+                                         : this->GatherToRootInformation(info);
+
+  // Barrier synchronization
+  this->ParallelController->Barrier();
+  return status;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVSessionCore::GatherToRootInformation(vtkPVInformation* info)
+{
+  // STEP 0: temporary variables
+  int rank = this->ParallelController->GetLocalProcessId();
+  int nranks = this->ParallelController->GetNumberOfProcesses();
+
   vtkIdType* rcvcounts = NULL;     /* significant only at rank 0 */
   vtkIdType* offSet = NULL;        /* significant only at rank 0 */
   int rbufsize = 0;                /* significant only at rank 0 */
@@ -982,12 +996,86 @@ bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
   assert("post: rcvcounts should be NULL" && (rcvcounts == NULL));
   assert("post: offSet should be NULL" && (offSet == NULL));
   assert("post: rcvbuffer should be NULL" && (rcvbuffer == NULL));
+  return true;
+}
 
-  // STEP 8: Barrier synchronization
-  this->ParallelController->Barrier();
+//----------------------------------------------------------------------------
+bool vtkPVSessionCore::TreeReduceInformation(vtkPVInformation* info)
+{
+  int rank = this->ParallelController->GetLocalProcessId();
+  int nranks = this->ParallelController->GetNumberOfProcesses();
+
+  // Binomial tree: at each level, ranks that are a multiple of 2*step receive
+  // the partial result of rank + step (which covers ranks
+  // [rank + step, rank + 2*step)) and append it to their own, while the others
+  // forward their partial result to rank - step and drop out. Merges thus
+  // happen in increasing rank order, as with GatherToRootInformation().
+  for (int step = 1; step < nranks; step *= 2)
+  {
+    if (rank % (2 * step) == 0)
+    {
+      int child = rank + step;
+      if (child >= nranks)
+      {
+        continue;
+      }
+
+      vtkIdType length = 0;
+      this->ParallelController->Receive(&length, 1, child, ROOT_SATELLITE_INFO_TAG);
+
+      std::vector<unsigned char> buffer(static_cast<size_t>(length));
+      if (length > 0)
+      {
+        this->ParallelController->Receive(&buffer[0], length, child, ROOT_SATELLITE_INFO_TAG);
+      }
+
+      vtkClientServerStream rcvStream;
+      rcvStream.SetData(length > 0 ? &buffer[0] : NULL, static_cast<size_t>(length));
+      vtkPVInformation* tempInfo = info->NewInstance();
+      tempInfo->CopyFromStream(&rcvStream);
+      info->AddInformation(tempInfo);
+      tempInfo->Delete();
+    }
+    else
+    {
+      vtkClientServerStream stream;
+      info->CopyToStream(&stream);
+
+      const unsigned char* data;
+      size_t length;
+      stream.GetData(&data, &length);
+
+      vtkIdType sendLength = static_cast<vtkIdType>(length);
+      int parent = rank - step;
+      this->ParallelController->Send(&sendLength, 1, parent, ROOT_SATELLITE_INFO_TAG);
+      if (sendLength > 0)
+      {
+        this->ParallelController->Send(data, sendLength, parent, ROOT_SATELLITE_INFO_TAG);
+      }
+      break;
+    }
+  }
   return true;
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionCore::SetInformationReductionMode(int mode)
+{
+  InformationReductionMode = (mode == TREE_REDUCTION) ? TREE_REDUCTION : GATHER_TO_ROOT;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVSessionCore::GetInformationReductionMode()
+{
+  if (InformationReductionMode == -1)
+  {
+    const char* env = vtksys::SystemTools::GetEnv("PV_INFORMATION_REDUCTION_MODE");
+    InformationReductionMode =
+      (env && strcmp(env, "tree") == 0) ? TREE_REDUCTION : GATHER_TO_ROOT;
+  }
+  return InformationReductionMode;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionCore::RegisterRemoteObject(vtkTypeUInt32 gid, vtkObject* obj)
 {
@@ -127,6 +127,36 @@ public:
   virtual bool GatherInformation(
     vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid);
 
+  //@{
+  /**
+   * Strategy used to combine vtkPVInformation objects from MPI satellites
+   * when gathering information.
+   *
+   * GATHER_TO_ROOT (default) gathers every rank's serialized information on
+   * the root node, which then merges them one at a time. This is O(N) in
+   * memory and time on the root.
+   *
+   * TREE_REDUCTION merges information objects pairwise along a binomial tree.
+   * Every interior rank merges its children's information before forwarding
+   * it to its parent so that the root only performs O(log N) merges. Ranks are
+   * still merged in increasing rank order, hence the result is identical to
+   * GATHER_TO_ROOT for vtkPVInformation subclasses whose AddInformation()
+   * is associative.
+   *
+   * The mode is a process-wide setting that only needs to be set on the root
+   * node; it is forwarded to the satellites with every gather request. The
+   * initial value can be set to TREE_REDUCTION using the environment variable
+   * `PV_INFORMATION_REDUCTION_MODE=tree`.
+   */
+  enum InformationReductionModes
+  {
+    GATHER_TO_ROOT = 0,
+    TREE_REDUCTION = 1
+  };
+  static void SetInformationReductionMode(int mode);
+  static int GetInformationReductionMode();
+  //@}
+
   /**
    * Returns the number of processes. This simply calls the
    * GetNumberOfProcesses() on this->ParallelController
@@ -210,10 +240,15 @@ protected:
    */
   bool GatherInformationInternal(vtkPVInformation* information, vtkTypeUInt32 globalid);
 
+  //@{
   /**
-   * Gather information across MPI satellites.
+   * Gather information across MPI satellites. \c mode is one of
+   * InformationReductionModes and must be the same on all ranks.
    */
-  bool CollectInformation(vtkPVInformation*);
+  bool CollectInformation(vtkPVInformation*, int mode);
+  bool GatherToRootInformation(vtkPVInformation*);
+  bool TreeReduceInformation(vtkPVInformation*);
+  //@}
 
   /**
    * Increment reference count of a local vtkSIObject.
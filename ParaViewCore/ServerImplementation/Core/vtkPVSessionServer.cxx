@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkPVSessionServer.h"
 
+#include "vtkClientServerInterpreter.h"
 #include "vtkClientServerStream.h"
 #include "vtkCommand.h"
 #include "vtkCompositeMultiProcessController.h"
@@ -22,6 +23,7 @@
 #include "vtkNetworkAccessManager.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVClientServerStreamTransfer.h"
 #include "vtkPVConfig.h"
 #include "vtkPVInformation.h"
 #include "vtkPVInstantiator.h"
@@ -35,6 +37,7 @@
 #include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
 #include "vtkSocketController.h"
+#include "vtkZLibDataCompressor.h"
 
 #include <assert.h>
 #include <map>
@@ -62,6 +65,36 @@ void CloseSessionCallback(void* localArg, void* vtkNotUsed(remoteArg),
   vtkPVSessionServer* self = reinterpret_cast<vtkPVSessionServer*>(localArg);
   self->OnCloseSessionRMI();
 }
+
+// Collects the errors reported by the interpreter while pushing batched
+// states.
+class vtkBatchErrorObserver : public vtkCommand
+{
+public:
+  static vtkBatchErrorObserver* New() { return new vtkBatchErrorObserver; }
+
+  void Execute(vtkObject* caller, unsigned long, void*) VTK_OVERRIDE
+  {
+    ++this->NumberOfErrors;
+    const char* errorMessage;
+    const vtkClientServerStream& last =
+      static_cast<vtkClientServerInterpreter*>(caller)->GetLastResult();
+    if (last.GetNumberOfMessages() > 0 && last.GetCommand(0) == vtkClientServerStream::Error &&
+      last.GetArgument(0, 0, &errorMessage))
+    {
+      this->Report << errorMessage << "\n";
+    }
+  }
+
+  int NumberOfErrors;
+  std::ostringstream Report;
+
+private:
+  vtkBatchErrorObserver()
+    : NumberOfErrors(0)
+  {
+  }
+};
 };
 //****************************************************************************/
 class vtkPVSessionServer::vtkInternals
@@ -71,6 +104,7 @@ public:
   {
     this->SatelliteServerSession = (vtkProcessModule::GetProcessModule()->GetPartitionId() > 0);
     this->Owner = owner;
+    this->NumberOfBatchErrors = 0;
 
     // Attach callbacks
     this->CompositeMultiProcessController->AddRMICallback(
@@ -320,6 +354,9 @@ private:
   vtkWeakPointer<vtkPVSessionServer> Owner;
   std::string ClientURL;
   std::string BaseURL;
+  // Errors reported while pushing batched states since the last report.
+  int NumberOfBatchErrors;
+  std::string BatchErrors;
   std::map<vtkTypeUInt32, vtkSMMessage> ShareOnlyCache;
   bool SatelliteServerSession;
 };
@@ -556,6 +593,12 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
     }
     break;
 
+    case vtkPVSessionServer::PUSH_BATCH:
+    {
+      this->PushBatchedStates(stream);
+    }
+    break;
+
     case vtkPVSessionServer::PULL:
     {
       std::string string;
@@ -596,15 +639,12 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
 
     case vtkPVSessionServer::EXECUTE_STREAM:
     {
-      int ignore_errors, size;
-      stream >> ignore_errors >> size;
-      unsigned char* css_data = new unsigned char[size + 1];
-      this->Internal->GetActiveController()->Receive(
-        css_data, size, 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+      int ignore_errors;
+      stream >> ignore_errors;
       vtkClientServerStream cssStream;
-      cssStream.SetData(css_data, size);
+      vtkPVClientServerStreamTransfer::Receive(cssStream, this->Internal->GetActiveController(), 1,
+        vtkPVSessionServer::EXECUTE_STREAM_TAG);
       this->ExecuteStream(vtkPVSession::CLIENT_AND_SERVERS, cssStream, ignore_errors != 0);
-      delete[] css_data;
     }
     break;
 
@@ -622,9 +662,56 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
       this->GatherInformationInternal(location, classname.c_str(), globalid, stream);
     }
     break;
+
+    case vtkPVSessionServer::GATHER_INFORMATION_ASYNC:
+    {
+      std::string classname;
+      vtkTypeUInt32 requestId, location, globalid;
+      stream >> requestId >> location >> classname >> globalid;
+      this->GatherInformationAsyncInternal(
+        requestId, location, classname.c_str(), globalid, stream);
+    }
+    break;
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::GatherInformationAsyncInternal(vtkTypeUInt32 requestId,
+  vtkTypeUInt32 location, const char* classname, vtkTypeUInt32 globalid,
+  vtkMultiProcessStream& stream)
+{
+  std::vector<unsigned char> reply(4);
+  for (int cc = 0; cc < 4; cc++)
+  {
+    reply[cc] = static_cast<unsigned char>((requestId >> (8 * cc)) & 0xff);
+  }
+
+  vtkSmartPointer<vtkObject> o;
+  o.TakeReference(vtkPVInstantiator::CreateInstance(classname));
+  vtkPVInformation* info = vtkPVInformation::SafeDownCast(o);
+  if (info)
+  {
+    info->CopyParametersFromStream(stream);
+    this->GatherInformation(location, info, globalid);
+
+    vtkClientServerStream css;
+    info->CopyToStream(&css);
+    size_t length;
+    const unsigned char* data;
+    css.GetData(&data, &length);
+    reply.insert(reply.end(), data, data + length);
+  }
+  else
+  {
+    vtkErrorMacro("Could not create information object.");
+  }
+
+  // The client dispatches the reply from its event loop, along with any
+  // other reply or notification it did not wait for yet.
+  this->Internal->GetActiveController()->GetActiveController()->TriggerRMI(
+    1, &reply[0], static_cast<int>(reply.size()), vtkPVSessionServer::REPLY_GATHER_INFORMATION_RMI);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionServer::SendLastResultToClient()
 {
@@ -641,6 +728,145 @@ void vtkPVSessionServer::SendLastResultToClient()
   this->Internal->GetActiveController()->Send(data, size, 1, vtkPVSessionServer::REPLY_LAST_RESULT);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::PackBatch(
+  vtkMultiProcessStream& stream, bool report, const std::vector<std::string>& states)
+{
+  // The batch holds whether to reply with the errors, the number of states
+  // and their sizes, then the size of their concatenation and that
+  // concatenation compressed with zlib.
+  stream << static_cast<int>(report) << static_cast<unsigned int>(states.size());
+  std::string batch;
+  for (size_t cc = 0; cc < states.size(); cc++)
+  {
+    stream << static_cast<unsigned int>(states[cc].size());
+    batch += states[cc];
+  }
+  vtkNew<vtkZLibDataCompressor> compressor;
+  std::vector<unsigned char> compressed(compressor->GetMaximumCompressionSpace(batch.size()));
+  size_t compressedSize =
+    compressor->Compress(reinterpret_cast<const unsigned char*>(batch.c_str()), batch.size(),
+      &compressed[0], compressed.size());
+  stream << static_cast<unsigned int>(batch.size())
+         << std::string(reinterpret_cast<const char*>(&compressed[0]), compressedSize);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVSessionServer::UnpackBatch(
+  vtkMultiProcessStream& stream, bool& report, std::vector<std::string>& states)
+{
+  states.clear();
+  if (stream.Empty())
+  {
+    return false;
+  }
+  int reportFlag;
+  stream >> reportFlag;
+  report = reportFlag != 0;
+
+  unsigned int count;
+  if (stream.Empty())
+  {
+    return false;
+  }
+  stream >> count;
+  std::vector<unsigned int> lengths;
+  size_t total = 0;
+  for (unsigned int cc = 0; cc < count; ++cc)
+  {
+    unsigned int length;
+    if (stream.Empty())
+    {
+      return false;
+    }
+    stream >> length;
+    lengths.push_back(length);
+    total += length;
+  }
+
+  unsigned int size;
+  std::string compressed;
+  if (stream.Empty())
+  {
+    return false;
+  }
+  stream >> size;
+  if (stream.Empty() || total != size)
+  {
+    return false;
+  }
+  stream >> compressed;
+  if (!stream.Empty())
+  {
+    return false;
+  }
+
+  std::vector<unsigned char> batch(size + 1);
+  vtkNew<vtkZLibDataCompressor> compressor;
+  if (size > 0 &&
+    compressor->Uncompress(reinterpret_cast<const unsigned char*>(compressed.c_str()),
+      compressed.size(), &batch[0], size) != size)
+  {
+    return false;
+  }
+  size_t position = 0;
+  for (unsigned int cc = 0; cc < count; ++cc)
+  {
+    states.push_back(std::string(reinterpret_cast<const char*>(&batch[position]), lengths[cc]));
+    position += lengths[cc];
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::PushBatchedStates(vtkMultiProcessStream& stream)
+{
+  // A malformed batch is rejected as a whole rather than partly pushed.
+  bool report = false;
+  std::vector<std::string> states;
+  bool valid = vtkPVSessionServer::UnpackBatch(stream, report, states);
+  std::vector<vtkSMMessage> messages(states.size());
+  for (size_t cc = 0; valid && cc < states.size(); ++cc)
+  {
+    valid = messages[cc].ParseFromString(states[cc]);
+  }
+
+  vtkNew<vtkBatchErrorObserver> observer;
+  if (valid)
+  {
+    vtkClientServerInterpreter* interpreter = this->GetSessionCore()->GetInterpreter();
+    unsigned long observerId =
+      interpreter->AddObserver(vtkCommand::UserEvent, observer.GetPointer());
+    for (size_t cc = 0; cc < messages.size(); ++cc)
+    {
+      // Same as for PUSH.
+      if (!this->Internal->StoreShareOnly(&messages[cc]))
+      {
+        this->PushState(&messages[cc]);
+      }
+      this->NotifyOtherClients(&messages[cc]);
+    }
+    interpreter->RemoveObserver(observerId);
+  }
+  else
+  {
+    vtkErrorMacro("Failed to decode the batched states, none of them were pushed.");
+    ++observer->NumberOfErrors;
+    observer->Report << "Failed to decode the batched states, none of them were pushed.\n";
+  }
+
+  this->Internal->NumberOfBatchErrors += observer->NumberOfErrors;
+  this->Internal->BatchErrors += observer->Report.str();
+  if (report)
+  {
+    vtkMultiProcessStream reply;
+    reply << this->Internal->NumberOfBatchErrors << this->Internal->BatchErrors;
+    this->Internal->GetActiveController()->Send(reply, 1, vtkPVSessionServer::REPLY_PUSH_BATCH);
+    this->Internal->NumberOfBatchErrors = 0;
+    this->Internal->BatchErrors.clear();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionServer::GatherInformationInternal(vtkTypeUInt32 location, const char* classname,
   vtkTypeUInt32 globalid, vtkMultiProcessStream& stream)
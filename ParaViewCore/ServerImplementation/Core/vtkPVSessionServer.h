@@ -28,6 +28,9 @@
 #include "vtkPVServerImplementationCoreModule.h" //needed for exports
 #include "vtkPVSessionBase.h"
 
+#include <string> // for std::string
+#include <vector> // for std::vector
+
 class vtkMultiProcessController;
 class vtkMultiProcessStream;
 
@@ -83,13 +86,17 @@ public:
     REGISTER_SI = 16,
     UNREGISTER_SI = 17,
     LAST_RESULT = 18,
+    PUSH_BATCH = 19,
+    GATHER_INFORMATION_ASYNC = 20,
     SERVER_NOTIFICATION_MESSAGE_RMI = 55624,
     CLIENT_SERVER_MESSAGE_RMI = 55625,
     CLOSE_SESSION = 55626,
     REPLY_GATHER_INFORMATION_TAG = 55627,
     REPLY_PULL = 55628,
     REPLY_LAST_RESULT = 55629,
-    EXECUTE_STREAM_TAG = 55630
+    EXECUTE_STREAM_TAG = 55630,
+    REPLY_PUSH_BATCH = 55631,
+    REPLY_GATHER_INFORMATION_RMI = 55632
   };
 
   //@{
@@ -136,6 +143,21 @@ public:
    */
   void NotifyOtherClients(const vtkSMMessage*) VTK_OVERRIDE;
 
+  //@{
+  /**
+   * Write/read the serialized states of a PUSH_BATCH message, and whether the
+   * server must reply with the number of errors, to/from `stream`. The states
+   * are concatenated and compressed with zlib. UnpackBatch() returns false,
+   * leaving `states` empty, if the batch is malformed, in which case none of
+   * its states must be pushed. `report` is set as soon as it is read so that
+   * the client waiting for a reply still gets one.
+   */
+  static void PackBatch(
+    vtkMultiProcessStream& stream, bool report, const std::vector<std::string>& states);
+  static bool UnpackBatch(
+    vtkMultiProcessStream& stream, bool& report, std::vector<std::string>& states);
+  //@}
+
 protected:
   vtkPVSessionServer();
   ~vtkPVSessionServer() override;
@@ -146,11 +168,31 @@ protected:
   void GatherInformationInternal(
     vtkTypeUInt32 location, const char* classname, vtkTypeUInt32 globalid, vtkMultiProcessStream&);
 
+  /**
+   * Called when client triggers GatherInformationAsync(). Instead of waiting
+   * for the client to receive it, the information is sent back by triggering
+   * the REPLY_GATHER_INFORMATION_RMI on the client, as 4 bytes holding the
+   * little-endian request id followed by the information stream, which is
+   * empty if the information could not be created.
+   */
+  void GatherInformationAsyncInternal(vtkTypeUInt32 requestId, vtkTypeUInt32 location,
+    const char* classname, vtkTypeUInt32 globalid, vtkMultiProcessStream&);
+
   /**
    * Sends the last result to client.
    */
   void SendLastResultToClient();
 
+  /**
+   * Called when the client sends the states queued by a transaction (see
+   * vtkSMSession::BeginTransaction()). Pushes them in order and, if asked
+   * to, replies with the number of errors reported while pushing the states
+   * of this batch and of the previous ones not yet reported, along with their
+   * messages. A malformed batch is rejected, none of its states are pushed,
+   * and counts as one error.
+   */
+  void PushBatchedStates(vtkMultiProcessStream& stream);
+
   vtkMPIMToNSocketConnection* MPIMToNSocketConnection;
 
   bool MultipleConnection;
@@ -17,6 +17,7 @@
 #include "vtkCollection.h"
 #include "vtkCollectionIterator.h"
 #include "vtkCommand.h"
+#include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVConfig.h"
@@ -35,13 +36,17 @@
 #include "vtkTimerLog.h"
 
 #include <cassert>
+#include <cstdio>
+#include <cstring>
 #include <map>
 #include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include <vtksys/FStream.hxx>
 #include <vtksys/RegularExpression.hxx>
+#include <vtksys/SystemTools.hxx>
 
 //****************************************************************************/
 //                    Internal Classes and typedefs
@@ -50,6 +55,232 @@ typedef vtkSmartPointer<vtkPVXMLElement> XMLElement;
 typedef std::map<std::string, XMLElement> StrToXmlMap;
 typedef std::map<std::string, StrToXmlMap> StrToStrToXmlMap;
 
+namespace
+{
+//-------------------------------------------------------------------------
+std::string& GetCacheDirectoryInternal()
+{
+  static std::string directory(vtksys::SystemTools::GetEnv("PV_PROXY_DEFINITIONS_CACHE")
+      ? vtksys::SystemTools::GetEnv("PV_PROXY_DEFINITIONS_CACHE")
+      : "");
+  return directory;
+}
+
+//-------------------------------------------------------------------------
+bool& GetBroadcastCoreDefinitionsInternal()
+{
+  static bool broadcast = vtksys::SystemTools::GetEnv("PV_PROXY_DEFINITIONS_BROADCAST") != NULL;
+  return broadcast;
+}
+
+// Cache files start with this magic string followed by the format version,
+// then the number of XML roots and the roots in the binary form of
+// vtkPVXMLElement::SaveBinary(). As in the latter, all integers are unsigned
+// 32 bit little-endian, whatever the byte order of the machine. Files of
+// another version are discarded.
+const char CacheMagic[8] = { 'P', 'V', 'P', 'D', 'C', 'A', 'C', 'H' };
+const vtkTypeUInt32 CacheVersion = 2;
+
+//-------------------------------------------------------------------------
+void AppendUInt32(std::string& buffer, vtkTypeUInt32 value)
+{
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    buffer.push_back(static_cast<char>((value >> (8 * cc)) & 0xff));
+  }
+}
+
+//-------------------------------------------------------------------------
+vtkTypeUInt32 ToUInt32(const char bytes[4])
+{
+  vtkTypeUInt32 value = 0;
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    value |= static_cast<vtkTypeUInt32>(static_cast<unsigned char>(bytes[cc])) << (8 * cc);
+  }
+  return value;
+}
+
+//-------------------------------------------------------------------------
+// Names the cache file after the plugin, the ParaView version and a 64 bit
+// FNV-1a hash of the XMLs, so that files are not used once any changes.
+std::string GetCacheFileName(const char* pluginName, const std::vector<std::string>& xmls)
+{
+  vtkTypeUInt64 hash = 14695981039346656037ull;
+  for (size_t cc = 0; cc < xmls.size(); ++cc)
+  {
+    // include the terminating null to tell apart the boundaries of XMLs.
+    const char* xml = xmls[cc].c_str();
+    for (size_t kk = 0; kk <= xmls[cc].size(); ++kk)
+    {
+      hash = (hash ^ static_cast<unsigned char>(xml[kk])) * 1099511628211ull;
+    }
+  }
+
+  std::ostringstream filename;
+  filename << GetCacheDirectoryInternal() << "/" << pluginName << "-" << PARAVIEW_VERSION_FULL
+           << "-" << std::hex << hash << ".pvdefs";
+  return filename.str();
+}
+
+//-------------------------------------------------------------------------
+// Parses the XMLs, skipping those that fail. Returns false if any failed.
+bool ParseXMLs(const std::vector<std::string>& xmls, std::vector<XMLElement>& roots)
+{
+  bool status = true;
+  for (size_t cc = 0; cc < xmls.size(); ++cc)
+  {
+    vtkNew<vtkPVXMLParser> parser;
+    if (parser->Parse(xmls[cc].c_str()) != 0 && parser->GetRootElement())
+    {
+      roots.push_back(parser->GetRootElement());
+    }
+    else
+    {
+      status = false;
+    }
+  }
+  return status;
+}
+
+//-------------------------------------------------------------------------
+void SaveRoots(const std::vector<XMLElement>& roots, std::string& payload)
+{
+  AppendUInt32(payload, static_cast<vtkTypeUInt32>(roots.size()));
+  for (size_t cc = 0; cc < roots.size(); ++cc)
+  {
+    roots[cc]->SaveBinary(payload);
+  }
+}
+
+//-------------------------------------------------------------------------
+bool LoadRoots(const std::string& payload, std::vector<XMLElement>& roots)
+{
+  if (payload.size() < 4)
+  {
+    return false;
+  }
+  const vtkTypeUInt32 count = ToUInt32(payload.c_str());
+  size_t position = 4;
+  for (vtkTypeUInt32 cc = 0; cc < count; ++cc)
+  {
+    vtkPVXMLElement* root =
+      vtkPVXMLElement::NewFromBinary(payload.c_str(), payload.size(), position);
+    if (!root)
+    {
+      roots.clear();
+      return false;
+    }
+    roots.push_back(root);
+    root->Delete();
+  }
+  if (position != payload.size())
+  {
+    roots.clear();
+    return false;
+  }
+  return true;
+}
+
+//-------------------------------------------------------------------------
+bool ReadCacheFile(const std::string& filename, std::string& payload)
+{
+  vtksys::ifstream ifs(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!ifs)
+  {
+    return false;
+  }
+  char magic[sizeof(CacheMagic)];
+  char version[4];
+  ifs.read(magic, sizeof(magic));
+  ifs.read(version, sizeof(version));
+  if (!ifs || memcmp(magic, CacheMagic, sizeof(magic)) != 0 || ToUInt32(version) != CacheVersion)
+  {
+    return false;
+  }
+  std::ostringstream contents;
+  contents << ifs.rdbuf();
+  payload = contents.str();
+  return true;
+}
+
+//-------------------------------------------------------------------------
+// Writes to a temporary file renamed once complete, so that processes
+// reading the cache concurrently never see a partial file.
+void WriteCacheFile(const std::string& filename, const std::string& payload)
+{
+  vtksys::SystemTools::MakeDirectory(GetCacheDirectoryInternal());
+  std::ostringstream tmpname;
+  tmpname << filename << "." << std::hex
+          << static_cast<vtkTypeUInt64>(vtkTimerLog::GetUniversalTime() * 1e6) << ".tmp";
+  vtksys::ofstream ofs(tmpname.str().c_str(), std::ios::out | std::ios::binary);
+  std::string version;
+  AppendUInt32(version, CacheVersion);
+  ofs.write(CacheMagic, sizeof(CacheMagic));
+  ofs.write(version.c_str(), static_cast<std::streamsize>(version.size()));
+  ofs.write(payload.c_str(), static_cast<std::streamsize>(payload.size()));
+  ofs.close();
+  if (!ofs || std::rename(tmpname.str().c_str(), filename.c_str()) != 0)
+  {
+    vtksys::SystemTools::RemoveFile(tmpname.str());
+  }
+}
+
+//-------------------------------------------------------------------------
+// Reads the definitions of a plugin from the cache, or parses and caches
+// them. For the core definitions, when broadcasting, only the root process
+// does so and sends them to the other processes.
+void ReadDefinitions(const char* pluginName, const std::vector<std::string>& xmls, bool isCore,
+  std::vector<XMLElement>& roots)
+{
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const bool isRoot = !controller || controller->GetLocalProcessId() == 0;
+  const bool broadcast = isCore && GetBroadcastCoreDefinitionsInternal() && controller &&
+    controller->GetNumberOfProcesses() > 1;
+  const std::string filename =
+    GetCacheDirectoryInternal().empty() ? std::string() : GetCacheFileName(pluginName, xmls);
+
+  vtkTimerLog::MarkStartEvent("vtkSIProxyDefinitionManager Parse XMLs");
+  std::string payload;
+  if (isRoot || !broadcast)
+  {
+    if (filename.empty() || !ReadCacheFile(filename, payload) || !LoadRoots(payload, roots))
+    {
+      payload.clear();
+      const bool parsed = ParseXMLs(xmls, roots);
+      const bool cache = parsed && !filename.empty() && isRoot;
+      if (broadcast || cache)
+      {
+        SaveRoots(roots, payload);
+      }
+      if (cache)
+      {
+        WriteCacheFile(filename, payload);
+      }
+    }
+  }
+
+  if (broadcast)
+  {
+    vtkIdType size = static_cast<vtkIdType>(payload.size());
+    controller->Broadcast(&size, 1, 0);
+    if (!isRoot)
+    {
+      payload.resize(static_cast<size_t>(size));
+    }
+    if (size > 0)
+    {
+      controller->Broadcast(&payload[0], size, 0);
+    }
+    if (!isRoot && !LoadRoots(payload, roots))
+    {
+      ParseXMLs(xmls, roots);
+    }
+  }
+  vtkTimerLog::MarkEndEvent("vtkSIProxyDefinitionManager Parse XMLs");
+}
+}
+
 class vtkSIProxyDefinitionManager::vtkInternals
 {
 public:
@@ -1181,12 +1412,14 @@ void vtkSIProxyDefinitionManager::HandlePlugin(vtkPVPlugin* plugin)
     // Make sure only the SERVER is processing the XML proxy definition
     if (this->Internals->EnableXMLProxyDefinitionUpdate)
     {
-      for (size_t cc = 0; cc < xmls.size(); cc++)
+      // if GetPluginName() == vtkPVInitializerPlugin, it implies that it's
+      // the ParaView core and should not be treated as plugin.
+      bool isCore = strcmp(plugin->GetPluginName(), "vtkPVInitializerPlugin") == 0;
+      std::vector<XMLElement> roots;
+      ReadDefinitions(plugin->GetPluginName(), xmls, isCore, roots);
+      for (size_t cc = 0; cc < roots.size(); cc++)
       {
-        this->LoadConfigurationXMLFromString(xmls[cc].c_str(),
-          // if GetPluginName() == vtkPVInitializerPlugin, it implies that it's
-          // the ParaView core and should not be treated as plugin.
-          strcmp(plugin->GetPluginName(), "vtkPVInitializerPlugin") != 0);
+        this->LoadConfigurationXML(roots[cc], !isCore);
       }
 
       // Make sure we invalidate any cached flatten version of our proxy definition
@@ -1194,6 +1427,31 @@ void vtkSIProxyDefinitionManager::HandlePlugin(vtkPVPlugin* plugin)
     }
   }
 }
+//---------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::SetCacheDirectory(const char* directory)
+{
+  GetCacheDirectoryInternal() = directory ? directory : "";
+}
+
+//---------------------------------------------------------------------------
+const char* vtkSIProxyDefinitionManager::GetCacheDirectory()
+{
+  const std::string& directory = GetCacheDirectoryInternal();
+  return directory.empty() ? NULL : directory.c_str();
+}
+
+//---------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::SetBroadcastCoreDefinitions(bool broadcast)
+{
+  GetBroadcastCoreDefinitionsInternal() = broadcast;
+}
+
+//---------------------------------------------------------------------------
+bool vtkSIProxyDefinitionManager::GetBroadcastCoreDefinitions()
+{
+  return GetBroadcastCoreDefinitionsInternal();
+}
+
 //---------------------------------------------------------------------------
 bool vtkSIProxyDefinitionManager::HasDefinition(const char* groupName, const char* proxyName)
 {
@@ -157,6 +157,34 @@ public:
   bool LoadConfigurationXMLFromString(const char* xmlContent);
   //@}
 
+  //@{
+  /**
+   * Set/Get the directory where the proxy definitions of the core and of
+   * plugins are cached in a binary form once parsed. Loading them from the
+   * cache avoids parsing the XML, which noticeably slows down startup. Cache
+   * files are named after the plugin, the ParaView version and a hash of its
+   * XML, so a file is no longer used once the XML changes. Only the root
+   * process writes the cache. Defaults to the value of the
+   * PV_PROXY_DEFINITIONS_CACHE environment variable; caching is disabled when
+   * NULL. Only affects definitions loaded after the call.
+   */
+  static void SetCacheDirectory(const char* directory);
+  static const char* GetCacheDirectory();
+  //@}
+
+  //@{
+  /**
+   * When true and running with more than one process, only the root process
+   * parses, or reads from the cache, the core proxy definitions and
+   * broadcasts them to the other processes. All processes must then create
+   * their vtkSIProxyDefinitionManager together, as pvserver and pvbatch do.
+   * Defaults to false, or true if the PV_PROXY_DEFINITIONS_BROADCAST
+   * environment variable is set.
+   */
+  static void SetBroadcastCoreDefinitions(bool broadcast);
+  static bool GetBroadcastCoreDefinitions();
+  //@}
+
   enum Events
   {
     ProxyDefinitionsUpdated = 2000,
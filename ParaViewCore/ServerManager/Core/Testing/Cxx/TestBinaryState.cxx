@@ -0,0 +1,157 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestBinaryState.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVXMLElement.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineController.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <vtksys/FStream.hxx>
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+const int NumberOfSpheres = 50;
+
+std::string ReadFile(const std::string& path)
+{
+  vtksys::ifstream ifs(path.c_str(), std::ios::in | std::ios::binary);
+  std::ostringstream contents;
+  contents << ifs.rdbuf();
+  return contents.str();
+}
+
+bool CheckPipeline(vtkSMSessionProxyManager* pxm)
+{
+  for (int cc = 0; cc < NumberOfSpheres; ++cc)
+  {
+    std::ostringstream sphereName, shrinkName;
+    sphereName << "Sphere" << cc;
+    shrinkName << "Shrink" << cc;
+    vtkSMProxy* sphere = pxm->GetProxy("sources", sphereName.str().c_str());
+    vtkSMProxy* shrink = pxm->GetProxy("sources", shrinkName.str().c_str());
+    if (!sphere || !shrink)
+    {
+      cerr << "ERROR: missing " << sphereName.str() << " or " << shrinkName.str() << endl;
+      return false;
+    }
+    if (vtkSMPropertyHelper(sphere, "ThetaResolution").GetAsInt() != 8 + cc ||
+      vtkSMPropertyHelper(shrink, "Input").GetAsProxy() != sphere)
+    {
+      cerr << "ERROR: " << shrinkName.str() << " was not restored correctly." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestBinaryState(int argc, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    cerr << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  const std::string xmlPath = std::string(tempDir) + "/TestBinaryState.pvsm";
+  const std::string binaryPath = std::string(tempDir) + "/TestBinaryState.pvsmb";
+  delete[] tempDir;
+
+  int status = EXIT_SUCCESS;
+  {
+    vtkNew<vtkSMParaViewPipelineController> controller;
+    vtkSmartPointer<vtkSMSession> session = vtkSmartPointer<vtkSMSession>::New();
+    vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+    if (!controller->InitializeSession(session))
+    {
+      return EXIT_FAILURE;
+    }
+
+    for (int cc = 0; cc < NumberOfSpheres; ++cc)
+    {
+      std::ostringstream sphereName, shrinkName;
+      sphereName << "Sphere" << cc;
+      shrinkName << "Shrink" << cc;
+
+      vtkSmartPointer<vtkSMProxy> sphere;
+      sphere.TakeReference(pxm->NewProxy("sources", "SphereSource"));
+      controller->InitializeProxy(sphere);
+      vtkSMPropertyHelper(sphere, "ThetaResolution").Set(8 + cc);
+      sphere->UpdateVTKObjects();
+      controller->RegisterPipelineProxy(sphere, sphereName.str().c_str());
+
+      vtkSmartPointer<vtkSMProxy> shrink;
+      shrink.TakeReference(pxm->NewProxy("filters", "ShrinkFilter"));
+      controller->PreInitializeProxy(shrink);
+      vtkSMPropertyHelper(shrink, "Input").Set(sphere);
+      controller->PostInitializeProxy(shrink);
+      shrink->UpdateVTKObjects();
+      controller->RegisterPipelineProxy(shrink, shrinkName.str().c_str());
+    }
+
+    pxm->SaveXMLState(xmlPath.c_str());
+    pxm->SaveBinaryState(binaryPath.c_str());
+    controller->ResetSession(session);
+
+    const std::string xml = ReadFile(xmlPath);
+    const std::string binary = ReadFile(binaryPath);
+    if (vtkSMSessionProxyManager::IsBinaryState(xml.c_str(), xml.size()) ||
+      !vtkSMSessionProxyManager::IsBinaryState(binary.c_str(), binary.size()))
+    {
+      cerr << "ERROR: binary state files are not told apart from XML ones." << endl;
+      status = EXIT_FAILURE;
+    }
+
+    // A truncated file must be rejected.
+    vtkSmartPointer<vtkPVXMLElement> root;
+    root.TakeReference(
+      vtkSMSessionProxyManager::NewStateFromBinary(binary.c_str(), binary.size() - 1));
+    if (root)
+    {
+      cerr << "ERROR: a truncated binary state was accepted." << endl;
+      status = EXIT_FAILURE;
+    }
+
+    pxm->LoadXMLState(binaryPath.c_str());
+    if (!CheckPipeline(pxm))
+    {
+      cerr << "ERROR: failed to load the binary state." << endl;
+      status = EXIT_FAILURE;
+    }
+    controller->ResetSession(session);
+
+    pxm->LoadXMLState(xmlPath.c_str());
+    if (!CheckPipeline(pxm))
+    {
+      cerr << "ERROR: failed to load the XML state." << endl;
+      status = EXIT_FAILURE;
+    }
+  }
+
+  vtkInitializationHelper::Finalize();
+  return status;
+}
@@ -0,0 +1,142 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestProxyDefinitionCache.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkInitializationHelper.h"
+#include "vtkPVProxyDefinitionIterator.h"
+#include "vtkPVXMLElement.h"
+#include "vtkProcessModule.h"
+#include "vtkSIProxyDefinitionManager.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <vtksys/Directory.hxx>
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <string>
+
+namespace
+{
+// Returns the number of definitions of `manager`, or -1 if any differs from
+// the one of `reference`.
+int CompareDefinitions(vtkSIProxyDefinitionManager* reference, vtkSIProxyDefinitionManager* manager)
+{
+  int count = 0;
+  vtkSmartPointer<vtkPVProxyDefinitionIterator> iter;
+  iter.TakeReference(manager->NewIterator(vtkSIProxyDefinitionManager::CORE_DEFINITIONS));
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkPVXMLElement* definition = reference->GetProxyDefinition(
+      iter->GetGroupName(), iter->GetProxyName(), /*throwError=*/false);
+    if (!definition || !definition->Equals(iter->GetProxyDefinition()))
+    {
+      cerr << "ERROR: definition of (" << iter->GetGroupName() << ", " << iter->GetProxyName()
+           << ") differs." << endl;
+      return -1;
+    }
+    ++count;
+  }
+  return count;
+}
+
+// The binary form and the cache files store their integers in little-endian
+// order whatever the machine, so that caches can be shared.
+bool CheckByteOrder(const std::string& cacheDir)
+{
+  vtkSmartPointer<vtkPVXMLElement> element = vtkSmartPointer<vtkPVXMLElement>::New();
+  element->SetName("ab");
+  std::string buffer;
+  element->SaveBinary(buffer);
+  const char nameLength[5] = { 1, 2, 0, 0, 0 };
+  if (buffer.size() < 5 || buffer.compare(0, 5, nameLength, 5) != 0)
+  {
+    cerr << "ERROR: the binary form is not little-endian." << endl;
+    return false;
+  }
+
+  vtksys::Directory directory;
+  directory.Load(cacheDir);
+  for (unsigned long cc = 0; cc < directory.GetNumberOfFiles(); ++cc)
+  {
+    const std::string name = directory.GetFile(cc);
+    if (vtksys::SystemTools::GetFilenameLastExtension(name) != ".pvdefs")
+    {
+      continue;
+    }
+    vtksys::ifstream ifs((cacheDir + "/" + name).c_str(), std::ios::in | std::ios::binary);
+    char header[12];
+    const char version[4] = { 2, 0, 0, 0 };
+    if (!ifs.read(header, sizeof(header)) || std::string(header + 8, 4) != std::string(version, 4))
+    {
+      cerr << "ERROR: unexpected header in " << name << endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestProxyDefinitionCache(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    cerr << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  std::string cacheDir = tempDir;
+  cacheDir += "/TestProxyDefinitionCache";
+  delete[] tempDir;
+  vtksys::SystemTools::RemoveADirectory(cacheDir);
+
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+  vtkSIProxyDefinitionManager::SetCacheDirectory(NULL);
+  vtkSmartPointer<vtkSIProxyDefinitionManager> reference =
+    vtkSmartPointer<vtkSIProxyDefinitionManager>::New();
+
+  // the first manager writes the cache, the second one reads it.
+  vtkSIProxyDefinitionManager::SetCacheDirectory(cacheDir.c_str());
+  int status = EXIT_SUCCESS;
+  for (int cc = 0; cc < 2 && status == EXIT_SUCCESS; ++cc)
+  {
+    vtkSmartPointer<vtkSIProxyDefinitionManager> manager =
+      vtkSmartPointer<vtkSIProxyDefinitionManager>::New();
+    int count = CompareDefinitions(reference, manager);
+    if (count != CompareDefinitions(manager, reference) || count <= 0)
+    {
+      cerr << "ERROR: definitions loaded " << (cc == 0 ? "before" : "after")
+           << " caching differ." << endl;
+      status = EXIT_FAILURE;
+    }
+
+    vtksys::Directory directory;
+    if (status == EXIT_SUCCESS &&
+      (!directory.Load(cacheDir) || directory.GetNumberOfFiles() < 3))
+    {
+      cerr << "ERROR: no cache file was written in " << cacheDir << endl;
+      status = EXIT_FAILURE;
+    }
+  }
+
+  if (status == EXIT_SUCCESS && !CheckByteOrder(cacheDir))
+  {
+    status = EXIT_FAILURE;
+  }
+
+  vtkSIProxyDefinitionManager::SetCacheDirectory(NULL);
+  reference = NULL;
+  vtkInitializationHelper::Finalize();
+  return status;
+}
@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestStateBatch.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the batches of states sent by transactions are unpacked as
+// packed, and that malformed batches are rejected as a whole.
+
+#include "vtkMultiProcessStream.h"
+#include "vtkPVSessionServer.h"
+
+#include <string>
+#include <vector>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                        \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+std::vector<std::string> GetStates()
+{
+  std::vector<std::string> states;
+  states.push_back("first state");
+  states.push_back("");
+  states.push_back(std::string(1000, 'x') + std::string(3, '\0') + "last state");
+  return states;
+}
+
+bool TestRoundTrip()
+{
+  const std::vector<std::string> states = GetStates();
+  for (int report = 0; report < 2; ++report)
+  {
+    vtkMultiProcessStream stream;
+    vtkPVSessionServer::PackBatch(stream, report != 0, states);
+    bool unpackedReport = report == 0;
+    std::vector<std::string> unpacked;
+    TASSERT(vtkPVSessionServer::UnpackBatch(stream, unpackedReport, unpacked));
+    TASSERT(unpackedReport == (report != 0));
+    TASSERT(unpacked == states);
+    TASSERT(stream.Empty());
+  }
+
+  vtkMultiProcessStream empty;
+  vtkPVSessionServer::PackBatch(empty, true, std::vector<std::string>());
+  bool report = false;
+  std::vector<std::string> unpacked(1);
+  TASSERT(vtkPVSessionServer::UnpackBatch(empty, report, unpacked));
+  TASSERT(report && unpacked.empty());
+  return true;
+}
+
+// Unpacks `stream`, which must be rejected while still telling whether to
+// report the errors.
+bool IsRejected(vtkMultiProcessStream& stream, bool expectedReport)
+{
+  bool report = !expectedReport;
+  std::vector<std::string> states(1, "stale");
+  TASSERT(!vtkPVSessionServer::UnpackBatch(stream, report, states));
+  TASSERT(states.empty());
+  TASSERT(report == expectedReport);
+  return true;
+}
+
+bool TestMalformed()
+{
+  // no data at all.
+  vtkMultiProcessStream empty;
+  bool report = false;
+  std::vector<std::string> states;
+  TASSERT(!vtkPVSessionServer::UnpackBatch(empty, report, states));
+
+  // truncated after the sizes of the states.
+  vtkMultiProcessStream truncated;
+  truncated << 1 << 3u << 10u << 20u << 30u;
+  TASSERT(IsRejected(truncated, true));
+
+  // fewer sizes than states.
+  vtkMultiProcessStream missingSizes;
+  missingSizes << 1 << 1000u << 10u;
+  TASSERT(IsRejected(missingSizes, true));
+
+  // the sizes of the states do not add up to the size of the batch.
+  const std::vector<std::string> valid = GetStates();
+  vtkMultiProcessStream packed;
+  vtkPVSessionServer::PackBatch(packed, false, valid);
+  int flag;
+  unsigned int count, size;
+  std::vector<unsigned int> lengths(valid.size());
+  std::string compressed;
+  packed >> flag >> count;
+  for (size_t cc = 0; cc < lengths.size(); ++cc)
+  {
+    packed >> lengths[cc];
+  }
+  packed >> size >> compressed;
+  vtkMultiProcessStream badSizes;
+  badSizes << flag << count << lengths[0] + 1;
+  for (size_t cc = 1; cc < lengths.size(); ++cc)
+  {
+    badSizes << lengths[cc];
+  }
+  badSizes << size << compressed;
+  TASSERT(IsRejected(badSizes, false));
+
+  // trailing data after the batch.
+  vtkMultiProcessStream trailing;
+  vtkPVSessionServer::PackBatch(trailing, true, valid);
+  trailing << 0;
+  TASSERT(IsRejected(trailing, true));
+  return true;
+}
+}
+
+int TestStateBatch(int, char* [])
+{
+  if (!TestRoundTrip() || !TestMalformed())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,77 @@
+"""
+    This test sends several information requests to a server without waiting
+    for them, then waits for them in the reverse order and checks that each
+    information object received the reply to its own request.
+"""
+
+from paraview import servermanager
+import paraview.simple as smp
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+def getHost(url):
+   return url.split(':')[1][2:]
+
+def getPort(url):
+   return int(url.split(':')[2])
+
+def checkInformation(info, radius, resolution):
+    # vtkSphereSource generates resolution * (PhiResolution - 2) + 2 points,
+    # the poles being exactly at the radius.
+    numberOfPoints = resolution * (8 - 2) + 2
+    assert info.GetNumberOfPoints() == numberOfPoints, \
+        "%d points instead of %d" % (info.GetNumberOfPoints(), numberOfPoints)
+    assert abs(info.GetBounds()[5] - radius) < 1e-6, \
+        "bounds %s for a radius of %g" % (str(info.GetBounds()), radius)
+
+options = servermanager.vtkProcessModule.GetProcessModule().GetOptions()
+url = options.GetServerURL()
+connection = smp.Connect(getHost(url), getPort(url))
+session = connection.Session
+pxm = session.GetSessionProxyManager()
+
+radii = [1.0, 2.0, 3.0, 4.0]
+resolutions = [4, 8, 12, 16]
+spheres = []
+for radius, resolution in zip(radii, resolutions):
+    # as in servermanager.ProxyManager.NewProxy().
+    sphere = pxm.NewProxy("sources", "SphereSource")
+    sphere.UnRegister(None)
+    sphere.GetProperty("Radius").SetElement(0, radius)
+    sphere.GetProperty("ThetaResolution").SetElement(0, resolution)
+    sphere.GetProperty("PhiResolution").SetElement(0, 8)
+    sphere.UpdateVTKObjects()
+    sphere.UpdatePipeline()
+    spheres.append(sphere)
+
+# all the requests are sent before any reply is processed.
+infos = []
+requests = []
+for sphere in spheres:
+    info = servermanager.vtkPVDataInformation()
+    info.SetPortNumber(0)
+    requests.append(sphere.GatherInformationAsync(info))
+    infos.append(info)
+assert 0 not in requests
+assert len(set(requests)) == len(requests), "request identifiers are not unique"
+
+for index in reversed(range(len(spheres))):
+    assert session.WaitForRequest(requests[index])
+    assert session.IsRequestComplete(requests[index])
+    checkInformation(infos[index], radii[index], resolutions[index])
+assert not session.HasPendingRequests()
+
+# the data information of the output ports goes through the same path, the
+# requests of all the sources being in flight at once.
+for sphere, radius in zip(spheres, radii):
+    sphere.GetProperty("Radius").SetElement(0, 2 * radius)
+    sphere.UpdateVTKObjects()
+    sphere.UpdatePipeline()
+    sphere.GatherDataInformationAsync()
+for index in reversed(range(len(spheres))):
+    checkInformation(spheres[index].GetDataInformation(0), 2 * radii[index],
+        resolutions[index])
+assert not session.HasPendingRequests()
+
+smp.Disconnect()
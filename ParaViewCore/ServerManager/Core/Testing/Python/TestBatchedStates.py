@@ -0,0 +1,76 @@
+"""
+    This test pushes states to a server within a transaction, one of them
+    failing, and checks that they are executed in order and that the error
+    is reported when the transaction ends.
+"""
+
+from paraview import servermanager
+import paraview.simple as smp
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+def getHost(url):
+   return url.split(':')[1][2:]
+
+def getPort(url):
+   return int(url.split(':')[2])
+
+# A sphere with a property invoking a method vtkSphereSource does not have,
+# hence failing on the server.
+brokenSourceXML = """
+<ServerManagerConfiguration>
+  <ProxyGroup name="sources">
+    <SourceProxy name="BatchedStatesBrokenSource" class="vtkSphereSource">
+      <IntVectorProperty name="Broken" command="NoSuchMethod"
+        number_of_elements="1" default_values="1" />
+    </SourceProxy>
+  </ProxyGroup>
+</ServerManagerConfiguration>
+"""
+
+def setRadius(sphere, radius):
+    sphere.GetProperty("Radius").SetElement(0, radius)
+    sphere.UpdateVTKObjects()
+
+def getRadius(sphere):
+    # the poles of the sphere are exactly at the radius.
+    sphere.UpdatePipeline()
+    return sphere.GetDataInformation().GetBounds()[5]
+
+options = servermanager.vtkProcessModule.GetProcessModule().GetOptions()
+url = options.GetServerURL()
+connection = smp.Connect(getHost(url), getPort(url))
+session = connection.Session
+pxm = session.GetSessionProxyManager()
+pxm.LoadConfigurationXML(brokenSourceXML)
+
+# as in servermanager.ProxyManager.NewProxy().
+sphere = pxm.NewProxy("sources", "SphereSource")
+sphere.UnRegister(None)
+broken = pxm.NewProxy("sources", "BatchedStatesBrokenSource")
+broken.UnRegister(None)
+
+session.BeginTransaction()
+assert session.GetInTransaction()
+setRadius(sphere, 1)
+setRadius(sphere, 2)
+# requests sent within the transaction see the states pushed before them.
+assert abs(getRadius(sphere) - 2) < 1e-6
+broken.UpdateVTKObjects()
+setRadius(sphere, 3)
+setRadius(sphere, 4)
+numberOfErrors = session.EndTransaction()
+assert not session.GetInTransaction()
+assert numberOfErrors == 1, "%d errors reported instead of 1" % numberOfErrors
+
+# the states pushed after the failing one were executed, the last one last.
+assert abs(getRadius(sphere) - 4) < 1e-6
+
+# errors are only reported once.
+session.BeginTransaction()
+setRadius(sphere, 5)
+assert session.EndTransaction() == 0
+assert abs(getRadius(sphere) - 5) < 1e-6
+
+smp.Disconnect()
@@ -21,6 +21,7 @@ vtk_module(vtkPVServerManagerCore
     PARAVIEW
   TEST_DEPENDS
     vtkPVServerManagerApplication
+    vtkTestingCore
   KIT
     vtkPVServerManager
 
@@ -22,6 +22,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPVClassNameInformation.h"
 #include "vtkPVDataInformation.h"
+#include "vtkPVSession.h"
 #include "vtkPVTemporalDataInformation.h"
 #include "vtkPVXMLElement.h"
 #include "vtkProcessModule.h"
@@ -43,6 +44,8 @@ vtkSMOutputPort::vtkSMOutputPort()
   this->TemporalDataInformation = vtkPVTemporalDataInformation::New();
   this->ClassNameInformationValid = 0;
   this->DataInformationValid = false;
+  this->DataInformationRequest = 0;
+  this->DataInformationRequestValid = false;
   this->TemporalDataInformationValid = false;
   this->PortIndex = 0;
   this->SourceProxy = 0;
@@ -103,25 +106,66 @@ const char* vtkSMOutputPort::GetDataClassName()
 void vtkSMOutputPort::InvalidateDataInformation()
 {
   this->DataInformationValid = false;
+  // The reply to a request already sent is out-of-date, but still fills
+  // DataInformation, see GatherDataInformationAsync().
+  this->DataInformationRequestValid = false;
   this->ClassNameInformationValid = false;
   this->TemporalDataInformationValid = false;
 }
 
 //----------------------------------------------------------------------------
-void vtkSMOutputPort::GatherDataInformation()
+vtkTypeUInt32 vtkSMOutputPort::GatherDataInformationAsync()
 {
+  if (this->DataInformationValid ||
+    (this->DataInformationRequest != 0 && this->DataInformationRequestValid))
+  {
+    return 0;
+  }
   if (!this->SourceProxy)
   {
     vtkErrorMacro("Invalid vtkSMOutputPort.");
-    return;
+    return 0;
   }
 
-  this->SourceProxy->GetSession()->PrepareProgress();
+  // Replies are received in order, wait for the out-of-date one so that it
+  // does not overwrite the information this request is about to gather.
+  if (this->DataInformationRequest != 0)
+  {
+    this->SourceProxy->GetSession()->WaitForRequest(this->DataInformationRequest);
+  }
+  if ((this->SourceProxy->GetLocation() & vtkPVSession::CLIENT) == 0)
+  {
+    // The information comes from a remote process; only blocks that changed
+    // since the last gather will be sent, the others are patched in from the
+    // current information.
+    this->DataInformation->PrepareForIncrementalGather();
+  }
   this->DataInformation->Initialize();
   this->DataInformation->SetPortNumber(this->PortIndex);
-  this->SourceProxy->GatherInformation(this->DataInformation);
+  this->DataInformationRequest = this->SourceProxy->GatherInformationAsync(this->DataInformation);
+  this->DataInformationRequestValid = true;
+  return this->DataInformationRequest;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMOutputPort::GatherDataInformation()
+{
+  if (!this->SourceProxy)
+  {
+    vtkErrorMacro("Invalid vtkSMOutputPort.");
+    return;
+  }
+
+  vtkSMSession* session = this->SourceProxy->GetSession();
+  session->PrepareProgress();
+  this->GatherDataInformationAsync();
+  if (this->DataInformationRequest != 0)
+  {
+    session->WaitForRequest(this->DataInformationRequest);
+    this->DataInformationRequest = 0;
+  }
   this->DataInformationValid = true;
-  this->SourceProxy->GetSession()->CleanupPendingProgress();
+  session->CleanupPendingProgress();
 }
 
 //----------------------------------------------------------------------------
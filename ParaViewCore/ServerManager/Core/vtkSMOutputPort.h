@@ -78,6 +78,16 @@ public:
    */
   virtual void InvalidateDataInformation();
 
+  /**
+   * Sends a request for the data information, if it is invalid, without
+   * waiting for the reply (see vtkSMSession::GatherInformationAsync()), so
+   * that the data information of several ports can be gathered at once. The
+   * next GetDataInformation() waits for the reply. Returns the identifier of
+   * the request, or 0 if none was sent because the data information is valid
+   * or already requested.
+   */
+  virtual vtkTypeUInt32 GatherDataInformationAsync();
+
   //@{
   /**
    * Returns the index of the port the output is obtained from.
@@ -100,7 +110,8 @@ protected:
   virtual void GatherClassNameInformation();
 
   /**
-   * Get information about dataset from server.
+   * Get information about dataset from server, waiting for the reply to
+   * GatherDataInformationAsync().
    * Fires the vtkCommand::UpdateInformationEvent event.
    */
   virtual void GatherDataInformation();
@@ -135,6 +146,11 @@ protected:
   vtkPVDataInformation* DataInformation;
   bool DataInformationValid;
 
+  // The request filling DataInformation that was not waited for yet, if any,
+  // and whether it was sent since the data information was last invalidated.
+  vtkTypeUInt32 DataInformationRequest;
+  bool DataInformationRequestValid;
+
   vtkPVTemporalDataInformation* TemporalDataInformation;
   bool TemporalDataInformationValid;
 
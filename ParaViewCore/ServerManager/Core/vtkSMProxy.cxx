@@ -821,6 +821,21 @@ bool vtkSMProxy::GatherInformation(vtkPVInformation* information)
   return false;
 }
 
+//---------------------------------------------------------------------------
+vtkTypeUInt32 vtkSMProxy::GatherInformationAsync(vtkPVInformation* information)
+{
+  assert(information);
+  if (this->GetSession() && this->Location != 0)
+  {
+    // ensure that the proxy is created.
+    this->CreateVTKObjects();
+
+    return this->GetSession()->GatherInformationAsync(
+      this->Location, information, this->GetGlobalID());
+  }
+  return 0;
+}
+
 //---------------------------------------------------------------------------
 bool vtkSMProxy::GatherInformation(vtkPVInformation* information, vtkTypeUInt32 location)
 {
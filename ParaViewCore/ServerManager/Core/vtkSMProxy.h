@@ -488,6 +488,13 @@ public:
   bool GatherInformation(vtkPVInformation* information, vtkTypeUInt32 location);
   //@}
 
+  /**
+   * Same as GatherInformation() except that it returns without waiting for
+   * the reply, see vtkSMSession::GatherInformationAsync(). Returns the
+   * identifier of the request, or 0 if the proxy has no session.
+   */
+  vtkTypeUInt32 GatherInformationAsync(vtkPVInformation* information);
+
   /**
    * Saves the state of the proxy. This state can be reloaded
    * to create a new proxy that is identical the present state of this proxy.
@@ -72,6 +72,8 @@ vtkSMSession::vtkSMSession(
   this->SessionProxyManager = NULL;
   this->StateLocator = vtkSMStateLocator::New();
   this->IsAutoMPI = false;
+  this->TransactionDepth = 0;
+  this->LastRequestId = 0;
 
   // Create and setup deserializer for the local ProxyLocator
   vtkNew<vtkSMDeserializerProtobuf> deserializer;
@@ -131,6 +133,49 @@ void vtkSMSession::PushState(vtkSMMessage* msg)
   this->Superclass::PushState(msg);
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSession::BeginTransaction()
+{
+  ++this->TransactionDepth;
+}
+
+//----------------------------------------------------------------------------
+int vtkSMSession::EndTransaction()
+{
+  if (this->TransactionDepth == 0)
+  {
+    vtkErrorMacro("EndTransaction() called without a matching BeginTransaction().");
+    return 0;
+  }
+  if (--this->TransactionDepth > 0)
+  {
+    return 0;
+  }
+  return this->FlushTransaction();
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt32 vtkSMSession::GatherInformationAsync(
+  vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid)
+{
+  vtkTypeUInt32 requestId = this->GetNextRequestId();
+  this->InvokeEvent(vtkSMSession::RequestSentEvent, &requestId);
+  this->GatherInformation(location, information, globalid);
+  this->InvokeEvent(vtkSMSession::RequestCompletedEvent, &requestId);
+  return requestId;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt32 vtkSMSession::GetNextRequestId()
+{
+  // 0 is never used so that it can stand for "no request".
+  if (++this->LastRequestId == 0)
+  {
+    ++this->LastRequestId;
+  }
+  return this->LastRequestId;
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSession::UpdateStateHistory(vtkSMMessage* msg)
 {
@@ -239,6 +284,7 @@ bool vtkSMSession::IsMPIInitialized(vtkTypeUInt32)
 void vtkSMSession::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "TransactionDepth: " << this->TransactionDepth << endl;
 }
 
 //----------------------------------------------------------------------------
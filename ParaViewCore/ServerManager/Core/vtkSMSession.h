@@ -162,6 +162,84 @@ public:
   // Called before application quit or session disconnection
   virtual void PreDisconnection() {}
 
+  //---------------------------------------------------------------------------
+  // API for batching state pushes.
+  //---------------------------------------------------------------------------
+
+  /**
+   * Starts a transaction. Until the matching EndTransaction(), the states
+   * pushed to the server(s), e.g. by vtkSMProxy::UpdateVTKObjects(), are
+   * queued and then sent as a single compressed message, which the server(s)
+   * execute in order. Any other request to the server(s), e.g.
+   * GatherInformation(), first sends the queued states so that requests are
+   * still executed in order. Transactions can be nested, in which case the
+   * states are sent when the outermost one ends. Builtin sessions execute
+   * states immediately, hence are not affected.
+   */
+  void BeginTransaction();
+
+  /**
+   * Ends a transaction started with BeginTransaction(). When ending the
+   * outermost transaction, sends the queued states and returns the number of
+   * errors the server(s) reported while executing the states pushed during
+   * the transaction. Returns 0 otherwise.
+   */
+  int EndTransaction();
+
+  /**
+   * Returns true between BeginTransaction() and the matching
+   * EndTransaction().
+   */
+  bool GetInTransaction() { return this->TransactionDepth > 0; }
+
+  //---------------------------------------------------------------------------
+  // API for asynchronous requests.
+  //---------------------------------------------------------------------------
+
+  /**
+   * Events fired by GatherInformationAsync() when a request is sent and when
+   * its reply has been received. The call data is a pointer to the
+   * vtkTypeUInt32 identifying the request.
+   */
+  enum RequestEventIds
+  {
+    RequestSentEvent = 5678,
+    RequestCompletedEvent = 5679
+  };
+
+  /**
+   * Same as GatherInformation() except that it returns without waiting for
+   * the server(s) to reply. Several requests can thus be in flight at once,
+   * e.g. to gather the data information of several ports, and the server(s)
+   * process them in order along with the other requests. Returns a non-zero
+   * identifier for the request. The session keeps a reference to
+   * `information` until the reply has been received and copied into it, at
+   * which point RequestCompletedEvent is fired. Replies are received by
+   * WaitForRequest() or, in the GUI, from the event loop. The implementation
+   * provided gathers the information immediately, as builtin sessions do.
+   */
+  virtual vtkTypeUInt32 GatherInformationAsync(
+    vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid);
+
+  /**
+   * Returns true when the request with the given identifier is complete,
+   * i.e. no longer waiting for a reply.
+   */
+  virtual bool IsRequestComplete(vtkTypeUInt32 vtkNotUsed(requestId)) { return true; }
+
+  /**
+   * Returns true when requests are waiting for a reply.
+   */
+  virtual bool HasPendingRequests() { return false; }
+
+  /**
+   * Blocks until the request with the given identifier is complete,
+   * processing the replies to the other requests, and server notifications,
+   * as they arrive. Returns false if the server(s) failed to gather the
+   * information.
+   */
+  virtual bool WaitForRequest(vtkTypeUInt32 vtkNotUsed(requestId)) { return true; }
+
   //---------------------------------------------------------------------------
   // Static methods to create and register sessions easily.
   //---------------------------------------------------------------------------
@@ -281,6 +359,23 @@ protected:
    */
   void UpdateStateHistory(vtkSMMessage* msg);
 
+  /**
+   * Called when the outermost transaction ends to send the states it queued.
+   * Returns the number of errors the server(s) reported while executing the
+   * states of the transaction. The implementation provided does nothing as
+   * states are executed immediately.
+   */
+  virtual int FlushTransaction() { return 0; }
+
+  int TransactionDepth;
+
+  /**
+   * Returns the identifier to use for a new asynchronous request.
+   */
+  vtkTypeUInt32 GetNextRequestId();
+
+  vtkTypeUInt32 LastRequestId;
+
   vtkSMSessionProxyManager* SessionProxyManager;
   vtkSMStateLocator* StateLocator;
   vtkSMProxyLocator* ProxyLocator;
@@ -22,6 +22,7 @@
 #include "vtkNetworkAccessManager.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVClientServerStreamTransfer.h"
 #include "vtkPVConfig.h"
 #include "vtkPVMultiClientsInformation.h"
 #include "vtkPVOptions.h"
@@ -60,6 +61,13 @@ void RMICallback(
   vtkSMSessionClient* self = reinterpret_cast<vtkSMSessionClient*>(localArg);
   self->OnServerNotificationMessageRMI(remoteArg, remoteArgLength);
 }
+
+void GatherInformationReplyRMICallback(
+  void* localArg, void* remoteArg, int remoteArgLength, int vtkNotUsed(remoteProcessId))
+{
+  vtkSMSessionClient* self = reinterpret_cast<vtkSMSessionClient*>(localArg);
+  self->OnGatherInformationReplyRMI(remoteArg, remoteArgLength);
+}
 };
 //****************************************************************************/
 vtkStandardNewMacro(vtkSMSessionClient);
@@ -92,6 +100,7 @@ vtkSMSessionClient::vtkSMSessionClient()
   // Default value
   this->NoMoreDelete = false;
   this->NotBusy = 0;
+  this->PendingReport[0] = this->PendingReport[1] = false;
 }
 
 //----------------------------------------------------------------------------
@@ -101,6 +110,13 @@ vtkSMSessionClient::~vtkSMSessionClient()
   {
     this->DataServerController->RemoveAllRMICallbacks(
       vtkPVSessionServer::SERVER_NOTIFICATION_MESSAGE_RMI);
+    this->DataServerController->RemoveAllRMICallbacks(
+      vtkPVSessionServer::REPLY_GATHER_INFORMATION_RMI);
+  }
+  if (this->RenderServerController)
+  {
+    this->RenderServerController->RemoveAllRMICallbacks(
+      vtkPVSessionServer::REPLY_GATHER_INFORMATION_RMI);
   }
   if (this->GetIsAlive())
   {
@@ -272,6 +288,8 @@ bool vtkSMSessionClient::Connect(const char* url, int timeout)
       vtkCommand::ErrorEvent, this, &vtkSMSessionClient::OnConnectionLost);
     dcontroller->AddRMICallback(
       &RMICallback, this, vtkPVSessionServer::SERVER_NOTIFICATION_MESSAGE_RMI);
+    dcontroller->AddRMICallback(&GatherInformationReplyRMICallback, this,
+      vtkPVSessionServer::REPLY_GATHER_INFORMATION_RMI);
     dcontroller->Delete();
   }
   if (rcontroller)
@@ -281,6 +299,8 @@ bool vtkSMSessionClient::Connect(const char* url, int timeout)
       vtkCommand::WrongTagEvent, this, &vtkSMSessionClient::OnWrongTagEvent);
     rcontroller->GetCommunicator()->AddObserver(
       vtkCommand::ErrorEvent, this, &vtkSMSessionClient::OnConnectionLost);
+    rcontroller->AddRMICallback(&GatherInformationReplyRMICallback, this,
+      vtkPVSessionServer::REPLY_GATHER_INFORMATION_RMI);
     rcontroller->Delete();
   }
 
@@ -447,6 +467,7 @@ bool vtkSMSessionClient::IsMPIInitialized(vtkTypeUInt32 servers)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::CloseSession()
 {
+  this->SendQueuedStates();
   if (this->DataServerController)
   {
     this->DataServerController->TriggerRMIOnAllChildren(vtkPVSessionServer::CLOSE_SESSION);
@@ -512,15 +533,10 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
   }
   if (num_controllers > 0)
   {
-    vtkMultiProcessStream stream;
-    stream << static_cast<int>(vtkPVSessionServer::PUSH);
-    stream << message->SerializeAsString();
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
+    const std::string state = message->SerializeAsString();
     for (int cc = 0; cc < num_controllers; cc++)
     {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+      this->SendState(controllers[cc], state);
     }
   }
 
@@ -552,13 +568,7 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
         msg.set_share_only(true);
         msg.set_client_id(this->ServerInformation->GetClientId());
 
-        vtkMultiProcessStream stream;
-        stream << static_cast<int>(vtkPVSessionServer::PUSH);
-        stream << msg.SerializeAsString();
-        std::vector<unsigned char> raw_message;
-        stream.GetRawData(raw_message);
-        this->DataServerController->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+        this->SendState(this->DataServerController, msg.SerializeAsString());
       }
       else if (!remoteObject)
       {
@@ -580,9 +590,98 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::SendState(vtkMultiProcessController* controller, const std::string& state)
+{
+  if (this->TransactionDepth > 0)
+  {
+    this->QueuedStates[controller == this->DataServerController ? 0 : 1].push_back(state);
+    return;
+  }
+
+  vtkMultiProcessStream stream;
+  stream << static_cast<int>(vtkPVSessionServer::PUSH);
+  stream << state;
+  std::vector<unsigned char> raw_message;
+  stream.GetRawData(raw_message);
+  controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
+    vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::SendQueuedStates()
+{
+  for (int cc = 0; cc < 2; cc++)
+  {
+    if (!this->QueuedStates[cc].empty())
+    {
+      this->SendBatch(cc, false);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkSMSessionClient::FlushTransaction()
+{
+  int numberOfErrors = 0;
+  for (int cc = 0; cc < 2; cc++)
+  {
+    if (!this->QueuedStates[cc].empty() || this->PendingReport[cc])
+    {
+      numberOfErrors += this->SendBatch(cc, true);
+    }
+  }
+  return numberOfErrors;
+}
+
+//----------------------------------------------------------------------------
+int vtkSMSessionClient::SendBatch(int server, bool report)
+{
+  vtkMultiProcessController* controller =
+    server == 0 ? this->DataServerController : this->RenderServerController;
+  std::vector<std::string> states;
+  states.swap(this->QueuedStates[server]);
+  this->PendingReport[server] = !report && controller != NULL;
+  if (!controller)
+  {
+    return 0;
+  }
+
+  vtkMultiProcessStream stream;
+  stream << static_cast<int>(vtkPVSessionServer::PUSH_BATCH);
+  vtkPVSessionServer::PackBatch(stream, report, states);
+  std::vector<unsigned char> raw_message;
+  stream.GetRawData(raw_message);
+
+  if (!report)
+  {
+    controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
+      vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+    return 0;
+  }
+
+  this->StartBusyWork();
+  controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
+    vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+  vtkMultiProcessStream reply;
+  controller->Receive(reply, 1, vtkPVSessionServer::REPLY_PUSH_BATCH);
+  this->EndBusyWork();
+
+  int numberOfErrors = 0;
+  std::string errors;
+  reply >> numberOfErrors >> errors;
+  if (numberOfErrors > 0)
+  {
+    vtkErrorMacro(<< numberOfErrors << " error(s) while pushing the states of a transaction:\n"
+                  << errors);
+  }
+  return numberOfErrors;
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PullState(vtkSMMessage* message)
 {
+  this->SendQueuedStates();
   this->StartBusyWork();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
@@ -639,6 +738,7 @@ void vtkSMSessionClient::ExecuteStream(
     return;
   }
 
+  this->SendQueuedStates();
   location = this->GetRealLocation(location);
 
   vtkMultiProcessController* controllers[2] = { NULL, NULL };
@@ -654,13 +754,9 @@ void vtkSMSessionClient::ExecuteStream(
 
   if (num_controllers > 0)
   {
-    const unsigned char* data;
-    size_t size;
-    cssstream.GetData(&data, &size);
-
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::EXECUTE_STREAM)
-           << static_cast<int>(ignore_errors) << static_cast<int>(size);
+           << static_cast<int>(ignore_errors);
     std::vector<unsigned char> raw_message;
     stream.GetRawData(raw_message);
 
@@ -668,8 +764,10 @@ void vtkSMSessionClient::ExecuteStream(
     {
       controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
         static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
-      controllers[cc]->Send(
-        data, static_cast<int>(size), 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+      // Arrays referenced by the stream are sent directly from their own
+      // memory, without flattening the stream first.
+      vtkPVClientServerStreamTransfer::Send(
+        cssstream, controllers[cc], 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
     }
   }
 
@@ -682,6 +780,7 @@ void vtkSMSessionClient::ExecuteStream(
 //----------------------------------------------------------------------------
 const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 location)
 {
+  this->SendQueuedStates();
   this->StartBusyWork();
   location = this->GetRealLocation(location);
 
@@ -730,6 +829,7 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
 bool vtkSMSessionClient::GatherInformation(
   vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid)
 {
+  this->SendQueuedStates();
   this->StartBusyWork();
   if (this->RenderServerController == NULL)
   {
@@ -821,6 +921,139 @@ bool vtkSMSessionClient::GatherInformation(
   return false;
 }
 
+//----------------------------------------------------------------------------
+vtkTypeUInt32 vtkSMSessionClient::GatherInformationAsync(
+  vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid)
+{
+  this->SendQueuedStates();
+  location = this->GetRealLocation(location);
+  vtkTypeUInt32 requestId = this->GetNextRequestId();
+  this->InvokeEvent(vtkSMSession::RequestSentEvent, &requestId);
+
+  bool add_local_info = false;
+  if ((location & vtkPVSession::CLIENT) != 0)
+  {
+    this->Superclass::GatherInformation(location, information, globalid);
+    add_local_info = !information->GetRootOnly();
+  }
+
+  vtkMultiProcessController* controller = NULL;
+  if ((location & (vtkPVSession::DATA_SERVER | vtkPVSession::DATA_SERVER_ROOT)) != 0)
+  {
+    controller = this->DataServerController;
+  }
+  else if ((location & (vtkPVSession::RENDER_SERVER | vtkPVSession::RENDER_SERVER_ROOT)) != 0)
+  {
+    controller = this->RenderServerController;
+  }
+  if (controller == NULL || ((location & vtkPVSession::CLIENT) != 0 && !add_local_info))
+  {
+    this->InvokeEvent(vtkSMSession::RequestCompletedEvent, &requestId);
+    return requestId;
+  }
+
+  vtkMultiProcessStream stream;
+  stream << static_cast<int>(vtkPVSessionServer::GATHER_INFORMATION_ASYNC) << requestId
+         << location << information->GetClassName() << globalid;
+  information->CopyParametersToStream(stream);
+  std::vector<unsigned char> raw_message;
+  stream.GetRawData(raw_message);
+
+  PendingRequest& request = this->PendingRequests[requestId];
+  request.Information = information;
+  request.Controller = controller;
+  request.AddInformation = add_local_info;
+  controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
+    vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+  return requestId;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMSessionClient::IsRequestComplete(vtkTypeUInt32 requestId)
+{
+  return this->PendingRequests.find(requestId) == this->PendingRequests.end();
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMSessionClient::WaitForRequest(vtkTypeUInt32 requestId)
+{
+  std::map<vtkTypeUInt32, PendingRequest>::iterator iter = this->PendingRequests.find(requestId);
+  if (iter != this->PendingRequests.end())
+  {
+    this->SendQueuedStates();
+    vtkMultiProcessController* controller = iter->second.Controller;
+    while (!this->IsRequestComplete(requestId))
+    {
+      // Dispatches one RMI, which may be the reply to another request or a
+      // server notification.
+      if (controller->ProcessRMIs(1, 1) != vtkMultiProcessController::RMI_NO_ERROR)
+      {
+        vtkErrorMacro("Failed to receive the reply to request " << requestId << ".");
+        this->PendingRequests.erase(requestId);
+        return false;
+      }
+    }
+  }
+  return this->FailedRequests.erase(requestId) == 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::ProcessPendingRequests()
+{
+  vtkNetworkAccessManager* nam = vtkProcessModule::GetProcessModule()->GetNetworkAccessManager();
+  while (this->HasPendingRequests() && nam->ProcessEvents(1) == 1)
+  {
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::OnGatherInformationReplyRMI(void* message, int message_length)
+{
+  // See vtkPVSessionServer::GatherInformationAsyncInternal() for the layout.
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(message);
+  if (message_length < 4)
+  {
+    vtkErrorMacro("Invalid reply to an asynchronous request.");
+    return;
+  }
+  vtkTypeUInt32 requestId = 0;
+  for (int cc = 0; cc < 4; cc++)
+  {
+    requestId |= static_cast<vtkTypeUInt32>(data[cc]) << (8 * cc);
+  }
+  std::map<vtkTypeUInt32, PendingRequest>::iterator iter = this->PendingRequests.find(requestId);
+  if (iter == this->PendingRequests.end())
+  {
+    vtkErrorMacro("Received the reply to unknown request " << requestId << ".");
+    return;
+  }
+  PendingRequest request = iter->second;
+  this->PendingRequests.erase(iter);
+
+  if (message_length == 4)
+  {
+    vtkErrorMacro("Server failed to gather information.");
+    this->FailedRequests.insert(requestId);
+  }
+  else
+  {
+    vtkClientServerStream csstream;
+    csstream.SetData(data + 4, message_length - 4);
+    if (request.AddInformation)
+    {
+      vtkPVInformation* tempInfo = request.Information->NewInstance();
+      tempInfo->CopyFromStream(&csstream);
+      request.Information->AddInformation(tempInfo);
+      tempInfo->Delete();
+    }
+    else
+    {
+      request.Information->CopyFromStream(&csstream);
+    }
+  }
+  this->InvokeEvent(vtkSMSession::RequestCompletedEvent, &requestId);
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
 {
@@ -829,6 +1062,7 @@ void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
     return;
   }
 
+  this->SendQueuedStates();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
@@ -870,6 +1104,7 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
     return;
   }
 
+  this->SendQueuedStates();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
@@ -961,7 +1196,7 @@ void vtkSMSessionClient::OnServerNotificationMessageRMI(void* message, int messa
 }
 //-----------------------------------------------------------------------------
 bool vtkSMSessionClient::OnWrongTagEvent(
-  vtkObject* vtkNotUsed(obj), unsigned long vtkNotUsed(event), void* calldata)
+  vtkObject* obj, unsigned long vtkNotUsed(event), void* calldata)
 {
   int tag = -1;
   const char* data = reinterpret_cast<const char*>(calldata);
@@ -971,8 +1206,9 @@ bool vtkSMSessionClient::OnWrongTagEvent(
   // Just buffer RMI_TAG's
   if (tag == vtkMultiProcessController::RMI_TAG || tag == vtkMultiProcessController::RMI_ARG_TAG)
   {
-    vtkSocketCommunicator::SafeDownCast(this->DataServerController->GetCommunicator())
-      ->BufferCurrentMessage();
+    // Buffer them on the communicator that received them, which may be the
+    // render-server one for replies to asynchronous requests.
+    vtkSocketCommunicator::SafeDownCast(obj)->BufferCurrentMessage();
   }
   else
   {
@@ -988,6 +1224,13 @@ bool vtkSMSessionClient::OnWrongTagEvent(
 void vtkSMSessionClient::OnConnectionLost(
   vtkObject* vtkNotUsed(src), unsigned long vtkNotUsed(event), void* vtkNotUsed(calldata))
 {
+  // Replies to pending requests will never arrive.
+  std::map<vtkTypeUInt32, PendingRequest>::iterator iter;
+  for (iter = this->PendingRequests.begin(); iter != this->PendingRequests.end(); ++iter)
+  {
+    this->FailedRequests.insert(iter->first);
+  }
+  this->PendingRequests.clear();
   this->InvokeEvent(vtkPVSessionBase::ConnectionLost,
     (void*)"The server had died, please look at the server side for more details.");
 }
@@ -25,6 +25,12 @@
 
 #include "vtkPVServerManagerCoreModule.h" //needed for exports
 #include "vtkSMSession.h"
+#include "vtkSmartPointer.h" // for vtkSmartPointer
+
+#include <map>    // for std::map
+#include <set>    // for std::set
+#include <string> // for std::string
+#include <vector> // for std::vector
 
 class vtkMultiProcessController;
 class vtkPVServerInformation;
@@ -132,6 +138,23 @@ public:
   bool GatherInformation(
     vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid) override;
 
+  //@{
+  /**
+   * Overridden to send the request to the server(s) and return immediately.
+   * The reply is received from the event loop, or by WaitForRequest().
+   */
+  vtkTypeUInt32 GatherInformationAsync(
+    vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid) override;
+  bool IsRequestComplete(vtkTypeUInt32 requestId) override;
+  bool HasPendingRequests() override { return !this->PendingRequests.empty(); }
+  bool WaitForRequest(vtkTypeUInt32 requestId) override;
+  //@}
+
+  /**
+   * Processes the replies that have already arrived, without blocking.
+   */
+  void ProcessPendingRequests();
+
   /**
    * Returns the number of processes on the given server/s. If more than 1
    * server is identified, than it returns the maximum number of processes e.g.
@@ -213,6 +236,7 @@ public:
   vtkTypeUInt32 GetNextChunkGlobalUniqueIdentifier(vtkTypeUInt32 chunkSize) override;
 
   void OnServerNotificationMessageRMI(void* message, int message_length);
+  void OnGatherInformationReplyRMI(void* message, int message_length);
 
 protected:
   vtkSMSessionClient();
@@ -239,6 +263,32 @@ protected:
    */
   vtkTypeUInt32 GetRealLocation(vtkTypeUInt32);
 
+  /**
+   * Overridden to send the queued states to each server as a single
+   * compressed message and wait for the report of errors.
+   */
+  int FlushTransaction() override;
+
+  /**
+   * Sends the states queued for the data (0) or render (1) server as a single
+   * compressed message. When `report` is true, waits for the server to reply
+   * with the number of errors reported by all the batches sent since the last
+   * report, and returns it. Returns 0 otherwise.
+   */
+  int SendBatch(int server, bool report);
+
+  /**
+   * Sends a serialized state to be pushed by the server of `controller`, or
+   * queues it while in a transaction.
+   */
+  void SendState(vtkMultiProcessController* controller, const std::string& state);
+
+  /**
+   * Sends the states queued by the current transaction, if any. Called before
+   * any other request to the servers so that requests execute in order.
+   */
+  void SendQueuedStates();
+
   // Both maybe the same when connected to pvserver.
   vtkMultiProcessController* RenderServerController;
   vtkMultiProcessController* DataServerController;
@@ -278,8 +328,23 @@ private:
   void operator=(const vtkSMSessionClient&) = delete;
 
   int NotBusy;
+  // States queued by the current transaction for the data and render servers,
+  // and whether batches were sent to them without asking for a report.
+  std::vector<std::string> QueuedStates[2];
+  bool PendingReport[2];
   vtkTypeUInt32 LastGlobalID;
   vtkTypeUInt32 LastGlobalIDAvailable;
+
+  // Asynchronous requests waiting for a reply, and the ones that failed and
+  // whose failure has not been reported by WaitForRequest() yet.
+  struct PendingRequest
+  {
+    vtkSmartPointer<vtkPVInformation> Information;
+    vtkMultiProcessController* Controller;
+    bool AddInformation;
+  };
+  std::map<vtkTypeUInt32, PendingRequest> PendingRequests;
+  std::set<vtkTypeUInt32> FailedRequests;
 };
 
 #endif
@@ -52,10 +52,12 @@
 #include "vtkVersion.h"
 
 #include <assert.h>
+#include <cstring>
 #include <map>
 #include <set>
 #include <sstream>
 #include <vector>
+#include <vtksys/FStream.hxx>
 #include <vtksys/RegularExpression.hxx>
 
 #include "vtkSMSessionProxyManagerInternals.h"
@@ -119,6 +121,15 @@ protected:
   vtkSMProxyManagerForwarder() {}
 };
 //*****************************************************************************
+namespace
+{
+// Binary state files start with this magic string followed by the format
+// version as an unsigned 32 bit little-endian integer, then the root element
+// in the binary form of vtkPVXMLElement::SaveBinary().
+const char BinaryStateMagic[8] = { 'P', 'V', 'S', 'M', 'B', 'I', 'N', '\n' };
+const unsigned char BinaryStateVersion = 1;
+}
+
 //---------------------------------------------------------------------------
 vtkSMSessionProxyManager* vtkSMSessionProxyManager::New(vtkSMSession* session)
 {
@@ -1203,11 +1214,34 @@ int vtkSMSessionProxyManager::AreProxiesModified()
 void vtkSMSessionProxyManager::LoadXMLState(
   const char* filename, vtkSMStateLoader* loader /*=NULL*/)
 {
-  vtkPVXMLParser* parser = vtkPVXMLParser::New();
-  parser->SetFileName(filename);
-  parser->Parse();
+  vtksys::ifstream ifs(filename, std::ios::in | std::ios::binary);
+  if (!ifs)
+  {
+    vtkErrorMacro("Failed to open state file '" << (filename ? filename : "(null)") << "'.");
+    return;
+  }
+  std::ostringstream contents;
+  contents << ifs.rdbuf();
+  const std::string buffer = contents.str();
 
-  this->LoadXMLState(parser->GetRootElement(), loader);
+  if (vtkSMSessionProxyManager::IsBinaryState(buffer.c_str(), buffer.size()))
+  {
+    vtkSmartPointer<vtkPVXMLElement> root;
+    root.TakeReference(vtkSMSessionProxyManager::NewStateFromBinary(buffer.c_str(), buffer.size()));
+    if (!root)
+    {
+      vtkErrorMacro("Invalid binary state file '" << filename << "'.");
+      return;
+    }
+    this->LoadXMLState(root, loader);
+    return;
+  }
+
+  vtkPVXMLParser* parser = vtkPVXMLParser::New();
+  if (parser->Parse(buffer.c_str(), static_cast<unsigned int>(buffer.size())))
+  {
+    this->LoadXMLState(parser->GetRootElement(), loader);
+  }
   parser->Delete();
 }
 
@@ -1232,7 +1266,11 @@ void vtkSMSessionProxyManager::LoadXMLState(
   {
     spLoader = loader;
   }
-  if (spLoader->LoadState(rootElement, keepOriginalIds))
+  // Send the states of the loaded proxies in as few messages as possible.
+  this->GetSession()->BeginTransaction();
+  bool loaded = spLoader->LoadState(rootElement, keepOriginalIds);
+  this->GetSession()->EndTransaction();
+  if (loaded)
   {
     vtkSMProxyManager::LoadStateInformation info;
     info.RootElement = rootElement;
@@ -1251,6 +1289,59 @@ void vtkSMSessionProxyManager::SaveXMLState(const char* filename)
   rootElement->Delete();
 }
 
+//---------------------------------------------------------------------------
+void vtkSMSessionProxyManager::SaveBinaryState(const char* filename)
+{
+  vtkSmartPointer<vtkPVXMLElement> rootElement;
+  rootElement.TakeReference(this->SaveXMLState());
+
+  std::string buffer(BinaryStateMagic, sizeof(BinaryStateMagic));
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    buffer.push_back(static_cast<char>((BinaryStateVersion >> (8 * cc)) & 0xff));
+  }
+  rootElement->SaveBinary(buffer);
+
+  vtksys::ofstream ofs(filename, std::ios::out | std::ios::binary);
+  ofs.write(buffer.c_str(), static_cast<std::streamsize>(buffer.size()));
+  if (!ofs)
+  {
+    vtkErrorMacro("Failed to write state file '" << (filename ? filename : "(null)") << "'.");
+  }
+}
+
+//---------------------------------------------------------------------------
+bool vtkSMSessionProxyManager::IsBinaryState(const char* buffer, size_t length)
+{
+  return buffer && length >= sizeof(BinaryStateMagic) &&
+    memcmp(buffer, BinaryStateMagic, sizeof(BinaryStateMagic)) == 0;
+}
+
+//---------------------------------------------------------------------------
+vtkPVXMLElement* vtkSMSessionProxyManager::NewStateFromBinary(const char* buffer, size_t length)
+{
+  const size_t headerSize = sizeof(BinaryStateMagic) + 4;
+  if (!vtkSMSessionProxyManager::IsBinaryState(buffer, length) || length < headerSize)
+  {
+    return NULL;
+  }
+  const unsigned char* version =
+    reinterpret_cast<const unsigned char*>(buffer + sizeof(BinaryStateMagic));
+  if (version[0] != BinaryStateVersion || version[1] != 0 || version[2] != 0 || version[3] != 0)
+  {
+    vtkGenericWarningMacro("Unsupported binary state file version.");
+    return NULL;
+  }
+  size_t position = headerSize;
+  vtkPVXMLElement* root = vtkPVXMLElement::NewFromBinary(buffer, length, position);
+  if (root && position != length)
+  {
+    root->Delete();
+    return NULL;
+  }
+  return root;
+}
+
 //---------------------------------------------------------------------------
 vtkPVXMLElement* vtkSMSessionProxyManager::SaveXMLState()
 {
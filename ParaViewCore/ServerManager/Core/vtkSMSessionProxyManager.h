@@ -409,7 +409,8 @@ public:
    * Loads the state of the server manager from XML.
    * If loader is not specified, a vtkSMStateLoader instance is used.
    * When loading XML state, `vtkSMSessionProxyManager::GetInLoadXMLState` will
-   * return true.
+   * return true. The file can also be a binary state file written by
+   * SaveBinaryState().
    */
   void LoadXMLState(const char* filename, vtkSMStateLoader* loader = NULL);
   void LoadXMLState(
@@ -436,6 +437,28 @@ public:
    */
   vtkPVXMLElement* SaveXMLState();
 
+  /**
+   * Same as SaveXMLState(const char*) except that the file holds the XML
+   * elements in the compact binary form of vtkPVXMLElement::SaveBinary(),
+   * which loads several times faster than XML for large states. Binary state
+   * files conventionally have the `.pvsmb` extension.
+   */
+  void SaveBinaryState(const char* filename);
+
+  /**
+   * Returns true if the `length` bytes of `buffer` start like a binary state
+   * file written by SaveBinaryState().
+   */
+  static bool IsBinaryState(const char* buffer, size_t length);
+
+  /**
+   * Creates the root element of the binary state file whose contents are the
+   * `length` bytes of `buffer`. Returns NULL if the contents are not a valid
+   * binary state. The caller must Delete() the returned element.
+   */
+  VTK_NEWINSTANCE
+  static vtkPVXMLElement* NewStateFromBinary(const char* buffer, size_t length);
+
   /**
    * Save/Load registered link states.
    */
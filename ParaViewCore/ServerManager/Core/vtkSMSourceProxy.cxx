@@ -503,6 +503,16 @@ vtkPVDataInformation* vtkSMSourceProxy::GetDataInformation(unsigned int idx)
   return this->GetOutputPort(idx)->GetDataInformation();
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSourceProxy::GatherDataInformationAsync()
+{
+  this->CreateOutputPorts();
+  for (unsigned int cc = 0; cc < this->GetNumberOfOutputPorts(); ++cc)
+  {
+    this->GetOutputPort(cc)->GatherDataInformationAsync();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSourceProxy::InvalidateDataInformation()
 {
@@ -142,6 +142,15 @@ public:
   vtkPVDataInformation* GetDataInformation(unsigned int outputIdx);
   //@}
 
+  /**
+   * Sends the requests for the data information of all the output ports
+   * whose data information is invalid at once, without waiting for the
+   * replies (see vtkSMOutputPort::GatherDataInformationAsync()). Call this
+   * before GetDataInformation() on several ports so that the network latency
+   * is paid once rather than per port.
+   */
+  void GatherDataInformationAsync();
+
   /**
    * Creates extract selection proxies for each output port if not already
    * created.
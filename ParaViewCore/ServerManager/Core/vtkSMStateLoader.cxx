@@ -31,6 +31,8 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
+#include <map>
 #include <vector>
 
 vtkObjectFactoryNewMacro(vtkSMStateLoader);
@@ -57,11 +59,47 @@ struct vtkSMStateLoaderInternals
   ProxyCreationOrderType ProxyCreationOrder;
   bool DeferProxyRegistration;
 
+  /// Proxy elements of IndexedElement by id, filled up by
+  /// LocateProxyElement() so that each lookup does not search the state.
+  typedef std::map<vtkTypeUInt32, vtkPVXMLElement*> ProxyElementsType;
+  ProxyElementsType ProxyElements;
+  vtkPVXMLElement* IndexedElement;
+
   vtkSMStateLoaderInternals()
     : KeepOriginalId(false)
     , DeferProxyRegistration(false)
+    , IndexedElement(NULL)
   {
   }
+
+  /// Adds the proxy elements nested in root to ProxyElements, in the order
+  /// LocateProxyElementInternal() searches them so that the first match wins.
+  void IndexProxyElements(vtkPVXMLElement* root)
+  {
+    unsigned int numElems = root->GetNumberOfNestedElements();
+    for (unsigned int i = 0; i < numElems; i++)
+    {
+      vtkPVXMLElement* currentElement = root->GetNestedElement(i);
+      vtkIdType id;
+      if (currentElement->GetName() && strcmp(currentElement->GetName(), "Proxy") == 0 &&
+        currentElement->GetScalarAttribute("id", &id) && id >= 0 &&
+        static_cast<vtkIdType>(static_cast<vtkTypeUInt32>(id)) == id)
+      {
+        this->ProxyElements.insert(
+          ProxyElementsType::value_type(static_cast<vtkTypeUInt32>(id), currentElement));
+      }
+    }
+    for (unsigned int i = 0; i < numElems; i++)
+    {
+      this->IndexProxyElements(root->GetNestedElement(i));
+    }
+  }
+
+  void ClearProxyElements()
+  {
+    this->ProxyElements.clear();
+    this->IndexedElement = NULL;
+  }
 };
 
 //---------------------------------------------------------------------------
@@ -185,17 +223,19 @@ void vtkSMStateLoader::CreatedNewProxy(vtkTypeUInt32 id, vtkSMProxy* proxy)
 
   // Calling UpdateVTKObjects() will assign the proxy a GlobalId, if needed.
   proxy->UpdateVTKObjects();
-  if (proxy->IsA("vtkSMSourceProxy"))
-  {
-    vtkSMSourceProxy::SafeDownCast(proxy)->UpdatePipelineInformation();
-  }
   if (this->Internal->DeferProxyRegistration)
   {
+    // The pipeline information is updated before registering the proxy, see
+    // LoadStateInternal().
     this->Internal->ProxyCreationOrder.push_back(
       vtkSMStateLoaderInternals::ProxyCreationOrderItem(id, proxy));
   }
   else
   {
+    if (proxy->IsA("vtkSMSourceProxy"))
+    {
+      vtkSMSourceProxy::SafeDownCast(proxy)->UpdatePipelineInformation();
+    }
     this->RegisterProxy(id, proxy);
   }
 }
@@ -279,7 +319,22 @@ bool vtkSMStateLoader::UpdateRegistrationInfo(
 //---------------------------------------------------------------------------
 vtkPVXMLElement* vtkSMStateLoader::LocateProxyElement(vtkTypeUInt32 id)
 {
-  return this->LocateProxyElementInternal(this->ServerManagerStateElement, id);
+  if (!this->ServerManagerStateElement)
+  {
+    return this->LocateProxyElementInternal(this->ServerManagerStateElement, id);
+  }
+
+  // Searching the state for every proxy takes quadratic time, hence index
+  // the proxy elements once per state.
+  vtkSMStateLoaderInternals* internal = this->Internal;
+  if (internal->IndexedElement != this->ServerManagerStateElement)
+  {
+    internal->ClearProxyElements();
+    internal->IndexProxyElements(this->ServerManagerStateElement);
+    internal->IndexedElement = this->ServerManagerStateElement;
+  }
+  vtkSMStateLoaderInternals::ProxyElementsType::iterator iter = internal->ProxyElements.find(id);
+  return iter != internal->ProxyElements.end() ? iter->second : NULL;
 }
 
 //---------------------------------------------------------------------------
@@ -546,6 +601,7 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
   }
 
   this->ServerManagerStateElement = rootElement;
+  this->Internal->ClearProxyElements();
 
   unsigned int numElems = rootElement->GetNumberOfNestedElements();
   unsigned int i;
@@ -608,6 +664,21 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
     }
   }
 
+  // Update the pipeline information of the sources once all the proxies are
+  // created rather than as each one is: the information is pulled from the
+  // server(s), which first sends them the states pushed so far. When loading
+  // within a transaction (see vtkSMSession::BeginTransaction()), the states
+  // of all the proxies are thus sent together.
+  for (vtkSMStateLoaderInternals::ProxyCreationOrderType::const_iterator iter =
+         this->Internal->ProxyCreationOrder.begin();
+       iter != this->Internal->ProxyCreationOrder.end(); ++iter)
+  {
+    if (vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(iter->second))
+    {
+      source->UpdatePipelineInformation();
+    }
+  }
+
   // Register proxies in order they were created (as that's a good dependency
   // order).
   for (vtkSMStateLoaderInternals::ProxyCreationOrderType::const_iterator iter =
@@ -663,6 +734,7 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
   // Clear internal data structures.
   this->Internal->ProxyCreationOrder.clear();
   this->Internal->RegistrationInformation.clear();
+  this->Internal->ClearProxyElements();
   this->ServerManagerStateElement = 0;
   return 1;
 }
@@ -1,7 +1,11 @@
+import glob
+import os
+
 from paraview.simple import *
 
 from paraview import smtesting
 from paraview.vtk.vtkPVClientServerCoreRendering import vtkPVCacheKeeper
+from paraview.vtk.vtkPVClientServerCoreRendering import vtkPVCacheSizeInformation
 from paraview.vtk.vtkPVServerManagerDefault import vtkPVGeneralSettings
 
 smtesting.ProcessCommandLineArguments()
@@ -139,5 +143,79 @@ assert vtkPVCacheKeeper.GetCacheSkips() == 0 and \
         vtkPVCacheKeeper.GetCacheHits() > 0 and \
         vtkPVCacheKeeper.GetCacheClears() == 0
 
+#---------------------------------------------------------
+# With a tiny cache limit, the least recently used geometries are evicted
+# instead of caching being disabled.
+def cacheInformation():
+    info = vtkPVCacheSizeInformation()
+    DataRepresentation1.GetSession().GatherInformation(
+        servermanager.vtkSMSession.DATA_SERVER, info, DataRepresentation1.SMProxy.GetGlobalID())
+    return info
+
+settings = vtkPVGeneralSettings.GetInstance()
+assert settings.GetAnimationGeometryCacheEvictionPolicy() == 0
+
+#---------------------------------------------------------
+# By default, caching stops when the cache is full. Looping over an animation
+# that does not fit in the cache must keep hitting the geometries cached first.
+DataRepresentation1.SetRepresentationType("Surface")
+can_ex2.PointVariables = ['ACCL', 'DISPL', 'VEL']
+AnimationScene1.Play()
+fullSize = cacheInformation().GetCacheSize()
+settings.SetAnimationGeometryCacheLimit(max(1, fullSize // 2))
+
+# modifying the reader clears the cache.
+can_ex2.PointVariables = ['ACCL', 'DISPL']
+AnimationScene1.Play()
+before = cacheInformation()
+AnimationScene1.Play()
+after = cacheInformation()
+hits = after.GetNumberOfCacheHits() - before.GetNumberOfCacheHits()
+misses = after.GetNumberOfCacheMisses() - before.GetNumberOfCacheMisses()
+cached = after.GetNumberOfCachedEntries()
+assert 0 < cached < len(can_ex2.TimestepValues)
+assert hits >= cached and misses > 0
+assert after.GetNumberOfCacheEvictions() == 0
+
+#---------------------------------------------------------
+settings.SetAnimationGeometryCacheEvictionPolicy(1)
+settings.SetAnimationGeometryCacheLimit(1)
+vtkPVCacheKeeper.ClearCacheStateFlags()
+AnimationScene1.Play()
+AnimationScene1.Play()
+assert vtkPVCacheKeeper.GetCacheSkips() == 0 and \
+        vtkPVCacheKeeper.GetCacheMisses() > 0
+assert cacheInformation().GetNumberOfCacheEvictions() > 0
+
+#---------------------------------------------------------
+# Evicted geometries written to disk are still cached.
+settings.SetAnimationGeometryCacheSpillDirectory(smtesting.TempDir)
+AnimationScene1.Play()
+vtkPVCacheKeeper.ClearCacheStateFlags()
+AnimationScene1.Play()
+assert vtkPVCacheKeeper.GetCacheSkips() == 0 and \
+        vtkPVCacheKeeper.GetCacheMisses() == 0 and \
+        vtkPVCacheKeeper.GetCacheHits() > 0
+assert cacheInformation().GetSpillSize() > 0
+
+#---------------------------------------------------------
+# Geometries that cannot be read back are produced again, rather than the
+# stale input of the cache being shown.
+def getRange(time):
+    AnimationScene1.AnimationTime = time
+    info = DataRepresentation1.GetRepresentedDataInformation()
+    return info.GetPointDataInformation().GetArrayInformation('ACCL').GetComponentRange(-1)
+
+timesteps = can_ex2.TimestepValues
+reference = [getRange(t) for t in timesteps]
+for spilled in glob.glob(os.path.join(smtesting.TempDir, 'pvcache-%d-*.bin' % os.getpid())):
+    os.remove(spilled)
+vtkPVCacheKeeper.ClearCacheStateFlags()
+for t, expected in zip(timesteps, reference):
+    assert getRange(t) == expected, "stale geometry at time %g" % t
+assert vtkPVCacheKeeper.GetCacheMisses() > 0
+
+settings.SetAnimationGeometryCacheSpillDirectory("")
+settings.SetAnimationGeometryCacheLimit(102400)
 
 print("All's well that ends well! Looks like the cache is working as expected.")
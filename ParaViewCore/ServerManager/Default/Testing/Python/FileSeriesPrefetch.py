@@ -0,0 +1,48 @@
+# Plays a file series with and without prefetching and checks that the data
+# read is the same and that prefetch statistics are reported.
+from paraview.simple import *
+
+from paraview import smtesting
+
+import os.path
+
+smtesting.ProcessCommandLineArguments()
+
+meta_file = os.path.join(smtesting.DataDir, "FileSeries/blow.vtk.series")
+settings = GetSettingsProxy('GeneralSettings')
+
+def play(depth):
+    settings.FileSeriesPrefetchDepth = depth
+    reader = LegacyVTKReader(FileNames=[meta_file])
+    reader.UpdatePipelineInformation()
+    ranges = []
+    for t in reader.TimestepValues:
+        reader.UpdatePipeline(t)
+        info = reader.GetDataInformation()
+        ranges.append((info.GetNumberOfPoints(),
+                       info.GetPointDataInformation().GetArrayInformation('displacement').GetComponentRange(-1)))
+    stats = None
+    if not servermanager.ActiveConnection.IsRemote():
+        series = reader.GetClientSideObject()
+        stats = (series.GetNumberOfPrefetchRequests(), series.GetNumberOfPrefetchHits(),
+                 series.GetPrefetchHitRate())
+    Delete(reader)
+    return ranges, stats
+
+reference, stats = play(0)
+if stats is not None and stats[0] != 0:
+    raise smtesting.TestError('Prefetch requests reported while prefetching is disabled.')
+
+prefetched, stats = play(2)
+settings.FileSeriesPrefetchDepth = 0
+
+if prefetched != reference:
+    raise smtesting.TestError('Data read with prefetching differs.')
+
+if stats is not None:
+    requests, hits, rate = stats
+    print('prefetch: %d requests, %d hits (%g)' % (requests, hits, rate))
+    # whether a file is prefetched before it is requested depends on thread
+    # scheduling, only check that the statistics are consistent.
+    if requests <= 0 or hits < 0 or hits > requests:
+        raise smtesting.TestError('Unexpected prefetch statistics: %s' % (stats,))
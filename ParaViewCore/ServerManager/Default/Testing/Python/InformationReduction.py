@@ -0,0 +1,71 @@
+# Gathers the information of distributed data with each of the reduction modes
+# of vtkPVSessionCore and checks that the tree reduction gives the same result
+# as gathering to the root. Runs on a number of ranks that is not a power of
+# two, so that some ranks of the tree have no child at some levels.
+from __future__ import print_function
+
+from paraview import servermanager
+from paraview import smtesting
+from paraview.simple import *
+
+smtesting.ProcessCommandLineArguments()
+
+# vtkPVSessionCore::InformationReductionModes
+GATHER_TO_ROOT = 0
+TREE_REDUCTION = 1
+
+def gather(proxy, mode):
+    servermanager.vtkPVSessionCore.SetInformationReductionMode(mode)
+    info = servermanager.vtkPVDataInformation()
+    servermanager.ActiveConnection.Session.GatherInformation(
+        servermanager.vtkSMSession.DATA_SERVER, info, proxy.GetGlobalID())
+    return info
+
+def arrays(attributes):
+    result = []
+    for index in range(attributes.GetNumberOfArrays()):
+        array = attributes.GetArrayInformation(index)
+        result.append((array.GetName(), array.GetNumberOfComponents(),
+            tuple(array.GetComponentRange(c) for c in range(-1, array.GetNumberOfComponents()))))
+    return result
+
+def summary(info):
+    return (info.GetDataSetTypeAsString(), info.GetNumberOfDataSets(),
+        info.GetNumberOfPoints(), info.GetNumberOfCells(), info.GetMemorySize(),
+        info.GetBounds(), info.GetExtent(),
+        arrays(info.GetPointDataInformation()), arrays(info.GetCellDataInformation()))
+
+def check(source, name):
+    source.UpdatePipeline()
+    reference = summary(gather(source.SMProxy, GATHER_TO_ROOT))
+    reduced = summary(gather(source.SMProxy, TREE_REDUCTION))
+    print('%s: %s' % (name, str(reference)))
+    if reduced != reference:
+        raise smtesting.TestError(
+            'Tree reduction of %s differs: %s' % (name, str(reduced)))
+    return reference
+
+initial_mode = servermanager.vtkPVSessionCore.GetInformationReductionMode()
+
+numberOfRanks = servermanager.vtkProcessModule.GetProcessModule().GetNumberOfLocalPartitions()
+if numberOfRanks < 2:
+    raise smtesting.TestError('The test must run on several ranks.')
+
+# a distributed image, with an array that differs on every rank.
+wavelet = Wavelet()
+pids = ProcessIdScalars(Input=wavelet)
+reference = check(pids, 'image')
+ranges = dict((name, ranges) for name, _, ranges in reference[7])
+if ranges['ProcessId'][0] != (0, numberOfRanks - 1):
+    raise smtesting.TestError('Information of some ranks is missing: %s' % str(ranges))
+
+# a multiblock dataset, whose blocks are merged in rank order.
+sphere = Sphere()
+group = GroupDatasets(Input=[pids, sphere])
+check(group, 'multiblock')
+
+servermanager.vtkPVSessionCore.SetInformationReductionMode(initial_mode)
+Delete(group)
+Delete(sphere)
+Delete(pids)
+Delete(wavelet)
@@ -0,0 +1,156 @@
+"""
+    This test checks how the spreadsheet view delivers a table to the client in
+    blocks: the values of the visible columns across block boundaries as
+    columns are hidden and shown again, the eviction of the least recently
+    used block from the cache, and the compressed delivery of a table.
+"""
+
+from paraview import servermanager
+import paraview.simple as smp
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+def getHost(url):
+   return url.split(':')[1][2:]
+
+def getPort(url):
+   return int(url.split(':')[2])
+
+NUMBER_OF_ROWS = 30
+NUMBER_OF_COLUMNS = 6
+BLOCK_SIZE = 7
+
+# vtk is imported in the scripts of programmable sources.
+TABLE_SCRIPT = '''
+output = self.GetOutput()
+for i in range(%(columns)d):
+    column = vtk.vtkDoubleArray()
+    column.SetName('column%%d' %% i)
+    column.SetNumberOfTuples(%(rows)d)
+    for row in range(%(rows)d):
+        column.SetValue(row, 100 * row + i)
+    output.AddColumn(column)
+labels = vtk.vtkStringArray()
+labels.SetName('labels')
+labels.SetNumberOfTuples(%(rows)d)
+for row in range(%(rows)d):
+    labels.SetValue(row, 'row%%d' %% row)
+output.AddColumn(labels)
+''' % {'rows': NUMBER_OF_ROWS, 'columns': NUMBER_OF_COLUMNS}
+
+def expectedValue(row, column):
+    return 100 * row + column
+
+def getColumnIndices(ss):
+    indices = {}
+    for index in range(ss.GetNumberOfColumns()):
+        indices[ss.GetColumnName(index)] = index
+    return indices
+
+def checkVisibleColumns(ss, indices, hidden):
+    """Checks the values of all the visible columns, reading each column down
+    through all the blocks."""
+    for column in range(NUMBER_OF_COLUMNS):
+        name = 'column%d' % column
+        index = indices[name]
+        assert ss.GetColumnVisibility(index) == (name not in hidden), \
+            "wrong visibility for %s" % name
+        if name in hidden:
+            continue
+        for row in range(NUMBER_OF_ROWS):
+            value = ss.GetValue(row, index)
+            assert value.IsValid() and value.ToDouble() == expectedValue(row, column), \
+                "wrong value at row %d of %s with %s hidden" % (row, name, str(hidden))
+
+def testHiddenColumns(view, ss):
+    indices = getColumnIndices(ss)
+    checkVisibleColumns(ss, indices, [])
+
+    # the cached blocks have all the columns and remain valid.
+    hidden = ['column1', 'column3']
+    view.HiddenColumnLabels = hidden
+    smp.Render(view)
+    checkVisibleColumns(ss, indices, hidden)
+
+    # all the blocks but the first are fetched without the hidden columns.
+    ss.ClearCache()
+    checkVisibleColumns(ss, indices, hidden)
+
+    # the blocks without the column shown again are fetched again.
+    hidden = ['column1']
+    view.HiddenColumnLabels = hidden
+    smp.Render(view)
+    checkVisibleColumns(ss, indices, hidden)
+
+    view.HiddenColumnLabels = []
+    smp.Render(view)
+    checkVisibleColumns(ss, indices, [])
+
+def testLeastRecentlyUsedEviction(view, ss):
+    view.CacheSize = 3
+    smp.Render(view)
+    index = getColumnIndices(ss)['column0']
+    ss.ClearCache()
+    ss.ResetCacheStatistics()
+
+    # fills the cache with blocks 0, 1 and 2, then uses block 0 again.
+    for block in [0, 1, 2, 0]:
+        ss.GetValue(block * BLOCK_SIZE, index)
+    assert ss.GetNumberOfCacheMisses() == 3 and ss.GetNumberOfCacheHits() == 1
+
+    # block 1 is now the least recently used one.
+    ss.GetValue(3 * BLOCK_SIZE, index)
+    assert not ss.IsAvailable(1 * BLOCK_SIZE), "block 1 was not evicted"
+    for block in [0, 2, 3]:
+        assert ss.IsAvailable(block * BLOCK_SIZE), "block %d was evicted" % block
+
+    # fetching block 1 again is a miss and gives the same values.
+    value = ss.GetValue(1 * BLOCK_SIZE + 1, index)
+    assert value.ToDouble() == expectedValue(1 * BLOCK_SIZE + 1, 0)
+    assert ss.GetNumberOfCacheMisses() == 5
+
+    view.CacheSize = 10
+    smp.Render(view)
+
+def testCompressedDelivery(source):
+    # 19 is VTK_TABLE.
+    moveData = servermanager.filters.ClientServerMoveData(Input=source,
+        OutputDataType=19, Compression=1)
+    moveData.UpdatePipeline()
+    table = moveData.GetClientSideObject().GetOutputDataObject(0)
+    assert table.IsA("vtkTable")
+    assert table.GetNumberOfRows() == NUMBER_OF_ROWS
+    assert table.GetNumberOfColumns() == NUMBER_OF_COLUMNS + 1
+    for column in range(NUMBER_OF_COLUMNS):
+        array = table.GetColumnByName('column%d' % column)
+        assert array and array.IsA("vtkDoubleArray")
+        for row in range(NUMBER_OF_ROWS):
+            assert array.GetValue(row) == expectedValue(row, column), \
+                "wrong value at row %d of column%d" % (row, column)
+    labels = table.GetColumnByName('labels')
+    assert labels and labels.IsA("vtkStringArray")
+    for row in range(NUMBER_OF_ROWS):
+        assert labels.GetValue(row) == 'row%d' % row
+    smp.Delete(moveData)
+
+options = servermanager.vtkProcessModule.GetProcessModule().GetOptions()
+url = options.GetServerURL()
+smp.Connect(getHost(url), getPort(url))
+
+source = smp.ProgrammableSource(OutputDataSetType='vtkTable')
+source.Script = TABLE_SCRIPT
+view = smp.CreateView('SpreadSheetView')
+view.FieldAssociation = 'Row Data'
+view.BlockSize = BLOCK_SIZE
+smp.Show(source, view)
+smp.Render(view)
+ss = view.GetClientSideObject()
+assert ss.GetNumberOfRows() == NUMBER_OF_ROWS
+
+testHiddenColumns(view, ss)
+testLeastRecentlyUsedEviction(view, ss)
+testCompressedDelivery(source)
+
+smp.Delete(view)
+smp.Disconnect()
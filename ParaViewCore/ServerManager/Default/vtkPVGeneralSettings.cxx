@@ -15,7 +15,10 @@
 #include "vtkPVGeneralSettings.h"
 
 #include "vtkCacheSizeKeeper.h"
+#include "vtkFileSeriesReader.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPVProminentValuesInformation.h"
 #include "vtkPVXYChartView.h"
 #include "vtkProcessModuleAutoMPI.h"
 #include "vtkSISourceProxy.h"
@@ -29,6 +32,7 @@
 #include "vtkSMViewProxy.h"
 
 #include <cassert>
+#include <cstring>
 
 vtkSmartPointer<vtkPVGeneralSettings> vtkPVGeneralSettings::Instance;
 
@@ -131,6 +135,38 @@ int vtkPVGeneralSettings::GetAutoMPILimit()
   return vtkProcessModuleAutoMPI::NumberOfCores;
 }
 
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetThreadedSurfaceExtraction(bool val)
+{
+  if (vtkPVGeometryFilter::GetThreadedCompositeExecution() != val)
+  {
+    vtkPVGeometryFilter::SetThreadedCompositeExecution(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVGeneralSettings::GetThreadedSurfaceExtraction()
+{
+  return vtkPVGeometryFilter::GetThreadedCompositeExecution();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetSketchProminentValues(bool val)
+{
+  if (vtkPVProminentValuesInformation::GetDefaultUseSketches() != val)
+  {
+    vtkPVProminentValuesInformation::SetDefaultUseSketches(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVGeneralSettings::GetSketchProminentValues()
+{
+  return vtkPVProminentValuesInformation::GetDefaultUseSketches();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVGeneralSettings::SetCacheGeometryForAnimation(bool val)
 {
@@ -153,6 +189,91 @@ void vtkPVGeneralSettings::SetAnimationGeometryCacheLimit(unsigned long val)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetAnimationGeometryCacheEvictionPolicy(int val)
+{
+  if (this->GetAnimationGeometryCacheEvictionPolicy() != val)
+  {
+    vtkCacheSizeKeeper::GetInstance()->SetEvictionPolicy(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVGeneralSettings::GetAnimationGeometryCacheEvictionPolicy()
+{
+  return vtkCacheSizeKeeper::GetInstance()->GetEvictionPolicy();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetCompressEvictedAnimationGeometry(bool val)
+{
+  if (this->GetCompressEvictedAnimationGeometry() != val)
+  {
+    vtkCacheSizeKeeper::GetInstance()->SetCompressEvictedEntries(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVGeneralSettings::GetCompressEvictedAnimationGeometry()
+{
+  return vtkCacheSizeKeeper::GetInstance()->GetCompressEvictedEntries();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetAnimationGeometryCacheSpillDirectory(const char* val)
+{
+  vtkCacheSizeKeeper* keeper = vtkCacheSizeKeeper::GetInstance();
+  const char* directory = (val && *val) ? val : NULL;
+  const char* current = keeper->GetSpillDirectory();
+  if ((directory == NULL) != (current == NULL) ||
+    (directory && strcmp(directory, current) != 0))
+  {
+    keeper->SetSpillDirectory(directory);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVGeneralSettings::GetAnimationGeometryCacheSpillDirectory()
+{
+  const char* directory = vtkCacheSizeKeeper::GetInstance()->GetSpillDirectory();
+  return directory ? directory : "";
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetFileSeriesPrefetchDepth(int val)
+{
+  if (vtkFileSeriesReader::GetPrefetchDepth() != val)
+  {
+    vtkFileSeriesReader::SetPrefetchDepth(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVGeneralSettings::GetFileSeriesPrefetchDepth()
+{
+  return vtkFileSeriesReader::GetPrefetchDepth();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetFileSeriesPrefetchMemoryLimit(unsigned long val)
+{
+  if (vtkFileSeriesReader::GetPrefetchMemoryLimit() != val)
+  {
+    vtkFileSeriesReader::SetPrefetchMemoryLimit(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPVGeneralSettings::GetFileSeriesPrefetchMemoryLimit()
+{
+  return vtkFileSeriesReader::GetPrefetchMemoryLimit();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVGeneralSettings::SetIgnoreNegativeLogAxisWarning(bool val)
 {
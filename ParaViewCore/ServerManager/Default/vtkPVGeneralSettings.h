@@ -96,6 +96,25 @@ public:
   int GetAutoMPILimit();
   //@}
 
+  //@{
+  /**
+   * Extract the surfaces of the blocks of composite datasets concurrently.
+   * Forwarded to vtkPVGeometryFilter.
+   */
+  void SetThreadedSurfaceExtraction(bool val);
+  bool GetThreadedSurfaceExtraction();
+  //@}
+
+  //@{
+  /**
+   * Summarize arrays with mergeable sketches when looking for their prominent
+   * values, e.g. to annotate from data. Forwarded to
+   * vtkPVProminentValuesInformation.
+   */
+  void SetSketchProminentValues(bool val);
+  bool GetSketchProminentValues();
+  //@}
+
   //@{
   /**
    * Get/Set the default view type.
@@ -152,6 +171,44 @@ public:
   vtkGetMacro(AnimationGeometryCacheLimit, unsigned long);
   //@}
 
+  //@{
+  /**
+   * Set the policy used to evict geometry from the animation cache when it
+   * exceeds the cache limit. See vtkCacheSizeKeeper::EvictionPolicies.
+   */
+  void SetAnimationGeometryCacheEvictionPolicy(int val);
+  int GetAnimationGeometryCacheEvictionPolicy();
+  //@}
+
+  //@{
+  /**
+   * Set whether geometry evicted from the animation cache is kept compressed
+   * in memory.
+   */
+  void SetCompressEvictedAnimationGeometry(bool val);
+  bool GetCompressEvictedAnimationGeometry();
+  //@}
+
+  //@{
+  /**
+   * Set the local directory geometry evicted from the animation cache is
+   * written to. Empty to discard evicted geometry.
+   */
+  void SetAnimationGeometryCacheSpillDirectory(const char* val);
+  const char* GetAnimationGeometryCacheSpillDirectory();
+  //@}
+
+  //@{
+  /**
+   * Set the number of files file series readers read ahead and the memory, in
+   * KiB, they may use to do so. Forwarded to vtkFileSeriesReader.
+   */
+  void SetFileSeriesPrefetchDepth(int val);
+  int GetFileSeriesPrefetchDepth();
+  void SetFileSeriesPrefetchMemoryLimit(unsigned long val);
+  unsigned long GetFileSeriesPrefetchMemoryLimit();
+  //@}
+
   //@{
   /**
    * Set the precision of the animation time toolbar.
@@ -0,0 +1,239 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestGeometryRepresentationStreaming.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Streams a multiblock dataset one block at a time through a
+// vtkGeometryRepresentation and checks that, once streaming is done, the
+// rendered data has every block exactly once, including after the data was
+// delivered again.
+
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkDataSet.h"
+#include "vtkGeometryRepresentation.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkInitializationHelper.h"
+#include "vtkMapper.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiBlockDataSetAlgorithm.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVLODActor.h"
+#include "vtkPVRenderView.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <set>
+
+// A source producing NumberOfBlocks spheres along the X axis, which gives the
+// bounds of every block as meta-data and only loads the blocks requested.
+class vtkTestBlocksSource : public vtkMultiBlockDataSetAlgorithm
+{
+public:
+  static vtkTestBlocksSource* New();
+  vtkTypeMacro(vtkTestBlocksSource, vtkMultiBlockDataSetAlgorithm);
+
+  static const unsigned int NumberOfBlocks = 6;
+
+  vtkSetMacro(Radius, double);
+
+protected:
+  vtkTestBlocksSource()
+    : Radius(0.5)
+  {
+    this->SetNumberOfInputPorts(0);
+  }
+
+  int RequestInformation(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkNew<vtkMultiBlockDataSet> metadata;
+    metadata->SetNumberOfBlocks(NumberOfBlocks);
+    for (unsigned int cc = 0; cc < NumberOfBlocks; ++cc)
+    {
+      double bounds[6] = { 2. * cc - 0.5, 2. * cc + 0.5, -0.5, 0.5, -0.5, 0.5 };
+      metadata->GetMetaData(cc)->Set(vtkStreamingDemandDrivenPipeline::BOUNDS(), bounds, 6);
+    }
+    outputVector->GetInformationObject(0)->Set(
+      vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA(), metadata.Get());
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::GetData(outInfo);
+    output->SetNumberOfBlocks(NumberOfBlocks);
+
+    // flat index of the block cc is cc + 1.
+    const bool loadRequested = outInfo->Has(vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS()) &&
+      outInfo->Has(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES());
+    std::set<int> requested;
+    if (loadRequested)
+    {
+      const int* ids = outInfo->Get(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES());
+      requested.insert(
+        ids, ids + outInfo->Length(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES()));
+    }
+    for (unsigned int cc = 0; cc < NumberOfBlocks; ++cc)
+    {
+      if (!loadRequested || requested.count(static_cast<int>(cc + 1)) > 0)
+      {
+        vtkNew<vtkSphereSource> sphere;
+        sphere->SetCenter(2. * cc, 0, 0);
+        sphere->SetRadius(this->Radius);
+        sphere->Update();
+        output->SetBlock(cc, sphere->GetOutput());
+      }
+    }
+    return 1;
+  }
+
+  double Radius;
+
+private:
+  vtkTestBlocksSource(const vtkTestBlocksSource&) = delete;
+  void operator=(const vtkTestBlocksSource&) = delete;
+};
+
+vtkStandardNewMacro(vtkTestBlocksSource);
+
+namespace
+{
+// Streams all the blocks left and checks that the rendered data has every
+// block, each having the points of one sphere.
+bool StreamAndCheck(vtkSMRenderViewProxy* view, vtkGeometryRepresentation* repr)
+{
+  view->StillRender();
+  unsigned int passes = 0;
+  while (view->StreamingUpdate(true) && passes <= vtkTestBlocksSource::NumberOfBlocks)
+  {
+    ++passes;
+  }
+  // one block came with the regular update, the others one per pass.
+  if (passes != vtkTestBlocksSource::NumberOfBlocks - 1)
+  {
+    cerr << "ERROR: streamed the blocks in " << passes << " passes instead of "
+         << vtkTestBlocksSource::NumberOfBlocks - 1 << "." << endl;
+    return false;
+  }
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->Update();
+  const vtkIdType numPoints = sphere->GetOutput()->GetNumberOfPoints();
+
+  vtkMultiBlockDataSet* rendered =
+    vtkMultiBlockDataSet::SafeDownCast(repr->GetActor()->GetMapper()->GetInputDataObject(0, 0));
+  if (!rendered)
+  {
+    cerr << "ERROR: the rendered data is not a multiblock dataset." << endl;
+    return false;
+  }
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(rendered->NewIterator());
+  unsigned int numBlocks = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkDataSet* block = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    if (!block || block->GetNumberOfPoints() != numPoints)
+    {
+      cerr << "ERROR: block " << iter->GetCurrentFlatIndex() << " is missing or duplicated."
+           << endl;
+      return false;
+    }
+    ++numBlocks;
+  }
+  if (numBlocks != vtkTestBlocksSource::NumberOfBlocks)
+  {
+    cerr << "ERROR: rendering " << numBlocks << " blocks instead of "
+         << vtkTestBlocksSource::NumberOfBlocks << "." << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestGeometryRepresentationStreaming(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+  vtkPVView::SetEnableStreaming(true);
+
+  int status = EXIT_SUCCESS;
+  {
+    vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+    vtkNew<vtkSMSession> session;
+    vtkProcessModule::GetProcessModule()->RegisterSession(session.Get());
+    controller->InitializeSession(session.Get());
+
+    vtkSmartPointer<vtkSMRenderViewProxy> view;
+    view.TakeReference(vtkSMRenderViewProxy::SafeDownCast(
+      session->GetSessionProxyManager()->NewProxy("views", "RenderView")));
+    controller->InitializeProxy(view);
+    view->UpdateVTKObjects();
+    vtkPVRenderView* renderView = vtkPVRenderView::SafeDownCast(view->GetClientSideObject());
+
+    vtkNew<vtkTestBlocksSource> source;
+    vtkNew<vtkGeometryRepresentation> repr;
+    repr->Initialize(1, 1);
+    repr->SetStreamingRequestSize(1);
+    repr->SetInputConnection(source->GetOutputPort());
+    renderView->AddRepresentation(repr.Get());
+    repr->Update();
+    renderView->Update();
+    view->ResetCamera();
+
+    if (!repr->GetStreamingCapablePipeline() || !StreamAndCheck(view, repr.Get()))
+    {
+      cerr << "ERROR: failed to stream the blocks." << endl;
+      status = EXIT_FAILURE;
+    }
+
+    // deliver the data again without executing the representation, as when
+    // the data distribution changes: the blocks streamed so far are lost and
+    // must be streamed again.
+    unsigned int keys[2] = { repr->GetUniqueIdentifier(), 0 };
+    renderView->Deliver(0, 2, keys);
+    if (!StreamAndCheck(view, repr.Get()))
+    {
+      cerr << "ERROR: failed to stream the blocks after the data was delivered again." << endl;
+      status = EXIT_FAILURE;
+    }
+
+    // and once more after the input changed.
+    source->SetRadius(0.4);
+    repr->MarkModified();
+    repr->Update();
+    renderView->Update();
+    if (!StreamAndCheck(view, repr.Get()))
+    {
+      cerr << "ERROR: failed to stream the blocks after the input changed." << endl;
+      status = EXIT_FAILURE;
+    }
+
+    renderView->RemoveRepresentation(repr.Get());
+    view = NULL;
+    vtkProcessModule::GetProcessModule()->UnRegisterSession(session.Get());
+  }
+
+  vtkPVView::SetEnableStreaming(false);
+  vtkInitializationHelper::Finalize();
+  return status;
+}
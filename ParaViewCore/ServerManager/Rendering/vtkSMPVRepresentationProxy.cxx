@@ -764,6 +764,16 @@ vtkPVArrayInformation* vtkSMPVRepresentationProxy::GetArrayInformationForColorAr
   unsigned int port = inputHelper.GetOutputPort();
   if (input)
   {
+    // When the data information of the input must be gathered, request the
+    // represented data information along with it, in case the array is not
+    // on the input, so that both replies come back in one round trip.
+    input->CreateOutputPorts();
+    vtkSMOutputPort* outputPort =
+      port < input->GetNumberOfOutputPorts() ? input->GetOutputPort(port) : NULL;
+    if (outputPort && outputPort->GatherDataInformationAsync() != 0)
+    {
+      this->GatherRepresentedDataInformationAsync();
+    }
     vtkPVArrayInformation* arrayInfoFromData = input->GetDataInformation(port)->GetArrayInformation(
       colorArrayHelper.GetInputArrayNameToProcess(), colorArrayHelper.GetInputArrayAssociation());
     if (arrayInfoFromData)
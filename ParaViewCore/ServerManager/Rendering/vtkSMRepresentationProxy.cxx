@@ -40,6 +40,8 @@ vtkSMRepresentationProxy::vtkSMRepresentationProxy()
   this->SetExecutiveName("vtkPVDataRepresentationPipeline");
   this->RepresentedDataInformationValid = false;
   this->RepresentedDataInformation = vtkPVRepresentedDataInformation::New();
+  this->RepresentedDataInformationRequest = 0;
+  this->RepresentedDataInformationRequestValid = false;
   this->ProminentValuesInformation = vtkPVProminentValuesInformation::New();
   this->ProminentValuesFraction = -1;
   this->ProminentValuesUncertainty = -1;
@@ -305,6 +307,7 @@ void vtkSMRepresentationProxy::InvalidateDataInformation()
 {
   this->Superclass::InvalidateDataInformation();
   this->RepresentedDataInformationValid = false;
+  this->RepresentedDataInformationRequestValid = false;
   this->ProminentValuesInformationValid = false;
 }
 
@@ -314,8 +317,12 @@ vtkPVDataInformation* vtkSMRepresentationProxy::GetRepresentedDataInformation()
   if (!this->RepresentedDataInformationValid)
   {
     vtkTimerLog::MarkStartEvent("vtkSMRepresentationProxy::GetRepresentedDataInformation");
-    this->RepresentedDataInformation->Initialize();
-    this->GatherInformation(this->RepresentedDataInformation);
+    this->GatherRepresentedDataInformationAsync();
+    if (this->RepresentedDataInformationRequest != 0)
+    {
+      this->GetSession()->WaitForRequest(this->RepresentedDataInformationRequest);
+      this->RepresentedDataInformationRequest = 0;
+    }
     vtkTimerLog::MarkEndEvent("vtkSMRepresentationProxy::GetRepresentedDataInformation");
     this->RepresentedDataInformationValid = true;
   }
@@ -323,6 +330,28 @@ vtkPVDataInformation* vtkSMRepresentationProxy::GetRepresentedDataInformation()
   return this->RepresentedDataInformation;
 }
 
+//----------------------------------------------------------------------------
+vtkTypeUInt32 vtkSMRepresentationProxy::GatherRepresentedDataInformationAsync()
+{
+  if (this->RepresentedDataInformationValid ||
+    (this->RepresentedDataInformationRequest != 0 && this->RepresentedDataInformationRequestValid))
+  {
+    return 0;
+  }
+
+  // Wait for the out-of-date reply so that it does not overwrite the
+  // information this request is about to gather.
+  if (this->RepresentedDataInformationRequest != 0)
+  {
+    this->GetSession()->WaitForRequest(this->RepresentedDataInformationRequest);
+  }
+  this->RepresentedDataInformation->Initialize();
+  this->RepresentedDataInformationRequest =
+    this->GatherInformationAsync(this->RepresentedDataInformation);
+  this->RepresentedDataInformationRequestValid = true;
+  return this->RepresentedDataInformationRequest;
+}
+
 //----------------------------------------------------------------------------
 vtkPVProminentValuesInformation* vtkSMRepresentationProxy::GetProminentValuesInformation(
   vtkStdString name, int fieldAssoc, int numComponents, double uncertaintyAllowed, double fraction,
@@ -337,8 +366,10 @@ vtkPVProminentValuesInformation* vtkSMRepresentationProxy::GetProminentValuesInf
     this->ProminentValuesFraction > 1. || this->ProminentValuesUncertainty > 1.;
   bool largerFractionOrLessCertain = this->ProminentValuesFraction < fraction ||
     this->ProminentValuesUncertainty > uncertaintyAllowed;
+  bool useSketches = vtkPVProminentValuesInformation::GetDefaultUseSketches();
+  bool differentMethod = this->ProminentValuesInformation->GetUseSketches() != useSketches;
   if (!this->ProminentValuesInformationValid || differentAttribute || invalid ||
-    largerFractionOrLessCertain || force)
+    largerFractionOrLessCertain || differentMethod || force)
   {
     vtkTimerLog::MarkStartEvent("vtkSMRepresentationProxy::GetProminentValues");
     this->CreateVTKObjects();
@@ -352,6 +383,7 @@ vtkPVProminentValuesInformation* vtkSMRepresentationProxy::GetProminentValuesInf
     this->ProminentValuesInformation->SetUncertainty(uncertaintyAllowed);
     this->ProminentValuesInformation->SetFraction(fraction);
     this->ProminentValuesInformation->SetForce(force);
+    this->ProminentValuesInformation->SetUseSketches(useSketches);
 
     // Ask the server to fill out the rest of the information:
 
@@ -98,6 +98,15 @@ public:
    */
   virtual vtkPVDataInformation* GetRepresentedDataInformation();
 
+  /**
+   * Sends the request for the represented data information, if it is invalid,
+   * without waiting for the reply (see vtkSMSession::GatherInformationAsync()),
+   * so that it can be gathered along with other information. The next
+   * GetRepresentedDataInformation() waits for the reply. Returns the
+   * identifier of the request, or 0 if none was sent.
+   */
+  vtkTypeUInt32 GatherRepresentedDataInformationAsync();
+
   /**
    * Returns information about a specific array component's prominent values (or NULL).
 
@@ -222,6 +231,9 @@ private:
 
   bool RepresentedDataInformationValid;
   vtkPVDataInformation* RepresentedDataInformation;
+  // Same as vtkSMOutputPort::DataInformationRequest(Valid).
+  vtkTypeUInt32 RepresentedDataInformationRequest;
+  bool RepresentedDataInformationRequestValid;
 
   bool ProminentValuesInformationValid;
   vtkPVProminentValuesInformation* ProminentValuesInformation;
@@ -14,19 +14,23 @@
 =========================================================================*/
 #include "vtkExtractHistogram.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkGraph.h"
 #include "vtkIOStream.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
-#include "vtkIntArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
@@ -276,16 +280,167 @@ void vtkExtractHistogram::FillBinExtents(vtkDoubleArray* bin_extents, double min
   }
 }
 
-inline int vtkExtractHistogramClamp(int value, int min, int max)
+namespace
 {
-  value = value < min ? min : value;
-  value = value > max ? max : value;
-  return value;
+//-----------------------------------------------------------------------------
+// Returns the bin a value falls in. Values out of the range, including the
+// max, go to the first or last bin.
+inline int vtkExtractHistogramBinIndex(
+  double value, double min, double offset, double binDelta, int binCount)
+{
+  const double index = (value - min + offset) / binDelta;
+  if (!(index >= 0.0))
+  {
+    return 0;
+  }
+  return index < binCount ? static_cast<int>(index) : binCount - 1;
+}
+
+//-----------------------------------------------------------------------------
+// vtkSMPTools functor binning one component, or the magnitude, of an array.
+// Each thread counts into its own bins, and adds the values of the arrays to
+// average into its own totals, laid out as BinCount x NumberOfTotals.
+template <typename ArrayT>
+class vtkExtractHistogramBinner
+{
+public:
+  vtkExtractHistogramBinner(ArrayT* array, int component,
+    const std::vector<vtkDataArray*>& averaged, int numberOfTotals, int binCount, double min,
+    double offset, double binDelta)
+    : Array(array)
+    , Component(component)
+    , Averaged(averaged)
+    , NumberOfTotals(numberOfTotals)
+    , BinCount(binCount)
+    , Min(min)
+    , Offset(offset)
+    , BinDelta(binDelta)
+  {
+  }
+
+  void Initialize()
+  {
+    this->Bins.Local().assign(this->BinCount, 0);
+    this->Totals.Local().assign(static_cast<size_t>(this->BinCount) * this->NumberOfTotals, 0.0);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkDataArrayAccessor<ArrayT> accessor(this->Array);
+    const int numComps = this->Array->GetNumberOfComponents();
+    // if component is equal to the number of components, then the magnitude was requested.
+    const bool magnitude = (this->Component == numComps);
+    std::vector<vtkIdType>& bins = this->Bins.Local();
+    std::vector<double>& totals = this->Totals.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      double value = 0.0;
+      if (magnitude)
+      {
+        for (int j = 0; j < numComps; ++j)
+        {
+          const double comp = static_cast<double>(accessor.Get(i, j));
+          value += comp * comp;
+        }
+        value = sqrt(value);
+      }
+      else
+      {
+        value = static_cast<double>(accessor.Get(i, this->Component));
+      }
+      const int index = ::vtkExtractHistogramBinIndex(
+        value, this->Min, this->Offset, this->BinDelta, this->BinCount);
+      ++bins[index];
+
+      if (this->NumberOfTotals > 0)
+      {
+        double* total = &totals[static_cast<size_t>(index) * this->NumberOfTotals];
+        for (size_t idx = 0; idx < this->Averaged.size(); ++idx)
+        {
+          vtkDataArray* array = this->Averaged[idx];
+          const int arrayComps = array->GetNumberOfComponents();
+          for (int comp = 0; comp < arrayComps; ++comp)
+          {
+            *total++ += array->GetComponent(i, comp);
+          }
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+
+  ArrayT* Array;
+  int Component;
+  const std::vector<vtkDataArray*>& Averaged;
+  int NumberOfTotals;
+  int BinCount;
+  double Min;
+  double Offset;
+  double BinDelta;
+  vtkSMPThreadLocal<std::vector<vtkIdType> > Bins;
+  vtkSMPThreadLocal<std::vector<double> > Totals;
+};
+
+//-----------------------------------------------------------------------------
+// Array dispatch worker running vtkExtractHistogramBinner and adding up the
+// per-thread results in Bins and Totals.
+struct vtkExtractHistogramBinWorker
+{
+  vtkExtractHistogramBinWorker(int component, const std::vector<vtkDataArray*>& averaged,
+    int numberOfTotals, int binCount, double min, double offset, double binDelta)
+    : Component(component)
+    , Averaged(averaged)
+    , NumberOfTotals(numberOfTotals)
+    , BinCount(binCount)
+    , Min(min)
+    , Offset(offset)
+    , BinDelta(binDelta)
+    , Bins(binCount, 0)
+    , Totals(static_cast<size_t>(binCount) * numberOfTotals, 0.0)
+  {
+  }
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    vtkExtractHistogramBinner<ArrayT> binner(array, this->Component, this->Averaged,
+      this->NumberOfTotals, this->BinCount, this->Min, this->Offset, this->BinDelta);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), binner);
+
+    typedef typename vtkSMPThreadLocal<std::vector<vtkIdType> >::iterator BinsIterator;
+    for (BinsIterator iter = binner.Bins.begin(); iter != binner.Bins.end(); ++iter)
+    {
+      for (int cc = 0; cc < this->BinCount; ++cc)
+      {
+        this->Bins[cc] += (*iter)[cc];
+      }
+    }
+    typedef typename vtkSMPThreadLocal<std::vector<double> >::iterator TotalsIterator;
+    for (TotalsIterator iter = binner.Totals.begin(); iter != binner.Totals.end(); ++iter)
+    {
+      for (size_t cc = 0; cc < this->Totals.size(); ++cc)
+      {
+        this->Totals[cc] += (*iter)[cc];
+      }
+    }
+  }
+
+  int Component;
+  const std::vector<vtkDataArray*>& Averaged;
+  int NumberOfTotals;
+  int BinCount;
+  double Min;
+  double Offset;
+  double BinDelta;
+  std::vector<vtkIdType> Bins;
+  std::vector<double> Totals;
+};
 }
 
 //-----------------------------------------------------------------------------
 void vtkExtractHistogram::BinAnArray(
-  vtkDataArray* data_array, vtkIntArray* bin_values, double min, double max, vtkFieldData* field)
+  vtkDataArray* data_array, vtkIdTypeArray* bin_values, double min, double max, vtkFieldData* field)
 {
   // If the requested component is out-of-range for the input,
   // the bin_values will be 0, so no need to do any actual counting.
@@ -295,65 +450,61 @@ void vtkExtractHistogram::BinAnArray(
     return;
   }
 
-  int num_of_tuples = data_array->GetNumberOfTuples();
+  const vtkIdType num_of_tuples = data_array->GetNumberOfTuples();
   double bin_delta =
     (max - min) / (this->CenterBinsAroundMinAndMax ? (this->BinCount - 1) : this->BinCount);
   double half_delta = bin_delta / 2.0;
 
-  for (int i = 0; i != num_of_tuples; ++i)
+  // Get all other arrays, their values are added to the totals of the bins
+  // and divided by the number of elements at the end.
+  std::vector<vtkDataArray*> averaged;
+  int numberOfTotals = 0;
+  if (this->CalculateAverages && field)
   {
-    if (i % 1000 == 0)
-    {
-      this->UpdateProgress(0.10 + 0.90 * i / num_of_tuples);
-    }
-    double value;
-    // if component is equal to the number of components, then the magnitude was requested.
-    if (this->Component == data_array->GetNumberOfComponents())
+    int num_arrays = field->GetNumberOfArrays();
+    for (int idx = 0; idx < num_arrays; idx++)
     {
-      value = 0;
-      double comp;
-      for (int j = 0; j < data_array->GetNumberOfComponents(); ++j)
+      vtkDataArray* array = field->GetArray(idx);
+      if (array && array != data_array && array->GetName() &&
+        array->GetNumberOfTuples() >= num_of_tuples)
       {
-        comp = data_array->GetComponent(i, j);
-        value += comp * comp;
+        averaged.push_back(array);
+        numberOfTotals += array->GetNumberOfComponents();
       }
-      value = sqrt(value);
-    }
-    else
-    {
-      value = data_array->GetComponent(i, this->Component);
     }
-    int index = static_cast<int>(
-      (value - min + (this->CenterBinsAroundMinAndMax ? half_delta : 0.)) / bin_delta);
+  }
+
+  vtkExtractHistogramBinWorker worker(this->Component, averaged, numberOfTotals, this->BinCount,
+    min, this->CenterBinsAroundMinAndMax ? half_delta : 0., bin_delta);
+  if (!vtkArrayDispatch::Dispatch::Execute(data_array, worker))
+  {
+    // fallback to the vtkDataArray API for arrays not covered by the dispatch.
+    worker(data_array);
+  }
 
-    // If the value is equal to max, include it in the last bin.
-    index = ::vtkExtractHistogramClamp(index, 0, this->BinCount - 1);
-    bin_values->SetValue(index, bin_values->GetValue(index) + 1);
+  vtkIdType* values = bin_values->GetPointer(0);
+  for (int cc = 0; cc < this->BinCount; ++cc)
+  {
+    values[cc] += worker.Bins[cc];
+  }
 
-    if (this->CalculateAverages)
+  const double* total = worker.Totals.empty() ? NULL : &worker.Totals[0];
+  for (size_t idx = 0; idx < averaged.size(); ++idx)
+  {
+    vtkDataArray* array = averaged[idx];
+    vtkEHInternals::ArrayValuesType& arrayValues = this->Internal->ArrayValues[array->GetName()];
+    int numComps = array->GetNumberOfComponents();
+    arrayValues.TotalValues.resize(this->BinCount);
+    for (int bin = 0; bin < this->BinCount; ++bin)
     {
-      // Get all other arrays, add their value to the bin
-      // For each bin, we will need 2 values per array ->
-      // total, num. elements
-      // at the end, divide each total by num. elements
-      int num_arrays = field->GetNumberOfArrays();
-      for (int idx = 0; idx < num_arrays; idx++)
+      arrayValues.TotalValues[bin].resize(numComps, 0.0);
+      const double* binTotal = total + static_cast<size_t>(bin) * numberOfTotals;
+      for (int comp = 0; comp < numComps; comp++)
       {
-        vtkDataArray* array = field->GetArray(idx);
-        if (array && array != data_array && array->GetName())
-        {
-          vtkEHInternals::ArrayValuesType& arrayValues =
-            this->Internal->ArrayValues[array->GetName()];
-          arrayValues.TotalValues.resize(this->BinCount);
-          int numComps = array->GetNumberOfComponents();
-          arrayValues.TotalValues[index].resize(numComps);
-          for (int comp = 0; comp < numComps; comp++)
-          {
-            arrayValues.TotalValues[index][comp] += array->GetComponent(i, comp);
-          }
-        }
+        arrayValues.TotalValues[bin][comp] += binTotal[comp];
       }
     }
+    total += numComps;
   }
 }
 
@@ -383,7 +534,7 @@ int vtkExtractHistogram::RequestData(vtkInformation* /*request*/,
   bin_extents->FillComponent(0, 0.0);
 
   // Insert values into bins ...
-  vtkSmartPointer<vtkIntArray> bin_values = vtkSmartPointer<vtkIntArray>::New();
+  vtkSmartPointer<vtkIdTypeArray> bin_values = vtkSmartPointer<vtkIdTypeArray>::New();
   bin_values->SetNumberOfComponents(1);
   bin_values->SetNumberOfTuples(this->BinCount);
   bin_values->SetName("bin_values");
@@ -406,13 +557,20 @@ int vtkExtractHistogram::RequestData(vtkInformation* /*request*/,
   if (cdin)
   {
     // for composite datasets visit each leaf dataset and add in its counts
+    vtkIdType numLeaves = 0;
     vtkCompositeDataIterator* cdit = cdin->NewIterator();
+    for (cdit->InitTraversal(); !cdit->IsDoneWithTraversal(); cdit->GoToNextItem())
+    {
+      ++numLeaves;
+    }
+    vtkIdType leaf = 0;
     cdit->InitTraversal();
     while (!cdit->IsDoneWithTraversal())
     {
       vtkDataObject* dObj = cdit->GetCurrentDataObject();
       vtkDataArray* data_array = this->GetInputArrayToProcess(0, dObj);
       this->BinAnArray(data_array, bin_values, min, max, this->GetInputFieldData(dObj));
+      this->UpdateProgress(0.10 + 0.90 * (++leaf) / numLeaves);
       cdit->GoToNextItem();
     }
     cdit->Delete();
@@ -20,8 +20,11 @@
  * vtkExtractHistogram accepts any vtkDataSet as input and produces a
  * vtkPolyData containing histogram data as output.  The output vtkPolyData
  * will have contain a vtkDoubleArray named "bin_extents" which contains
- * the boundaries between each histogram bin, and a vtkUnsignedLongArray
+ * the boundaries between each histogram bin, and a vtkIdTypeArray
  * named "bin_values" which will contain the value for each bin.
+ *
+ * The values are binned concurrently using vtkSMPTools, each thread counting
+ * into its own bins which are added up once the array has been traversed.
 */
 
 #ifndef vtkExtractHistogram_h
@@ -32,7 +35,7 @@
 
 class vtkDoubleArray;
 class vtkFieldData;
-class vtkIntArray;
+class vtkIdTypeArray;
 struct vtkEHInternals;
 
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkExtractHistogram : public vtkTableAlgorithm
@@ -124,8 +127,13 @@ protected:
   virtual bool InitializeBinExtents(
     vtkInformationVector** inputVector, vtkDoubleArray* bin_extents, double& min, double& max);
 
+  /**
+   * Adds the number of values of src falling in each bin to vals. When
+   * CalculateAverages is true, the values of the other arrays of field are
+   * also added to the per-bin totals.
+   */
   void BinAnArray(
-    vtkDataArray* src, vtkIntArray* vals, double min, double max, vtkFieldData* field);
+    vtkDataArray* src, vtkIdTypeArray* vals, double min, double max, vtkFieldData* field);
 
   void FillBinExtents(vtkDoubleArray* bin_extents, double min, double max);
 
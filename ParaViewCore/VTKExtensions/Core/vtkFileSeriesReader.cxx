@@ -27,23 +27,28 @@
 #include "vtkClientServerInterpreter.h"
 #include "vtkClientServerInterpreterInitializer.h"
 #include "vtkClientServerStream.h"
+#include "vtkConditionVariable.h"
 #include "vtkGenericDataObjectReader.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkTypeTraits.h"
 
+#include <vtksys/FStream.hxx>
 #include <vtksys/SystemTools.hxx>
 
 #include "vtkSmartPointer.h"
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
 #include <algorithm>
+#include <atomic>
 #include <ctype.h> // for isprint().
 #include <map>
 #include <set>
@@ -55,6 +60,9 @@
 //=============================================================================
 vtkStandardNewMacro(vtkFileSeriesReader);
 
+int vtkFileSeriesReader::PrefetchDepth = 0;
+unsigned long vtkFileSeriesReader::PrefetchMemoryLimit = 256 * 1024;
+
 //=============================================================================
 // Internal class for holding time ranges.
 class vtkFileSeriesReaderTimeRanges
@@ -359,6 +367,220 @@ private:
 };
 }
 
+//=============================================================================
+// Internal class that reads files ahead of the pipeline on a background
+// thread. Readers open files by name, hence the prefetched data is handed to
+// them through the operating system's file cache: a file is kept in the
+// memory pool until it is requested, which ensures its contents are resident
+// when the reader opens it.
+class vtkFileSeriesReaderPrefetcher
+{
+public:
+  vtkFileSeriesReaderPrefetcher()
+    : Threader(vtkMultiThreader::New())
+    , ThreadId(-1)
+    , Terminate(false)
+    , MemoryLimit(0)
+    , MemoryUsed(0)
+  {
+  }
+
+  ~vtkFileSeriesReaderPrefetcher()
+  {
+    if (this->ThreadId >= 0)
+    {
+      this->Lock.Lock();
+      this->Terminate = true;
+      this->Condition.Broadcast();
+      this->Lock.Unlock();
+      this->Threader->TerminateThread(this->ThreadId);
+    }
+    this->Threader->Delete();
+  }
+
+  /**
+   * Replaces the files to prefetch. Files are prefetched in the given order
+   * while the memory used stays under memoryLimit bytes. Prefetched files that
+   * are no longer in the list are released.
+   */
+  void Schedule(const std::vector<std::string>& files, size_t memoryLimit)
+  {
+    this->Lock.Lock();
+    this->MemoryLimit = memoryLimit;
+    for (EntriesType::iterator iter = this->Entries.begin(); iter != this->Entries.end();)
+    {
+      if (std::find(files.begin(), files.end(), iter->first) == files.end() &&
+        iter->second.State != LOADING)
+      {
+        this->MemoryUsed -= iter->second.Data.size();
+        this->Entries.erase(iter++);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+    this->Queue = files;
+    for (size_t cc = 0; cc < files.size(); ++cc)
+    {
+      // inserts a PENDING entry if not already present.
+      this->Entries[files[cc]];
+    }
+    if (this->ThreadId < 0 && !files.empty())
+    {
+      this->ThreadId =
+        this->Threader->SpawnThread(&vtkFileSeriesReaderPrefetcher::ThreadMain, this);
+    }
+    this->Condition.Broadcast();
+    this->Lock.Unlock();
+  }
+
+  /**
+   * Releases the prefetched data for a file about to be read. Returns true if
+   * the file was prefetched, waiting for it to complete if it is being read.
+   */
+  bool Consume(const std::string& fname)
+  {
+    this->Lock.Lock();
+    EntriesType::iterator iter = this->Entries.find(fname);
+    while (iter != this->Entries.end() && iter->second.State == LOADING)
+    {
+      this->Condition.Wait(this->Lock);
+      iter = this->Entries.find(fname);
+    }
+    bool hit = false;
+    if (iter != this->Entries.end())
+    {
+      hit = (iter->second.State == READY);
+      this->MemoryUsed -= iter->second.Data.size();
+      this->Entries.erase(iter);
+    }
+    this->Queue.erase(std::remove(this->Queue.begin(), this->Queue.end(), fname), this->Queue.end());
+    this->Condition.Broadcast();
+    this->Lock.Unlock();
+    return hit;
+  }
+
+private:
+  enum States
+  {
+    PENDING,
+    LOADING,
+    READY,
+    FAILED,
+    SKIPPED
+  };
+
+  struct Entry
+  {
+    Entry()
+      : State(PENDING)
+    {
+    }
+    States State;
+    std::vector<char> Data;
+  };
+
+  static VTK_THREAD_RETURN_TYPE ThreadMain(void* arg)
+  {
+    vtkMultiThreader::ThreadInfo* info = static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+    static_cast<vtkFileSeriesReaderPrefetcher*>(info->UserData)->Run();
+    return VTK_THREAD_RETURN_VALUE;
+  }
+
+  // Returns the next file to read, or an empty string if there is nothing
+  // to read within the memory limit. Called with the lock held.
+  std::string NextFile(size_t& length)
+  {
+    for (size_t cc = 0; cc < this->Queue.size(); ++cc)
+    {
+      EntriesType::iterator iter = this->Entries.find(this->Queue[cc]);
+      if (iter == this->Entries.end() || iter->second.State != PENDING)
+      {
+        continue;
+      }
+      length = static_cast<size_t>(vtksys::SystemTools::FileLength(iter->first));
+      if (length > this->MemoryLimit)
+      {
+        // would never fit in the pool, the reader reads it itself.
+        iter->second.State = SKIPPED;
+        continue;
+      }
+      if (this->MemoryUsed + length > this->MemoryLimit)
+      {
+        // files are prefetched in order, do not skip ahead.
+        return std::string();
+      }
+      return iter->first;
+    }
+    return std::string();
+  }
+
+  void Run()
+  {
+    this->Lock.Lock();
+    while (!this->Terminate)
+    {
+      size_t length = 0;
+      std::string fname = this->NextFile(length);
+      if (fname.empty())
+      {
+        this->Condition.Wait(this->Lock);
+        continue;
+      }
+
+      Entry& entry = this->Entries[fname];
+      entry.State = LOADING;
+      this->MemoryUsed += length;
+      this->Lock.Unlock();
+
+      std::vector<char> data(length);
+      vtksys::ifstream file(fname.c_str(), std::ios::in | std::ios::binary);
+      bool success = file.good();
+      const size_t chunkSize = 1 << 20;
+      for (size_t offset = 0; success && offset < length && !this->Terminate; offset += chunkSize)
+      {
+        std::streamsize count = static_cast<std::streamsize>(std::min(chunkSize, length - offset));
+        success = !file.read(&data[offset], count).fail();
+      }
+
+      this->Lock.Lock();
+      // the entry is never erased while being loaded.
+      Entry& loaded = this->Entries[fname];
+      loaded.State = success ? READY : FAILED;
+      if (success)
+      {
+        loaded.Data.swap(data);
+      }
+      else
+      {
+        this->MemoryUsed -= length;
+      }
+      if (std::find(this->Queue.begin(), this->Queue.end(), fname) == this->Queue.end())
+      {
+        // no longer needed.
+        this->MemoryUsed -= loaded.Data.size();
+        this->Entries.erase(fname);
+      }
+      this->Condition.Broadcast();
+    }
+    this->Lock.Unlock();
+  }
+
+  typedef std::map<std::string, Entry> EntriesType;
+  EntriesType Entries;
+  std::vector<std::string> Queue;
+
+  vtkMultiThreader* Threader;
+  int ThreadId;
+  // read without the lock while a file is being loaded.
+  std::atomic<bool> Terminate;
+  size_t MemoryLimit;
+  size_t MemoryUsed;
+  vtkSimpleMutexLock Lock;
+  vtkSimpleConditionVariable Condition;
+};
+
 //=============================================================================
 struct vtkFileSeriesReaderInternals
 {
@@ -367,6 +589,9 @@ struct vtkFileSeriesReaderInternals
   std::vector<double> TimeValues;
   bool FileNameIsSet;
   vtkFileSeriesReaderTimeRanges* TimeRanges;
+  vtkFileSeriesReaderPrefetcher* Prefetcher;
+  int LastRequestedIndex;
+  int PrefetchStride;
 };
 
 //=============================================================================
@@ -378,16 +603,23 @@ vtkFileSeriesReader::vtkFileSeriesReader()
   this->Internal = new vtkFileSeriesReaderInternals;
   this->Internal->FileNameIsSet = false;
   this->Internal->TimeRanges = new vtkFileSeriesReaderTimeRanges;
+  this->Internal->Prefetcher = NULL;
+  this->Internal->LastRequestedIndex = -1;
+  this->Internal->PrefetchStride = 1;
 
   this->UseMetaFile = 0;
   this->UseJsonMetaFile = false;
 
   this->IgnoreReaderTime = false;
+
+  this->NumberOfPrefetchRequests = 0;
+  this->NumberOfPrefetchHits = 0;
 }
 
 //-----------------------------------------------------------------------------
 vtkFileSeriesReader::~vtkFileSeriesReader()
 {
+  delete this->Internal->Prefetcher;
   delete this->Internal->TimeRanges;
   delete this->Internal;
 }
@@ -638,6 +870,8 @@ int vtkFileSeriesReader::RequestUpdateExtent(vtkInformation* request,
     return 0;
   }
 
+  this->PrefetchInputs(index);
+
   // Make sure that the reader file name is set correctly and that
   // RequestInformation has been called.
   this->RequestInformationForInput(index);
@@ -659,6 +893,72 @@ int vtkFileSeriesReader::RequestUpdateExtent(vtkInformation* request,
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::PrefetchInputs(int index)
+{
+  vtkFileSeriesReaderInternals* internal = this->Internal;
+  if (index == internal->LastRequestedIndex)
+  {
+    return;
+  }
+
+  // Animations traverse the series in a constant direction and stride, use
+  // the last step to predict the next requests.
+  if (internal->LastRequestedIndex >= 0)
+  {
+    internal->PrefetchStride = index - internal->LastRequestedIndex;
+  }
+  internal->LastRequestedIndex = index;
+
+  int depth = vtkFileSeriesReader::PrefetchDepth;
+  if (depth <= 0 && !internal->Prefetcher)
+  {
+    return;
+  }
+  if (!internal->Prefetcher)
+  {
+    internal->Prefetcher = new vtkFileSeriesReaderPrefetcher;
+  }
+
+  if (depth > 0)
+  {
+    this->NumberOfPrefetchRequests++;
+    if (internal->Prefetcher->Consume(this->GetFileName(index)))
+    {
+      this->NumberOfPrefetchHits++;
+    }
+  }
+
+  std::vector<std::string> files;
+  int numFiles = static_cast<int>(this->GetNumberOfFileNames());
+  for (int cc = 1; cc <= depth; ++cc)
+  {
+    int next = index + cc * internal->PrefetchStride;
+    if (next < 0 || next >= numFiles)
+    {
+      break;
+    }
+    files.push_back(this->GetFileName(next));
+  }
+  internal->Prefetcher->Schedule(
+    files, static_cast<size_t>(vtkFileSeriesReader::PrefetchMemoryLimit) * 1024);
+}
+
+//-----------------------------------------------------------------------------
+double vtkFileSeriesReader::GetPrefetchHitRate()
+{
+  return this->NumberOfPrefetchRequests > 0
+    ? static_cast<double>(this->NumberOfPrefetchHits) / this->NumberOfPrefetchRequests
+    : 0.0;
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::ResetPrefetchStatistics()
+{
+  this->NumberOfPrefetchRequests = 0;
+  this->NumberOfPrefetchHits = 0;
+}
+
 //-----------------------------------------------------------------------------
 int vtkFileSeriesReader::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -932,6 +1232,10 @@ void vtkFileSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
      << endl;
   os << indent << "UseMetaFile: " << this->UseMetaFile << endl;
   os << indent << "IgnoreReaderTime: " << this->IgnoreReaderTime << endl;
+  os << indent << "PrefetchDepth: " << vtkFileSeriesReader::PrefetchDepth << endl;
+  os << indent << "PrefetchMemoryLimit: " << vtkFileSeriesReader::PrefetchMemoryLimit << endl;
+  os << indent << "NumberOfPrefetchRequests: " << this->NumberOfPrefetchRequests << endl;
+  os << indent << "NumberOfPrefetchHits: " << this->NumberOfPrefetchHits << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -151,6 +151,55 @@ public:
   vtkBooleanMacro(IgnoreReaderTime, bool);
   //@}
 
+  //@{
+  /**
+   * Set the number of files to read ahead, on a background thread, of the one
+   * requested by the pipeline. The next requests are predicted from the
+   * direction and stride of the last step through the series, as done when
+   * playing an animation. 0 disables prefetching. This is a global setting,
+   * default is 0.
+   */
+  static void SetPrefetchDepth(int depth)
+  {
+    vtkFileSeriesReader::PrefetchDepth = depth < 0 ? 0 : depth;
+  }
+  static int GetPrefetchDepth() { return vtkFileSeriesReader::PrefetchDepth; }
+  //@}
+
+  //@{
+  /**
+   * Set the maximum memory, in KiB, used by each reader to hold prefetched
+   * files. This is a global setting, default is 256 MiB.
+   */
+  static void SetPrefetchMemoryLimit(unsigned long limit)
+  {
+    vtkFileSeriesReader::PrefetchMemoryLimit = limit;
+  }
+  static unsigned long GetPrefetchMemoryLimit()
+  {
+    return vtkFileSeriesReader::PrefetchMemoryLimit;
+  }
+  //@}
+
+  //@{
+  /**
+   * Returns the number of files requested by the pipeline while prefetching
+   * was enabled and how many of them had been prefetched.
+   */
+  vtkGetMacro(NumberOfPrefetchRequests, vtkIdType);
+  vtkGetMacro(NumberOfPrefetchHits, vtkIdType);
+  //@}
+
+  /**
+   * Returns the fraction of the requested files that had been prefetched.
+   */
+  double GetPrefetchHitRate();
+
+  /**
+   * Resets the number of prefetch requests and hits.
+   */
+  void ResetPrefetchStatistics();
+
 protected:
   vtkFileSeriesReader();
   ~vtkFileSeriesReader() override;
@@ -216,11 +265,23 @@ protected:
 
   int ChooseInput(vtkInformation*);
 
+  /**
+   * Called when the pipeline requests the file with the given index. Updates
+   * the prefetch statistics and schedules the next files to prefetch.
+   */
+  void PrefetchInputs(int index);
+
+  vtkIdType NumberOfPrefetchRequests;
+  vtkIdType NumberOfPrefetchHits;
+
 private:
   vtkFileSeriesReader(const vtkFileSeriesReader&) = delete;
   void operator=(const vtkFileSeriesReader&) = delete;
 
   vtkFileSeriesReaderInternals* Internal;
+
+  static int PrefetchDepth;
+  static unsigned long PrefetchMemoryLimit;
 };
 
 #endif
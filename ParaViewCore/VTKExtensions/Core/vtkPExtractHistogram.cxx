@@ -14,21 +14,21 @@
 =========================================================================*/
 #include "vtkPExtractHistogram.h"
 
-#include "vtkAttributeDataReductionFilter.h"
-#include "vtkCellData.h"
 #include "vtkCommunicator.h"
-#include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
 #include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
-#include "vtkIntArray.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
-#include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
 
+#include <map>
+#include <sstream>
 #include <string>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 
 vtkStandardNewMacro(vtkPExtractHistogram);
@@ -87,73 +87,132 @@ int vtkPExtractHistogram::RequestData(
   }
 
   vtkTable* output = vtkTable::GetData(outputVector, 0);
-  vtkSmartPointer<vtkDataArray> oldExtents = output->GetRowData()->GetArray("bin_extents");
-  if (oldExtents == NULL)
+  vtkDataArray* bin_values = output->GetRowData()->GetArray("bin_values");
+  if (bin_values == NULL)
   {
     // Nothing to do if there is no data
     return 1;
   }
-  // Now we need to collect and reduce data from all nodes on the root.
-  vtkSmartPointer<vtkReductionFilter> reduceFilter = vtkSmartPointer<vtkReductionFilter>::New();
-  reduceFilter->SetController(this->Controller);
 
-  bool isRoot = (this->Controller->GetLocalProcessId() == 0);
-  if (isRoot)
+  // The bins are the same on all processes, hence the counts and totals are
+  // summed up in place instead of gathering the tables on the root.
+  vtkSmartPointer<vtkIdTypeArray> counts = vtkSmartPointer<vtkIdTypeArray>::New();
+  counts->DeepCopy(bin_values);
+  if (!this->Controller->AllReduce(counts, bin_values, vtkCommunicator::SUM_OP))
   {
-    // PostGatherHelper needs to be set only on the root node.
-    vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
-      vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
-    rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
-    rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
-    reduceFilter->SetPostGatherHelper(rf);
+    vtkErrorMacro("Parallel communication error. Could not reduce bin values.");
+    return 0;
+  }
+
+  if (this->CalculateAverages && !this->ReduceTotals(output, bin_values))
+  {
+    vtkErrorMacro("Parallel communication error. Could not reduce averages.");
+    return 0;
   }
 
-  vtkSmartPointer<vtkTable> copy = vtkSmartPointer<vtkTable>::New();
-  copy->ShallowCopy(output);
-  reduceFilter->SetInputData(copy);
-  reduceFilter->Update();
-  if (isRoot)
+  if (this->Controller->GetLocalProcessId() != 0)
   {
-    // We save the old bin_extents and then revert to be restored later since
-    // the reduction reduces the bin_extents as well.
-    output->ShallowCopy(reduceFilter->GetOutput());
-    if (output->GetRowData()->GetNumberOfArrays() == 0)
+    output->Initialize();
+  }
+
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPExtractHistogram::ReduceTotals(vtkTable* output, vtkDataArray* bin_values)
+{
+  // The arrays averaged may differ between processes, e.g. when an array is
+  // missing on some of them, hence agree on their union first.
+  vtksys::RegularExpression reg_ex("^(.*)_total$");
+  std::ostringstream localNames;
+  int numArrays = output->GetRowData()->GetNumberOfArrays();
+  for (int i = 0; i < numArrays; i++)
+  {
+    vtkDataArray* array = output->GetRowData()->GetArray(i);
+    if (array && array->GetName() && reg_ex.find(array->GetName()))
     {
-      vtkErrorMacro(<< "Reduced data has 0 arrays");
-      return 0;
+      localNames << reg_ex.match(1) << '\n' << array->GetNumberOfComponents() << '\n';
     }
-    output->GetRowData()->GetArray("bin_extents")->DeepCopy(oldExtents);
-    if (this->CalculateAverages)
+  }
+  const std::string localBuffer = localNames.str();
+
+  const int numProcs = this->Controller->GetNumberOfProcesses();
+  vtkIdType localLength = static_cast<vtkIdType>(localBuffer.size());
+  std::vector<vtkIdType> lengths(numProcs, 0);
+  std::vector<vtkIdType> offsets(numProcs, 0);
+  if (!this->Controller->AllGather(&localLength, &lengths[0], 1))
+  {
+    return false;
+  }
+  vtkIdType totalLength = 0;
+  for (int cc = 0; cc < numProcs; ++cc)
+  {
+    offsets[cc] = totalLength;
+    totalLength += lengths[cc];
+  }
+  if (totalLength == 0)
+  {
+    return true;
+  }
+  std::vector<char> allNames(totalLength);
+  if (!this->Controller->AllGatherV(
+        localBuffer.c_str(), &allNames[0], localLength, &lengths[0], &offsets[0]))
+  {
+    return false;
+  }
+
+  std::map<std::string, int> arrays;
+  std::istringstream names(std::string(allNames.begin(), allNames.end()));
+  std::string name;
+  int numComps;
+  while (std::getline(names, name) && names >> numComps && names.ignore())
+  {
+    arrays[name] = numComps;
+  }
+
+  for (std::map<std::string, int>::const_iterator iter = arrays.begin(); iter != arrays.end();
+       ++iter)
+  {
+    const std::string totalName = iter->first + "_total";
+    const std::string averageName = iter->first + "_average";
+    vtkSmartPointer<vtkDoubleArray> total = vtkDoubleArray::SafeDownCast(
+      output->GetRowData()->GetArray(totalName.c_str()));
+    if (!total || total->GetNumberOfComponents() != iter->second)
     {
-      vtkDataArray* bin_values = output->GetRowData()->GetArray("bin_values");
-      vtksys::RegularExpression reg_ex("^(.*)_average$");
-      int numArrays = output->GetRowData()->GetNumberOfArrays();
-      for (int i = 0; i < numArrays; i++)
+      // this process did not see the array, contribute zeros.
+      total = vtkSmartPointer<vtkDoubleArray>::New();
+      total->SetName(totalName.c_str());
+      total->SetNumberOfComponents(iter->second);
+      total->SetNumberOfTuples(this->BinCount);
+      for (int j = 0; j < iter->second; j++)
       {
-        vtkDataArray* array = output->GetRowData()->GetArray(i);
-        if (array && reg_ex.find(array->GetName()))
-        {
-          int numComps = array->GetNumberOfComponents();
-          std::string name = reg_ex.match(1) + "_total";
-          vtkDataArray* tarray = output->GetRowData()->GetArray(name.c_str());
-          for (vtkIdType idx = 0; idx < this->BinCount; idx++)
-          {
-            for (int j = 0; j < numComps; j++)
-            {
-              array->SetComponent(
-                idx, j, tarray->GetComponent(idx, j) / bin_values->GetTuple1(idx));
-            }
-          }
-        }
+        total->FillComponent(j, 0.0);
       }
+      output->GetRowData()->AddArray(total);
     }
-  }
-  else
-  {
-    output->Initialize();
-  }
 
-  return 1;
+    vtkSmartPointer<vtkDoubleArray> localTotal = vtkSmartPointer<vtkDoubleArray>::New();
+    localTotal->DeepCopy(total);
+    if (!this->Controller->AllReduce(localTotal, total, vtkCommunicator::SUM_OP))
+    {
+      return false;
+    }
+
+    vtkSmartPointer<vtkDoubleArray> average = vtkSmartPointer<vtkDoubleArray>::New();
+    average->SetName(averageName.c_str());
+    average->SetNumberOfComponents(iter->second);
+    average->SetNumberOfTuples(this->BinCount);
+    for (vtkIdType idx = 0; idx < this->BinCount; idx++)
+    {
+      const double count = bin_values->GetTuple1(idx);
+      for (int j = 0; j < iter->second; j++)
+      {
+        average->SetComponent(idx, j, count ? total->GetComponent(idx, j) / count : 0.0);
+      }
+    }
+    output->GetRowData()->AddArray(average);
+  }
+  return true;
 }
 
 //-----------------------------------------------------------------------------
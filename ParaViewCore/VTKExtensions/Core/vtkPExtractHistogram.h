@@ -17,7 +17,9 @@
  * @brief   Extract histogram for parallel dataset.
  *
  * vtkPExtractHistogram is vtkExtractHistogram subclass for parallel datasets.
- * It gathers the histogram data on the root node.
+ * The bin counts, and the totals used to compute averages, are summed up
+ * across processes with an all-reduce. The resulting histogram is only kept on
+ * the root node.
 */
 
 #ifndef vtkPExtractHistogram_h
@@ -26,7 +28,9 @@
 #include "vtkExtractHistogram.h"
 #include "vtkPVVTKExtensionsCoreModule.h" //needed for exports
 
+class vtkDataArray;
 class vtkMultiProcessController;
+class vtkTable;
 
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPExtractHistogram : public vtkExtractHistogram
 {
@@ -57,6 +61,13 @@ protected:
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) VTK_OVERRIDE;
 
+  /**
+   * Sums up the "_total" arrays of output across processes and recomputes
+   * the "_average" arrays from them and the reduced bin_values.
+   * Returns false on communication error.
+   */
+  bool ReduceTotals(vtkTable* output, vtkDataArray* bin_values);
+
   vtkMultiProcessController* Controller;
 
 private:
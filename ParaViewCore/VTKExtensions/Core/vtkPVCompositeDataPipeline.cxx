@@ -23,6 +23,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkInformationObjectBaseKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVExecutionTracer.h"
 #include "vtkPVPostFilterExecutive.h"
 
 #include <assert.h>
@@ -88,6 +89,28 @@ void vtkPVCompositeDataPipeline::ResetPipelineInformation(int port, vtkInformati
   this->Superclass::ResetPipelineInformation(port, info);
 }
 
+//----------------------------------------------------------------------------
+int vtkPVCompositeDataPipeline::ExecuteInformation(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  vtkPVExecutionTracerScope scope(
+    "pipeline", this->Algorithm->GetClassName(), "::RequestInformation");
+  return this->Superclass::ExecuteInformation(request, inInfoVec, outInfoVec);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVCompositeDataPipeline::ExecuteData(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  int result;
+  {
+    vtkPVExecutionTracerScope scope("pipeline", this->Algorithm->GetClassName(), "::RequestData");
+    result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+  }
+  vtkPVExecutionTracer::AddMemoryUsage();
+  return result;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVCompositeDataPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
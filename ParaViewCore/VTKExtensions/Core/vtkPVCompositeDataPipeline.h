@@ -23,6 +23,9 @@
  *     algorithms are passed along to the input vtkPVPostFilter, if one exists.
  *     vtkPVPostFilter is used to automatically extract components or generated
  *     derived arrays such as magnitude array for vectors.
+ * \li Tracing :- when vtkPVExecutionTracer is enabled, it records the time
+ *     spent in the RequestInformation and RequestData passes of the algorithm,
+ *     and the memory used after RequestData.
 */
 
 #ifndef vtkPVCompositeDataPipeline_h
@@ -49,6 +52,12 @@ protected:
   // Remove update/whole extent when resetting pipeline information.
   void ResetPipelineInformation(int port, vtkInformation*) VTK_OVERRIDE;
 
+  // Overridden to record the passes with vtkPVExecutionTracer.
+  int ExecuteInformation(vtkInformation* request, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec) VTK_OVERRIDE;
+  int ExecuteData(vtkInformation* request, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec) VTK_OVERRIDE;
+
 private:
   vtkPVCompositeDataPipeline(const vtkPVCompositeDataPipeline&) = delete;
   void operator=(const vtkPVCompositeDataPipeline&) = delete;
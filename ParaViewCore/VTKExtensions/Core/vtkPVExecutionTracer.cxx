@@ -0,0 +1,440 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVExecutionTracer.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVExecutionTracer.h"
+
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemInformation.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+struct vtkPVExecutionTracerEvent
+{
+  char Name[64];
+  const char* Category;
+  const char* ArgName;
+  double ArgValue;
+  double Start;    // in seconds
+  double Duration; // in seconds, negative for counters
+};
+
+//----------------------------------------------------------------------------
+// Single writer ring buffer. Only the owning thread pushes events, readers
+// only read the events published by the release store on Head.
+class vtkPVExecutionTracerBuffer
+{
+public:
+  vtkPVExecutionTracerBuffer(int capacity, int threadId)
+    : Events(static_cast<size_t>(capacity))
+    , Head(0)
+    , ThreadId(threadId)
+  {
+  }
+
+  vtkPVExecutionTracerEvent& Next()
+  {
+    return this->Events[this->Head.load(std::memory_order_relaxed) % this->Events.size()];
+  }
+
+  void Publish() { this->Head.fetch_add(1, std::memory_order_release); }
+
+  std::vector<vtkPVExecutionTracerEvent> Events;
+  std::atomic<vtkTypeUInt64> Head;
+  int ThreadId;
+};
+
+std::atomic<bool> TracerEnabled(false);
+std::atomic<int> TracerBufferCapacity(65536);
+std::atomic<double> TracerMemorySamplingInterval(0.5);
+std::atomic<double> TracerNextMemorySample(0.0);
+std::atomic<vtkTypeUInt64> TracerMemoryHighWaterMark(0);
+
+// The buffers are owned by the registry and never released so that the
+// events of threads that exited can still be written.
+std::mutex TracerRegistryMutex;
+std::vector<std::unique_ptr<vtkPVExecutionTracerBuffer> > TracerRegistry;
+
+//----------------------------------------------------------------------------
+vtkPVExecutionTracerBuffer* vtkGetThreadBuffer()
+{
+  static thread_local vtkPVExecutionTracerBuffer* buffer = NULL;
+  if (buffer == NULL)
+  {
+    std::lock_guard<std::mutex> lock(TracerRegistryMutex);
+    const int threadId = static_cast<int>(TracerRegistry.size());
+    TracerRegistry.push_back(std::unique_ptr<vtkPVExecutionTracerBuffer>(
+      new vtkPVExecutionTracerBuffer(TracerBufferCapacity, threadId)));
+    buffer = TracerRegistry.back().get();
+  }
+  return buffer;
+}
+
+//----------------------------------------------------------------------------
+void vtkCopyName(char name[64], const char* first, const char* second)
+{
+  size_t len = 0;
+  for (const char* part : { first, second })
+  {
+    for (; part && *part && len < 63; ++part)
+    {
+      name[len++] = *part;
+    }
+  }
+  name[len] = '\0';
+}
+
+//----------------------------------------------------------------------------
+void vtkWriteJSONString(std::ostream& os, const char* str)
+{
+  os << '"';
+  for (; str && *str; ++str)
+  {
+    const unsigned char c = static_cast<unsigned char>(*str);
+    if (c == '"' || c == '\\')
+    {
+      os << '\\' << *str;
+    }
+    else if (c < 0x20)
+    {
+      os << ' ';
+    }
+    else
+    {
+      os << *str;
+    }
+  }
+  os << '"';
+}
+
+//----------------------------------------------------------------------------
+// Serializes the events of this process, each followed by a ",\n", with
+// timestamps shifted by `offset` seconds. The buffers are read without
+// synchronizing with the threads that own them, an event being recorded at
+// the same time may be written partially.
+std::string vtkSerializeEvents(int pid, double offset)
+{
+  std::ostringstream os;
+  os << std::fixed;
+  os.precision(3);
+  os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+     << ",\"args\":{\"name\":\"rank " << pid << "\"}},\n";
+
+  std::vector<vtkPVExecutionTracerBuffer*> buffers;
+  {
+    std::lock_guard<std::mutex> lock(TracerRegistryMutex);
+    for (auto& buffer : TracerRegistry)
+    {
+      buffers.push_back(buffer.get());
+    }
+  }
+
+  for (auto buffer : buffers)
+  {
+    const vtkTypeUInt64 head = buffer->Head.load(std::memory_order_acquire);
+    const vtkTypeUInt64 capacity = buffer->Events.size();
+    for (vtkTypeUInt64 cc = head > capacity ? head - capacity : 0; cc < head; ++cc)
+    {
+      const vtkPVExecutionTracerEvent& event = buffer->Events[cc % capacity];
+      os << "{\"name\":";
+      vtkWriteJSONString(os, event.Name);
+      os << ",\"cat\":";
+      vtkWriteJSONString(os, event.Category);
+      os << ",\"ph\":\"" << (event.Duration < 0 ? 'C' : 'X')
+         << "\",\"ts\":" << (event.Start - offset) * 1e6;
+      if (event.Duration >= 0)
+      {
+        os << ",\"dur\":" << event.Duration * 1e6;
+      }
+      os << ",\"pid\":" << pid << ",\"tid\":" << buffer->ThreadId;
+      if (event.ArgName)
+      {
+        os << ",\"args\":{";
+        vtkWriteJSONString(os, event.ArgName);
+        os << ":" << event.ArgValue << "}";
+      }
+      os << "},\n";
+    }
+  }
+  return os.str();
+}
+}
+
+vtkStandardNewMacro(vtkPVExecutionTracer);
+//----------------------------------------------------------------------------
+vtkPVExecutionTracer::vtkPVExecutionTracer()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVExecutionTracer::~vtkPVExecutionTracer()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExecutionTracer::SetEnabled(bool val)
+{
+  TracerEnabled = val;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVExecutionTracer::GetEnabled()
+{
+  return TracerEnabled.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExecutionTracer::SetBufferCapacity(int capacity)
+{
+  TracerBufferCapacity = std::max(capacity, 16);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVExecutionTracer::GetBufferCapacity()
+{
+  return TracerBufferCapacity;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExecutionTracer::SetMemorySamplingInterval(double seconds)
+{
+  TracerMemorySamplingInterval = std::max(seconds, 0.0);
+}
+
+//----------------------------------------------------------------------------
+double vtkPVExecutionTracer::GetMemorySamplingInterval()
+{
+  return TracerMemorySamplingInterval;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExecutionTracer::AddSpan(const char* category, const char* name, double startTime,
+  double endTime, const char* argName, double argValue)
+{
+  if (!vtkPVExecutionTracer::GetEnabled())
+  {
+    return;
+  }
+
+  vtkPVExecutionTracerBuffer* buffer = vtkGetThreadBuffer();
+  vtkPVExecutionTracerEvent& event = buffer->Next();
+  vtkCopyName(event.Name, name, NULL);
+  event.Category = category;
+  event.ArgName = argName;
+  event.ArgValue = argValue;
+  event.Start = startTime;
+  event.Duration = std::max(endTime - startTime, 0.0);
+  buffer->Publish();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExecutionTracer::AddCounter(const char* category, const char* name, double value)
+{
+  if (!vtkPVExecutionTracer::GetEnabled())
+  {
+    return;
+  }
+
+  vtkPVExecutionTracerBuffer* buffer = vtkGetThreadBuffer();
+  vtkPVExecutionTracerEvent& event = buffer->Next();
+  vtkCopyName(event.Name, name, NULL);
+  event.Category = category;
+  event.ArgName = "value";
+  event.ArgValue = value;
+  event.Start = vtkTimerLog::GetUniversalTime();
+  event.Duration = -1.0;
+  buffer->Publish();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExecutionTracer::AddMemoryUsage()
+{
+  if (!vtkPVExecutionTracer::GetEnabled())
+  {
+    return;
+  }
+
+  // Reading the memory used is expensive, sample it at most once per
+  // interval. Only the thread that moves the next sample time records it.
+  const double now = vtkTimerLog::GetUniversalTime();
+  double next = TracerNextMemorySample.load(std::memory_order_relaxed);
+  if (now < next ||
+    !TracerNextMemorySample.compare_exchange_strong(next, now + TracerMemorySamplingInterval))
+  {
+    return;
+  }
+
+  vtksys::SystemInformation sysInfo;
+  const long long used = sysInfo.GetProcMemoryUsed();
+  if (used < 0)
+  {
+    return;
+  }
+
+  vtkTypeUInt64 highWaterMark = TracerMemoryHighWaterMark.load();
+  while (highWaterMark < static_cast<vtkTypeUInt64>(used) &&
+    !TracerMemoryHighWaterMark.compare_exchange_weak(
+      highWaterMark, static_cast<vtkTypeUInt64>(used)))
+  {
+  }
+  highWaterMark = std::max(highWaterMark, static_cast<vtkTypeUInt64>(used));
+  vtkPVExecutionTracer::AddCounter("memory", "memory used (KiB)", static_cast<double>(used));
+  vtkPVExecutionTracer::AddCounter(
+    "memory", "memory high-water mark (KiB)", static_cast<double>(highWaterMark));
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExecutionTracer::Clear()
+{
+  std::lock_guard<std::mutex> lock(TracerRegistryMutex);
+  for (auto& buffer : TracerRegistry)
+  {
+    buffer->Head = 0;
+  }
+  TracerNextMemorySample = 0.0;
+  TracerMemoryHighWaterMark = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVExecutionTracer::GetNumberOfDroppedEvents()
+{
+  vtkIdType dropped = 0;
+  std::lock_guard<std::mutex> lock(TracerRegistryMutex);
+  for (auto& buffer : TracerRegistry)
+  {
+    const vtkTypeUInt64 head = buffer->Head.load(std::memory_order_acquire);
+    if (head > buffer->Events.size())
+    {
+      dropped += static_cast<vtkIdType>(head - buffer->Events.size());
+    }
+  }
+  return dropped;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVExecutionTracer::Write(const char* filename, vtkMultiProcessController* controller)
+{
+  controller = controller ? controller : vtkMultiProcessController::GetGlobalController();
+  const int numProcs = controller ? controller->GetNumberOfProcesses() : 1;
+  const int myId = controller ? controller->GetLocalProcessId() : 0;
+
+  // Align the clocks of all processes on the root's, assuming all leave the
+  // barrier at the same time. This is much more accurate than relying on the
+  // clocks of the nodes being synchronized.
+  double offset = 0.0;
+  if (numProcs > 1)
+  {
+    controller->Barrier();
+    const double localTime = vtkTimerLog::GetUniversalTime();
+    double rootTime = localTime;
+    controller->Broadcast(&rootTime, 1, 0);
+    offset = localTime - rootTime;
+  }
+
+  const std::string events = vtkSerializeEvents(myId, offset);
+  std::vector<char> allEvents;
+  if (numProcs > 1)
+  {
+    vtkIdType length = static_cast<vtkIdType>(events.size());
+    std::vector<vtkIdType> lengths(numProcs, 0);
+    controller->Gather(&length, &lengths[0], 1, 0);
+
+    std::vector<vtkIdType> offsets(numProcs, 0);
+    for (int cc = 1; cc < numProcs; ++cc)
+    {
+      offsets[cc] = offsets[cc - 1] + lengths[cc - 1];
+    }
+    if (myId == 0)
+    {
+      allEvents.resize(static_cast<size_t>(offsets[numProcs - 1] + lengths[numProcs - 1]) + 1);
+    }
+    controller->GatherV(events.c_str(), allEvents.empty() ? NULL : &allEvents[0], length,
+      &lengths[0], &offsets[0], 0);
+  }
+  else
+  {
+    allEvents.assign(events.begin(), events.end());
+    allEvents.push_back('\0');
+  }
+
+  if (myId != 0)
+  {
+    return true;
+  }
+
+  vtksys::ofstream ofs(filename, ios::out | ios::trunc);
+  if (!ofs)
+  {
+    vtkGenericWarningMacro("Failed to open '" << filename << "' to write the trace events.");
+    return false;
+  }
+
+  // drop the trailing ",\n" of the last event.
+  std::string allEventsStr(allEvents.begin(), allEvents.end() - 1);
+  if (allEventsStr.size() >= 2)
+  {
+    allEventsStr.resize(allEventsStr.size() - 2);
+  }
+  ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" << allEventsStr << "\n]}\n";
+  return static_cast<bool>(ofs);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExecutionTracer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Enabled: " << vtkPVExecutionTracer::GetEnabled() << endl;
+  os << indent << "BufferCapacity: " << vtkPVExecutionTracer::GetBufferCapacity() << endl;
+  os << indent << "MemorySamplingInterval: " << vtkPVExecutionTracer::GetMemorySamplingInterval()
+     << endl;
+}
+
+//****************************************************************************
+//----------------------------------------------------------------------------
+vtkPVExecutionTracerScope::vtkPVExecutionTracerScope(
+  const char* category, const char* name, const char* suffix)
+  : Category(NULL)
+  , ArgName(NULL)
+  , ArgValue(0.0)
+  , StartTime(0.0)
+{
+  this->Name[0] = '\0';
+  if (vtkPVExecutionTracer::GetEnabled())
+  {
+    this->Category = category;
+    vtkCopyName(this->Name, name, suffix);
+    this->StartTime = vtkTimerLog::GetUniversalTime();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkPVExecutionTracerScope::~vtkPVExecutionTracerScope()
+{
+  if (this->Category)
+  {
+    vtkPVExecutionTracer::AddSpan(this->Category, this->Name, this->StartTime,
+      vtkTimerLog::GetUniversalTime(), this->ArgName, this->ArgValue);
+  }
+}
@@ -0,0 +1,178 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVExecutionTracer.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVExecutionTracer
+ * @brief   records timed spans and counters and saves them as a Chrome
+ * trace-event file.
+ *
+ * vtkPVExecutionTracer is a low overhead alternative to vtkTimerLog meant to
+ * analyze the execution of parallel jobs. Spans, i.e. named intervals of time,
+ * and counters are recorded in a fixed size ring buffer owned by the thread
+ * that records them, hence recording only locks when a thread records its
+ * first event, to register its buffer. When a buffer is full, the oldest
+ * events are overwritten.
+ *
+ * Write() gathers the events of all processes to the root process and saves
+ * them in the trace-event JSON format, which can be loaded in Chrome's
+ * about:tracing or in Perfetto. Each process is shown as a separate process
+ * in the trace, named after its rank, and timestamps are aligned across
+ * processes.
+ *
+ * Recording is disabled by default. Once enabled, vtkPVCompositeDataPipeline
+ * records a span for every RequestInformation and RequestData pass along with
+ * samples of the memory used by the process, the data movers record the
+ * amount of data they move and vtkIceTCompositePass records the time spent
+ * compositing. Use vtkPVExecutionTracerScope to instrument other code.
+ * ParaView executables enable it when passed `--trace-events=<filename>` and
+ * write the trace to that file when exiting.
+ */
+
+#ifndef vtkPVExecutionTracer_h
+#define vtkPVExecutionTracer_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+
+class vtkMultiProcessController;
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVExecutionTracer : public vtkObject
+{
+public:
+  static vtkPVExecutionTracer* New();
+  vtkTypeMacro(vtkPVExecutionTracer, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) VTK_OVERRIDE;
+
+  //@{
+  /**
+   * Enable/disable recording. Disabled by default.
+   */
+  static void SetEnabled(bool);
+  static bool GetEnabled();
+  //@}
+
+  //@{
+  /**
+   * Set the number of events each thread can hold before overwriting its
+   * oldest ones. Only affects threads that record their first event after
+   * the call. Default is 65536.
+   */
+  static void SetBufferCapacity(int);
+  static int GetBufferCapacity();
+  //@}
+
+  /**
+   * Records a span, in seconds as returned by vtkTimerLog::GetUniversalTime().
+   * `category` and `argName` must be string literals, or at least outlive the
+   * tracer. `name` is copied, and truncated if longer than 63 characters.
+   * `argName` may be NULL, in which case `argValue` is ignored.
+   */
+  static void AddSpan(const char* category, const char* name, double startTime, double endTime,
+    const char* argName = NULL, double argValue = 0.0);
+
+  /**
+   * Records the value of a counter at the current time. Each counter is shown
+   * as a graph in the trace. `category` must be a string literal.
+   */
+  static void AddCounter(const char* category, const char* name, double value);
+
+  //@{
+  /**
+   * Set the minimum time, in seconds, between two samples of the memory used
+   * by the process. Default is 0.5.
+   */
+  static void SetMemorySamplingInterval(double seconds);
+  static double GetMemorySamplingInterval();
+  //@}
+
+  /**
+   * Records the memory used by the process and its high-water mark, in KiB,
+   * as counters. Does nothing if the memory was sampled less than
+   * MemorySamplingInterval seconds ago, as reading it is expensive.
+   */
+  static void AddMemoryUsage();
+
+  /**
+   * Saves the events recorded by all processes to `filename`. This must be
+   * called on all processes of `controller`, and only the root process
+   * writes the file. If `controller` is NULL, the global controller is used.
+   * The buffers of the other threads are read without locking, hence the
+   * pipeline must be idle: an event recorded by another thread during the
+   * call may be written partially. Returns false on failure.
+   */
+  static bool Write(const char* filename, vtkMultiProcessController* controller = NULL);
+
+  /**
+   * Discards all recorded events. As for Write(), other threads should not be
+   * recording when this is called.
+   */
+  static void Clear();
+
+  /**
+   * Returns the number of events overwritten on this process since the last
+   * call to Clear() because a buffer was full.
+   */
+  static vtkIdType GetNumberOfDroppedEvents();
+
+protected:
+  vtkPVExecutionTracer();
+  ~vtkPVExecutionTracer() override;
+
+private:
+  vtkPVExecutionTracer(const vtkPVExecutionTracer&) = delete;
+  void operator=(const vtkPVExecutionTracer&) = delete;
+};
+
+#ifndef __VTK_WRAP__
+/**
+ * @class   vtkPVExecutionTracerScope
+ * @brief   records a span covering its lifetime.
+ *
+ * vtkPVExecutionTracerScope records a span with vtkPVExecutionTracer from its
+ * construction to its destruction, when the tracer is enabled at
+ * construction. The name is built as the concatenation of `name` and
+ * `suffix`, if any, e.g.
+ * @code{cpp}
+ * vtkPVExecutionTracerScope scope("pipeline", algorithm->GetClassName(), "::RequestData");
+ * @endcode
+ */
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVExecutionTracerScope
+{
+public:
+  vtkPVExecutionTracerScope(const char* category, const char* name, const char* suffix = NULL);
+  ~vtkPVExecutionTracerScope();
+
+  /**
+   * Sets the argument recorded along with the span, e.g. the number of bytes
+   * processed. `name` must be a string literal.
+   */
+  void SetArgument(const char* name, double value)
+  {
+    this->ArgName = name;
+    this->ArgValue = value;
+  }
+
+private:
+  vtkPVExecutionTracerScope(const vtkPVExecutionTracerScope&) = delete;
+  void operator=(const vtkPVExecutionTracerScope&) = delete;
+
+  const char* Category;
+  char Name[64];
+  const char* ArgName;
+  double ArgValue;
+  double StartTime;
+};
+#endif
+
+#endif
@@ -0,0 +1,211 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestAMRDualMultiThreading.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Runs vtkAMRDualContour and vtkAMRDualClip on a CTH AMR dataset with the
+// blocks processed one after the other and concurrently, and checks that the
+// outputs are identical.
+
+#include "vtkAMRDualClip.h"
+#include "vtkAMRDualContour.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDummyController.h"
+#include "vtkIdList.h"
+#include "vtkMultiThreader.h"
+#include "vtkNew.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpyPlotReader.h"
+#include "vtkTestUtilities.h"
+
+namespace
+{
+const char* ArrayName = "Material volume fraction - 2";
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b, const char* name)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    cerr << "ERROR: array " << name << " differs in size." << endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        cerr << "ERROR: array " << name << " differs at tuple " << i << "." << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    cerr << "ERROR: the number of arrays differs." << endl;
+    return false;
+  }
+  for (int cc = 0; cc < a->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* array = a->GetArray(cc);
+    if (array && !SameArrays(array, b->GetArray(array->GetName()), array->GetName()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameDataSets(vtkDataSet* a, vtkDataSet* b)
+{
+  if (!a || !b || a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    cerr << "ERROR: the numbers of points or cells differ." << endl;
+    return false;
+  }
+  vtkPointSet* pa = vtkPointSet::SafeDownCast(a);
+  vtkPointSet* pb = vtkPointSet::SafeDownCast(b);
+  if (pa && pa->GetPoints() &&
+    !SameArrays(pa->GetPoints()->GetData(), pb->GetPoints()->GetData(), "Points"))
+  {
+    return false;
+  }
+  vtkNew<vtkIdList> ida;
+  vtkNew<vtkIdList> idb;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    a->GetCellPoints(cellId, ida.Get());
+    b->GetCellPoints(cellId, idb.Get());
+    bool same = ida->GetNumberOfIds() == idb->GetNumberOfIds();
+    for (vtkIdType ii = 0; same && ii < ida->GetNumberOfIds(); ++ii)
+    {
+      same = ida->GetId(ii) == idb->GetId(ii);
+    }
+    if (!same)
+    {
+      cerr << "ERROR: cell " << cellId << " differs." << endl;
+      return false;
+    }
+  }
+  return SameAttributes(a->GetPointData(), b->GetPointData()) &&
+    SameAttributes(a->GetCellData(), b->GetCellData());
+}
+
+bool SameOutputs(vtkDataObject* a, vtkDataObject* b)
+{
+  vtkCompositeDataSet* ca = vtkCompositeDataSet::SafeDownCast(a);
+  vtkCompositeDataSet* cb = vtkCompositeDataSet::SafeDownCast(b);
+  if (!ca || !cb)
+  {
+    cerr << "ERROR: the outputs are not composite datasets." << endl;
+    return false;
+  }
+
+  vtkSmartPointer<vtkCompositeDataIterator> ia;
+  ia.TakeReference(ca->NewIterator());
+  vtkSmartPointer<vtkCompositeDataIterator> ib;
+  ib.TakeReference(cb->NewIterator());
+  vtkIdType numCells = 0;
+  for (ia->InitTraversal(), ib->InitTraversal(); !ia->IsDoneWithTraversal();
+       ia->GoToNextItem(), ib->GoToNextItem())
+  {
+    vtkDataSet* da = vtkDataSet::SafeDownCast(ia->GetCurrentDataObject());
+    if (ib->IsDoneWithTraversal() ||
+      !SameDataSets(da, vtkDataSet::SafeDownCast(ib->GetCurrentDataObject())))
+    {
+      return false;
+    }
+    numCells += da->GetNumberOfCells();
+  }
+  if (!ib->IsDoneWithTraversal() || numCells == 0)
+  {
+    cerr << "ERROR: the outputs do not have the same blocks, or are empty." << endl;
+    return false;
+  }
+  return true;
+}
+
+template <class FilterType>
+vtkSmartPointer<FilterType> NewFilter(vtkSpyPlotReader* reader, int mergePoints, int threaded)
+{
+  vtkSmartPointer<FilterType> filter = vtkSmartPointer<FilterType>::New();
+  filter->SetInputConnection(reader->GetOutputPort());
+  filter->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, ArrayName);
+  filter->SetIsoValue(0.1);
+  filter->SetEnableDegenerateCells(1);
+  filter->SetEnableMultiProcessCommunication(0);
+  filter->SetEnableMergePoints(mergePoints);
+  filter->SetEnableMultiThreading(threaded);
+  filter->Update();
+  return filter;
+}
+
+template <class FilterType>
+bool TestFilter(vtkSpyPlotReader* reader, int mergePoints, const char* name)
+{
+  vtkSmartPointer<FilterType> serial = NewFilter<FilterType>(reader, mergePoints, 0);
+  vtkSmartPointer<FilterType> threaded = NewFilter<FilterType>(reader, mergePoints, 1);
+  if (!SameOutputs(serial->GetOutputDataObject(0), threaded->GetOutputDataObject(0)))
+  {
+    cerr << "ERROR: " << name << " differs when the blocks are processed concurrently"
+         << (mergePoints ? ", merging points." : ".") << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestAMRDualMultiThreading(int argc, char* argv[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller.Get());
+  // splits the blocks in several lists whatever the number of cores.
+  vtkMultiThreader::SetGlobalDefaultNumberOfThreads(4);
+
+  char* fname =
+    vtkTestUtilities::ExpandDataFileName(argc, argv, "SPCTH/Dave_Karelitz_Small/spcth_a");
+  vtkNew<vtkSpyPlotReader> reader;
+  reader->SetFileName(fname);
+  reader->SetGlobalController(controller.Get());
+  reader->MergeXYZComponentsOn();
+  reader->DownConvertVolumeFractionOn();
+  reader->SetCellArrayStatus(ArrayName, 1);
+  reader->Update();
+  delete[] fname;
+
+  int status = EXIT_SUCCESS;
+  // the level masks of the clip are only computed when merging points.
+  if (!TestFilter<vtkAMRDualContour>(reader.Get(), 0, "vtkAMRDualContour") ||
+    !TestFilter<vtkAMRDualContour>(reader.Get(), 1, "vtkAMRDualContour") ||
+    !TestFilter<vtkAMRDualClip>(reader.Get(), 1, "vtkAMRDualClip"))
+  {
+    status = EXIT_FAILURE;
+  }
+
+  vtkMultiThreader::SetGlobalDefaultNumberOfThreads(0);
+  vtkMultiProcessController::SetGlobalController(NULL);
+  return status;
+}
@@ -0,0 +1,228 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestMaterialInterfaceParallelLabeling.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Extracts the fragments of a CTH AMR dataset with serial and with parallel
+// labeling and checks that both find the same fragments, with the same ids,
+// volumes and integrated attributes. The dataset has several levels of
+// refinement. With MPI, its blocks are distributed across the processes, so
+// that fragments are also linked through the ghost blocks of the others.
+
+#include "vtkPVConfig.h"
+
+#include "vtkDataArray.h"
+#include "vtkMaterialInterfaceFilter.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkNonOverlappingAMR.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSpyPlotReader.h"
+#include "vtkTestUtilities.h"
+
+#ifdef PARAVIEW_USE_MPI
+#include "vtkMPIController.h"
+#else
+#include "vtkDummyController.h"
+#endif
+
+#include <cmath>
+#include <map>
+#include <string>
+
+namespace
+{
+void SetupFilter(vtkMaterialInterfaceFilter* filter, vtkSpyPlotReader* reader, int parallel)
+{
+  filter->SetInputConnection(reader->GetOutputPort());
+  filter->SetParallelLabeling(parallel);
+  for (int cc = 0; cc < reader->GetNumberOfCellArrays(); ++cc)
+  {
+    // the volume fractions define the materials, the other arrays are
+    // integrated over the fragments.
+    const std::string name = reader->GetCellArrayName(cc);
+    if (name.find("volume fraction") != std::string::npos)
+    {
+      filter->SelectMaterialArray(name.c_str());
+    }
+    else
+    {
+      filter->SelectVolumeWtdAvgArray(name.c_str());
+      filter->SelectSummationArray(name.c_str());
+    }
+  }
+  filter->Update();
+}
+
+// Maps fragment ids to their index in the attributes.
+bool GetFragments(vtkPointData* pd, std::map<int, vtkIdType>& fragments)
+{
+  vtkDataArray* ids = pd->GetArray("Id");
+  if (!ids)
+  {
+    cerr << "ERROR: the fragments have no ids." << endl;
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < ids->GetNumberOfTuples(); ++cc)
+  {
+    if (!fragments.insert(std::make_pair(static_cast<int>(ids->GetTuple1(cc)), cc)).second)
+    {
+      cerr << "ERROR: fragment id " << ids->GetTuple1(cc) << " is repeated." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameFragments(vtkPolyData* serial, vtkPolyData* parallel)
+{
+  std::map<int, vtkIdType> serialFragments;
+  std::map<int, vtkIdType> parallelFragments;
+  if (!serial || !parallel || !GetFragments(serial->GetPointData(), serialFragments) ||
+    !GetFragments(parallel->GetPointData(), parallelFragments))
+  {
+    return false;
+  }
+  if (serialFragments.size() != parallelFragments.size())
+  {
+    cerr << "ERROR: found " << parallelFragments.size() << " fragments instead of "
+         << serialFragments.size() << "." << endl;
+    return false;
+  }
+
+  vtkPointData* spd = serial->GetPointData();
+  vtkPointData* ppd = parallel->GetPointData();
+  if (spd->GetNumberOfArrays() != ppd->GetNumberOfArrays())
+  {
+    cerr << "ERROR: the number of attributes differs." << endl;
+    return false;
+  }
+  for (int cc = 0; cc < spd->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* sa = spd->GetArray(cc);
+    if (!sa)
+    {
+      continue;
+    }
+    vtkDataArray* pa = ppd->GetArray(sa->GetName());
+    if (!pa || pa->GetNumberOfComponents() != sa->GetNumberOfComponents())
+    {
+      cerr << "ERROR: attribute " << sa->GetName() << " differs." << endl;
+      return false;
+    }
+    std::map<int, vtkIdType>::const_iterator siter = serialFragments.begin();
+    for (; siter != serialFragments.end(); ++siter)
+    {
+      std::map<int, vtkIdType>::const_iterator piter = parallelFragments.find(siter->first);
+      if (piter == parallelFragments.end())
+      {
+        cerr << "ERROR: fragment " << siter->first << " is missing." << endl;
+        return false;
+      }
+      for (int comp = 0; comp < sa->GetNumberOfComponents(); ++comp)
+      {
+        // the sums may be accumulated in another order.
+        const double sv = sa->GetComponent(siter->second, comp);
+        const double pv = pa->GetComponent(piter->second, comp);
+        if (std::abs(sv - pv) > 1e-6 * (1 + std::abs(sv)))
+        {
+          cerr << "ERROR: attribute " << sa->GetName() << " of fragment " << siter->first
+               << " differs: " << sv << " vs " << pv << endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// The statistics output has one block per material, with one point per
+// fragment.
+bool SameStatistics(vtkMultiBlockDataSet* serial, vtkMultiBlockDataSet* parallel)
+{
+  if (!serial || !parallel || serial->GetNumberOfBlocks() == 0 ||
+    serial->GetNumberOfBlocks() != parallel->GetNumberOfBlocks())
+  {
+    cerr << "ERROR: the materials differ." << endl;
+    return false;
+  }
+  bool same = true;
+  for (unsigned int cc = 0; cc < serial->GetNumberOfBlocks(); ++cc)
+  {
+    if (!SameFragments(vtkPolyData::SafeDownCast(serial->GetBlock(cc)),
+          vtkPolyData::SafeDownCast(parallel->GetBlock(cc))))
+    {
+      cerr << "ERROR: the fragments of material " << cc << " differ when labeled in parallel."
+           << endl;
+      same = false;
+    }
+  }
+  return same;
+}
+}
+
+int TestMaterialInterfaceParallelLabeling(int argc, char* argv[])
+{
+#ifdef PARAVIEW_USE_MPI
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv, 0);
+#else
+  vtkNew<vtkDummyController> controller;
+#endif
+  vtkMultiProcessController::SetGlobalController(controller.Get());
+
+  char* fname =
+    vtkTestUtilities::ExpandDataFileName(argc, argv, "SPCTH/Dave_Karelitz_Small/spcth_a");
+  vtkNew<vtkSpyPlotReader> reader;
+  reader->SetFileName(fname);
+  reader->SetGlobalController(controller.Get());
+  reader->MergeXYZComponentsOn();
+  reader->DownConvertVolumeFractionOn();
+  reader->UpdateInformation();
+  for (int cc = 0; cc < reader->GetNumberOfCellArrays(); ++cc)
+  {
+    reader->SetCellArrayStatus(reader->GetCellArrayName(cc), 1);
+  }
+  delete[] fname;
+
+  vtkNew<vtkMaterialInterfaceFilter> serial;
+  SetupFilter(serial.Get(), reader.Get(), 0);
+  vtkNew<vtkMaterialInterfaceFilter> parallel;
+  SetupFilter(parallel.Get(), reader.Get(), 1);
+
+  // the statistics are gathered on the first process.
+  int status = 1;
+  if (controller->GetLocalProcessId() == 0)
+  {
+    vtkNonOverlappingAMR* amr =
+      vtkNonOverlappingAMR::SafeDownCast(reader->GetOutputDataObject(0));
+    if (!amr || amr->GetNumberOfLevels() < 2)
+    {
+      cerr << "ERROR: the dataset does not have several levels." << endl;
+      status = 0;
+    }
+    if (!SameStatistics(vtkMultiBlockDataSet::SafeDownCast(serial->GetOutputDataObject(1)),
+          vtkMultiBlockDataSet::SafeDownCast(parallel->GetOutputDataObject(1))))
+    {
+      status = 0;
+    }
+  }
+
+  int allStatus = 0;
+  controller->AllReduce(&status, &allStatus, 1, vtkCommunicator::MIN_OP);
+  vtkMultiProcessController::SetGlobalController(NULL);
+#ifdef PARAVIEW_USE_MPI
+  controller->Finalize();
+#endif
+  return allStatus ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,157 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPEnSightMemoryMappedFiles.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads EnSight Gold binary cases with and without memory mapped files and
+// checks that the outputs are identical.
+
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkNew.h"
+#include "vtkPGenericEnSightReader.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+namespace
+{
+bool SameArrays(vtkDataArray* a, vtkDataArray* b, const char* name)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    cerr << "ERROR: array " << name << " differs in size." << endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        cerr << "ERROR: array " << name << " differs at tuple " << i << "." << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    cerr << "ERROR: the number of arrays differs." << endl;
+    return false;
+  }
+  for (int cc = 0; cc < a->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* array = a->GetArray(cc);
+    if (array && !SameArrays(array, b->GetArray(array->GetName()), array->GetName()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameDataSets(vtkDataSet* a, vtkDataSet* b)
+{
+  if (!a || !b || a->GetDataObjectType() != b->GetDataObjectType() ||
+    a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    cerr << "ERROR: datasets differ in type or size." << endl;
+    return false;
+  }
+  vtkPointSet* pa = vtkPointSet::SafeDownCast(a);
+  vtkPointSet* pb = vtkPointSet::SafeDownCast(b);
+  if (pa && pa->GetPoints() &&
+    !SameArrays(pa->GetPoints()->GetData(), pb->GetPoints()->GetData(), "Points"))
+  {
+    return false;
+  }
+  return SameAttributes(a->GetPointData(), b->GetPointData()) &&
+    SameAttributes(a->GetCellData(), b->GetCellData());
+}
+
+bool SameOutputs(vtkDataObject* a, vtkDataObject* b)
+{
+  vtkCompositeDataSet* ca = vtkCompositeDataSet::SafeDownCast(a);
+  vtkCompositeDataSet* cb = vtkCompositeDataSet::SafeDownCast(b);
+  if (!ca || !cb)
+  {
+    return SameDataSets(vtkDataSet::SafeDownCast(a), vtkDataSet::SafeDownCast(b));
+  }
+
+  vtkSmartPointer<vtkCompositeDataIterator> ia;
+  ia.TakeReference(ca->NewIterator());
+  vtkSmartPointer<vtkCompositeDataIterator> ib;
+  ib.TakeReference(cb->NewIterator());
+  int numBlocks = 0;
+  for (ia->InitTraversal(), ib->InitTraversal(); !ia->IsDoneWithTraversal();
+       ia->GoToNextItem(), ib->GoToNextItem(), ++numBlocks)
+  {
+    if (ib->IsDoneWithTraversal() ||
+      !SameDataSets(vtkDataSet::SafeDownCast(ia->GetCurrentDataObject()),
+        vtkDataSet::SafeDownCast(ib->GetCurrentDataObject())))
+    {
+      cerr << "ERROR: block " << numBlocks << " differs." << endl;
+      return false;
+    }
+  }
+  if (!ib->IsDoneWithTraversal() || numBlocks == 0)
+  {
+    cerr << "ERROR: the outputs do not have the same blocks." << endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestCase(int argc, char* argv[], const char* caseName)
+{
+  char* fname = vtkTestUtilities::ExpandDataFileName(argc, argv, caseName);
+  vtkNew<vtkPGenericEnSightReader> streamed;
+  streamed->SetCaseFileName(fname);
+  streamed->ReadAllVariablesOn();
+  streamed->Update();
+  vtkNew<vtkPGenericEnSightReader> mapped;
+  mapped->SetCaseFileName(fname);
+  mapped->ReadAllVariablesOn();
+  mapped->SetUseMemoryMappedFiles(true);
+  mapped->Update();
+  delete[] fname;
+
+  if (!SameOutputs(streamed->GetOutputDataObject(0), mapped->GetOutputDataObject(0)))
+  {
+    cerr << "ERROR: " << caseName << " differs when read from memory mapped files." << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPEnSightMemoryMappedFiles(int argc, char* argv[])
+{
+  // naca has structured parts, elements has unstructured ones with variables.
+  if (!TestCase(argc, argv, "EnSight/naca.bin.case") ||
+    !TestCase(argc, argv, "EnSight/elements-bin.case"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSpyPlotPipelinedDecoding.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads a SpyPlot file with and without pipelined decoding and checks that the
+// outputs are identical.
+
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDummyController.h"
+#include "vtkNew.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpyPlotReader.h"
+#include "vtkTestUtilities.h"
+
+namespace
+{
+bool SameArrays(vtkDataArray* a, vtkDataArray* b, const char* name)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    cerr << "ERROR: array " << name << " differs in size." << endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        cerr << "ERROR: array " << name << " differs at tuple " << i << "." << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    cerr << "ERROR: the number of arrays differs." << endl;
+    return false;
+  }
+  for (int cc = 0; cc < a->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* array = a->GetArray(cc);
+    if (array && !SameArrays(array, b->GetArray(array->GetName()), array->GetName()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameDataSets(vtkDataSet* a, vtkDataSet* b)
+{
+  if (!a || !b || a->GetDataObjectType() != b->GetDataObjectType() ||
+    a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    cerr << "ERROR: datasets differ in type or size." << endl;
+    return false;
+  }
+  vtkPointSet* pa = vtkPointSet::SafeDownCast(a);
+  vtkPointSet* pb = vtkPointSet::SafeDownCast(b);
+  if (pa && pa->GetPoints() &&
+    !SameArrays(pa->GetPoints()->GetData(), pb->GetPoints()->GetData(), "Points"))
+  {
+    return false;
+  }
+  return SameAttributes(a->GetPointData(), b->GetPointData()) &&
+    SameAttributes(a->GetCellData(), b->GetCellData());
+}
+
+bool SameOutputs(vtkDataObject* a, vtkDataObject* b)
+{
+  vtkCompositeDataSet* ca = vtkCompositeDataSet::SafeDownCast(a);
+  vtkCompositeDataSet* cb = vtkCompositeDataSet::SafeDownCast(b);
+  if (!ca || !cb)
+  {
+    return SameDataSets(vtkDataSet::SafeDownCast(a), vtkDataSet::SafeDownCast(b));
+  }
+
+  vtkSmartPointer<vtkCompositeDataIterator> ia;
+  ia.TakeReference(ca->NewIterator());
+  vtkSmartPointer<vtkCompositeDataIterator> ib;
+  ib.TakeReference(cb->NewIterator());
+  int numBlocks = 0;
+  for (ia->InitTraversal(), ib->InitTraversal(); !ia->IsDoneWithTraversal();
+       ia->GoToNextItem(), ib->GoToNextItem(), ++numBlocks)
+  {
+    if (ib->IsDoneWithTraversal() ||
+      !SameDataSets(vtkDataSet::SafeDownCast(ia->GetCurrentDataObject()),
+        vtkDataSet::SafeDownCast(ib->GetCurrentDataObject())))
+    {
+      cerr << "ERROR: block " << numBlocks << " differs." << endl;
+      return false;
+    }
+  }
+  if (!ib->IsDoneWithTraversal() || numBlocks == 0)
+  {
+    cerr << "ERROR: the outputs do not have the same blocks." << endl;
+    return false;
+  }
+  return true;
+}
+
+void SetupReader(
+  vtkSpyPlotReader* reader, vtkDummyController* controller, const char* fname, int pipelined)
+{
+  reader->SetFileName(fname);
+  reader->SetGlobalController(controller);
+  reader->MergeXYZComponentsOn();
+  reader->DownConvertVolumeFractionOn();
+  reader->SetPipelinedDecoding(pipelined);
+  reader->UpdateInformation();
+  for (int cc = 0; cc < reader->GetNumberOfCellArrays(); ++cc)
+  {
+    reader->SetCellArrayStatus(reader->GetCellArrayName(cc), 1);
+  }
+  reader->Update();
+}
+}
+
+int TestSpyPlotPipelinedDecoding(int argc, char* argv[])
+{
+  vtkNew<vtkDummyController> controller;
+  char* fname = vtkTestUtilities::ExpandDataFileName(argc, argv, "SPCTH/ball_and_box.spcth");
+  vtkNew<vtkSpyPlotReader> serial;
+  SetupReader(serial.Get(), controller.Get(), fname, 0);
+  vtkNew<vtkSpyPlotReader> pipelined;
+  SetupReader(pipelined.Get(), controller.Get(), fname, 1);
+  delete[] fname;
+
+  if (serial->GetNumberOfCellArrays() == 0 ||
+    !SameOutputs(serial->GetOutputDataObject(0), pipelined->GetOutputDataObject(0)))
+  {
+    cerr << "ERROR: the output differs when the blocks are decoded in a pipeline." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
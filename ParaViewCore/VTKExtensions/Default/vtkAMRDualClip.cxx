@@ -15,6 +15,8 @@
 #include "vtkAMRDualClip.h"
 #include "vtkAMRDualGridHelper.h"
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 // Pipeline & VTK
@@ -22,6 +24,7 @@
 #include "vtkInformationVector.h"
 #include "vtkMarchingCubesTriangleCases.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiThreader.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -41,6 +44,7 @@
 #include "vtkMultiPieceDataSet.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedCharArray.h"
@@ -125,6 +129,15 @@ public:
   void ShareBlockLocatorWithNeighbor(
     vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor);
 
+  // Description:
+  // Used when blocks are processed concurrently, each with a locator of its
+  // own. This locator holds the point ids shared by the neighbors processed
+  // before the block. The points of `blockLocator`, whose ids are offset by
+  // `offset`, are mapped to the shared ones in `pointMap`, and the others are
+  // added to this locator to be shared with the next neighbors.
+  void MergeBlockPointIds(
+    vtkAMRDualClipLocator* blockLocator, vtkIdType offset, vtkIdType* pointMap);
+
   // The level mask could be a separate object, but it is used
   // by the locator to position points.
   // This computes just the center region.
@@ -1016,6 +1029,41 @@ void vtkAMRDualClipLocator::ShareBlockLocatorWithNeighbor(
   }
 }
 
+//----------------------------------------------------------------------------
+static void vtkAMRDualClipMergePointIds(
+  vtkIdType* shared, const vtkIdType* block, int length, vtkIdType offset, vtkIdType* pointMap)
+{
+  for (int idx = 0; idx < length; ++idx)
+  {
+    if (block[idx] < 0)
+    {
+      continue;
+    }
+    if (shared[idx] >= 0)
+    {
+      pointMap[block[idx] + offset] = shared[idx];
+    }
+    else
+    {
+      shared[idx] = block[idx] + offset;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualClipLocator::MergeBlockPointIds(
+  vtkAMRDualClipLocator* blockLocator, vtkIdType offset, vtkIdType* pointMap)
+{
+  vtkAMRDualClipMergePointIds(
+    this->XEdges, blockLocator->XEdges, this->ArrayLength, offset, pointMap);
+  vtkAMRDualClipMergePointIds(
+    this->YEdges, blockLocator->YEdges, this->ArrayLength, offset, pointMap);
+  vtkAMRDualClipMergePointIds(
+    this->ZEdges, blockLocator->ZEdges, this->ArrayLength, offset, pointMap);
+  vtkAMRDualClipMergePointIds(
+    this->Corners, blockLocator->Corners, this->ArrayLength, offset, pointMap);
+}
+
 //============================================================================
 //----------------------------------------------------------------------------
 // Description:
@@ -1030,6 +1078,8 @@ vtkAMRDualClip::vtkAMRDualClip()
   this->EnableDegenerateCells = 1;
   this->EnableMultiProcessCommunication = 0;
   this->EnableMergePoints = 0;
+  this->EnableMultiThreading = 0;
+  this->KeepBlockLocators = 0;
 
   this->Controller = NULL;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -1064,6 +1114,7 @@ void vtkAMRDualClip::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableInternalDecimation: " << this->EnableInternalDecimation << endl;
   os << indent << "EnableDegenerateCells: " << this->EnableDegenerateCells << endl;
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
+  os << indent << "EnableMultiThreading: " << this->EnableMultiThreading << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -1208,13 +1259,20 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
   int blockId;
 
   // Add each block.
-  for (int level = 0; level < numLevels; ++level)
+  if (this->EnableMultiThreading)
   {
-    numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
-    for (blockId = 0; blockId < numBlocks; ++blockId)
+    this->ProcessBlocksInParallel(hbdsInput, arrayNameToProcess);
+  }
+  else
+  {
+    for (int level = 0; level < numLevels; ++level)
     {
-      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+      for (blockId = 0; blockId < numBlocks; ++blockId)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+        this->ProcessBlock(block, blockId, arrayNameToProcess);
+      }
     }
   }
 
@@ -1255,6 +1313,194 @@ void vtkDualGridContourCastCornerValues(T* ptr, vtkIdType offsets[8], double val
   values[7] = (double)(ptr[offsets[7]]);
 }
 
+//----------------------------------------------------------------------------
+// Processes lists of blocks, each with a copy of the filter generating a
+// mesh of its own.
+class vtkAMRDualClipProcessBlocks
+{
+public:
+  std::vector<vtkAMRDualClip*> Workers;
+  std::vector<std::vector<std::pair<vtkAMRDualGridHelperBlock*, int> > > Blocks;
+  const char* ArrayName;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ii = begin; ii < end; ++ii)
+    {
+      for (size_t jj = 0; jj < this->Blocks[ii].size(); ++jj)
+      {
+        this->Workers[ii]->ProcessBlock(
+          this->Blocks[ii][jj].first, this->Blocks[ii][jj].second, this->ArrayName);
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Computes the center region of the level mask of blocks. Once done for all
+// blocks, each block can copy the regions it needs from its neighbors.
+class vtkAMRDualClipComputeLevelMasks
+{
+public:
+  std::vector<vtkAMRDualGridHelperBlock*> Blocks;
+  const char* ArrayName;
+  double IsoValue;
+  int Decimate;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ii = begin; ii < end; ++ii)
+    {
+      vtkAMRDualGridHelperBlock* block = this->Blocks[ii];
+      vtkDataArray* volumeFractionArray =
+        block->Image->GetCellData()->GetArray(this->ArrayName);
+      if (volumeFractionArray)
+      {
+        vtkAMRDualClipLocator* locator = static_cast<vtkAMRDualClipLocator*>(block->UserData);
+        locator->ComputeLevelMask(volumeFractionArray, this->IsoValue, this->Decimate);
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+void vtkAMRDualClip::ProcessBlocksInParallel(
+  vtkNonOverlappingAMR* hbdsInput, const char* arrayNameToProcess)
+{
+  std::vector<std::pair<vtkAMRDualGridHelperBlock*, int> > blocks;
+  int numLevels = this->Helper->GetNumberOfLevels();
+  for (int level = 0; level < numLevels; ++level)
+  {
+    int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+    for (int blockId = 0; blockId < numBlocks; ++blockId)
+    {
+      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+      if (block->Image)
+      {
+        blocks.push_back(std::make_pair(block, blockId));
+      }
+    }
+  }
+
+  if (this->EnableMergePoints)
+  {
+    // The level mask of a block is computed from its own cells and copied
+    // to the ghost regions of its neighbors. Compute all the masks before
+    // the blocks are processed, so that each block copies the regions of
+    // its neighbors in InitializeLevelMask as in the serial case.
+    vtkAMRDualClipComputeLevelMasks computeLevelMasks;
+    computeLevelMasks.ArrayName = this->Helper->GetArrayName();
+    computeLevelMasks.IsoValue = this->IsoValue;
+    computeLevelMasks.Decimate = this->EnableInternalDecimation;
+    for (size_t ii = 0; ii < blocks.size(); ++ii)
+    {
+      vtkAMRDualClipGetBlockLocator(blocks[ii].first);
+      computeLevelMasks.Blocks.push_back(blocks[ii].first);
+    }
+    vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()), computeLevelMasks);
+  }
+
+  // Split the blocks in contiguous lists, more lists than threads to balance
+  // the load. Each block keeps its own locator, the points shared by
+  // neighbor blocks are merged afterwards.
+  const size_t maxLists =
+    4 * static_cast<size_t>(vtkMultiThreader::GetGlobalDefaultNumberOfThreads());
+  const size_t listSize = (blocks.size() + maxLists - 1) / maxLists;
+  vtkAMRDualClipProcessBlocks processBlocks;
+  processBlocks.ArrayName = arrayNameToProcess;
+  std::vector<vtkPointSet*> pieces;
+  std::vector<vtkCellArray*> cells;
+  for (size_t first = 0; first < blocks.size(); first += listSize)
+  {
+    const size_t last = std::min(blocks.size(), first + listSize);
+    processBlocks.Blocks.push_back(std::vector<std::pair<vtkAMRDualGridHelperBlock*, int> >(
+      blocks.begin() + first, blocks.begin() + last));
+
+    vtkAMRDualClip* worker = vtkAMRDualClip::New();
+    worker->IsoValue = this->IsoValue;
+    worker->EnableInternalDecimation = this->EnableInternalDecimation;
+    worker->EnableMergePoints = this->EnableMergePoints;
+    worker->KeepBlockLocators = 1;
+    worker->Helper = this->Helper;
+    worker->Mesh = vtkUnstructuredGrid::New();
+    worker->Points = vtkPoints::New();
+    worker->Cells = vtkCellArray::New();
+    worker->Mesh->SetPoints(worker->Points);
+    worker->BlockIdCellArray = vtkIntArray::New();
+    worker->BlockIdCellArray->SetName("BlockIds");
+    worker->Mesh->GetCellData()->AddArray(worker->BlockIdCellArray);
+    worker->LevelMaskPointArray = vtkUnsignedCharArray::New();
+    worker->LevelMaskPointArray->SetName("LevelMask");
+    worker->Mesh->GetPointData()->AddArray(worker->LevelMaskPointArray);
+    worker->InitializeCopyAttributes(hbdsInput, worker->Mesh);
+    processBlocks.Workers.push_back(worker);
+    pieces.push_back(worker->Mesh);
+    cells.push_back(worker->Cells);
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(processBlocks.Workers.size()), 1, processBlocks);
+
+  std::vector<vtkIdType> pointMap;
+  if (this->EnableMergePoints)
+  {
+    // Share the point ids between neighbor blocks in the order the blocks
+    // are processed serially, so that the same points are merged. The
+    // locators of the blocks are set aside and the ones shared between
+    // neighbors are attached to the blocks instead.
+    std::vector<vtkIdType> offsets(pieces.size() + 1, 0);
+    for (size_t ii = 0; ii < pieces.size(); ++ii)
+    {
+      offsets[ii + 1] = offsets[ii] + pieces[ii]->GetNumberOfPoints();
+    }
+    pointMap.resize(offsets.back());
+    for (vtkIdType id = 0; id < offsets.back(); ++id)
+    {
+      pointMap[id] = id;
+    }
+    std::vector<vtkAMRDualClipLocator*> blockLocators(blocks.size());
+    for (size_t ii = 0; ii < blocks.size(); ++ii)
+    {
+      blockLocators[ii] = static_cast<vtkAMRDualClipLocator*>(blocks[ii].first->UserData);
+      blocks[ii].first->UserData = 0;
+    }
+    for (size_t ii = 0; ii < blocks.size(); ++ii)
+    {
+      vtkAMRDualGridHelperBlock* block = blocks[ii].first;
+      if (block->Image->GetCellData()->GetArray(arrayNameToProcess))
+      {
+        vtkAMRDualClipLocator* sharedLocator = vtkAMRDualClipGetBlockLocator(block);
+        sharedLocator->MergeBlockPointIds(
+          blockLocators[ii], offsets[ii / listSize], &pointMap[0]);
+        this->ShareBlockLocatorWithNeighbors(block);
+        delete sharedLocator;
+        block->UserData = 0;
+        block->RegionBits[1][1][1] = 0;
+      }
+      delete blockLocators[ii];
+    }
+  }
+
+  vtkAMRDualGridHelper::AppendPieces(
+    pieces, cells, pointMap.empty() ? NULL : &pointMap[0], this->Mesh, this->Cells);
+
+  for (size_t ii = 0; ii < processBlocks.Workers.size(); ++ii)
+  {
+    vtkAMRDualClip* worker = processBlocks.Workers[ii];
+    worker->Helper = 0;
+    worker->BlockIdCellArray->Delete();
+    worker->BlockIdCellArray = 0;
+    worker->LevelMaskPointArray->Delete();
+    worker->LevelMaskPointArray = 0;
+    worker->Mesh->Delete();
+    worker->Mesh = 0;
+    worker->Points->Delete();
+    worker->Points = 0;
+    worker->Cells->Delete();
+    worker->Cells = 0;
+    worker->Delete();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkAMRDualClip::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block)
 {
@@ -1584,7 +1830,13 @@ void vtkAMRDualClip::ProcessBlock(
     zOffset += zInc;
   }
 
-  if (this->EnableMergePoints)
+  if (this->EnableMergePoints && this->KeepBlockLocators)
+  {
+    // The level masks of neighbors were pulled by InitializeLevelMask and
+    // the points are merged once all the blocks are processed.
+    this->BlockLocator = 0;
+  }
+  else if (this->EnableMergePoints)
   {
     this->ShareLevelMask(block);
     // Copy point ids into neighbor locators.
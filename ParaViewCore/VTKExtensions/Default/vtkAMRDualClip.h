@@ -85,6 +85,19 @@ public:
   vtkBooleanMacro(EnableMergePoints, int);
   //@}
 
+  //@{
+  /**
+   * Process the blocks concurrently, using vtkSMPTools. Each thread generates
+   * its own mesh and the meshes are then appended in block order, merging the
+   * points shared by neighbor blocks if EnableMergePoints is on. The output
+   * is the same as when the blocks are processed one after the other. Off by
+   * default.
+   */
+  vtkSetMacro(EnableMultiThreading, int);
+  vtkGetMacro(EnableMultiThreading, int);
+  vtkBooleanMacro(EnableMultiThreading, int);
+  //@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -99,6 +112,7 @@ protected:
   int EnableDegenerateCells;
   int EnableMultiProcessCommunication;
   int EnableMergePoints;
+  int EnableMultiThreading;
 
   // Needed for copying cell data to point data.
   vtkUnstructuredGrid* Mesh;
@@ -120,6 +134,12 @@ protected:
 
   void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
 
+  /**
+   * Same as calling ProcessBlock for all blocks, with the blocks processed
+   * concurrently.
+   */
+  void ProcessBlocksInParallel(vtkNonOverlappingAMR* input, const char* arrayName);
+
   void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
     vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
 
@@ -149,8 +169,14 @@ protected:
   int* MessageBufferLength;
 
   vtkAMRDualClipLocator* BlockLocator;
+  // Set on the copies of the filter processing blocks concurrently, which
+  // keep the locator of each block so that ProcessBlocksInParallel can merge
+  // the points of neighbor blocks once all blocks are processed.
+  int KeepBlockLocators;
 
 private:
+  friend class vtkAMRDualClipProcessBlocks;
+
   vtkAMRDualClip(const vtkAMRDualClip&) = delete;
   void operator=(const vtkAMRDualClip&) = delete;
 };
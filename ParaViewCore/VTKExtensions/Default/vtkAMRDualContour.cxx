@@ -14,6 +14,8 @@
 =========================================================================*/
 #include "vtkAMRDualContour.h"
 #include "vtkAMRDualGridHelper.h"
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 // Pipeline & VTK
@@ -21,6 +23,7 @@
 #include "vtkInformationVector.h"
 #include "vtkMarchingCubesTriangleCases.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiThreader.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -41,6 +44,7 @@
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
@@ -103,6 +107,15 @@ public:
   void ShareBlockLocatorWithNeighbor(
     vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor);
 
+  // Description:
+  // Used when blocks are processed concurrently, each with a locator of its
+  // own. This locator holds the point ids shared by the neighbors processed
+  // before the block. The points of `blockLocator`, whose ids are offset by
+  // `offset`, are mapped to the shared ones in `pointMap`, and the others are
+  // added to this locator to be shared with the next neighbors.
+  void MergeBlockPointIds(
+    vtkAMRDualContourEdgeLocator* blockLocator, vtkIdType offset, vtkIdType* pointMap);
+
 private:
   int DualCellDimensions[3];
   // Increments for translating 3d to 1d.  XIncrement = 1;
@@ -608,6 +621,41 @@ void vtkAMRDualContourEdgeLocator::ShareBlockLocatorWithNeighbor(
   }
 }
 
+//----------------------------------------------------------------------------
+static void vtkAMRDualContourMergePointIds(
+  vtkIdType* shared, const vtkIdType* block, int length, vtkIdType offset, vtkIdType* pointMap)
+{
+  for (int idx = 0; idx < length; ++idx)
+  {
+    if (block[idx] < 0)
+    {
+      continue;
+    }
+    if (shared[idx] >= 0)
+    {
+      pointMap[block[idx] + offset] = shared[idx];
+    }
+    else
+    {
+      shared[idx] = block[idx] + offset;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualContourEdgeLocator::MergeBlockPointIds(
+  vtkAMRDualContourEdgeLocator* blockLocator, vtkIdType offset, vtkIdType* pointMap)
+{
+  vtkAMRDualContourMergePointIds(
+    this->XEdges, blockLocator->XEdges, this->ArrayLength, offset, pointMap);
+  vtkAMRDualContourMergePointIds(
+    this->YEdges, blockLocator->YEdges, this->ArrayLength, offset, pointMap);
+  vtkAMRDualContourMergePointIds(
+    this->ZEdges, blockLocator->ZEdges, this->ArrayLength, offset, pointMap);
+  vtkAMRDualContourMergePointIds(
+    this->Corners, blockLocator->Corners, this->ArrayLength, offset, pointMap);
+}
+
 //============================================================================
 //----------------------------------------------------------------------------
 // Description:
@@ -622,6 +670,8 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->EnableCapping = 1;
   this->EnableMultiProcessCommunication = 1;
   this->EnableMergePoints = 1;
+  this->EnableMultiThreading = 0;
+  this->KeepBlockLocators = 0;
   this->TriangulateCap = 1;
 
   this->Controller = NULL;
@@ -659,6 +709,7 @@ void vtkAMRDualContour::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableMultiProcessCommunication: " << this->EnableMultiProcessCommunication
      << endl;
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
+  os << indent << "EnableMultiThreading: " << this->EnableMultiThreading << endl;
   os << indent << "TriangulateCap: " << this->TriangulateCap << endl;
   os << indent << "SkipGhostCopy: " << this->SkipGhostCopy << endl;
 }
@@ -810,13 +861,20 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
   int numLevels = hbdsInput->GetNumberOfLevels();
 
   // Add each block.
-  for (int level = 0; level < numLevels; ++level)
+  if (this->EnableMultiThreading)
   {
-    int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
-    for (int blockId = 0; blockId < numBlocks; ++blockId)
+    this->ProcessBlocksInParallel(hbdsInput, arrayNameToProcess);
+  }
+  else
+  {
+    for (int level = 0; level < numLevels; ++level)
     {
-      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+      for (int blockId = 0; blockId < numBlocks; ++blockId)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+        this->ProcessBlock(block, blockId, arrayNameToProcess);
+      }
     }
   }
 
@@ -836,6 +894,146 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
   return mbdsOutput0;
 }
 
+//----------------------------------------------------------------------------
+// Processes lists of blocks, each with a copy of the filter generating a
+// mesh of its own.
+class vtkAMRDualContourProcessBlocks
+{
+public:
+  std::vector<vtkAMRDualContour*> Workers;
+  std::vector<std::vector<std::pair<vtkAMRDualGridHelperBlock*, int> > > Blocks;
+  const char* ArrayName;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ii = begin; ii < end; ++ii)
+    {
+      for (size_t jj = 0; jj < this->Blocks[ii].size(); ++jj)
+      {
+        this->Workers[ii]->ProcessBlock(
+          this->Blocks[ii][jj].first, this->Blocks[ii][jj].second, this->ArrayName);
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+void vtkAMRDualContour::ProcessBlocksInParallel(
+  vtkNonOverlappingAMR* hbdsInput, const char* arrayNameToProcess)
+{
+  std::vector<std::pair<vtkAMRDualGridHelperBlock*, int> > blocks;
+  int numLevels = this->Helper->GetNumberOfLevels();
+  for (int level = 0; level < numLevels; ++level)
+  {
+    int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+    for (int blockId = 0; blockId < numBlocks; ++blockId)
+    {
+      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+      if (block->Image)
+      {
+        blocks.push_back(std::make_pair(block, blockId));
+      }
+    }
+  }
+
+  // Split the blocks in contiguous lists, more lists than threads to balance
+  // the load. Each block keeps its own locator, the points shared by
+  // neighbor blocks are merged afterwards.
+  const size_t maxLists =
+    4 * static_cast<size_t>(vtkMultiThreader::GetGlobalDefaultNumberOfThreads());
+  const size_t listSize = (blocks.size() + maxLists - 1) / maxLists;
+  vtkAMRDualContourProcessBlocks processBlocks;
+  processBlocks.ArrayName = arrayNameToProcess;
+  std::vector<vtkPointSet*> pieces;
+  std::vector<vtkCellArray*> cells;
+  for (size_t first = 0; first < blocks.size(); first += listSize)
+  {
+    const size_t last = std::min(blocks.size(), first + listSize);
+    processBlocks.Blocks.push_back(std::vector<std::pair<vtkAMRDualGridHelperBlock*, int> >(
+      blocks.begin() + first, blocks.begin() + last));
+
+    vtkAMRDualContour* worker = vtkAMRDualContour::New();
+    worker->IsoValue = this->IsoValue;
+    worker->EnableCapping = this->EnableCapping;
+    worker->EnableMergePoints = this->EnableMergePoints;
+    worker->KeepBlockLocators = 1;
+    worker->TriangulateCap = this->TriangulateCap;
+    worker->Helper = this->Helper;
+    worker->Mesh = vtkPolyData::New();
+    worker->Points = vtkPoints::New();
+    worker->Faces = vtkCellArray::New();
+    worker->Mesh->SetPoints(worker->Points);
+    worker->Mesh->SetPolys(worker->Faces);
+    worker->InitializeCopyAttributes(hbdsInput, worker->Mesh);
+    worker->BlockIdCellArray = vtkIntArray::New();
+    worker->BlockIdCellArray->SetName("BlockIds");
+    worker->Mesh->GetCellData()->AddArray(worker->BlockIdCellArray);
+    processBlocks.Workers.push_back(worker);
+    pieces.push_back(worker->Mesh);
+    cells.push_back(worker->Faces);
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(processBlocks.Workers.size()), 1, processBlocks);
+
+  std::vector<vtkIdType> pointMap;
+  if (this->EnableMergePoints)
+  {
+    // Share the point ids between neighbor blocks in the order the blocks
+    // are processed serially, so that the same points are merged. The
+    // locators of the blocks are set aside and the ones shared between
+    // neighbors are attached to the blocks instead.
+    std::vector<vtkIdType> offsets(pieces.size() + 1, 0);
+    for (size_t ii = 0; ii < pieces.size(); ++ii)
+    {
+      offsets[ii + 1] = offsets[ii] + pieces[ii]->GetNumberOfPoints();
+    }
+    pointMap.resize(offsets.back());
+    for (vtkIdType id = 0; id < offsets.back(); ++id)
+    {
+      pointMap[id] = id;
+    }
+    std::vector<vtkAMRDualContourEdgeLocator*> blockLocators(blocks.size());
+    for (size_t ii = 0; ii < blocks.size(); ++ii)
+    {
+      blockLocators[ii] = static_cast<vtkAMRDualContourEdgeLocator*>(blocks[ii].first->UserData);
+      blocks[ii].first->UserData = 0;
+    }
+    for (size_t ii = 0; ii < blocks.size(); ++ii)
+    {
+      vtkAMRDualGridHelperBlock* block = blocks[ii].first;
+      if (blockLocators[ii])
+      {
+        vtkAMRDualContourEdgeLocator* sharedLocator = vtkAMRDualContourGetBlockLocator(block);
+        sharedLocator->MergeBlockPointIds(
+          blockLocators[ii], offsets[ii / listSize], &pointMap[0]);
+        this->ShareBlockLocatorWithNeighbors(block);
+        delete sharedLocator;
+        delete blockLocators[ii];
+        block->UserData = 0;
+        block->RegionBits[1][1][1] = 0;
+      }
+    }
+  }
+
+  vtkAMRDualGridHelper::AppendPieces(
+    pieces, cells, pointMap.empty() ? NULL : &pointMap[0], this->Mesh, this->Faces);
+
+  for (size_t ii = 0; ii < processBlocks.Workers.size(); ++ii)
+  {
+    vtkAMRDualContour* worker = processBlocks.Workers[ii];
+    worker->Helper = 0;
+    worker->BlockIdCellArray->Delete();
+    worker->BlockIdCellArray = 0;
+    worker->Mesh->Delete();
+    worker->Mesh = 0;
+    worker->Points->Delete();
+    worker->Points = 0;
+    worker->Faces->Delete();
+    worker->Faces = 0;
+    worker->Delete();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block)
 {
@@ -1016,7 +1214,12 @@ void vtkAMRDualContour::ProcessBlock(
     zOffset += zInc;
   }
 
-  if (this->EnableMergePoints)
+  if (this->EnableMergePoints && this->KeepBlockLocators)
+  {
+    // The points are merged once all the blocks are processed.
+    this->BlockLocator = 0;
+  }
+  else if (this->EnableMergePoints)
   {
     // Copy point ids into neighbor locators.
     this->ShareBlockLocatorWithNeighbors(block);
@@ -93,6 +93,19 @@ public:
   vtkBooleanMacro(EnableMergePoints, int);
   //@}
 
+  //@{
+  /**
+   * Process the blocks concurrently, using vtkSMPTools. Each thread generates
+   * its own mesh and the meshes are then appended in block order, merging the
+   * points shared by neighbor blocks if EnableMergePoints is on. The output
+   * is the same as when the blocks are processed one after the other. Off by
+   * default.
+   */
+  vtkSetMacro(EnableMultiThreading, int);
+  vtkGetMacro(EnableMultiThreading, int);
+  vtkBooleanMacro(EnableMultiThreading, int);
+  //@}
+
   //@{
   /**
    * A flag that causes the polygons on the capping surfaces to be triagulated.
@@ -128,6 +141,7 @@ protected:
   int EnableCapping;
   int EnableMultiProcessCommunication;
   int EnableMergePoints;
+  int EnableMultiThreading;
   int TriangulateCap;
   int SkipGhostCopy;
 
@@ -156,6 +170,12 @@ protected:
 
   void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
 
+  /**
+   * Same as calling ProcessBlock for all blocks, with the blocks processed
+   * concurrently.
+   */
+  void ProcessBlocksInParallel(vtkNonOverlappingAMR* input, const char* arrayName);
+
   void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
     vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
 
@@ -197,6 +217,10 @@ protected:
   int* MessageBufferLength;
 
   vtkAMRDualContourEdgeLocator* BlockLocator;
+  // Set on the copies of the filter processing blocks concurrently, which
+  // keep the locator of each block so that ProcessBlocksInParallel can merge
+  // the points of neighbor blocks once all blocks are processed.
+  int KeepBlockLocators;
 
   // Stuff for passing cell attributes to point attributes.
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
@@ -206,6 +230,8 @@ protected:
   void FinalizeCopyAttributes(vtkDataSet* mesh);
 
 private:
+  friend class vtkAMRDualContourProcessBlocks;
+
   vtkAMRDualContour(const vtkAMRDualContour&) = delete;
   void operator=(const vtkAMRDualContour&) = delete;
 };
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkAMRDualGridHelper.h"
 #include "vtkAMRBox.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkDataArray.h"
@@ -25,6 +26,9 @@
 #include "vtkMultiProcessController.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkTimerLog.h"
@@ -2944,3 +2948,82 @@ ng[2]));
   //    DebuggingGlobalOrigin[1] = this->GlobalOrigin[1];
   //    DebuggingGlobalOrigin[2] = this->GlobalOrigin[2];
 }
+
+//----------------------------------------------------------------------------
+void vtkAMRDualGridHelper::AppendPieces(const std::vector<vtkPointSet*>& pieces,
+  const std::vector<vtkCellArray*>& cells, const vtkIdType* pointMap, vtkPointSet* output,
+  vtkCellArray* outputCells)
+{
+  const size_t numPieces = pieces.size();
+  if (numPieces == 0)
+  {
+    return;
+  }
+  std::vector<vtkIdType> offsets(numPieces + 1, 0);
+  for (size_t ii = 0; ii < numPieces; ++ii)
+  {
+    offsets[ii + 1] = offsets[ii] + pieces[ii]->GetNumberOfPoints();
+  }
+  const vtkIdType numPoints = offsets[numPieces];
+
+  // Number the points kept in order. A merged point always maps to a
+  // smaller id, which is already numbered.
+  vtkPoints* outPoints = output->GetPoints();
+  vtkPointData* outPD = output->GetPointData();
+  vtkCellData* outCD = output->GetCellData();
+  outPD->CopyAllocate(pieces[0]->GetPointData(), numPoints);
+  outCD->CopyAllocate(pieces[0]->GetCellData());
+  vtkIdType numKept = numPoints;
+  if (pointMap)
+  {
+    numKept = 0;
+    for (vtkIdType id = 0; id < numPoints; ++id)
+    {
+      numKept += pointMap[id] == id ? 1 : 0;
+    }
+  }
+  outPoints->SetNumberOfPoints(numKept);
+  std::vector<vtkIdType> newIds(numPoints);
+  vtkIdType newId = 0;
+  for (size_t ii = 0; ii < numPieces; ++ii)
+  {
+    vtkPoints* points = pieces[ii]->GetPoints();
+    vtkPointData* pd = pieces[ii]->GetPointData();
+    for (vtkIdType id = offsets[ii]; id < offsets[ii + 1]; ++id)
+    {
+      if (pointMap && pointMap[id] != id)
+      {
+        newIds[id] = newIds[pointMap[id]];
+        continue;
+      }
+      double pt[3];
+      points->GetPoint(id - offsets[ii], pt);
+      outPoints->SetPoint(newId, pt);
+      outPD->CopyData(pd, id - offsets[ii], newId);
+      newIds[id] = newId++;
+    }
+  }
+
+  // Append the cells with their new point ids.
+  std::vector<vtkIdType> cellPtIds;
+  vtkIdType outCellId = 0;
+  for (size_t ii = 0; ii < numPieces; ++ii)
+  {
+    vtkCellData* cd = pieces[ii]->GetCellData();
+    vtkIdType npts;
+    vtkIdType* pts;
+    vtkIdType cellId = 0;
+    for (cells[ii]->InitTraversal(); cells[ii]->GetNextCell(npts, pts); ++cellId)
+    {
+      cellPtIds.resize(npts);
+      for (vtkIdType jj = 0; jj < npts; ++jj)
+      {
+        cellPtIds[jj] = newIds[offsets[ii] + pts[jj]];
+      }
+      outputCells->InsertNextCell(npts, npts > 0 ? &cellPtIds[0] : NULL);
+      outCD->CopyData(cd, cellId, outCellId++);
+    }
+  }
+  outPD->Squeeze();
+  outCD->Squeeze();
+}
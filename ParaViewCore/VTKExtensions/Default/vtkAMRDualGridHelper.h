@@ -33,6 +33,7 @@
 #include <map>
 #include <vector>
 
+class vtkCellArray;
 class vtkDataArray;
 class vtkIntArray;
 class vtkIdTypeArray;
@@ -41,6 +42,7 @@ class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperLevel;
 class vtkMultiProcessController;
 class vtkImageData;
+class vtkPointSet;
 class vtkAMRDualGridHelperDegenerateRegion;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualGridHelperCommRequestList;
@@ -142,6 +144,18 @@ public:
   vtkGetStringMacro(ArrayName);
   //@}
 
+  /**
+   * Appends, in order, meshes generated concurrently by the filters using
+   * this helper to `output`. `cells` are the cells of each piece and are
+   * appended to `outputCells`, which the caller sets on `output`. When given,
+   * `pointMap` maps the ids of the points of all pieces, numbered one piece
+   * after the other, to the smaller id of the point they are merged with, or
+   * to themselves. Cells are appended as they are.
+   */
+  static void AppendPieces(const std::vector<vtkPointSet*>& pieces,
+    const std::vector<vtkCellArray*>& cells, const vtkIdType* pointMap, vtkPointSet* output,
+    vtkCellArray* outputCells);
+
 private:
   vtkAMRDualGridHelper();
   ~vtkAMRDualGridHelper() override;
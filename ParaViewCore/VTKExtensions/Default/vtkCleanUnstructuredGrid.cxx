@@ -15,36 +15,260 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkCleanUnstructuredGrid.h"
 
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
-#include "vtkCollection.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
-#include "vtkIntArray.h"
-#include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkCleanUnstructuredGrid);
 
+namespace
+{
+// Number of bits per axis of the Morton keys.
+const int vtkCleanUGMortonBits = 21;
+
+// Key of the points with a NaN coordinate, these are never merged.
+const vtkTypeUInt64 vtkCleanUGInvalidKey = ~static_cast<vtkTypeUInt64>(0);
+
+struct vtkCleanUGPoint
+{
+  vtkTypeUInt64 Key;
+  float X[3];
+  vtkIdType Id;
+};
+
+//----------------------------------------------------------------------------
+// Orders the points by key, then coordinates and finally id, so that
+// coincident points are contiguous and the first of them has the smallest id.
+struct vtkCleanUGPointLess
+{
+  bool operator()(const vtkCleanUGPoint& a, const vtkCleanUGPoint& b) const
+  {
+    if (a.Key != b.Key)
+    {
+      return a.Key < b.Key;
+    }
+    if (a.Key != vtkCleanUGInvalidKey)
+    {
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        if (a.X[cc] != b.X[cc])
+        {
+          return a.X[cc] < b.X[cc];
+        }
+      }
+    }
+    return a.Id < b.Id;
+  }
+};
+
+//----------------------------------------------------------------------------
+inline bool vtkCleanUGCoincident(const vtkCleanUGPoint& a, const vtkCleanUGPoint& b)
+{
+  return a.Key == b.Key && a.Key != vtkCleanUGInvalidKey && a.X[0] == b.X[0] &&
+    a.X[1] == b.X[1] && a.X[2] == b.X[2];
+}
+
+//----------------------------------------------------------------------------
+// Spreads the lower 21 bits of v so that they occupy every third bit.
+inline vtkTypeUInt64 vtkCleanUGSpreadBits(vtkTypeUInt64 v)
+{
+  v &= 0x1fffffULL;
+  v = (v | v << 32) & 0x1f00000000ffffULL;
+  v = (v | v << 16) & 0x1f0000ff0000ffULL;
+  v = (v | v << 8) & 0x100f00f00f00f00fULL;
+  v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+  v = (v | v << 2) & 0x1249249249249249ULL;
+  return v;
+}
+
+//----------------------------------------------------------------------------
+// Fetches the points, rounded to float as they are stored in the output, and
+// computes their Morton key.
+class vtkCleanUGKeyFunctor
+{
+public:
+  vtkCleanUGKeyFunctor(vtkDataSet* input, const double bounds[6], vtkCleanUGPoint* points)
+    : Input(input)
+    , Points(points)
+  {
+    const double maxQuantum = static_cast<double>((1 << vtkCleanUGMortonBits) - 1);
+    for (int cc = 0; cc < 3; ++cc)
+    {
+      this->Origin[cc] = bounds[2 * cc];
+      const double length = bounds[2 * cc + 1] - bounds[2 * cc];
+      this->Scale[cc] = length > 0.0 ? maxQuantum / length : 0.0;
+    }
+    this->MaxQuantum = maxQuantum;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double pt[3];
+    for (vtkIdType id = begin; id < end; ++id)
+    {
+      vtkCleanUGPoint& point = this->Points[id];
+      this->Input->GetPoint(id, pt);
+      point.Id = id;
+      point.Key = 0;
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        point.X[cc] = static_cast<float>(pt[cc]);
+        if (point.X[cc] != point.X[cc])
+        {
+          point.Key = vtkCleanUGInvalidKey;
+        }
+      }
+      if (point.Key == vtkCleanUGInvalidKey)
+      {
+        continue;
+      }
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        double quantum = (point.X[cc] - this->Origin[cc]) * this->Scale[cc];
+        quantum = quantum > 0.0 ? quantum : 0.0;
+        quantum = quantum < this->MaxQuantum ? quantum : this->MaxQuantum;
+        point.Key |= vtkCleanUGSpreadBits(static_cast<vtkTypeUInt64>(quantum)) << cc;
+      }
+    }
+  }
+
+private:
+  vtkDataSet* Input;
+  vtkCleanUGPoint* Points;
+  double Origin[3];
+  double Scale[3];
+  double MaxQuantum;
+};
+
+//----------------------------------------------------------------------------
+// Sets, for each run of coincident sorted points, the id of the first point
+// of the run as the representative of all the points of the run.
+class vtkCleanUGMergeFunctor
+{
+public:
+  vtkCleanUGMergeFunctor(const vtkCleanUGPoint* points, vtkIdType numPoints, vtkIdType* reps)
+    : Points(points)
+    , NumberOfPoints(numPoints)
+    , Representatives(reps)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      if (cc > 0 && vtkCleanUGCoincident(this->Points[cc - 1], this->Points[cc]))
+      {
+        // not the first point of its run.
+        continue;
+      }
+      const vtkIdType rep = this->Points[cc].Id;
+      vtkIdType next = cc;
+      do
+      {
+        this->Representatives[this->Points[next].Id] = rep;
+        ++next;
+      } while (next < this->NumberOfPoints &&
+        vtkCleanUGCoincident(this->Points[cc], this->Points[next]));
+    }
+  }
+
+private:
+  const vtkCleanUGPoint* Points;
+  vtkIdType NumberOfPoints;
+  vtkIdType* Representatives;
+};
+
+//----------------------------------------------------------------------------
+// Copies the coordinates of the merged points.
+class vtkCleanUGCopyPointsFunctor
+{
+public:
+  vtkCleanUGCopyPointsFunctor(vtkDataSet* input, const vtkIdType* newToOld, vtkPoints* points)
+    : Input(input)
+    , NewToOld(newToOld)
+    , Points(points)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double pt[3];
+    for (vtkIdType id = begin; id < end; ++id)
+    {
+      this->Input->GetPoint(this->NewToOld[id], pt);
+      this->Points->SetPoint(id, pt);
+    }
+  }
+
+private:
+  vtkDataSet* Input;
+  const vtkIdType* NewToOld;
+  vtkPoints* Points;
+};
+
+//----------------------------------------------------------------------------
+// Remaps the point ids of the cells of a vtkCellArray, cell by cell using the
+// cell locations.
+class vtkCleanUGRemapFunctor
+{
+public:
+  vtkCleanUGRemapFunctor(
+    vtkIdType* connectivity, const vtkIdType* locations, const vtkIdType* ptMap)
+    : Connectivity(connectivity)
+    , Locations(locations)
+    , PointMap(ptMap)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      vtkIdType* cell = this->Connectivity + this->Locations[cellId];
+      const vtkIdType npts = *cell++;
+      for (vtkIdType cc = 0; cc < npts; ++cc)
+      {
+        cell[cc] = this->PointMap[cell[cc]];
+      }
+    }
+  }
+
+private:
+  vtkIdType* Connectivity;
+  const vtkIdType* Locations;
+  const vtkIdType* PointMap;
+};
+}
+
 //----------------------------------------------------------------------------
 vtkCleanUnstructuredGrid::vtkCleanUnstructuredGrid()
 {
-  this->Locator = vtkMergePoints::New();
+  this->PointOrdering = INPUT_ORDER;
 }
 
 //----------------------------------------------------------------------------
 vtkCleanUnstructuredGrid::~vtkCleanUnstructuredGrid()
 {
-  this->Locator->Delete();
-  this->Locator = NULL;
 }
 
 //----------------------------------------------------------------------------
 void vtkCleanUnstructuredGrid::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "PointOrdering: " << this->PointOrdering << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -71,72 +295,142 @@ int vtkCleanUnstructuredGrid::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  output->GetPointData()->CopyAllocate(input->GetPointData());
   output->GetCellData()->PassData(input->GetCellData());
 
-  // First, create a new points array that eliminate duplicate points.
-  // Also create a mapping from the old point id to the new.
-  vtkPoints* newPts = vtkPoints::New();
+  // First, sort the points along a Morton curve so that coincident points are
+  // next to each other.
   vtkIdType num = input->GetNumberOfPoints();
-  vtkIdType id;
-  vtkIdType newId;
-  vtkIdType* ptMap = new vtkIdType[num];
-  double pt[3];
-
-  this->Locator->InitPointInsertion(newPts, input->GetBounds(), num);
-
-  vtkIdType progressStep = num / 100;
-  if (progressStep == 0)
+  std::vector<vtkCleanUGPoint> sorted(num);
+  std::vector<vtkIdType> ptMap(num);
+  if (num > 0)
   {
-    progressStep = 1;
+    // GetPoint() is thread safe only once it has been called from a single
+    // thread.
+    double pt[3];
+    input->GetPoint(0, pt);
+
+    vtkCleanUGKeyFunctor keys(input, input->GetBounds(), &sorted[0]);
+    vtkSMPTools::For(0, num, keys);
+    this->UpdateProgress(0.2);
+    vtkSMPTools::Sort(&sorted[0], &sorted[0] + num, vtkCleanUGPointLess());
+    this->UpdateProgress(0.5);
   }
-  for (id = 0; id < num; ++id)
+
+  // Then number the merged points and create the mapping from the old point
+  // id to the new.
+  std::vector<vtkIdType> newToOld;
+  if (this->PointOrdering == SPATIAL_ORDER)
   {
-    if (id % progressStep == 0)
+    for (vtkIdType cc = 0; cc < num; ++cc)
     {
-      this->UpdateProgress(0.8 * ((float)id / num));
+      if (cc == 0 || !vtkCleanUGCoincident(sorted[cc - 1], sorted[cc]))
+      {
+        newToOld.push_back(sorted[cc].Id);
+      }
+      ptMap[sorted[cc].Id] = static_cast<vtkIdType>(newToOld.size()) - 1;
     }
-    input->GetPoint(id, pt);
-    if (this->Locator->InsertUniquePoint(pt, newId))
+  }
+  else if (num > 0)
+  {
+    // Map each point to the first of its duplicates. The representative of a
+    // point never has a greater id than the point itself, hence its new id is
+    // already known when traversing the points in increasing order.
+    vtkCleanUGMergeFunctor merge(&sorted[0], num, &ptMap[0]);
+    vtkSMPTools::For(0, num, merge);
+    for (vtkIdType id = 0; id < num; ++id)
     {
-      output->GetPointData()->CopyData(input->GetPointData(), id, newId);
+      if (ptMap[id] == id)
+      {
+        ptMap[id] = static_cast<vtkIdType>(newToOld.size());
+        newToOld.push_back(id);
+      }
+      else
+      {
+        ptMap[id] = ptMap[ptMap[id]];
+      }
     }
-    ptMap[id] = newId;
+  }
+  std::vector<vtkCleanUGPoint>().swap(sorted);
+  const vtkIdType numNewPts = static_cast<vtkIdType>(newToOld.size());
+
+  vtkPoints* newPts = vtkPoints::New();
+  newPts->SetNumberOfPoints(numNewPts);
+  if (numNewPts > 0)
+  {
+    vtkCleanUGCopyPointsFunctor copyPoints(input, &newToOld[0], newPts);
+    vtkSMPTools::For(0, numNewPts, copyPoints);
   }
   output->SetPoints(newPts);
   newPts->Delete();
 
+  vtkNew<vtkIdList> fromIds;
+  vtkNew<vtkIdList> toIds;
+  fromIds->SetNumberOfIds(numNewPts);
+  toIds->SetNumberOfIds(numNewPts);
+  for (vtkIdType id = 0; id < numNewPts; ++id)
+  {
+    fromIds->SetId(id, newToOld[id]);
+    toIds->SetId(id, id);
+  }
+  output->GetPointData()->CopyAllocate(input->GetPointData(), numNewPts);
+  output->GetPointData()->CopyData(
+    input->GetPointData(), fromIds.GetPointer(), toIds.GetPointer());
+  this->UpdateProgress(0.8);
+
   // Now copy the cells.
-  vtkIdList* cellPoints = vtkIdList::New();
   num = input->GetNumberOfCells();
-  output->Allocate(num);
-  for (id = 0; id < num; ++id)
+  vtkUnstructuredGrid* ugInput = vtkUnstructuredGrid::SafeDownCast(input);
+  if (ugInput && ugInput->GetCells() && !ugInput->GetFaces())
   {
-    if (id % progressStep == 0)
-    {
-      this->UpdateProgress(0.8 + 0.2 * ((float)id / num));
-    }
-    // special handling for polyhedron cells
-    if (vtkUnstructuredGrid::SafeDownCast(input) && input->GetCellType(id) == VTK_POLYHEDRON)
+    // without polyhedra, the connectivity can be remapped in place, all cells
+    // at once.
+    vtkNew<vtkIdTypeArray> connectivity;
+    connectivity->DeepCopy(ugInput->GetCells()->GetData());
+    vtkNew<vtkUnsignedCharArray> types;
+    types->DeepCopy(ugInput->GetCellTypesArray());
+    vtkNew<vtkIdTypeArray> locations;
+    locations->DeepCopy(ugInput->GetCellLocationsArray());
+    vtkCleanUGRemapFunctor remap(
+      connectivity->GetPointer(0), locations->GetPointer(0), ptMap.data());
+    vtkSMPTools::For(0, num, remap);
+
+    vtkNew<vtkCellArray> cells;
+    cells->SetCells(num, connectivity.GetPointer());
+    output->SetCells(types.GetPointer(), locations.GetPointer(), cells.GetPointer());
+  }
+  else
+  {
+    vtkIdType progressStep = num / 100;
+    if (progressStep == 0)
     {
-      vtkUnstructuredGrid::SafeDownCast(input)->GetFaceStream(id, cellPoints);
-      vtkUnstructuredGrid::ConvertFaceStreamPointIds(cellPoints, ptMap);
+      progressStep = 1;
     }
-    else
+    vtkIdList* cellPoints = vtkIdList::New();
+    output->Allocate(num);
+    for (vtkIdType id = 0; id < num; ++id)
     {
-      input->GetCellPoints(id, cellPoints);
-      for (int i = 0; i < cellPoints->GetNumberOfIds(); i++)
+      if (id % progressStep == 0)
+      {
+        this->UpdateProgress(0.8 + 0.2 * ((float)id / num));
+      }
+      // special handling for polyhedron cells
+      if (ugInput && input->GetCellType(id) == VTK_POLYHEDRON)
       {
-        int cellPtId = cellPoints->GetId(i);
-        newId = ptMap[cellPtId];
-        cellPoints->SetId(i, newId);
+        ugInput->GetFaceStream(id, cellPoints);
+        vtkUnstructuredGrid::ConvertFaceStreamPointIds(cellPoints, ptMap.data());
       }
+      else
+      {
+        input->GetCellPoints(id, cellPoints);
+        for (vtkIdType i = 0; i < cellPoints->GetNumberOfIds(); i++)
+        {
+          cellPoints->SetId(i, ptMap[cellPoints->GetId(i)]);
+        }
+      }
+      output->InsertNextCell(input->GetCellType(id), cellPoints);
     }
-    output->InsertNextCell(input->GetCellType(id), cellPoints);
+    cellPoints->Delete();
   }
-
-  delete[] ptMap;
-  cellPoints->Delete();
   output->Squeeze();
 
   return 1;
@@ -20,8 +20,14 @@
  *
  * vtkCleanUnstructuredGrid is a filter that takes unstructured grid data as
  * input and generates unstructured grid data as output. vtkCleanUnstructuredGrid can
- * merge duplicate points (with coincident coordinates) using the vtkMergePoints object
- * to merge points.
+ * merge duplicate points (with coincident coordinates).
+ *
+ * Instead of inserting the points one at a time in a locator, the points are
+ * tagged with a Morton key computed from their quantized coordinates and
+ * sorted concurrently using vtkSMPTools. Coincident points end up next to each
+ * other and are merged in one pass, after which the connectivity of the cells
+ * is remapped in bulk. As with vtkMergePoints, points are compared using the
+ * precision of the output points, i.e. float.
  *
  * @sa
  * vtkCleanPolyData
@@ -33,8 +39,6 @@
 #include "vtkPVVTKExtensionsDefaultModule.h" //needed for exports
 #include "vtkUnstructuredGridAlgorithm.h"
 
-class vtkPointLocator;
-
 class VTKPVVTKEXTENSIONSDEFAULT_EXPORT vtkCleanUnstructuredGrid
   : public vtkUnstructuredGridAlgorithm
 {
@@ -45,11 +49,30 @@ public:
 
   void PrintSelf(ostream& os, vtkIndent indent) VTK_OVERRIDE;
 
+  enum PointOrderingTypes
+  {
+    INPUT_ORDER = 0,
+    SPATIAL_ORDER = 1
+  };
+
+  //@{
+  /**
+   * Set the order of the merged points in the output. With INPUT_ORDER, the
+   * points are ordered by their first occurrence in the input, which is the
+   * ordering of the locator based algorithm formerly used by this filter.
+   * With SPATIAL_ORDER, the points are ordered along the Morton curve used to
+   * merge them, which improves the memory locality of downstream filters.
+   * Default is INPUT_ORDER.
+   */
+  vtkSetClampMacro(PointOrdering, int, INPUT_ORDER, SPATIAL_ORDER);
+  vtkGetMacro(PointOrdering, int);
+  //@}
+
 protected:
   vtkCleanUnstructuredGrid();
   ~vtkCleanUnstructuredGrid() override;
 
-  vtkPointLocator* Locator;
+  int PointOrdering;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) VTK_OVERRIDE;
   int FillInputPortInformation(int port, vtkInformation* info) VTK_OVERRIDE;
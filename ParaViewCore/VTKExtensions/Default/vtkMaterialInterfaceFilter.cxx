@@ -18,6 +18,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiThreader.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -54,6 +55,7 @@
 #include "vtkMaterialInterfaceToProcMap.h"
 #include "vtkPointAccumulator.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedIntArray.h"
 // IO & IPC
 #include "vtkDataSetWriter.h"
@@ -70,6 +72,7 @@
 #include "vtkOBBTree.h"
 #include "vtkTriangleFilter.h"
 // STL
+#include <atomic>
 #include <fstream>
 using std::ofstream;
 #include <sstream>
@@ -1668,6 +1671,9 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
 
   // 1 Layer of ghost cell by block by default
   this->BlockGhostLevel = 1;
+
+  this->ParallelLabeling = 0;
+  this->ConfineFragmentsToBlock = false;
 }
 
 //----------------------------------------------------------------------------
@@ -3592,11 +3598,20 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
     // Lets profile to see what takes the most time for large number of processes.
     this->ProcessBlocksTimer->StartTimer();
 #endif
-    int blockId;
-    for (blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
+    if (this->ParallelLabeling)
+    {
+      this->ProcessBlocksInParallel(hbdsInput, SummedArrayNames);
+      this->Progress += this->ProgressBlockInc * this->NumberOfInputBlocks;
+      this->UpdateProgress(this->Progress);
+    }
+    else
     {
-      // build fragments
-      this->ProcessBlock(blockId);
+      int blockId;
+      for (blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
+      {
+        // build fragments
+        this->ProcessBlock(blockId);
+      }
     }
 #ifdef vtkMaterialInterfaceFilterPROFILE
     // Lets profile to see what takes the most time for large number of processes.
@@ -3752,7 +3767,12 @@ int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
   this->Progress += this->ProgressBlockInc;
   this->UpdateProgress(this->Progress);
 
-  vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[blockId];
+  return this->ProcessBlock(this->InputBlocks[blockId]);
+}
+
+//----------------------------------------------------------------------------
+int vtkMaterialInterfaceFilter::ProcessBlock(vtkMaterialInterfaceFilterBlock* block)
+{
   if (block == 0)
   {
     return 0;
@@ -3872,6 +3892,351 @@ int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// Labels lists of blocks, each with a labeler of its own.
+class vtkMaterialInterfaceFilterLabelBlocks
+{
+public:
+  std::vector<vtkMaterialInterfaceFilter*> Labelers;
+  std::vector<std::vector<vtkMaterialInterfaceFilterBlock*> > Blocks;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ii = begin; ii < end; ++ii)
+    {
+      for (size_t jj = 0; jj < this->Blocks[ii].size(); ++jj)
+      {
+        this->Labelers[ii]->ProcessBlock(this->Blocks[ii][jj]);
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Adds the offset of their labeler to the fragment ids of blocks.
+class vtkMaterialInterfaceFilterOffsetIds
+{
+public:
+  std::vector<vtkMaterialInterfaceFilterBlock*> Blocks;
+  std::vector<int> Offsets;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ii = begin; ii < end; ++ii)
+    {
+      if (this->Offsets[ii] == 0)
+      {
+        continue;
+      }
+      int ext[6];
+      this->Blocks[ii]->GetCellExtent(ext);
+      int numCells = (ext[1] - ext[0] + 1) * (ext[3] - ext[2] + 1) * (ext[5] - ext[4] + 1);
+      int* ids = this->Blocks[ii]->GetFragmentIdPointer();
+      for (int cc = 0; cc < numCells; ++cc)
+      {
+        if (ids[cc] != -1)
+        {
+          ids[cc] += this->Offsets[ii];
+        }
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Lock-free disjoint sets of fragment ids. A root is always linked to the
+// smallest of the two, so that the root of a set is its smallest id.
+class vtkMaterialInterfaceFilterUnionFind
+{
+public:
+  vtkMaterialInterfaceFilterUnionFind(int numIds)
+    : Parents(numIds)
+  {
+    for (int id = 0; id < numIds; ++id)
+    {
+      this->Parents[id].store(id);
+    }
+  }
+
+  int Find(int id)
+  {
+    int parent = this->Parents[id].load();
+    while (parent != id)
+    {
+      // Path halving. Parents only decrease, losing the race to another
+      // thread leaves a valid, if longer, path.
+      int grandParent = this->Parents[parent].load();
+      this->Parents[id].compare_exchange_weak(parent, grandParent);
+      id = grandParent;
+      parent = this->Parents[id].load();
+    }
+    return id;
+  }
+
+  void Union(int id1, int id2)
+  {
+    for (;;)
+    {
+      id1 = this->Find(id1);
+      id2 = this->Find(id2);
+      if (id1 == id2)
+      {
+        return;
+      }
+      if (id1 < id2)
+      {
+        std::swap(id1, id2);
+      }
+      // Fails when another thread linked id1 in the mean time.
+      int root = id1;
+      if (this->Parents[id1].compare_exchange_strong(root, id2))
+      {
+        return;
+      }
+    }
+  }
+
+private:
+  std::vector<std::atomic<int> > Parents;
+};
+
+//----------------------------------------------------------------------------
+// Merges the sets of fragments found touching across blocks.
+class vtkMaterialInterfaceFilterMergeLinks
+{
+public:
+  vtkMaterialInterfaceFilterUnionFind* Sets;
+  const std::pair<int*, int*>* Links;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ii = begin; ii < end; ++ii)
+    {
+      int id1 = *(this->Links[ii].first);
+      int id2 = *(this->Links[ii].second);
+      if (id1 != -1 && id2 != -1)
+      {
+        this->Sets->Union(id1, id2);
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Gives ghost voxels the smallest id of the local fragments they are
+// connected to, or -1 when they are connected to none.
+class vtkMaterialInterfaceFilterResolveGhostIds
+{
+public:
+  vtkMaterialInterfaceFilterUnionFind* Sets;
+  vtkMaterialInterfaceFilterBlock* const* Blocks;
+  int NumberOfLocalFragments;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ii = begin; ii < end; ++ii)
+    {
+      int ext[6];
+      this->Blocks[ii]->GetCellExtent(ext);
+      int numCells = (ext[1] - ext[0] + 1) * (ext[3] - ext[2] + 1) * (ext[5] - ext[4] + 1);
+      int* ids = this->Blocks[ii]->GetFragmentIdPointer();
+      for (int cc = 0; cc < numCells; ++cc)
+      {
+        if (ids[cc] != -1)
+        {
+          int root = this->Sets->Find(ids[cc]);
+          ids[cc] = root < this->NumberOfLocalFragments ? root : -1;
+        }
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Labels the local and the ghost blocks concurrently. The blocks are split
+// in lists, each labeled by a copy of this filter which does not let
+// fragments leave their block and records where they touch other blocks
+// instead. The fragments of the local blocks are then numbered in block
+// order, and the ones touching each other are made equivalent. As when
+// labeling serially, ghost voxels end up with the id of a local fragment
+// they are connected to, or -1.
+void vtkMaterialInterfaceFilter::ProcessBlocksInParallel(
+  vtkNonOverlappingAMR* hbdsInput, vector<string>& summedArrayNames)
+{
+  vector<vtkMaterialInterfaceFilterBlock*> localBlocks;
+  for (int blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
+  {
+    if (this->InputBlocks[blockId])
+    {
+      localBlocks.push_back(this->InputBlocks[blockId]);
+    }
+  }
+  vector<vtkMaterialInterfaceFilterBlock*> ghostBlocks;
+  for (size_t ii = 0; ii < this->GhostBlocks.size(); ++ii)
+  {
+    if (this->GhostBlocks[ii])
+    {
+      ghostBlocks.push_back(this->GhostBlocks[ii]);
+    }
+  }
+
+  // Split the local blocks, then the ghost blocks, in contiguous lists.
+  // There are more lists than threads to balance the load.
+  const size_t maxLists =
+    4 * static_cast<size_t>(vtkMultiThreader::GetGlobalDefaultNumberOfThreads());
+  vtkMaterialInterfaceFilterLabelBlocks labelBlocks;
+  size_t numLocalLists = 0;
+  for (int ghost = 0; ghost < 2; ++ghost)
+  {
+    const vector<vtkMaterialInterfaceFilterBlock*>& blocks = ghost ? ghostBlocks : localBlocks;
+    const size_t listSize = (blocks.size() + maxLists - 1) / maxLists;
+    for (size_t first = 0; first < blocks.size(); first += listSize)
+    {
+      const size_t last = std::min(blocks.size(), first + listSize);
+      labelBlocks.Blocks.push_back(vector<vtkMaterialInterfaceFilterBlock*>(
+        blocks.begin() + first, blocks.begin() + last));
+    }
+    if (!ghost)
+    {
+      numLocalLists = labelBlocks.Blocks.size();
+    }
+  }
+  const size_t numLists = labelBlocks.Blocks.size();
+  for (size_t ii = 0; ii < numLists; ++ii)
+  {
+    vtkMaterialInterfaceFilter* labeler = vtkMaterialInterfaceFilter::New();
+    labeler->ConfineFragmentsToBlock = true;
+    labeler->MaterialId = this->MaterialId;
+    labeler->scaledMaterialFractionThreshold = this->scaledMaterialFractionThreshold;
+    labeler->ComputeMoments = this->ComputeMoments;
+    labeler->ComputeOBB = this->ComputeOBB;
+    labeler->NVolumeWtdAvgs = this->NVolumeWtdAvgs;
+    labeler->NMassWtdAvgs = this->NMassWtdAvgs;
+    labeler->NToSum = this->NToSum;
+    labeler->NToIntegrate = this->NToIntegrate;
+    labeler->IntegratedArrayNames = this->IntegratedArrayNames;
+    labeler->ClipWithSphere = this->ClipWithSphere;
+    labeler->ClipRadius = this->ClipRadius;
+    labeler->ClipWithPlane = this->ClipWithPlane;
+    for (int q = 0; q < 3; ++q)
+    {
+      labeler->ClipCenter[q] = this->ClipCenter[q];
+      labeler->ClipPlaneVector[q] = this->ClipPlaneVector[q];
+      labeler->ClipPlaneNormal[q] = this->ClipPlaneNormal[q];
+    }
+    labeler->PrepareForPass(hbdsInput, this->VolumeWtdAvgArrayNames, this->MassWtdAvgArrayNames,
+      summedArrayNames, this->IntegratedArrayNames);
+    labelBlocks.Labelers.push_back(labeler);
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numLists), 1, labelBlocks);
+
+  // Number the fragments: the local ones in block order, followed by the
+  // ones of the ghost blocks which are only used to find connections.
+  vtkMaterialInterfaceFilterOffsetIds offsetIds;
+  vector<int> labelerOffsets(numLists);
+  int numIds = this->FragmentId;
+  for (size_t ii = 0; ii < numLists; ++ii)
+  {
+    vtkMaterialInterfaceFilter* labeler = labelBlocks.Labelers[ii];
+    labelerOffsets[ii] = numIds;
+    for (size_t jj = 0; jj < labelBlocks.Blocks[ii].size(); ++jj)
+    {
+      offsetIds.Blocks.push_back(labelBlocks.Blocks[ii][jj]);
+      offsetIds.Offsets.push_back(numIds);
+    }
+    numIds += labeler->FragmentId;
+    this->BlockLinks.insert(
+      this->BlockLinks.end(), labeler->BlockLinks.begin(), labeler->BlockLinks.end());
+    if (ii >= numLocalLists)
+    {
+      continue;
+    }
+    for (int id = 0; id < labeler->FragmentId; ++id, ++this->FragmentId)
+    {
+      this->EquivalenceSet->AddEquivalence(this->FragmentId, this->FragmentId);
+      this->FragmentMeshes.push_back(labeler->FragmentMeshes[id]);
+      this->FragmentVolumes->InsertTuple(this->FragmentId, id, labeler->FragmentVolumes);
+      if (this->ClipWithPlane)
+      {
+        this->ClipDepthMaximums->InsertTuple(this->FragmentId, id, labeler->ClipDepthMaximums);
+        this->ClipDepthMinimums->InsertTuple(this->FragmentId, id, labeler->ClipDepthMinimums);
+      }
+      if (this->ComputeMoments)
+      {
+        this->FragmentMoments->InsertTuple(this->FragmentId, id, labeler->FragmentMoments);
+      }
+      for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
+      {
+        this->FragmentVolumeWtdAvgs[i]->InsertTuple(
+          this->FragmentId, id, labeler->FragmentVolumeWtdAvgs[i]);
+      }
+      for (int i = 0; i < this->NMassWtdAvgs; ++i)
+      {
+        this->FragmentMassWtdAvgs[i]->InsertTuple(
+          this->FragmentId, id, labeler->FragmentMassWtdAvgs[i]);
+      }
+      for (int i = 0; i < this->NToSum; ++i)
+      {
+        this->FragmentSums[i]->InsertTuple(this->FragmentId, id, labeler->FragmentSums[i]);
+      }
+    }
+    // The meshes now belong to this filter.
+    labeler->FragmentMeshes.clear();
+  }
+  const int numLocalFragments = this->FragmentId;
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(offsetIds.Blocks.size()), offsetIds);
+
+  // Merge the fragments touching across blocks.
+  vtkMaterialInterfaceFilterUnionFind sets(numIds);
+  if (!this->BlockLinks.empty())
+  {
+    vtkMaterialInterfaceFilterMergeLinks mergeLinks;
+    mergeLinks.Sets = &sets;
+    mergeLinks.Links = &this->BlockLinks[0];
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->BlockLinks.size()), mergeLinks);
+  }
+  // As well as the ones each labeler found equivalent.
+  for (size_t ii = 0; ii < numLists; ++ii)
+  {
+    vtkMaterialInterfaceFilter* labeler = labelBlocks.Labelers[ii];
+    vtkMaterialInterfaceEquivalenceSet* set = labeler->EquivalenceSet;
+    const int numMembers = std::min(set->GetNumberOfMembers(), labeler->FragmentId);
+    for (int id = 0; id < numMembers; ++id)
+    {
+      int setId = set->GetEquivalentSetId(id);
+      if (setId != id)
+      {
+        sets.Union(labelerOffsets[ii] + setId, labelerOffsets[ii] + id);
+      }
+    }
+  }
+  for (int id = 0; id < numLocalFragments; ++id)
+  {
+    int root = sets.Find(id);
+    if (root != id)
+    {
+      this->EquivalenceSet->AddEquivalence(root, id);
+    }
+  }
+  if (!ghostBlocks.empty())
+  {
+    vtkMaterialInterfaceFilterResolveGhostIds resolveGhostIds;
+    resolveGhostIds.Sets = &sets;
+    resolveGhostIds.Blocks = &ghostBlocks[0];
+    resolveGhostIds.NumberOfLocalFragments = numLocalFragments;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(ghostBlocks.size()), resolveGhostIds);
+  }
+
+  this->BlockLinks.clear();
+  for (size_t ii = 0; ii < numLists; ++ii)
+  {
+    ClearVectorOfVtkPointers(labelBlocks.Labelers[ii]->FragmentMeshes);
+    labelBlocks.Labelers[ii]->Delete();
+  }
+}
+
 // We conserver neighbor relations and put the reference (in)
 // block in position 0, and the out block in position 1.
 // The face being generated is between 0 and 1.
@@ -5563,6 +5928,11 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         // Neighbor is outside of fragment.  Make a face.
         this->CreateFace(&iterator, &next, ii, 0);
       }
+      else if (this->ConfineFragmentsToBlock && next.Block != iterator.Block)
+      { // The neighbor is labeled along with its own block. Link them.
+        this->BlockLinks.push_back(
+          std::make_pair(iterator.FragmentIdPointer, next.FragmentIdPointer));
+      }
       else if (next.FragmentIdPointer[0] == -1)
       { // We have not visited this neighbor yet. Mark the voxel and recurse.
         *(next.FragmentIdPointer) = this->FragmentId;
@@ -5594,11 +5964,21 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next2, ii, 0);
           }
+          else if (this->ConfineFragmentsToBlock && next2.Block != iterator.Block)
+          { // The neighbor is labeled along with its own block. Link them.
+            this->BlockLinks.push_back(
+              std::make_pair(iterator.FragmentIdPointer, next2.FragmentIdPointer));
+          }
           else if (next2.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
             *(next2.FragmentIdPointer) = this->FragmentId;
             queue->Push(&next2);
           }
+          else if (this->ConfineFragmentsToBlock)
+          { // next is in another block, labeled concurrently. Link them.
+            this->BlockLinks.push_back(
+              std::make_pair(next2.FragmentIdPointer, next.FragmentIdPointer));
+          }
           else
           { // The last case is that we have already visited this voxel and it
             // is in the same fragment.
@@ -5615,11 +5995,21 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next2, ii, 0);
           }
+          else if (this->ConfineFragmentsToBlock && next2.Block != iterator.Block)
+          { // The neighbor is labeled along with its own block. Link them.
+            this->BlockLinks.push_back(
+              std::make_pair(iterator.FragmentIdPointer, next2.FragmentIdPointer));
+          }
           else if (next2.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
             *(next2.FragmentIdPointer) = this->FragmentId;
             queue->Push(&next2);
           }
+          else if (this->ConfineFragmentsToBlock)
+          { // next is in another block, labeled concurrently. Link them.
+            this->BlockLinks.push_back(
+              std::make_pair(next2.FragmentIdPointer, next.FragmentIdPointer));
+          }
           else
           { // The last case is that we have already visited this voxel and it
             // is in the same fragment.
@@ -5636,11 +6026,21 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next, ii, 0);
           }
+          else if (this->ConfineFragmentsToBlock && next.Block != iterator.Block)
+          { // The neighbor is labeled along with its own block. Link them.
+            this->BlockLinks.push_back(
+              std::make_pair(iterator.FragmentIdPointer, next.FragmentIdPointer));
+          }
           else if (next.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
             *(next.FragmentIdPointer) = this->FragmentId;
             queue->Push(&next);
           }
+          else if (this->ConfineFragmentsToBlock)
+          { // next is in another block, labeled concurrently. Link them.
+            this->BlockLinks.push_back(
+              std::make_pair(next2.FragmentIdPointer, next.FragmentIdPointer));
+          }
           else
           { // The last case is that we have already visited this voxel and it
             // is in the same fragment.
@@ -5656,6 +6056,11 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
       { // Neighbor is outside of fragment.  Make a face.
         this->CreateFace(&iterator, &next, ii, 1);
       }
+      else if (this->ConfineFragmentsToBlock && next.Block != iterator.Block)
+      { // The neighbor is labeled along with its own block. Link them.
+        this->BlockLinks.push_back(
+          std::make_pair(iterator.FragmentIdPointer, next.FragmentIdPointer));
+      }
       else if (next.FragmentIdPointer[0] == -1)
       { // We have not visited this neighbor yet. Mark the voxel and recurse.
         *(next.FragmentIdPointer) = this->FragmentId;
@@ -5682,11 +6087,21 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next2, ii, 1);
           }
+          else if (this->ConfineFragmentsToBlock && next2.Block != iterator.Block)
+          { // The neighbor is labeled along with its own block. Link them.
+            this->BlockLinks.push_back(
+              std::make_pair(iterator.FragmentIdPointer, next2.FragmentIdPointer));
+          }
           else if (next2.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
             *(next2.FragmentIdPointer) = this->FragmentId;
             queue->Push(&next2);
           }
+          else if (this->ConfineFragmentsToBlock)
+          { // next is in another block, labeled concurrently. Link them.
+            this->BlockLinks.push_back(
+              std::make_pair(next2.FragmentIdPointer, next.FragmentIdPointer));
+          }
           else
           { // The last case is that we have already visited this voxel and it
             // is in the same fragment.
@@ -5703,11 +6118,21 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next2, ii, 1);
           }
+          else if (this->ConfineFragmentsToBlock && next2.Block != iterator.Block)
+          { // The neighbor is labeled along with its own block. Link them.
+            this->BlockLinks.push_back(
+              std::make_pair(iterator.FragmentIdPointer, next2.FragmentIdPointer));
+          }
           else if (next2.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
             *(next2.FragmentIdPointer) = this->FragmentId;
             queue->Push(&next2);
           }
+          else if (this->ConfineFragmentsToBlock)
+          { // next is in another block, labeled concurrently. Link them.
+            this->BlockLinks.push_back(
+              std::make_pair(next2.FragmentIdPointer, next.FragmentIdPointer));
+          }
           else
           { // The last case is that we have already visited this voxel and it
             // is in the same fragment.
@@ -5724,11 +6149,21 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next, ii, 1);
           }
+          else if (this->ConfineFragmentsToBlock && next.Block != iterator.Block)
+          { // The neighbor is labeled along with its own block. Link them.
+            this->BlockLinks.push_back(
+              std::make_pair(iterator.FragmentIdPointer, next.FragmentIdPointer));
+          }
           else if (next.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
             *(next.FragmentIdPointer) = this->FragmentId;
             queue->Push(&next);
           }
+          else if (this->ConfineFragmentsToBlock)
+          { // next is in another block, labeled concurrently. Link them.
+            this->BlockLinks.push_back(
+              std::make_pair(next2.FragmentIdPointer, next.FragmentIdPointer));
+          }
           else
           { // The last case is that we have already visited this voxel and it
             // is in the same fragment.
@@ -38,6 +38,7 @@
 #include "vtkMultiBlockDataSetAlgorithm.h"
 #include "vtkPVVTKExtensionsDefaultModule.h" //needed for exports
 #include <string>                            // needed for string
+#include <utility>                           // needed for pair
 #include <vector>                            // needed for vector
 
 #include "vtkSmartPointer.h" // needed for smart pointer
@@ -327,6 +328,18 @@ public:
   vtkGetMacro(InvertVolumeFraction, int);
   //@}
 
+  //@{
+  /**
+   * When on, the blocks of a process are labeled concurrently, using
+   * vtkSMPTools, and the fragments found touching across blocks are merged
+   * afterwards. Fragments are only resolved across processes through the
+   * controller. Off by default.
+   */
+  vtkSetMacro(ParallelLabeling, int);
+  vtkGetMacro(ParallelLabeling, int);
+  vtkBooleanMacro(ParallelLabeling, int);
+  //@}
+
   /**
    * Return the mtime also considering the locator and clip function.
    */
@@ -350,6 +363,11 @@ protected:
   vtkPolyData* NewFragmentMesh();
   // Process each cell, looking for fragments.
   int ProcessBlock(int blockId);
+  int ProcessBlock(vtkMaterialInterfaceFilterBlock* block);
+  // Same as calling ProcessBlock for each block, with the blocks
+  // processed concurrently.
+  void ProcessBlocksInParallel(
+    vtkNonOverlappingAMR* hbdsInput, std::vector<std::string>& summedArrayNames);
   // Cell has been identified as inside the fragment. Integrate, and
   // generate fragment surface etc...
   void ConnectFragment(vtkMaterialInterfaceFilterRingBuffer* iterator);
@@ -713,6 +731,14 @@ protected:
   // By default set to 1
   unsigned char BlockGhostLevel;
 
+  // Label the blocks concurrently.
+  int ParallelLabeling;
+  // Set on the copies labeling the blocks concurrently. A fragment does not
+  // leave its block, the pairs of voxels where it touches another block are
+  // kept in BlockLinks instead.
+  bool ConfineFragmentsToBlock;
+  std::vector<std::pair<int*, int*> > BlockLinks;
+
 #ifdef vtkMaterialInterfaceFilterPROFILE
   // Lets profile to see what takes the most time for large number of processes.
   vtkSmartPointer<vtkTimerLog> InitializeBlocksTimer;
@@ -724,6 +750,8 @@ protected:
 #endif
 
 private:
+  friend class vtkMaterialInterfaceFilterLabelBlocks;
+
   vtkMaterialInterfaceFilter(const vtkMaterialInterfaceFilter&) = delete;
   void operator=(const vtkMaterialInterfaceFilter&) = delete;
 };
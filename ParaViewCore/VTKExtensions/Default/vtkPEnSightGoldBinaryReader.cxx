@@ -11,23 +11,224 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <vtksys/SystemTools.hxx>
 
 #include <ctype.h>
+#include <cstring>
+#include <streambuf>
 #include <string>
 
+#ifdef _WIN32
+#include "vtkWindows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
 
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
+//----------------------------------------------------------------------------
+// Read-only memory mapping of a file, exposed as a stream buffer so that the
+// stream based parsing code works unchanged on top of it.
+class vtkPEnSightGoldBinaryReader::MappedFile : public std::streambuf
+{
+public:
+  MappedFile()
+    : Data(NULL)
+    , Size(0)
+#ifdef _WIN32
+    , FileHandle(INVALID_HANDLE_VALUE)
+    , MappingHandle(NULL)
+#endif
+  {
+  }
+
+  ~MappedFile() override { this->Unmap(); }
+
+  // Returns false if the file could not be mapped, e.g. if it is empty.
+  bool Map(const char* filename)
+  {
+    this->Unmap();
+    char* data = NULL;
+    size_t size = 0;
+#ifdef _WIN32
+    this->FileHandle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (this->FileHandle == INVALID_HANDLE_VALUE)
+    {
+      return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(this->FileHandle, &fileSize) && fileSize.QuadPart > 0)
+    {
+      this->MappingHandle = CreateFileMappingA(this->FileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    if (this->MappingHandle)
+    {
+      data = static_cast<char*>(MapViewOfFile(this->MappingHandle, FILE_MAP_READ, 0, 0, 0));
+      size = static_cast<size_t>(fileSize.QuadPart);
+    }
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+      return false;
+    }
+    struct stat fs;
+    if (fstat(fd, &fs) == 0 && fs.st_size > 0)
+    {
+      size = static_cast<size_t>(fs.st_size);
+      void* address = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (address != MAP_FAILED)
+      {
+        data = static_cast<char*>(address);
+#ifdef POSIX_MADV_SEQUENTIAL
+        posix_madvise(address, size, POSIX_MADV_SEQUENTIAL);
+#endif
+      }
+    }
+    // the mapping stays valid once the descriptor is closed.
+    close(fd);
+#endif
+    if (!data)
+    {
+      this->Unmap();
+      return false;
+    }
+    this->Data = data;
+    this->Size = size;
+    this->setg(this->Data, this->Data, this->Data + this->Size);
+    return true;
+  }
+
+  void Unmap()
+  {
+#ifdef _WIN32
+    if (this->Data)
+    {
+      UnmapViewOfFile(this->Data);
+    }
+    if (this->MappingHandle)
+    {
+      CloseHandle(this->MappingHandle);
+      this->MappingHandle = NULL;
+    }
+    if (this->FileHandle != INVALID_HANDLE_VALUE)
+    {
+      CloseHandle(this->FileHandle);
+      this->FileHandle = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (this->Data)
+    {
+      munmap(this->Data, this->Size);
+    }
+#endif
+    this->Data = NULL;
+    this->Size = 0;
+    this->setg(NULL, NULL, NULL);
+  }
+
+  const char* GetData() const { return this->Data; }
+  size_t GetSize() const { return this->Size; }
+
+protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+  {
+    off_type position = off;
+    if (dir == std::ios_base::cur)
+    {
+      position += this->gptr() - this->eback();
+    }
+    else if (dir == std::ios_base::end)
+    {
+      position += static_cast<off_type>(this->Size);
+    }
+    return this->seekpos(pos_type(position), which);
+  }
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+  {
+    off_type position = pos;
+    if (!(which & std::ios_base::in) || !this->Data || position < 0 ||
+      position > static_cast<off_type>(this->Size))
+    {
+      return pos_type(off_type(-1));
+    }
+    this->setg(this->Data, this->Data + position, this->Data + this->Size);
+    return pos;
+  }
+
+private:
+  char* Data;
+  size_t Size;
+#ifdef _WIN32
+  HANDLE FileHandle;
+  HANDLE MappingHandle;
+#endif
+};
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Decodes consecutive blocks of floats of a memory mapped file into
+// consecutive components of a float array, value i of every block going to
+// the tuple Ids->GetId(i).
+class vtkMappedFloatDecoder
+{
+public:
+  const char* Source;
+  size_t BlockStride;
+  int NumberOfBlocks;
+  float* Destination;
+  int NumberOfComponents;
+  int Component;
+  vtkPEnSightReader::vtkPEnSightReaderCellIds* Ids;
+  bool LittleEndian;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType id = this->Ids ? this->Ids->GetId(static_cast<int>(i)) : i;
+      if (id == -1)
+      {
+        continue;
+      }
+      float* tuple = this->Destination + id * this->NumberOfComponents + this->Component;
+      const char* value = this->Source + i * sizeof(float);
+      for (int block = 0; block < this->NumberOfBlocks; ++block, value += this->BlockStride)
+      {
+        memcpy(tuple + block, value, sizeof(float));
+        if (this->LittleEndian)
+        {
+          vtkByteSwap::Swap4LE(tuple + block);
+        }
+        else
+        {
+          vtkByteSwap::Swap4BE(tuple + block);
+        }
+      }
+    }
+  }
+};
+}
+
 //----------------------------------------------------------------------------
 vtkPEnSightGoldBinaryReader::vtkPEnSightGoldBinaryReader()
 {
+  this->UseMemoryMappedFiles = false;
   this->IFile = NULL;
+  this->Mapping = NULL;
   this->FileSize = 0;
   this->Fortran = 0;
   this->NodeIdsListed = 0;
@@ -47,12 +248,7 @@ vtkPEnSightGoldBinaryReader::vtkPEnSightGoldBinaryReader()
 //----------------------------------------------------------------------------
 vtkPEnSightGoldBinaryReader::~vtkPEnSightGoldBinaryReader()
 {
-  if (this->IFile)
-  {
-    this->IFile->close();
-    delete this->IFile;
-    this->IFile = NULL;
-  }
+  this->CloseFile();
   delete[] this->FloatBuffer[2];
   delete[] this->FloatBuffer[1];
   delete[] this->FloatBuffer[0];
@@ -69,12 +265,7 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
   }
 
   // Close file from any previous image
-  if (this->IFile)
-  {
-    this->IFile->close();
-    delete this->IFile;
-    this->IFile = NULL;
-  }
+  this->CloseFile();
 
   // Open the new file
   vtkDebugMacro(<< "Opening file " << filename);
@@ -84,11 +275,28 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
     // Find out how big the file is.
     this->FileSize = (long)(fs.st_size);
 
+    if (this->UseMemoryMappedFiles)
+    {
+      this->Mapping = new MappedFile;
+      if (this->Mapping->Map(filename))
+      {
+        this->IFile = new istream(this->Mapping);
+      }
+      else
+      {
+        vtkDebugMacro(<< "Could not map " << filename << ", reading it as a stream.");
+        delete this->Mapping;
+        this->Mapping = NULL;
+      }
+    }
+    if (!this->IFile)
+    {
 #ifdef _WIN32
-    this->IFile = new ifstream(filename, ios::in | ios::binary);
+      this->IFile = new ifstream(filename, ios::in | ios::binary);
 #else
-    this->IFile = new ifstream(filename, ios::in);
+      this->IFile = new ifstream(filename, ios::in);
 #endif
+    }
   }
   else
   {
@@ -165,6 +373,16 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkPEnSightGoldBinaryReader::CloseFile()
+{
+  // the stream must go before the mapping it reads from.
+  delete this->IFile;
+  this->IFile = NULL;
+  delete this->Mapping;
+  this->Mapping = NULL;
+}
+
 //----------------------------------------------------------------------------
 int vtkPEnSightGoldBinaryReader::InitializeFile(const char* fileName)
 {
@@ -390,24 +608,14 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
       if (lineRead < 0)
       {
         free(name);
-        if (this->IFile)
-        {
-          this->IFile->close();
-          delete this->IFile;
-          this->IFile = NULL;
-        }
+        this->CloseFile();
         return 0;
       }
     }
     free(name);
   }
 
-  if (this->IFile)
-  {
-    this->IFile->close();
-    delete this->IFile;
-    this->IFile = NULL;
-  }
+  this->CloseFile();
   if (lineRead < 0)
   {
     return 0;
@@ -535,12 +743,7 @@ int vtkPEnSightGoldBinaryReader::SkipTimeStep()
 
   if (lineRead < 0)
   {
-    if (this->IFile)
-    {
-      this->IFile->close();
-      delete this->IFile;
-      this->IFile = NULL;
-    }
+    this->CloseFile();
     return 0;
   }
 
@@ -1278,12 +1481,7 @@ int vtkPEnSightGoldBinaryReader::ReadMeasuredGeometryFile(
   delete[] yCoords;
   delete[] zCoords;
 
-  if (this->IFile)
-  {
-    this->IFile->close();
-    delete this->IFile;
-    this->IFile = NULL;
-  }
+  this->CloseFile();
   return 1;
 }
 
@@ -1411,17 +1609,21 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
       scalars = vtkFloatArray::New();
       scalars->SetNumberOfComponents(numberOfComponents);
       scalars->SetNumberOfTuples(this->GetPointIds(partId)->GetLocalNumberOfIds());
-      scalarsRead = new float[numPts];
-      this->ReadFloatArray(scalarsRead, numPts);
       // Why are we setting only one component here?
       // Only one component is set because scalars are single-component arrays.
       // For complex scalars, there is a file for the real part and another
       // file for the imaginary part, but we are storing them as a 2-component
       // array.
-      for (i = 0; i < numPts; i++)
+      if (!this->ReadMappedFloatArrays(scalars, component, 1, numPts, this->GetPointIds(partId)))
       {
-        this->InsertVariableComponent(
-          scalars, i, component, &(scalarsRead[i]), partId, 0, SCALAR_PER_NODE);
+        scalarsRead = new float[numPts];
+        this->ReadFloatArray(scalarsRead, numPts);
+        for (i = 0; i < numPts; i++)
+        {
+          this->InsertVariableComponent(
+            scalars, i, component, &(scalarsRead[i]), partId, 0, SCALAR_PER_NODE);
+        }
+        delete[] scalarsRead;
       }
       scalars->SetName(description);
       output->GetPointData()->AddArray(scalars);
@@ -1430,14 +1632,8 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
         output->GetPointData()->SetScalars(scalars);
       }
       scalars->Delete();
-      delete[] scalarsRead;
-    }
-    if (this->IFile)
-    {
-      this->IFile->close();
-      delete this->IFile;
-      this->IFile = NULL;
     }
+    this->CloseFile();
     return 1;
   }
 
@@ -1465,13 +1661,17 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
         scalars = (vtkFloatArray*)(output->GetPointData()->GetArray(description));
       }
 
-      scalarsRead = new float[numPts];
-      this->ReadFloatArray(scalarsRead, numPts);
-
-      for (i = 0; i < numPts; i++)
+      if (!this->ReadMappedFloatArrays(scalars, component, 1, numPts, this->GetPointIds(realId)))
       {
-        this->InsertVariableComponent(
-          scalars, i, component, &(scalarsRead[i]), realId, 0, SCALAR_PER_NODE);
+        scalarsRead = new float[numPts];
+        this->ReadFloatArray(scalarsRead, numPts);
+
+        for (i = 0; i < numPts; i++)
+        {
+          this->InsertVariableComponent(
+            scalars, i, component, &(scalarsRead[i]), realId, 0, SCALAR_PER_NODE);
+        }
+        delete[] scalarsRead;
       }
       if (component == 0)
       {
@@ -1487,7 +1687,6 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
       {
         output->GetPointData()->AddArray(scalars);
       }
-      delete[] scalarsRead;
     }
 
     this->IFile->peek();
@@ -1499,12 +1698,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
     lineRead = this->ReadLine(line);
   }
 
-  if (this->IFile)
-  {
-    this->IFile->close();
-    delete this->IFile;
-    this->IFile = NULL;
-  }
+  this->CloseFile();
   return 1;
 }
 
@@ -1653,12 +1847,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
       }
       vectors->Delete();
     }
-    if (this->IFile)
-    {
-      this->IFile->close();
-      delete this->IFile;
-      this->IFile = NULL;
-    }
+    this->CloseFile();
     return 1;
   }
 
@@ -1676,18 +1865,24 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
       this->ReadLine(line); // "coordinates" or "block"
       vectors->SetNumberOfComponents(3);
       vectors->SetNumberOfTuples(this->GetPointIds(realId)->GetLocalNumberOfIds());
-      comp1 = new float[numPts];
-      comp2 = new float[numPts];
-      comp3 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
-      for (i = 0; i < numPts; i++)
-      {
-        tuple[0] = comp1[i];
-        tuple[1] = comp2[i];
-        tuple[2] = comp3[i];
-        this->InsertVariableComponent(vectors, i, -1, tuple, realId, 0, VECTOR_PER_NODE);
+      if (!this->ReadMappedFloatArrays(vectors, 0, 3, numPts, this->GetPointIds(realId)))
+      {
+        comp1 = new float[numPts];
+        comp2 = new float[numPts];
+        comp3 = new float[numPts];
+        this->ReadFloatArray(comp1, numPts);
+        this->ReadFloatArray(comp2, numPts);
+        this->ReadFloatArray(comp3, numPts);
+        for (i = 0; i < numPts; i++)
+        {
+          tuple[0] = comp1[i];
+          tuple[1] = comp2[i];
+          tuple[2] = comp3[i];
+          this->InsertVariableComponent(vectors, i, -1, tuple, realId, 0, VECTOR_PER_NODE);
+        }
+        delete[] comp1;
+        delete[] comp2;
+        delete[] comp3;
       }
       vectors->SetName(description);
       output->GetPointData()->AddArray(vectors);
@@ -1696,9 +1891,6 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
         output->GetPointData()->SetVectors(vectors);
       }
       vectors->Delete();
-      delete[] comp1;
-      delete[] comp2;
-      delete[] comp3;
     }
 
     this->IFile->peek();
@@ -1710,12 +1902,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
     lineRead = this->ReadLine(line);
   }
 
-  if (this->IFile)
-  {
-    this->IFile->close();
-    delete this->IFile;
-    this->IFile = NULL;
-  }
+  this->CloseFile();
 
   return 1;
 }
@@ -1873,12 +2060,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
     lineRead = this->ReadLine(line);
   }
 
-  if (this->IFile)
-  {
-    this->IFile->close();
-    delete this->IFile;
-    this->IFile = NULL;
-  }
+  this->CloseFile();
 
   return 1;
 }
@@ -1981,12 +2163,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
               if (elementType == -1)
               {
                 vtkErrorMacro("Unknown element type \"" << line << "\"");
-                if (this->IFile)
-                {
-                  this->IFile->close();
-                  delete this->IFile;
-                  this->IFile = NULL;
-                }
+                this->CloseFile();
                 return 0;
               }
               idx = this->UnstructuredPartIds->IsId(realId);
@@ -2043,12 +2220,17 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
       // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
       if (strncmp(line, "block", 5) == 0)
       {
-        scalarsRead = new float[numCells];
-        this->ReadFloatArray(scalarsRead, numCells);
-        for (i = 0; i < numCells; i++)
+        if (!this->ReadMappedFloatArrays(
+              scalars, component, 1, numCells, this->GetCellIds(realId, 0)))
         {
-          this->InsertVariableComponent(
-            scalars, i, component, &(scalarsRead[i]), realId, 0, SCALAR_PER_ELEMENT);
+          scalarsRead = new float[numCells];
+          this->ReadFloatArray(scalarsRead, numCells);
+          for (i = 0; i < numCells; i++)
+          {
+            this->InsertVariableComponent(
+              scalars, i, component, &(scalarsRead[i]), realId, 0, SCALAR_PER_ELEMENT);
+          }
+          delete[] scalarsRead;
         }
         if (this->IFile->eof())
         {
@@ -2058,7 +2240,6 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
         {
           lineRead = this->ReadLine(line);
         }
-        delete[] scalarsRead;
       }
       else
       {
@@ -2068,12 +2249,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
           if (elementType == -1)
           {
             vtkErrorMacro("Unknown element type \"" << line << "\"");
-            if (this->IFile)
-            {
-              this->IFile->close();
-              delete this->IFile;
-              this->IFile = NULL;
-            }
+            this->CloseFile();
             if (component == 0)
             {
               scalars->Delete();
@@ -2082,12 +2258,17 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
           }
           idx = this->UnstructuredPartIds->IsId(realId);
           numCellsPerElement = this->GetCellIds(idx, elementType)->GetNumberOfIds();
-          scalarsRead = new float[numCellsPerElement];
-          this->ReadFloatArray(scalarsRead, numCellsPerElement);
-          for (i = 0; i < numCellsPerElement; i++)
+          if (!this->ReadMappedFloatArrays(scalars, component, 1, numCellsPerElement,
+                this->GetCellIds(idx, elementType)))
           {
-            this->InsertVariableComponent(
-              scalars, i, component, &(scalarsRead[i]), idx, elementType, SCALAR_PER_ELEMENT);
+            scalarsRead = new float[numCellsPerElement];
+            this->ReadFloatArray(scalarsRead, numCellsPerElement);
+            for (i = 0; i < numCellsPerElement; i++)
+            {
+              this->InsertVariableComponent(
+                scalars, i, component, &(scalarsRead[i]), idx, elementType, SCALAR_PER_ELEMENT);
+            }
+            delete[] scalarsRead;
           }
           this->IFile->peek();
           if (this->IFile->eof())
@@ -2098,7 +2279,6 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
           {
             lineRead = this->ReadLine(line);
           }
-          delete[] scalarsRead;
         } // end while
       }   // end else
       if (component == 0)
@@ -2130,12 +2310,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
     }
   }
 
-  if (this->IFile)
-  {
-    this->IFile->close();
-    delete this->IFile;
-    this->IFile = NULL;
-  }
+  this->CloseFile();
   return 1;
 }
 
@@ -2288,18 +2463,24 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
       // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
       if (strncmp(line, "block", 5) == 0)
       {
-        comp1 = new float[numCells];
-        comp2 = new float[numCells];
-        comp3 = new float[numCells];
-        this->ReadFloatArray(comp1, numCells);
-        this->ReadFloatArray(comp2, numCells);
-        this->ReadFloatArray(comp3, numCells);
-        for (i = 0; i < numCells; i++)
+        if (!this->ReadMappedFloatArrays(vectors, 0, 3, numCells, this->GetCellIds(realId, 0)))
         {
-          tuple[0] = comp1[i];
-          tuple[1] = comp2[i];
-          tuple[2] = comp3[i];
-          this->InsertVariableComponent(vectors, i, -1, tuple, realId, 0, VECTOR_PER_ELEMENT);
+          comp1 = new float[numCells];
+          comp2 = new float[numCells];
+          comp3 = new float[numCells];
+          this->ReadFloatArray(comp1, numCells);
+          this->ReadFloatArray(comp2, numCells);
+          this->ReadFloatArray(comp3, numCells);
+          for (i = 0; i < numCells; i++)
+          {
+            tuple[0] = comp1[i];
+            tuple[1] = comp2[i];
+            tuple[2] = comp3[i];
+            this->InsertVariableComponent(vectors, i, -1, tuple, realId, 0, VECTOR_PER_ELEMENT);
+          }
+          delete[] comp1;
+          delete[] comp2;
+          delete[] comp3;
         }
         this->IFile->peek();
         if (this->IFile->eof())
@@ -2310,9 +2491,6 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
         {
           lineRead = this->ReadLine(line);
         }
-        delete[] comp1;
-        delete[] comp2;
-        delete[] comp3;
       }
       else
       {
@@ -2329,19 +2507,26 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
           }
           idx = this->UnstructuredPartIds->IsId(realId);
           numCellsPerElement = this->GetCellIds(idx, elementType)->GetNumberOfIds();
-          comp1 = new float[numCellsPerElement];
-          comp2 = new float[numCellsPerElement];
-          comp3 = new float[numCellsPerElement];
-          this->ReadFloatArray(comp1, numCellsPerElement);
-          this->ReadFloatArray(comp2, numCellsPerElement);
-          this->ReadFloatArray(comp3, numCellsPerElement);
-          for (i = 0; i < numCellsPerElement; i++)
+          if (!this->ReadMappedFloatArrays(
+                vectors, 0, 3, numCellsPerElement, this->GetCellIds(idx, elementType)))
           {
-            tuple[0] = comp1[i];
-            tuple[1] = comp2[i];
-            tuple[2] = comp3[i];
-            this->InsertVariableComponent(
-              vectors, i, 0, tuple, idx, elementType, VECTOR_PER_ELEMENT);
+            comp1 = new float[numCellsPerElement];
+            comp2 = new float[numCellsPerElement];
+            comp3 = new float[numCellsPerElement];
+            this->ReadFloatArray(comp1, numCellsPerElement);
+            this->ReadFloatArray(comp2, numCellsPerElement);
+            this->ReadFloatArray(comp3, numCellsPerElement);
+            for (i = 0; i < numCellsPerElement; i++)
+            {
+              tuple[0] = comp1[i];
+              tuple[1] = comp2[i];
+              tuple[2] = comp3[i];
+              this->InsertVariableComponent(
+                vectors, i, 0, tuple, idx, elementType, VECTOR_PER_ELEMENT);
+            }
+            delete[] comp1;
+            delete[] comp2;
+            delete[] comp3;
           }
           this->IFile->peek();
           if (this->IFile->eof())
@@ -2352,9 +2537,6 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
           {
             lineRead = this->ReadLine(line);
           }
-          delete[] comp1;
-          delete[] comp2;
-          delete[] comp3;
         } // end while
       }   // end else
       vectors->SetName(description);
@@ -2379,12 +2561,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
     }
   }
 
-  if (this->IFile)
-  {
-    this->IFile->close();
-    delete this->IFile;
-    this->IFile = NULL;
-  }
+  this->CloseFile();
   return 1;
 }
 
@@ -2649,12 +2826,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
     }
   }
 
-  if (this->IFile)
-  {
-    this->IFile->close();
-    delete this->IFile;
-    this->IFile = NULL;
-  }
+  this->CloseFile();
   return 1;
 }
 
@@ -3787,30 +3959,46 @@ int vtkPEnSightGoldBinaryReader::CreateStructuredGridOutput(
   output->SetDimensions(newDimensions);
   //   output->SetWholeExtent(
   //                          0, newDimensions[0]-1, 0, newDimensions[1]-1, 0, newDimensions[2]-1);
-  points->Allocate(this->GetPointIds(partId)->GetLocalNumberOfIds());
+  int localNumberOfIds = this->GetPointIds(partId)->GetLocalNumberOfIds();
+  points->Allocate(localNumberOfIds);
 
   long currentPositionInFile = this->IFile->tellg();
-
-  // Buffer Read.
-  this->FloatBufferFilePosition = currentPositionInFile;
-  this->FloatBufferIndexBegin = 0;
-  this->FloatBufferNumberOfVectors = numPts;
   long endFilePosition = currentPositionInFile + 3 * numPts * sizeof(float);
   if (this->Fortran)
     endFilePosition += 24; // 4 * (begin + end) * number of components (3)
-  this->UpdateFloatBuffer();
-  this->IFile->seekg(endFilePosition);
 
-  for (i = 0; i < numPts; i++)
+  // Local point ids follow the order of the points in the file.
+  bool mapped = false;
+  if (this->Mapping)
   {
-    int realPointId = this->GetPointIds(partId)->GetId(i);
-    if (realPointId != -1)
+    points->SetNumberOfPoints(localNumberOfIds);
+    mapped = this->ReadMappedFloatArrays(vtkFloatArray::SafeDownCast(points->GetData()), 0, 3,
+               numPts, this->GetPointIds(partId)) != 0;
+    if (!mapped)
     {
-      float vec[3];
-      this->GetVectorFromFloatBuffer(i, vec);
-      points->InsertNextPoint(vec[0], vec[1], vec[2]);
+      points->Reset();
     }
   }
+
+  if (!mapped)
+  {
+    // Buffer Read, filled on first access.
+    this->FloatBufferFilePosition = currentPositionInFile;
+    this->FloatBufferIndexBegin = -1;
+    this->FloatBufferNumberOfVectors = numPts;
+
+    for (i = 0; i < numPts; i++)
+    {
+      int realPointId = this->GetPointIds(partId)->GetId(i);
+      if (realPointId != -1)
+      {
+        float vec[3];
+        this->GetVectorFromFloatBuffer(i, vec);
+        points->InsertNextPoint(vec[0], vec[1], vec[2]);
+      }
+    }
+  }
+  this->IFile->seekg(endFilePosition);
   output->SetPoints(points);
   if (iblanked)
   {
@@ -4321,6 +4509,45 @@ int vtkPEnSightGoldBinaryReader::ReadFloatArray(float* result, int numFloats)
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkPEnSightGoldBinaryReader::ReadMappedFloatArrays(vtkFloatArray* array, int component,
+  int numberOfArrays, int numFloats, vtkPEnSightReaderCellIds* ids)
+{
+  if (!this->Mapping || !array || numFloats <= 0 ||
+    component + numberOfArrays > array->GetNumberOfComponents())
+  {
+    return 0;
+  }
+
+  std::streamoff position = this->IFile->tellg();
+  if (position < 0)
+  {
+    return 0;
+  }
+  // every array is surrounded by its length in Fortran files.
+  std::streamoff markerSize = this->Fortran ? 4 : 0;
+  std::streamoff stride = 2 * markerSize + static_cast<std::streamoff>(sizeof(float)) * numFloats;
+  std::streamoff end = position + numberOfArrays * stride;
+  if (end > static_cast<std::streamoff>(this->Mapping->GetSize()))
+  {
+    return 0;
+  }
+
+  vtkMappedFloatDecoder decoder;
+  decoder.Source = this->Mapping->GetData() + position + markerSize;
+  decoder.BlockStride = static_cast<size_t>(stride);
+  decoder.NumberOfBlocks = numberOfArrays;
+  decoder.Destination = array->GetPointer(0);
+  decoder.NumberOfComponents = array->GetNumberOfComponents();
+  decoder.Component = component;
+  decoder.Ids = ids;
+  decoder.LittleEndian = (this->ByteOrder == FILE_LITTLE_ENDIAN);
+  vtkSMPTools::For(0, numFloats, decoder);
+
+  this->IFile->seekg(end, ios::beg);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
   vtkPoints* points, long offset, int partId, bool skip)
@@ -4351,10 +4578,10 @@ int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
 
   long currentPositionInFile = this->IFile->tellg();
 
+  // The buffer is only filled if the coordinates are read without a mapping.
   this->FloatBufferFilePosition = currentPositionInFile;
-  this->FloatBufferIndexBegin = 0;
+  this->FloatBufferIndexBegin = -1;
   this->FloatBufferNumberOfVectors = numPts;
-  this->UpdateFloatBuffer();
 
   // Position to reach at the end of this method
   long endFilePosition = currentPositionInFile + 3 * numPts * sizeof(float);
@@ -4392,20 +4619,24 @@ int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
       int localNumberOfIds = this->GetPointIds(partId)->GetLocalNumberOfIds();
       points->Allocate(localNumberOfIds);
       points->SetNumberOfPoints(localNumberOfIds);
-      int maxId = -1;
-      int minId = -1;
-      for (i = 0; i < numPts; i++)
+      if (!this->ReadMappedFloatArrays(vtkFloatArray::SafeDownCast(points->GetData()), 0, 3,
+            numPts, this->GetPointIds(partId)))
       {
-        float vec[3];
-        int id = this->GetPointIds(partId)->GetId(i);
-        if (id != -1)
+        int maxId = -1;
+        int minId = -1;
+        for (i = 0; i < numPts; i++)
         {
-          if ((minId == -1) || (minId > id))
-            minId = id;
-          if ((maxId == -1) || (maxId < id))
-            maxId = id;
-          this->GetVectorFromFloatBuffer(i, vec);
-          points->SetPoint(id, vec[0], vec[1], vec[2]);
+          float vec[3];
+          int id = this->GetPointIds(partId)->GetId(i);
+          if (id != -1)
+          {
+            if ((minId == -1) || (minId > id))
+              minId = id;
+            if ((maxId == -1) || (maxId < id))
+              maxId = id;
+            this->GetVectorFromFloatBuffer(i, vec);
+            points->SetPoint(id, vec[0], vec[1], vec[2]);
+          }
         }
       }
 
@@ -4536,4 +4767,5 @@ void vtkPEnSightGoldBinaryReader::UpdateFloatBuffer()
 void vtkPEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseMemoryMappedFiles: " << this->UseMemoryMappedFiles << endl;
 }
@@ -17,6 +17,11 @@
  *
  * Parallel vtkEnSightGoldBinaryReader.
  *
+ * When UseMemoryMappedFiles is on, the files are mapped in memory instead of
+ * being read through a stream: seeking is free, and the coordinates and the
+ * float variables are decoded and byte swapped concurrently, using
+ * vtkSMPTools, straight into the output arrays.
+ *
  * \verbatim
  * This file has been developed as part of the CARRIOCAS (Distributed
  * computation over ultra high optical internet network ) project (
@@ -35,6 +40,7 @@
 #include "vtkPEnSightReader.h"
 #include "vtkPVVTKExtensionsDefaultModule.h" //needed for exports
 
+class vtkFloatArray;
 class vtkMultiBlockDataSet;
 class vtkUnstructuredGrid;
 class vtkPoints;
@@ -46,6 +52,18 @@ public:
   vtkTypeMacro(vtkPEnSightGoldBinaryReader, vtkPEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) VTK_OVERRIDE;
 
+  //@{
+  /**
+   * Map the files in memory rather than reading them through a stream. The
+   * coordinates and the float variables of unstructured parts are then
+   * decoded in parallel directly into the output arrays, which is
+   * significantly faster for large files. Default is off.
+   */
+  vtkSetMacro(UseMemoryMappedFiles, bool);
+  vtkGetMacro(UseMemoryMappedFiles, bool);
+  vtkBooleanMacro(UseMemoryMappedFiles, bool);
+  //@}
+
 protected:
   vtkPEnSightGoldBinaryReader();
   ~vtkPEnSightGoldBinaryReader() override;
@@ -53,6 +71,9 @@ protected:
   // Returns 1 if successful.  Sets file size as a side action.
   int OpenFile(const char* filename);
 
+  // Closes the file opened by OpenFile, if any.
+  void CloseFile();
+
   // Returns 1 if successful.  Handles constructing the filename, opening the file and checking
   // if it's binary
   int InitializeFile(const char* filename);
@@ -171,6 +192,18 @@ protected:
    */
   int ReadFloatArray(float* result, int numFloats);
 
+  /**
+   * Internal function to read numberOfArrays consecutive float arrays of
+   * numFloats values from a memory mapped file, straight into the components
+   * component, component + 1, ... of array. Value i of every array goes to the
+   * tuple ids->GetId(i), or i if ids is NULL, and is skipped if that id is -1.
+   * Returns zero, leaving the file position untouched, if the file is not
+   * mapped or the arrays cannot be read this way, in which case the caller
+   * must fall back to ReadFloatArray.
+   */
+  int ReadMappedFloatArrays(vtkFloatArray* array, int component, int numberOfArrays,
+    int numFloats, vtkPEnSightReaderCellIds* ids);
+
   /**
    * Read Coordinates, or just skip the part in the file.
    */
@@ -205,7 +238,9 @@ protected:
   int ElementIdsListed;
   int Fortran;
 
-  ifstream* IFile;
+  bool UseMemoryMappedFiles;
+
+  istream* IFile;
   // The size of the file could be used to choose byte order.
   long FileSize;
 
@@ -227,6 +262,9 @@ protected:
 private:
   vtkPEnSightGoldBinaryReader(const vtkPEnSightGoldBinaryReader&) = delete;
   void operator=(const vtkPEnSightGoldBinaryReader&) = delete;
+
+  class MappedFile;
+  MappedFile* Mapping;
 };
 
 #endif
@@ -44,6 +44,7 @@ vtkPGenericEnSightReader::vtkPGenericEnSightReader()
   // -2 is the default starting value
   this->MultiProcessLocalProcessId = -2;
   this->MultiProcessNumberOfProcesses = -2;
+  this->UseMemoryMappedFiles = false;
 }
 
 //----------------------------------------------------------------------------
@@ -135,6 +136,12 @@ int vtkPGenericEnSightReader::RequestInformation(
   this->ByteOrder = FILE_UNKNOWN_ENDIAN;
 
   this->Reader->SetByteOrder(this->ByteOrder);
+  vtkPEnSightGoldBinaryReader* binaryReader =
+    vtkPEnSightGoldBinaryReader::SafeDownCast(this->Reader);
+  if (binaryReader)
+  {
+    binaryReader->SetUseMemoryMappedFiles(this->UseMemoryMappedFiles);
+  }
   vtkPGenericEnSightReader* reader = dynamic_cast<vtkPGenericEnSightReader*>(this->Reader);
   if (reader)
   {
@@ -203,4 +210,5 @@ void vtkPGenericEnSightReader::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "MultiProcessLocalProcessId: " << this->MultiProcessLocalProcessId << endl;
   os << indent << "MultiProcessNumberOfProcesses: " << this->MultiProcessNumberOfProcesses << endl;
+  os << indent << "UseMemoryMappedFiles: " << this->UseMemoryMappedFiles << endl;
 }
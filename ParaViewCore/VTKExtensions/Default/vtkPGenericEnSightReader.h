@@ -38,6 +38,17 @@ public:
   vtkTypeMacro(vtkPGenericEnSightReader, vtkGenericEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) VTK_OVERRIDE;
 
+  //@{
+  /**
+   * When EnSight Gold binary files are read in parallel, map them in memory
+   * and decode their coordinates and variables using several threads. See
+   * vtkPEnSightGoldBinaryReader::SetUseMemoryMappedFiles. Default is off.
+   */
+  vtkSetMacro(UseMemoryMappedFiles, bool);
+  vtkGetMacro(UseMemoryMappedFiles, bool);
+  vtkBooleanMacro(UseMemoryMappedFiles, bool);
+  //@}
+
 protected:
   vtkPGenericEnSightReader();
   ~vtkPGenericEnSightReader() override;
@@ -57,6 +68,8 @@ protected:
   int MultiProcessLocalProcessId;
   int MultiProcessNumberOfProcesses;
 
+  bool UseMemoryMappedFiles;
+
 private:
   vtkPGenericEnSightReader(const vtkPGenericEnSightReader&) = delete;
   void operator=(const vtkPGenericEnSightReader&) = delete;
@@ -97,6 +97,7 @@ vtkSpyPlotReader::vtkSpyPlotReader()
   this->TimeStepRange[1] = 0;
   this->ComputeDerivedVariables = 1;
   this->DownConvertVolumeFraction = 1;
+  this->PipelinedDecoding = 0;
   this->MergeXYZComponents = 1;
 
   // this has all of the processes.
@@ -1346,6 +1347,22 @@ void vtkSpyPlotReader::SetDownConvertVolumeFraction(int vf)
   this->Modified();
 }
 
+//-----------------------------------------------------------------------------
+void vtkSpyPlotReader::SetPipelinedDecoding(int pipelined)
+{
+  if (pipelined == this->PipelinedDecoding)
+  {
+    return;
+  }
+  vtkSpyPlotReaderMap::MapOfStringToSPCTH::iterator mapIt;
+  for (mapIt = this->Map->Files.begin(); mapIt != this->Map->Files.end(); ++mapIt)
+  {
+    this->Map->GetReader(mapIt, this)->SetPipelinedDecoding(pipelined);
+  }
+  this->PipelinedDecoding = pipelined;
+  this->Modified();
+}
+
 //-----------------------------------------------------------------------------
 void vtkSpyPlotReader::SetMergeXYZComponents(int merge)
 {
@@ -1420,6 +1437,16 @@ void vtkSpyPlotReader::PrintSelf(ostream& os, vtkIndent indent)
     os << "false" << endl;
   }
 
+  os << "PipelinedDecoding: ";
+  if (this->PipelinedDecoding)
+  {
+    os << "true" << endl;
+  }
+  else
+  {
+    os << "false" << endl;
+  }
+
   os << "MergeXYZComponents: ";
   if (this->MergeXYZComponents)
   {
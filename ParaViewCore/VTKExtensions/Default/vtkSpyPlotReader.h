@@ -175,6 +175,19 @@ public:
   vtkBooleanMacro(DownConvertVolumeFraction, int);
   //@}
 
+  //@{
+  /**
+   * If true, the compressed arrays are read from the file on a background
+   * thread while the arrays already read are decoded in parallel. This speeds
+   * up reading files with many blocks, at the cost of a few buffers of
+   * compressed data. Ignored when markers are generated.
+   * False by default.
+   */
+  void SetPipelinedDecoding(int pipelined);
+  vtkGetMacro(PipelinedDecoding, int);
+  vtkBooleanMacro(PipelinedDecoding, int);
+  //@}
+
   //@{
   /**
    * If true, the reader will calculate all derived variables it can given
@@ -387,6 +400,8 @@ protected:
 
   int DownConvertVolumeFraction;
 
+  int PipelinedDecoding;
+
   bool TimeRequestedFromPipeline;
 
   int MergeXYZComponents;
@@ -124,6 +124,7 @@ vtkSpyPlotUniReader* vtkSpyPlotReaderMap::GetReader(
     it->second = vtkSpyPlotUniReader::New();
     it->second->SetCellArraySelection(parent->GetCellDataArraySelection());
     it->second->SetFileName(it->first.c_str());
+    it->second->SetPipelinedDecoding(parent->GetPipelinedDecoding());
     // cout << parent->GetController()->GetLocalProcessId()
     // << "Create reader: " << it->second << endl;
   }
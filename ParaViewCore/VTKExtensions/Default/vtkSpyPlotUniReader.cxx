@@ -1,13 +1,22 @@
 #include "vtkSpyPlotUniReader.h"
 #include "vtkByteSwap.h"
+#include "vtkConditionVariable.h"
 #include "vtkDataArray.h"
 #include "vtkDataArraySelection.h"
 #include "vtkFloatArray.h"
 #include "vtkIntArray.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSpyPlotBlock.h"
 #include "vtkSpyPlotIStream.h"
 #include "vtkUnsignedCharArray.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <sstream>
 #include <vector>
 #include <vtksys/RegularExpression.hxx>
@@ -38,6 +47,337 @@ inline ostream& operator<<(ostream& os, const vtkSpyPlotWriteString& c)
   return os;
 }
 
+//-----------------------------------------------------------------------------
+// Run-length decodes inSize bytes into at most outSize values, see the
+// description of the format below. Returns 0 if the data decodes to more than
+// outSize values. Does not report errors so that it can be called from any
+// thread.
+template <class t>
+int vtkSpyPlotUniReaderRunLengthDataDecode(
+  const unsigned char* in, int inSize, t* out, int outSize, t scale = 1)
+{
+  int outIndex = 0, inIndex = 0;
+
+  const unsigned char* ptmp = in;
+
+  /* Run-length decode */
+  while ((outIndex < outSize) && (inIndex < inSize))
+  {
+    // Okay get the run length
+    unsigned char runLength = *ptmp;
+    ptmp++;
+    if (runLength < 128)
+    {
+      float val;
+      memcpy(&val, ptmp, sizeof(float));
+      vtkByteSwap::SwapBE(&val);
+      ptmp += 4;
+      // Now populate the out data
+      if (outIndex + runLength > outSize)
+      {
+        return 0;
+      }
+      const t value = static_cast<t>(val * scale);
+      int k;
+      for (k = 0; k < runLength; ++k)
+      {
+        out[outIndex] = value;
+        outIndex++;
+      }
+      inIndex += 5;
+    }
+    else // runLength >= 128
+    {
+      if (outIndex + runLength - 128 > outSize)
+      {
+        return 0;
+      }
+      int k;
+      for (k = 0; k < runLength - 128; ++k)
+      {
+        float val;
+        memcpy(&val, ptmp, sizeof(float));
+        vtkByteSwap::SwapBE(&val);
+        out[outIndex] = static_cast<t>(val * scale);
+        outIndex++;
+        ptmp += 4;
+      }
+      inIndex += 4 * (runLength - 128) + 1;
+    }
+  } // while
+
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+// Reads and decodes the arrays of a dump for vtkSpyPlotUniReader when
+// PipelinedDecoding is on. A background thread reads the compressed planes of
+// the arrays from the file into batches of about BatchSize bytes while the
+// planes of the batches already read are decoded in parallel, straight into
+// the arrays. At most MaximumNumberOfReadyBatches batches wait to be decoded.
+class vtkSpyPlotUniReaderPipeline
+{
+public:
+  enum Status
+  {
+    SUCCESS,
+    READ_ERROR,
+    DECODE_ERROR
+  };
+
+  vtkSpyPlotUniReaderPipeline(const char* fileName)
+    : FileName(fileName)
+    , NextSeek(-1)
+    , Done(false)
+    , Abort(false)
+    , ReadFailed(false)
+  {
+  }
+
+  /**
+   * Starts a new variable, whose blocks are stored at offset in the file.
+   */
+  void AddVariable(vtkTypeInt64 offset) { this->NextSeek = offset; }
+
+  /**
+   * Adds the planes of a block of the current variable, in file order.
+   */
+  void AddBlock(vtkDataArray* array, const int dims[3])
+  {
+    vtkFloatArray* floatArray = vtkArrayDownCast<vtkFloatArray>(array);
+    vtkUnsignedCharArray* unsignedCharArray = vtkArrayDownCast<vtkUnsignedCharArray>(array);
+    const int planeSize = dims[0] * dims[1];
+    for (int zax = 0; zax < dims[2]; ++zax)
+    {
+      Plane plane;
+      plane.Seek = this->NextSeek;
+      plane.FloatOut = floatArray ? floatArray->GetPointer(zax * planeSize) : NULL;
+      plane.UnsignedCharOut =
+        unsignedCharArray ? unsignedCharArray->GetPointer(zax * planeSize) : NULL;
+      plane.Size = planeSize;
+      plane.Offset = 0;
+      plane.NumberOfBytes = 0;
+      this->Planes.push_back(plane);
+      this->NextSeek = -1;
+    }
+  }
+
+  /**
+   * Reads and decodes all the planes added.
+   */
+  Status Execute()
+  {
+    if (this->Planes.empty())
+    {
+      return SUCCESS;
+    }
+    vtkNew<vtkMultiThreader> threader;
+    int threadId = threader->SpawnThread(&vtkSpyPlotUniReaderPipeline::ThreadMain, this);
+
+    Status status = SUCCESS;
+    this->Lock.Lock();
+    for (;;)
+    {
+      while (this->Ready.empty() && !this->Done)
+      {
+        this->Condition.Wait(this->Lock);
+      }
+      if (this->Ready.empty())
+      {
+        break;
+      }
+      Batch batch;
+      batch.Swap(this->Ready.front());
+      this->Ready.pop_front();
+      this->Condition.Broadcast();
+      this->Lock.Unlock();
+
+      Decoder decoder(this->Planes, batch.Buffer);
+      vtkSMPTools::For(static_cast<vtkIdType>(batch.Begin), static_cast<vtkIdType>(batch.End),
+        decoder);
+
+      this->Lock.Lock();
+      this->Free.push_back(std::vector<unsigned char>());
+      this->Free.back().swap(batch.Buffer);
+      if (decoder.Failed)
+      {
+        status = DECODE_ERROR;
+        this->Abort = true;
+        this->Condition.Broadcast();
+        break;
+      }
+    }
+    if (status == SUCCESS && this->ReadFailed)
+    {
+      status = READ_ERROR;
+    }
+    this->Lock.Unlock();
+
+    threader->TerminateThread(threadId);
+    return status;
+  }
+
+private:
+  static const size_t BatchSize = 4 << 20;
+  static const size_t MaximumNumberOfReadyBatches = 2;
+  // a corrupted run may be decoded past the end of its plane, this many bytes
+  // of padding ensure it stays inside the buffer.
+  static const size_t Padding = 4 * 128 + 1;
+
+  struct Plane
+  {
+    vtkTypeInt64 Seek; // where to seek before reading the plane, or -1.
+    float* FloatOut;
+    unsigned char* UnsignedCharOut;
+    int Size;
+    // set by the reading thread.
+    size_t Offset;
+    int NumberOfBytes;
+  };
+
+  struct Batch
+  {
+    Batch()
+      : Begin(0)
+      , End(0)
+    {
+    }
+    void Swap(Batch& other)
+    {
+      std::swap(this->Begin, other.Begin);
+      std::swap(this->End, other.End);
+      this->Buffer.swap(other.Buffer);
+    }
+    size_t Begin;
+    size_t End;
+    std::vector<unsigned char> Buffer;
+  };
+
+  class Decoder
+  {
+  public:
+    Decoder(const std::vector<Plane>& planes, const std::vector<unsigned char>& buffer)
+      : Planes(planes)
+      , Buffer(buffer)
+      , Failed(false)
+    {
+    }
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType cc = begin; cc < end && !this->Failed; ++cc)
+      {
+        const Plane& plane = this->Planes[cc];
+        const unsigned char* in = &this->Buffer[plane.Offset];
+        int success = plane.FloatOut
+          ? ::vtkSpyPlotUniReaderRunLengthDataDecode(
+              in, plane.NumberOfBytes, plane.FloatOut, plane.Size)
+          : ::vtkSpyPlotUniReaderRunLengthDataDecode(in, plane.NumberOfBytes,
+              plane.UnsignedCharOut, plane.Size, static_cast<unsigned char>(255));
+        if (!success)
+        {
+          this->Failed = true;
+        }
+      }
+    }
+
+    const std::vector<Plane>& Planes;
+    const std::vector<unsigned char>& Buffer;
+    std::atomic<bool> Failed;
+  };
+
+  static VTK_THREAD_RETURN_TYPE ThreadMain(void* arg)
+  {
+    vtkMultiThreader::ThreadInfo* info = static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+    static_cast<vtkSpyPlotUniReaderPipeline*>(info->UserData)->Read();
+    return VTK_THREAD_RETURN_VALUE;
+  }
+
+  void Read()
+  {
+    ifstream ifs(this->FileName, ios::binary | ios::in);
+    vtkSpyPlotIStream spis;
+    spis.SetStream(&ifs);
+    bool success = true;
+    size_t cc = 0;
+    while (success && cc < this->Planes.size())
+    {
+      // wait for room in the queue, recycling the buffer of a decoded batch.
+      Batch batch;
+      this->Lock.Lock();
+      while (this->Ready.size() >= MaximumNumberOfReadyBatches && !this->Abort)
+      {
+        this->Condition.Wait(this->Lock);
+      }
+      if (this->Abort)
+      {
+        this->Lock.Unlock();
+        return;
+      }
+      if (!this->Free.empty())
+      {
+        batch.Buffer.swap(this->Free.back());
+        this->Free.pop_back();
+      }
+      this->Lock.Unlock();
+
+      batch.Begin = cc;
+      batch.Buffer.clear();
+      for (; cc < this->Planes.size() && batch.Buffer.size() < BatchSize; ++cc)
+      {
+        Plane& plane = this->Planes[cc];
+        if (plane.Seek >= 0)
+        {
+          spis.Seek(plane.Seek);
+        }
+        int numBytes;
+        if (!spis.ReadInt32s(&numBytes, 1) || numBytes < 0)
+        {
+          success = false;
+          break;
+        }
+        plane.Offset = batch.Buffer.size();
+        plane.NumberOfBytes = numBytes;
+        batch.Buffer.resize(plane.Offset + numBytes);
+        if (numBytes > 0 && !spis.ReadString(&batch.Buffer[plane.Offset], numBytes))
+        {
+          success = false;
+          break;
+        }
+      }
+      batch.End = cc;
+      batch.Buffer.resize(batch.Buffer.size() + Padding);
+
+      this->Lock.Lock();
+      if (success)
+      {
+        this->Ready.push_back(Batch());
+        this->Ready.back().Swap(batch);
+      }
+      this->Condition.Broadcast();
+      this->Lock.Unlock();
+    }
+
+    this->Lock.Lock();
+    this->ReadFailed = !success;
+    this->Done = true;
+    this->Condition.Broadcast();
+    this->Lock.Unlock();
+  }
+
+  const char* FileName;
+  vtkTypeInt64 NextSeek;
+  std::vector<Plane> Planes;
+  std::deque<Batch> Ready;
+  std::vector<std::vector<unsigned char> > Free;
+
+  bool Done;
+  bool Abort;
+  bool ReadFailed;
+  vtkSimpleMutexLock Lock;
+  vtkSimpleConditionVariable Condition;
+};
+
 //-----------------------------------------------------------------------------
 vtkSpyPlotUniReader::vtkSpyPlotUniReader()
 {
@@ -78,6 +418,7 @@ vtkSpyPlotUniReader::vtkSpyPlotUniReader()
   this->NumberOfCellFields = 0;
   this->HaveInformation = 0;
   this->DownConvertVolumeFraction = 1;
+  this->PipelinedDecoding = 0;
   this->DataTypeChanged = 0;
   this->GeomTimeStep = -1; // Indicate that geometry will have to be loaded
   this->NeedToCheck = 1;   // Indicates non-geometric data needs to be checked
@@ -192,6 +533,25 @@ void vtkSpyPlotUniReader::SetDownConvertVolumeFraction(int vf)
   this->DataTypeChanged = 1;
 }
 
+//-----------------------------------------------------------------------------
+vtkDataArray* vtkSpyPlotUniReader::NewCellFieldArray(Variable* var, vtkSpyPlotBlock* block)
+{
+  vtkDataArray* dataArray;
+  if (this->DownConvertVolumeFraction && this->IsVolumeFraction(var))
+  {
+    dataArray = vtkUnsignedCharArray::New();
+  }
+  else
+  {
+    dataArray = vtkFloatArray::New();
+  }
+  dataArray->SetNumberOfComponents(1);
+  dataArray->SetNumberOfTuples(
+    block->GetDimension(0) * block->GetDimension(1) * block->GetDimension(2));
+  dataArray->SetName(var->Name);
+  return dataArray;
+}
+
 //-----------------------------------------------------------------------------
 int vtkSpyPlotUniReader::MakeCurrent()
 {
@@ -325,6 +685,13 @@ int vtkSpyPlotUniReader::MakeCurrent()
   dump = this->CurrentTimeStep;
   dp = this->DataDumps + dump;
 
+  // markers are read after the variables, hence their dumps are read serially.
+  std::unique_ptr<vtkSpyPlotUniReaderPipeline> pipeline;
+  if (this->PipelinedDecoding && !needMarkers)
+  {
+    pipeline.reset(new vtkSpyPlotUniReaderPipeline(this->FileName));
+  }
+
   for (int fieldCnt = 0; fieldCnt < dp->NumVars; ++fieldCnt)
   {
     vtkSpyPlotUniReader::Variable* var = dp->Variables + fieldCnt;
@@ -383,40 +750,49 @@ int vtkSpyPlotUniReader::MakeCurrent()
       continue;
     }
 
+    int block;
+    int actualBlockId = 0;
+    if (pipeline)
+    {
+      // the variable is selected since markers are not needed. Its arrays are
+      // created now and decoded along with the other variables below.
+      pipeline->AddVariable(dp->SavedVariableOffsets[fieldCnt]);
+      for (block = 0; block < dp->NumberOfBlocks; ++block)
+      {
+        vtkSpyPlotBlock* bk = this->Blocks + block;
+        if (bk->IsAllocated())
+        {
+          int bdims[3];
+          bk->GetDimensions(bdims);
+          vtkDataArray* dataArray = this->NewCellFieldArray(var, bk);
+          pipeline->AddBlock(dataArray, bdims);
+          var->DataBlocks[actualBlockId] = dataArray;
+          var->GhostCellsFixed[actualBlockId] = 0;
+          actualBlockId++;
+        }
+      }
+      continue;
+    }
+
     // vtkDebugMacro( "  Field: " << fieldCnt << " / " << dp->NumVars
     // << " [" << var->Name << "]" );
     // vtkDebugMacro( "    Jump to: " << dp->SavedVariableOffsets[fieldCnt] );
     spis.Seek(dp->SavedVariableOffsets[fieldCnt]);
     int numBytes;
-    int block;
-    int actualBlockId = 0;
     for (block = 0; block < dp->NumberOfBlocks; ++block)
     {
       vtkSpyPlotBlock* bk = this->Blocks + block;
       if (bk->IsAllocated())
       {
-        vtkFloatArray* floatArray = 0;
-        vtkUnsignedCharArray* unsignedCharArray = 0;
         vtkDataArray* dataArray = 0;
         if (this->CellArraySelection->ArrayIsEnabled(var->Name) && !var->DataBlocks[actualBlockId])
         {
-          if (this->DownConvertVolumeFraction && this->IsVolumeFraction(var))
-          {
-            unsignedCharArray = vtkUnsignedCharArray::New();
-            dataArray = unsignedCharArray;
-          }
-          else
-          {
-            floatArray = vtkFloatArray::New();
-            dataArray = floatArray;
-          }
-          dataArray->SetNumberOfComponents(1);
-          dataArray->SetNumberOfTuples(
-            bk->GetDimension(0) * bk->GetDimension(1) * bk->GetDimension(2));
-          dataArray->SetName(var->Name);
+          dataArray = this->NewCellFieldArray(var, bk);
           // vtkDebugMacro( "*** Create data array: "
           // << dataArray->GetNumberOfTuples() );
         }
+        vtkFloatArray* floatArray = vtkArrayDownCast<vtkFloatArray>(dataArray);
+        vtkUnsignedCharArray* unsignedCharArray = vtkArrayDownCast<vtkUnsignedCharArray>(dataArray);
         int zax;
         int bdims[3];
         bk->GetDimensions(bdims);
@@ -467,6 +843,18 @@ int vtkSpyPlotUniReader::MakeCurrent()
     }
   }
 
+  switch (pipeline ? pipeline->Execute() : vtkSpyPlotUniReaderPipeline::SUCCESS)
+  {
+    case vtkSpyPlotUniReaderPipeline::READ_ERROR:
+      vtkErrorMacro("Problem reading the bytes");
+      return 0;
+    case vtkSpyPlotUniReaderPipeline::DECODE_ERROR:
+      vtkErrorMacro("Problem RLD decoding data array");
+      return 0;
+    default:
+      break;
+  }
+
   if (blocksUpdated && needMarkers)
   {
     if (this->ReadMarkerDumps(&spis) == 0)
@@ -666,59 +1054,12 @@ template <class t>
 int vtkSpyPlotUniReaderRunLengthDataDecode(
   vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale = 1)
 {
-  int outIndex = 0, inIndex = 0;
-
-  const unsigned char* ptmp = in;
-
-  /* Run-length decode */
-  while ((outIndex < outSize) && (inIndex < inSize))
+  if (!::vtkSpyPlotUniReaderRunLengthDataDecode(in, inSize, out, outSize, scale))
   {
-    // Okay get the run length
-    unsigned char runLength = *ptmp;
-    ptmp++;
-    if (runLength < 128)
-    {
-      float val;
-      memcpy(&val, ptmp, sizeof(float));
-      vtkByteSwap::SwapBE(&val);
-      ptmp += 4;
-      // Now populate the out data
-      int k;
-      for (k = 0; k < runLength; ++k)
-      {
-        if (outIndex >= outSize)
-        {
-          vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
-              << "Too much data generated. Expected: " << outSize);
-          return 0;
-        }
-        out[outIndex] = static_cast<t>(val * scale);
-        outIndex++;
-      }
-      inIndex += 5;
-    }
-    else // runLength >= 128
-    {
-      int k;
-      for (k = 0; k < runLength - 128; ++k)
-      {
-        if (outIndex >= outSize)
-        {
-          vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
-              << "Too much data generated. Expected: " << outSize);
-          return 0;
-        }
-        float val;
-        memcpy(&val, ptmp, sizeof(float));
-        vtkByteSwap::SwapBE(&val);
-        out[outIndex] = static_cast<t>(val * scale);
-        outIndex++;
-        ptmp += 4;
-      }
-      inIndex += 4 * (runLength - 128) + 1;
-    }
-  } // while
-
+    vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
+        << "Too much data generated. Expected: " << outSize);
+    return 0;
+  }
   return 1;
 }
 
@@ -1337,6 +1678,7 @@ void vtkSpyPlotUniReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "DataTypeChanged: " << this->DataTypeChanged << endl;
   os << indent << "NumberOfCellFields: " << this->NumberOfCellFields << endl;
   os << indent << "NeedToCheck: " << this->NeedToCheck << endl;
+  os << indent << "PipelinedDecoding: " << this->PipelinedDecoding << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -231,6 +231,17 @@ public:
   vtkSetMacro(DataTypeChanged, int);
   void SetDownConvertVolumeFraction(int vf);
 
+  //@{
+  /**
+   * When on, MakeCurrent() reads the compressed arrays of the current dump on
+   * a background thread while the arrays already read are run-length decoded
+   * in parallel with vtkSMPTools, directly into their final storage. Ignored
+   * when markers are generated. Off by default.
+   */
+  vtkSetMacro(PipelinedDecoding, int);
+  vtkGetMacro(PipelinedDecoding, int);
+  //@}
+
 protected:
   vtkSpyPlotUniReader();
   ~vtkSpyPlotUniReader() override;
@@ -306,6 +317,7 @@ private:
 
   int DataTypeChanged;
   int DownConvertVolumeFraction;
+  int PipelinedDecoding;
 
   int NumberOfCellFields;
 
@@ -314,6 +326,9 @@ private:
   Variable* GetCellField(int field);
   int IsVolumeFraction(Variable* var);
 
+  // Creates the array of the variable for the block, to be decoded.
+  vtkDataArray* NewCellFieldArray(Variable* var, vtkSpyPlotBlock* block);
+
 private:
   vtkSpyPlotUniReader(const vtkSpyPlotUniReader&) = delete;
   void operator=(const vtkSpyPlotUniReader&) = delete;
@@ -0,0 +1,129 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestExecutionTracer.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkNew.h"
+#include "vtkPVCompositeDataPipeline.h"
+#include "vtkPVExecutionTracer.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <vtksys/FStream.hxx>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+size_t Count(const std::string& str, const std::string& pattern)
+{
+  size_t count = 0;
+  for (size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1))
+  {
+    ++count;
+  }
+  return count;
+}
+}
+
+int TestExecutionTracer(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    cerr << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  std::string path = tempDir;
+  path += "/TestExecutionTracer.json";
+  delete[] tempDir;
+
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkPVCompositeDataPipeline> executive;
+  sphere->SetExecutive(executive.GetPointer());
+
+  // nothing is recorded while disabled.
+  sphere->Update();
+
+  vtkPVExecutionTracer::SetEnabled(true);
+  vtkPVExecutionTracer::SetBufferCapacity(16);
+  vtkPVExecutionTracer::SetMemorySamplingInterval(3600);
+  sphere->SetThetaResolution(32);
+  sphere->Update();
+
+  // the memory is not sampled again within the interval.
+  sphere->SetPhiResolution(32);
+  sphere->Update();
+
+  // record from several threads, overflowing their buffers.
+  std::vector<std::thread> threads;
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    threads.push_back(std::thread([cc]() {
+      for (int kk = 0; kk < 20; ++kk)
+      {
+        vtkPVExecutionTracerScope scope("test", "thread \"span\"");
+        scope.SetArgument("index", cc * 20 + kk);
+      }
+    }));
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  vtkPVExecutionTracer::AddCounter("test", "counter", 42);
+  vtkPVExecutionTracer::SetEnabled(false);
+
+  if (vtkPVExecutionTracer::GetNumberOfDroppedEvents() != 4 * 4)
+  {
+    cerr << "ERROR: unexpected number of dropped events: "
+         << vtkPVExecutionTracer::GetNumberOfDroppedEvents() << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!vtkPVExecutionTracer::Write(path.c_str()))
+  {
+    cerr << "ERROR: failed to write " << path << endl;
+    return EXIT_FAILURE;
+  }
+  vtkPVExecutionTracer::Clear();
+
+  vtksys::ifstream ifs(path.c_str());
+  std::ostringstream contents;
+  contents << ifs.rdbuf();
+  const std::string trace = contents.str();
+
+  const std::string header = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n{";
+  const std::string footer = "}\n]}\n";
+  if (trace.size() < header.size() + footer.size() ||
+    trace.compare(0, header.size(), header) != 0 ||
+    trace.compare(trace.size() - footer.size(), footer.size(), footer) != 0)
+  {
+    cerr << "ERROR: malformed trace:" << endl << trace << endl;
+    return EXIT_FAILURE;
+  }
+  if (Count(trace, "\"name\":\"vtkSphereSource::RequestInformation\"") != 2 ||
+    Count(trace, "\"name\":\"vtkSphereSource::RequestData\"") != 2 ||
+    Count(trace, "\"name\":\"memory used (KiB)\"") != 1 ||
+    Count(trace, "\"name\":\"thread \\\"span\\\"\"") != 4 * 16 ||
+    Count(trace, "\"name\":\"counter\",\"cat\":\"test\",\"ph\":\"C\"") != 1 ||
+    Count(trace, "\"args\":{\"value\":42.000}") != 1)
+  {
+    cerr << "ERROR: unexpected events in the trace:" << endl << trace << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -26,6 +26,8 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <map>
 #include <string>
 #include <vtksys/CommandLineArguments.hxx>
@@ -48,7 +50,39 @@ public:
 };
 typedef std::map<std::string, Data> MapType;
 
-bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* input)
+// Checks that each color channel of `output` is within `tolerance` of the
+// input and that the alpha channel, if any, is within `alphaTolerance`.
+bool SameAsInput(vtkUnsignedCharArray* input, vtkUnsignedCharArray* output, int tolerance,
+  int alphaTolerance)
+{
+  const int numComps = input->GetNumberOfComponents();
+  const vtkIdType size = input->GetNumberOfTuples() * numComps;
+  if (output->GetNumberOfComponents() != numComps ||
+    output->GetNumberOfTuples() != input->GetNumberOfTuples())
+  {
+    cerr << "ERROR: the decompressed image does not have the size of the input." << endl;
+    return false;
+  }
+  const unsigned char* in = input->GetPointer(0);
+  const unsigned char* out = output->GetPointer(0);
+  for (vtkIdType cc = 0; cc < size; ++cc)
+  {
+    const int maxDifference = (numComps == 4 && cc % 4 == 3) ? alphaTolerance : tolerance;
+    if (std::abs(static_cast<int>(in[cc]) - static_cast<int>(out[cc])) > maxDifference)
+    {
+      cerr << "ERROR: the decompressed image differs from the input at value " << cc << ": "
+           << static_cast<int>(out[cc]) << " instead of " << static_cast<int>(in[cc])
+           << " (tolerance: " << maxDifference << ")." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compresses and decompresses `input`, then compares the result with `input`
+// using SameAsInput.
+bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* input,
+  int tolerance, int alphaTolerance, vtkUnsignedCharArray* result = NULL)
 {
   vtkNew<vtkUnsignedCharArray> outputCompressed;
   vtkNew<vtkUnsignedCharArray> outputDeCompressed;
@@ -76,8 +110,25 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
   }
   timer->StopTimer();
   data.DecompressTime += timer->GetElapsedTime();
+
+  if (result)
+  {
+    result->DeepCopy(outputDeCompressed.Get());
+  }
   data.CompressedSize =
     outputCompressed->GetNumberOfTuples() * outputCompressed->GetNumberOfComponents();
+  return SameAsInput(input, outputDeCompressed.Get(), tolerance, alphaTolerance);
+}
+
+bool SameImage(vtkUnsignedCharArray* a, vtkUnsignedCharArray* b)
+{
+  const vtkIdType size = a->GetNumberOfTuples() * a->GetNumberOfComponents();
+  if (size != b->GetNumberOfTuples() * b->GetNumberOfComponents() ||
+    !std::equal(a->GetPointer(0), a->GetPointer(0) + size, b->GetPointer(0)))
+  {
+    cerr << "ERROR: threaded and serial compression results differ." << endl;
+    return false;
+  }
   return true;
 }
 
@@ -125,7 +176,7 @@ int TestImageCompressors(int argc, char* argv[])
   {
     vtkNew<vtkLZ4Compressor> lz4;
     lz4->SetQuality(0);
-    if (!DoTest(datas["LZ4 (quality: 0)"], lz4.Get(), input))
+    if (!DoTest(datas["LZ4 (quality: 0)"], lz4.Get(), input, 0, 0))
     {
       return TEST_FAILED;
     }
@@ -133,13 +184,13 @@ int TestImageCompressors(int argc, char* argv[])
     {
       lz4->SetQuality(3);
       lz4->SetLossLessMode(0);
-      if (!DoTest(datas["LZ4 (quality: 3)"], lz4.Get(), input))
+      if (!DoTest(datas["LZ4 (quality: 3)"], lz4.Get(), input, 7, 7))
       {
         return TEST_FAILED;
       }
       lz4->SetQuality(5);
       lz4->SetLossLessMode(0);
-      if (!DoTest(datas["LZ4 (quality: 5)"], lz4.Get(), input))
+      if (!DoTest(datas["LZ4 (quality: 5)"], lz4.Get(), input, 31, 31))
       {
         return TEST_FAILED;
       }
@@ -147,7 +198,7 @@ int TestImageCompressors(int argc, char* argv[])
 
     vtkNew<vtkSquirtCompressor> squirt;
     squirt->SetSquirtLevel(0);
-    if (!DoTest(datas["SQUIRT (squirt-level: 0)"], squirt.Get(), input))
+    if (!DoTest(datas["SQUIRT (squirt-level: 0)"], squirt.Get(), input, 0, 15))
     {
       return TEST_FAILED;
     }
@@ -155,14 +206,14 @@ int TestImageCompressors(int argc, char* argv[])
     if (test_lossy)
     {
       squirt->SetSquirtLevel(3);
-      if (!DoTest(datas["SQUIRT (squirt-level: 3)"], squirt.Get(), input))
+      if (!DoTest(datas["SQUIRT (squirt-level: 3)"], squirt.Get(), input, 7, 22))
       {
         return TEST_FAILED;
       }
 
       squirt->SetSquirtLevel(5);
       squirt->SetLossLessMode(0);
-      if (!DoTest(datas["SQUIRT (squirt-level: 5)"], squirt.Get(), input))
+      if (!DoTest(datas["SQUIRT (squirt-level: 5)"], squirt.Get(), input, 31, 46))
       {
         return TEST_FAILED;
       }
@@ -170,17 +221,51 @@ int TestImageCompressors(int argc, char* argv[])
 
     vtkNew<vtkZlibImageCompressor> zlib;
     zlib->SetCompressionLevel(1);
-    if (!DoTest(datas["ZLIB (compression-level: 1, color-space: 0)"], zlib.Get(), input))
+    if (!DoTest(datas["ZLIB (compression-level: 1, color-space: 0)"], zlib.Get(), input, 0, 0))
+    {
+      return TEST_FAILED;
+    }
+
+    // Serial variants, to compare with the default threaded compression.
+    // Both must decompress to the input, and to the same image.
+    vtkNew<vtkUnsignedCharArray> threaded;
+    vtkNew<vtkUnsignedCharArray> serial;
+    Data reference;
+    squirt->SetSquirtLevel(0);
+    squirt->SetThreaded(1);
+    if (!DoTest(reference, squirt.Get(), input, 0, 15, threaded.Get()))
+    {
+      return TEST_FAILED;
+    }
+    squirt->SetThreaded(0);
+    if (!DoTest(datas["SQUIRT (squirt-level: 0, serial)"], squirt.Get(), input, 0, 15,
+          serial.Get()) ||
+      !SameImage(threaded.Get(), serial.Get()))
+    {
+      return TEST_FAILED;
+    }
+    squirt->SetThreaded(1);
+
+    zlib->SetThreaded(1);
+    if (!DoTest(reference, zlib.Get(), input, 0, 0, threaded.Get()))
+    {
+      return TEST_FAILED;
+    }
+    zlib->SetThreaded(0);
+    if (!DoTest(datas["ZLIB (compression-level: 1, color-space: 0, serial)"], zlib.Get(), input,
+          0, 0, serial.Get()) ||
+      !SameImage(threaded.Get(), serial.Get()))
     {
       return TEST_FAILED;
     }
+    zlib->SetThreaded(1);
 
     if (test_lossy)
     {
       zlib->SetCompressionLevel(1);
       zlib->SetColorSpace(3);
       zlib->SetLossLessMode(0);
-      if (!DoTest(datas["ZLIB (compression-level: 1, color-space: 3)"], zlib.Get(), input))
+      if (!DoTest(datas["ZLIB (compression-level: 1, color-space: 3)"], zlib.Get(), input, 7, 0))
       {
         return TEST_FAILED;
       }
@@ -188,7 +273,7 @@ int TestImageCompressors(int argc, char* argv[])
       zlib->SetCompressionLevel(9);
       zlib->SetColorSpace(5);
       zlib->SetLossLessMode(0);
-      if (!DoTest(datas["ZLIB (compression-level: 9, color-space: 5)"], zlib.Get(), input))
+      if (!DoTest(datas["ZLIB (compression-level: 9, color-space: 5)"], zlib.Get(), input, 31, 0))
       {
         return TEST_FAILED;
       }
@@ -0,0 +1,187 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestLZ4DeltaCompressor.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkLZ4DeltaCompressor.h"
+#include "vtkNew.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+
+namespace
+{
+void FillImage(vtkUnsignedCharArray* image, int width, int height, int seed)
+{
+  image->SetNumberOfComponents(4);
+  image->SetNumberOfTuples(width * height);
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      unsigned char* pixel = image->GetPointer(4 * (y * width + x));
+      pixel[0] = static_cast<unsigned char>(x + seed);
+      pixel[1] = static_cast<unsigned char>(y);
+      pixel[2] = static_cast<unsigned char>(x * y);
+      pixel[3] = 0xff;
+    }
+  }
+}
+
+// Compresses `image` with `sender`, decompresses it with `receiver` and checks
+// that the result matches. Returns the compressed size or -1 on error.
+vtkIdType RoundTrip(vtkLZ4DeltaCompressor* sender, vtkLZ4DeltaCompressor* receiver,
+  vtkUnsignedCharArray* image, int width, int height)
+{
+  vtkNew<vtkUnsignedCharArray> compressed;
+  sender->SetImageResolution(width, height);
+  sender->SetInput(image);
+  sender->SetOutput(compressed.Get());
+  if (!sender->Compress())
+  {
+    cerr << "ERROR: Compress failed." << endl;
+    return -1;
+  }
+
+  vtkNew<vtkUnsignedCharArray> result;
+  result->SetNumberOfComponents(image->GetNumberOfComponents());
+  result->SetNumberOfTuples(image->GetNumberOfTuples());
+  receiver->SetImageResolution(width, height);
+  receiver->SetInput(compressed.Get());
+  receiver->SetOutput(result.Get());
+  if (!receiver->Decompress())
+  {
+    cerr << "ERROR: Decompress failed." << endl;
+    return -1;
+  }
+
+  const vtkIdType size = image->GetNumberOfTuples() * image->GetNumberOfComponents();
+  if (!std::equal(image->GetPointer(0), image->GetPointer(0) + size, result->GetPointer(0)))
+  {
+    cerr << "ERROR: Decompressed image does not match the input." << endl;
+    return -1;
+  }
+  return compressed->GetNumberOfTuples();
+}
+}
+
+int TestLZ4DeltaCompressor(int, char* [])
+{
+  vtkNew<vtkLZ4DeltaCompressor> sender;
+  vtkNew<vtkLZ4DeltaCompressor> receiver;
+  sender->SetLossLessMode(1);
+  receiver->SetLossLessMode(1);
+
+  int width = 300;
+  int height = 200;
+  vtkNew<vtkUnsignedCharArray> image;
+  FillImage(image.Get(), width, height, 0);
+
+  const vtkIdType keyFrameSize =
+    RoundTrip(sender.Get(), receiver.Get(), image.Get(), width, height);
+  if (keyFrameSize < 0)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Unchanged frame: no tile is sent.
+  vtkIdType size = RoundTrip(sender.Get(), receiver.Get(), image.Get(), width, height);
+  if (size < 0 || sender->GetNumberOfChangedTiles() != 0 ||
+    receiver->GetNumberOfChangedTiles() != 0 || size >= keyFrameSize / 10)
+  {
+    cerr << "ERROR: unchanged frame was not skipped." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Change a small region spanning a tile corner: exactly 4 tiles change.
+  for (int y = 60; y < 70; ++y)
+  {
+    for (int x = 60; x < 70; ++x)
+    {
+      image->GetPointer(4 * (y * width + x))[0] ^= 0x55;
+    }
+  }
+  size = RoundTrip(sender.Get(), receiver.Get(), image.Get(), width, height);
+  if (size < 0 || sender->GetNumberOfChangedTiles() != 4)
+  {
+    cerr << "ERROR: expected 4 changed tiles, got " << sender->GetNumberOfChangedTiles() << endl;
+    return EXIT_FAILURE;
+  }
+
+  // A new resolution must generate a key frame.
+  width = 128;
+  height = 100;
+  FillImage(image.Get(), width, height, 7);
+  if (RoundTrip(sender.Get(), receiver.Get(), image.Get(), width, height) < 0)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Serial compression must decode identically.
+  sender->SetThreaded(0);
+  FillImage(image.Get(), width, height, 9);
+  if (RoundTrip(sender.Get(), receiver.Get(), image.Get(), width, height) < 0)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // A receiver that missed a frame must reject deltas.
+  vtkNew<vtkLZ4DeltaCompressor> lateReceiver;
+  FillImage(image.Get(), width, height, 11);
+  sender->ForceKeyFrame();
+  RoundTrip(sender.Get(), receiver.Get(), image.Get(), width, height);
+  FillImage(image.Get(), width, height, 12);
+  vtkObject::GlobalWarningDisplayOff();
+  size = RoundTrip(sender.Get(), lateReceiver.Get(), image.Get(), width, height);
+  vtkObject::GlobalWarningDisplayOn();
+  if (size >= 0)
+  {
+    cerr << "ERROR: delta frame accepted without the previous frame." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Drop a delta on its way to `receiver`: the next delta must be rejected,
+  // and the key frame the receiver then asks for must restore the image.
+  FillImage(image.Get(), width, height, 13);
+  vtkNew<vtkUnsignedCharArray> dropped;
+  sender->SetInput(image.Get());
+  sender->SetOutput(dropped.Get());
+  if (!sender->Compress())
+  {
+    cerr << "ERROR: Compress failed." << endl;
+    return EXIT_FAILURE;
+  }
+  FillImage(image.Get(), width, height, 14);
+  vtkObject::GlobalWarningDisplayOff();
+  size = RoundTrip(sender.Get(), receiver.Get(), image.Get(), width, height);
+  vtkObject::GlobalWarningDisplayOn();
+  if (size >= 0)
+  {
+    cerr << "ERROR: delta frame accepted after a dropped frame." << endl;
+    return EXIT_FAILURE;
+  }
+  sender->ForceKeyFrame();
+  FillImage(image.Get(), width, height, 15);
+  if (RoundTrip(sender.Get(), receiver.Get(), image.Get(), width, height) < 0)
+  {
+    cerr << "ERROR: the key frame did not recover from the dropped frame." << endl;
+    return EXIT_FAILURE;
+  }
+  image->GetPointer(0)[0] ^= 0x55;
+  if (RoundTrip(sender.Get(), receiver.Get(), image.Get(), width, height) < 0 ||
+    sender->GetNumberOfChangedTiles() == sender->GetNumberOfTiles())
+  {
+    cerr << "ERROR: deltas did not resume after the key frame." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
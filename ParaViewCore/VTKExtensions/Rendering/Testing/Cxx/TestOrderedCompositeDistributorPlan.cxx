@@ -0,0 +1,172 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestOrderedCompositeDistributorPlan.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that redistributing data along a reused redistribution plan gives
+// the same result as redistributing it with D3 from scratch.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkIntArray.h"
+#include "vtkKdTreeManager.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkOrderedCompositeDistributor.h"
+#include "vtkPKdTree.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+
+namespace
+{
+// Returns a piece of a sphere with a linear point array, so that interpolating
+// it in the cells split by D3 is exact, a cell array and a field array, all
+// depending on `step`.
+vtkSmartPointer<vtkPolyData> MakePiece(int piece, int numPieces, int step)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+  sphere->SetStartTheta(360. * piece / numPieces);
+  sphere->SetEndTheta(360. * (piece + 1) / numPieces);
+  sphere->Update();
+
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  output->ShallowCopy(sphere->GetOutput());
+  output->GetPointData()->Initialize();
+
+  vtkNew<vtkDoubleArray> linear;
+  linear->SetName("Linear");
+  linear->SetNumberOfTuples(output->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < output->GetNumberOfPoints(); ++cc)
+  {
+    double x[3];
+    output->GetPoint(cc, x);
+    linear->SetValue(cc, (step + 1) * x[0] + 2 * x[1] - step * x[2]);
+  }
+  output->GetPointData()->SetScalars(linear.Get());
+
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfTuples(output->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < output->GetNumberOfCells(); ++cc)
+  {
+    cellIds->SetValue(cc, static_cast<int>(100000 * piece + cc + step));
+  }
+  output->GetCellData()->AddArray(cellIds.Get());
+
+  vtkNew<vtkIntArray> field;
+  field->SetName("Step");
+  field->InsertNextValue(step);
+  output->GetFieldData()->AddArray(field.Get());
+  return output;
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b, const char* name)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    cerr << "ERROR: array " << name << " is missing or differs in size." << endl;
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < a->GetNumberOfTuples(); ++cc)
+  {
+    for (int comp = 0; comp < a->GetNumberOfComponents(); ++comp)
+    {
+      const double va = a->GetComponent(cc, comp);
+      const double vb = b->GetComponent(cc, comp);
+      if (std::abs(va - vb) > 1e-6 * (1 + std::abs(va)))
+      {
+        cerr << "ERROR: array " << name << " differs at tuple " << cc << ": " << va << " vs "
+             << vb << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameOutputs(vtkPolyData* reused, vtkPolyData* fresh)
+{
+  if (reused->GetNumberOfPoints() != fresh->GetNumberOfPoints() ||
+    reused->GetNumberOfCells() != fresh->GetNumberOfCells())
+  {
+    cerr << "ERROR: the outputs differ in size." << endl;
+    return false;
+  }
+  return SameArrays(reused->GetPoints()->GetData(), fresh->GetPoints()->GetData(), "Points") &&
+    SameArrays(reused->GetPointData()->GetArray("Linear"),
+      fresh->GetPointData()->GetArray("Linear"), "Linear") &&
+    SameArrays(reused->GetCellData()->GetArray("CellIds"),
+      fresh->GetCellData()->GetArray("CellIds"), "CellIds") &&
+    SameArrays(reused->GetFieldData()->GetArray("Step"), fresh->GetFieldData()->GetArray("Step"),
+      "Step");
+}
+}
+
+int TestOrderedCompositeDistributorPlan(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller.Get());
+  const int myId = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  vtkSmartPointer<vtkPolyData> first = MakePiece(myId, numProcs, 0);
+  vtkNew<vtkKdTreeManager> cutsGenerator;
+  cutsGenerator->AddDataObject(first);
+  cutsGenerator->GenerateKdTree();
+  vtkPKdTree* tree = cutsGenerator->GetKdTree();
+
+  // builds the plan with the first data, then applies it to the second one,
+  // which only differs by its attributes.
+  vtkNew<vtkOrderedCompositeDistributor> reused;
+  reused->SetController(controller.Get());
+  reused->SetPKdTree(tree);
+  reused->SetReuseRedistributionPlan(true);
+  reused->SetInputData(first);
+  reused->Update();
+
+  vtkSmartPointer<vtkPolyData> second = MakePiece(myId, numProcs, 1);
+  reused->SetInputData(second);
+  reused->SetInputGeometryHash(vtkOrderedCompositeDistributor::ComputeGeometryHash(second));
+  reused->Update();
+
+  vtkNew<vtkOrderedCompositeDistributor> fresh;
+  fresh->SetController(controller.Get());
+  fresh->SetPKdTree(tree);
+  fresh->SetInputData(second);
+  fresh->Update();
+
+  int status = 1;
+  vtkPolyData* reusedOutput = vtkPolyData::SafeDownCast(reused->GetOutputDataObject(0));
+  vtkPolyData* freshOutput = vtkPolyData::SafeDownCast(fresh->GetOutputDataObject(0));
+  if (!reusedOutput || !freshOutput || !SameOutputs(reusedOutput, freshOutput))
+  {
+    cerr << "ERROR: process " << myId
+         << ": the reused plan and D3 give different redistributions." << endl;
+    status = 0;
+  }
+  int allStatus = 0;
+  controller->AllReduce(&status, &allStatus, 1, vtkCommunicator::MIN_OP);
+
+  vtkMultiProcessController::SetGlobalController(NULL);
+  controller->Finalize();
+  return allStatus ? EXIT_SUCCESS : EXIT_FAILURE;
+}
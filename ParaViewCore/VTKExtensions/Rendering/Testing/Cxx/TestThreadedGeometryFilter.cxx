@@ -0,0 +1,190 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestThreadedGeometryFilter.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkFieldData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+namespace
+{
+vtkSmartPointer<vtkMultiBlockDataSet> CreateDataSet()
+{
+  vtkSmartPointer<vtkMultiBlockDataSet> data = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  for (unsigned int cc = 0; cc < 24; ++cc)
+  {
+    vtkNew<vtkRTAnalyticSource> wavelet;
+    wavelet->SetWholeExtent(0, 8 + cc, 0, 8, 0, 8);
+    wavelet->Update();
+    switch (cc % 4)
+    {
+      case 0:
+      {
+        vtkNew<vtkSphereSource> sphere;
+        sphere->SetThetaResolution(8 + cc);
+        sphere->SetCenter(cc, 0, 0);
+        sphere->Update();
+        data->SetBlock(cc, sphere->GetOutput());
+        break;
+      }
+      case 1:
+        data->SetBlock(cc, wavelet->GetOutput());
+        break;
+      case 2:
+      {
+        vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+        tetrahedralize->SetInputConnection(wavelet->GetOutputPort());
+        tetrahedralize->Update();
+        data->SetBlock(cc, tetrahedralize->GetOutput());
+        break;
+      }
+      default:
+      {
+        // a nested multiblock with a null leaf.
+        vtkNew<vtkMultiBlockDataSet> nested;
+        nested->SetBlock(0, wavelet->GetOutput());
+        nested->SetBlock(1, NULL);
+        data->SetBlock(cc, nested.GetPointer());
+        break;
+      }
+    }
+  }
+  return data;
+}
+
+vtkSmartPointer<vtkMultiBlockDataSet> Extract(vtkMultiBlockDataSet* data, bool threaded)
+{
+  vtkPVGeometryFilter::SetThreadedCompositeExecution(threaded);
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetUseOutline(0);
+  filter->SetGenerateCellNormals(1);
+  filter->SetInputData(data);
+  filter->Update();
+  vtkPVGeometryFilter::SetThreadedCompositeExecution(false);
+  return vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+}
+
+bool SameArrays(vtkFieldData* a, vtkFieldData* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int cc = 0; cc < a->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* arrayA = a->GetArray(cc);
+    vtkDataArray* arrayB = b->GetArray(cc);
+    if (arrayA == NULL || arrayB == NULL)
+    {
+      continue;
+    }
+    int numComps = arrayA->GetNumberOfComponents();
+    if (arrayA->GetNumberOfTuples() != arrayB->GetNumberOfTuples() ||
+      numComps != arrayB->GetNumberOfComponents())
+    {
+      return false;
+    }
+    for (vtkIdType idx = 0; idx < arrayA->GetNumberOfTuples(); ++idx)
+    {
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        if (arrayA->GetComponent(idx, comp) != arrayB->GetComponent(idx, comp))
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool SamePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells() ||
+    a->GetPolys()->GetNumberOfConnectivityEntries() !=
+      b->GetPolys()->GetNumberOfConnectivityEntries())
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < a->GetNumberOfPoints(); ++cc)
+  {
+    double pa[3], pb[3];
+    a->GetPoint(cc, pa);
+    b->GetPoint(cc, pb);
+    if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2])
+    {
+      return false;
+    }
+  }
+  return SameArrays(a->GetPointData(), b->GetPointData()) &&
+    SameArrays(a->GetCellData(), b->GetCellData()) &&
+    SameArrays(a->GetFieldData(), b->GetFieldData());
+}
+}
+
+int TestThreadedGeometryFilter(int, char* [])
+{
+  vtkSmartPointer<vtkMultiBlockDataSet> data = CreateDataSet();
+  vtkSmartPointer<vtkMultiBlockDataSet> serial = Extract(data, false);
+  vtkSmartPointer<vtkMultiBlockDataSet> threaded = Extract(data, true);
+  if (!serial || !threaded)
+  {
+    cerr << "ERROR: missing output." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkCompositeDataIterator> iterA;
+  iterA.TakeReference(serial->NewIterator());
+  iterA->SkipEmptyNodesOff();
+  vtkSmartPointer<vtkCompositeDataIterator> iterB;
+  iterB.TakeReference(threaded->NewIterator());
+  iterB->SkipEmptyNodesOff();
+
+  int numLeaves = 0;
+  for (iterA->InitTraversal(), iterB->InitTraversal(); !iterA->IsDoneWithTraversal();
+       iterA->GoToNextItem(), iterB->GoToNextItem(), ++numLeaves)
+  {
+    if (iterB->IsDoneWithTraversal() ||
+      iterA->GetCurrentFlatIndex() != iterB->GetCurrentFlatIndex())
+    {
+      cerr << "ERROR: output structures differ." << endl;
+      return EXIT_FAILURE;
+    }
+    vtkPolyData* a = vtkPolyData::SafeDownCast(iterA->GetCurrentDataObject());
+    vtkPolyData* b = vtkPolyData::SafeDownCast(iterB->GetCurrentDataObject());
+    if ((a == NULL) != (b == NULL) || (a && !SamePolyData(a, b)))
+    {
+      cerr << "ERROR: mismatch in leaf " << iterA->GetCurrentFlatIndex() << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (!iterB->IsDoneWithTraversal() || numLeaves == 0)
+  {
+    cerr << "ERROR: output structures differ." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
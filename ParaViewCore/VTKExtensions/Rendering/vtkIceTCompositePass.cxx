@@ -30,6 +30,7 @@
 #include "vtkOpenGLRenderUtilities.h"
 #include "vtkOpenGLRenderWindow.h"
 #include "vtkOpenGLState.h"
+#include "vtkPVExecutionTracer.h"
 #include "vtkPartitionOrderingInterface.h"
 #include "vtkPixelBufferObject.h"
 #include "vtkRenderState.h"
@@ -444,6 +445,9 @@ void vtkIceTCompositePass::CleanupContext(const vtkRenderState*)
 //----------------------------------------------------------------------------
 void vtkIceTCompositePass::Render(const vtkRenderState* render_state)
 {
+  // the time spent compositing is that of this span minus the nested
+  // vtkIceTCompositePass::Draw span.
+  vtkPVExecutionTracerScope scope("compositing", "vtkIceTCompositePass::Render");
   vtkOpenGLRenderUtilities::MarkDebugEvent("vtkIceTCompositePass::Render Start");
   this->IceTContext->SetController(this->Controller);
   if (!this->IceTContext->IsValid())
@@ -611,6 +615,7 @@ void vtkIceTCompositePass::Draw(const vtkRenderState* render_state, const IceTDo
   const IceTDouble* mv_matrix, const IceTFloat* vtkNotUsed(background_color),
   const IceTInt* vtkNotUsed(readback_viewport), IceTImage result)
 {
+  vtkPVExecutionTracerScope scope("rendering", "vtkIceTCompositePass::Draw");
   vtkOpenGLClearErrorMacro();
 
   vtkRenderer* ren = static_cast<vtkRenderer*>(render_state->GetRenderer());
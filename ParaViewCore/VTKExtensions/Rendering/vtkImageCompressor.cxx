@@ -17,10 +17,19 @@
 
 #include "vtkCommand.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
 #include <sstream>
 #include <string>
 
+namespace
+{
+// Bands smaller than this are not worth the threading overhead.
+const vtkIdType MinimumPixelsPerBand = 64 * 1024;
+}
+
 //-----------------------------------------------------------------------------
 vtkCxxSetObjectMacro(vtkImageCompressor, Output, vtkUnsignedCharArray);
 
@@ -32,6 +41,7 @@ vtkImageCompressor::vtkImageCompressor()
   : Output(0)
   , Input(0)
   , LossLessMode(0)
+  , Threaded(1)
   , Configuration(0)
 {
   // Always allocate output array as a convenience.
@@ -53,6 +63,18 @@ void vtkImageCompressor::SetImageResolution(int, int)
 {
 }
 
+//-----------------------------------------------------------------------------
+int vtkImageCompressor::GetNumberOfBands(vtkIdType numberOfPixels)
+{
+  if (!this->Threaded)
+  {
+    return 1;
+  }
+  vtkIdType numBands = std::min(static_cast<vtkIdType>(vtkSMPTools::GetEstimatedNumberOfThreads()),
+    numberOfPixels / MinimumPixelsPerBand);
+  return static_cast<int>(std::max(numBands, static_cast<vtkIdType>(1)));
+}
+
 //-----------------------------------------------------------------------------
 void vtkImageCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
 {
@@ -107,5 +129,6 @@ void vtkImageCompressor::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Input:          " << this->Input << endl
      << indent << "Output:         " << this->Output << endl
-     << indent << "LossLessMode: " << this->LossLessMode << endl;
+     << indent << "LossLessMode: " << this->LossLessMode << endl
+     << indent << "Threaded: " << this->Threaded << endl;
 }
@@ -24,6 +24,8 @@
  * the LossLessMode ivar, which is used by the composite manager to force
  * loss less compression during a still render. Additionally compressors
  * must be able to seriealize and restore their setting from a stream.
+ *
+ * Subclasses may support threaded compression, see SetThreaded().
 */
 
 #ifndef vtkImageCompressor_h
@@ -66,6 +68,27 @@ public:
   vtkGetMacro(LossLessMode, int);
   //@}
 
+  //@{
+  /**
+   * When set (default), implementations that support it split the image into
+   * horizontal bands that are compressed concurrently using vtkSMPTools. The
+   * bands are recorded in the compressed data, hence Decompress() decodes
+   * them concurrently as well irrespective of this flag on the receiving end.
+   */
+  vtkSetMacro(Threaded, int);
+  vtkGetMacro(Threaded, int);
+  vtkBooleanMacro(Threaded, int);
+  //@}
+
+  /**
+   * Returns the index of the first pixel of the given band when an image with
+   * \c numberOfPixels pixels is split into \c numberOfBands bands.
+   */
+  static vtkIdType GetBandStart(vtkIdType numberOfPixels, int numberOfBands, vtkIdType band)
+  {
+    return (numberOfPixels * band) / numberOfBands;
+  }
+
   /**
    * Call this method to compress the input and generate the compressed
    * data.
@@ -122,6 +145,14 @@ protected:
   vtkUnsignedCharArray* Input;
 
   int LossLessMode;
+  int Threaded;
+
+  /**
+   * Returns the number of bands an image with the given number of pixels
+   * should be split into for compression. This is 1 when Threaded is off or
+   * when the image is too small for threading to pay off.
+   */
+  int GetNumberOfBands(vtkIdType numberOfPixels);
 
   vtkSetStringMacro(Configuration);
   char* Configuration;
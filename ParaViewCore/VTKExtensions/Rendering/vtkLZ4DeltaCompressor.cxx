@@ -0,0 +1,506 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkLZ4DeltaCompressor.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkLZ4DeltaCompressor.h"
+
+#include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+
+#include "vtk_lz4.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+// The compressed data starts with a header made of HEADER_SIZE 32-bit values
+// followed by the 32-bit compressed size of each tile, 0 for tiles that did
+// not change, and finally the LZ4 compressed XOR delta of each changed tile.
+enum HeaderFields
+{
+  FLAGS,
+  FRAME_ID,
+  WIDTH,
+  HEIGHT,
+  COMPONENTS,
+  TILE_SIZE,
+  HEADER_SIZE
+};
+const vtkTypeUInt32 KEY_FRAME = 0x1;
+
+class vtkTileLayout
+{
+public:
+  int Width;
+  int Height;
+  int Components;
+  int TileSize;
+  int TilesX;
+  int TilesY;
+
+  vtkTileLayout(int width, int height, int comps, int tileSize)
+    : Width(width)
+    , Height(height)
+    , Components(comps)
+    , TileSize(tileSize)
+  {
+    this->TilesX = (width + tileSize - 1) / tileSize;
+    this->TilesY = (height + tileSize - 1) / tileSize;
+  }
+
+  int GetNumberOfTiles() const { return this->TilesX * this->TilesY; }
+
+  vtkIdType GetNumberOfBytes() const
+  {
+    return static_cast<vtkIdType>(this->Width) * this->Height * this->Components;
+  }
+
+  void GetTile(vtkIdType tile, int& x0, int& y0, int& w, int& h) const
+  {
+    x0 = static_cast<int>(tile % this->TilesX) * this->TileSize;
+    y0 = static_cast<int>(tile / this->TilesX) * this->TileSize;
+    w = std::min(this->TileSize, this->Width - x0);
+    h = std::min(this->TileSize, this->Height - y0);
+  }
+
+  vtkIdType GetOffset(int x, int y) const
+  {
+    return (static_cast<vtkIdType>(y) * this->Width + x) * this->Components;
+  }
+};
+
+typedef vtkSMPThreadLocal<std::vector<unsigned char> > ScratchType;
+
+// XORs a row of `count` RGBA pixels against the reference after applying
+// `mask`, stores the delta in `delta` and updates the reference. Returns
+// non-zero if any pixel changed.
+inline unsigned int vtkEncodeRowRGBA(const unsigned int* in, unsigned int* ref,
+  unsigned int* delta, int count, unsigned int mask)
+{
+  unsigned int changed = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    const unsigned int value = in[i] & mask;
+    const unsigned int x = value ^ ref[i];
+    delta[i] = x;
+    ref[i] = value;
+    changed |= x;
+  }
+  return changed;
+}
+
+inline unsigned int vtkEncodeRow(
+  const unsigned char* in, unsigned char* ref, unsigned char* delta, vtkIdType count)
+{
+  unsigned int changed = 0;
+  for (vtkIdType i = 0; i < count; ++i)
+  {
+    const unsigned char x = in[i] ^ ref[i];
+    delta[i] = x;
+    ref[i] = in[i];
+    changed |= x;
+  }
+  return changed;
+}
+
+class vtkEncodeTiles
+{
+public:
+  const unsigned char* Input;
+  unsigned char* Reference;
+  unsigned int Mask;
+  bool ApplyMask;
+  const vtkTileLayout& Layout;
+  std::vector<std::vector<char> >& Tiles;
+  std::vector<unsigned char>& Status;
+  ScratchType& Scratch;
+
+  vtkEncodeTiles(const vtkTileLayout& layout, std::vector<std::vector<char> >& tiles,
+    std::vector<unsigned char>& status, ScratchType& scratch)
+    : Layout(layout)
+    , Tiles(tiles)
+    , Status(status)
+    , Scratch(scratch)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<unsigned char>& delta = this->Scratch.Local();
+    for (vtkIdType tile = begin; tile < end; ++tile)
+    {
+      int x0, y0, w, h;
+      this->Layout.GetTile(tile, x0, y0, w, h);
+      const vtkIdType rowSize = static_cast<vtkIdType>(w) * this->Layout.Components;
+      const int tileSize = static_cast<int>(rowSize * h);
+      delta.resize(tileSize);
+
+      unsigned int changed = 0;
+      for (int row = 0; row < h; ++row)
+      {
+        const vtkIdType offset = this->Layout.GetOffset(x0, y0 + row);
+        unsigned char* d = &delta[0] + row * rowSize;
+        if (this->ApplyMask)
+        {
+          changed |= vtkEncodeRowRGBA(reinterpret_cast<const unsigned int*>(this->Input + offset),
+            reinterpret_cast<unsigned int*>(this->Reference + offset),
+            reinterpret_cast<unsigned int*>(d), w, this->Mask);
+        }
+        else
+        {
+          changed |= vtkEncodeRow(this->Input + offset, this->Reference + offset, d, rowSize);
+        }
+      }
+
+      std::vector<char>& out = this->Tiles[tile];
+      if (changed == 0)
+      {
+        out.clear();
+        continue;
+      }
+      const int maxOutputSize = LZ4_compressBound(tileSize);
+      out.resize(maxOutputSize);
+      const int compressedSize = LZ4_compress_fast(
+        reinterpret_cast<const char*>(&delta[0]), &out[0], tileSize, maxOutputSize, 16);
+      out.resize(std::max(compressedSize, 0));
+      this->Status[tile] = (compressedSize > 0) ? 1 : 0;
+    }
+  }
+};
+
+class vtkDecodeTiles
+{
+public:
+  const char* Input;
+  unsigned char* Reference;
+  const vtkTileLayout& Layout;
+  const std::vector<vtkIdType>& Offsets;
+  std::vector<unsigned char>& Status;
+  ScratchType& Scratch;
+
+  vtkDecodeTiles(const vtkTileLayout& layout, const std::vector<vtkIdType>& offsets,
+    std::vector<unsigned char>& status, ScratchType& scratch)
+    : Layout(layout)
+    , Offsets(offsets)
+    , Status(status)
+    , Scratch(scratch)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<unsigned char>& delta = this->Scratch.Local();
+    for (vtkIdType tile = begin; tile < end; ++tile)
+    {
+      const int compressedSize = static_cast<int>(this->Offsets[tile + 1] - this->Offsets[tile]);
+      if (compressedSize == 0)
+      {
+        continue;
+      }
+
+      int x0, y0, w, h;
+      this->Layout.GetTile(tile, x0, y0, w, h);
+      const vtkIdType rowSize = static_cast<vtkIdType>(w) * this->Layout.Components;
+      const int tileSize = static_cast<int>(rowSize * h);
+      delta.resize(tileSize);
+      if (LZ4_decompress_safe(this->Input + this->Offsets[tile],
+            reinterpret_cast<char*>(&delta[0]), compressedSize, tileSize) != tileSize)
+      {
+        this->Status[tile] = 0;
+        continue;
+      }
+
+      for (int row = 0; row < h; ++row)
+      {
+        unsigned char* ref = this->Reference + this->Layout.GetOffset(x0, y0 + row);
+        const unsigned char* d = &delta[0] + row * rowSize;
+        for (vtkIdType i = 0; i < rowSize; ++i)
+        {
+          ref[i] ^= d[i];
+        }
+      }
+    }
+  }
+};
+}
+
+class vtkLZ4DeltaCompressor::vtkInternals
+{
+public:
+  // The previous frame, as reconstructed by the decompressor.
+  std::vector<unsigned char> Reference;
+  int Width;
+  int Height;
+  int Components;
+  vtkTypeUInt32 FrameId;
+  bool KeyFrameRequested;
+
+  std::vector<std::vector<char> > Tiles;
+  ScratchType Scratch;
+
+  vtkInternals()
+    : Width(0)
+    , Height(0)
+    , Components(0)
+    , FrameId(0)
+    , KeyFrameRequested(true)
+  {
+  }
+
+  template <typename Functor>
+  static void For(int threaded, vtkIdType last, Functor& functor)
+  {
+    if (threaded)
+    {
+      vtkSMPTools::For(0, last, functor);
+    }
+    else
+    {
+      functor(0, last);
+    }
+  }
+};
+
+vtkStandardNewMacro(vtkLZ4DeltaCompressor);
+//----------------------------------------------------------------------------
+vtkLZ4DeltaCompressor::vtkLZ4DeltaCompressor()
+  : TileSize(64)
+  , ImageWidth(0)
+  , ImageHeight(0)
+  , NumberOfTiles(0)
+  , NumberOfChangedTiles(0)
+  , Internals(new vtkLZ4DeltaCompressor::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkLZ4DeltaCompressor::~vtkLZ4DeltaCompressor()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkLZ4DeltaCompressor::SetImageResolution(int width, int height)
+{
+  this->ImageWidth = width;
+  this->ImageHeight = height;
+}
+
+//----------------------------------------------------------------------------
+void vtkLZ4DeltaCompressor::ForceKeyFrame()
+{
+  this->Internals->KeyFrameRequested = true;
+}
+
+//----------------------------------------------------------------------------
+int vtkLZ4DeltaCompressor::Compress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot compress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  vtkInternals& internals = *this->Internals;
+  vtkUnsignedCharArray* input = this->Input;
+  const vtkIdType numPixels = input->GetNumberOfTuples();
+  const int comps = input->GetNumberOfComponents();
+
+  int width = this->ImageWidth;
+  int height = this->ImageHeight;
+  if (static_cast<vtkIdType>(width) * height != numPixels)
+  {
+    width = static_cast<int>(numPixels);
+    height = 1;
+  }
+  vtkTileLayout layout(width, height, comps, this->TileSize);
+
+  const bool keyFrame = internals.KeyFrameRequested || internals.Width != width ||
+    internals.Height != height || internals.Components != comps;
+  if (keyFrame)
+  {
+    // a key frame is a delta against a black image.
+    internals.Reference.assign(layout.GetNumberOfBytes(), 0);
+    internals.Width = width;
+    internals.Height = height;
+    internals.Components = comps;
+    internals.KeyFrameRequested = false;
+  }
+  internals.FrameId++;
+
+  unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
+    { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
+    { 0xE0, 0xF0, 0xE0, 0xE0 } };
+  const int compress_level = this->LossLessMode ? 0 : this->Quality;
+
+  const int numTiles = layout.GetNumberOfTiles();
+  internals.Tiles.resize(numTiles);
+
+  std::vector<unsigned char> status(numTiles, 1);
+  vtkEncodeTiles worker(layout, internals.Tiles, status, internals.Scratch);
+  worker.Input = input->GetPointer(0);
+  worker.Reference = internals.Reference.empty() ? NULL : &internals.Reference[0];
+  worker.ApplyMask = (compress_level > 0 && comps == 4);
+  memcpy(&worker.Mask, &compress_masks[compress_level], 4);
+  vtkInternals::For(this->Threaded, numTiles, worker);
+  if (std::find(status.begin(), status.end(), 0) != status.end())
+  {
+    vtkErrorMacro("Failed to compress tiles.");
+    internals.KeyFrameRequested = true;
+    return VTK_ERROR;
+  }
+
+  // Package the header, the tile sizes and the changed tiles.
+  vtkIdType outputSize = (HEADER_SIZE + numTiles) * sizeof(vtkTypeUInt32);
+  this->NumberOfTiles = numTiles;
+  this->NumberOfChangedTiles = 0;
+  for (int tile = 0; tile < numTiles; ++tile)
+  {
+    const std::vector<char>& data = internals.Tiles[tile];
+    outputSize += static_cast<vtkIdType>(data.size());
+    this->NumberOfChangedTiles += data.empty() ? 0 : 1;
+  }
+
+  vtkTypeUInt32 header[HEADER_SIZE];
+  header[FLAGS] = keyFrame ? KEY_FRAME : 0;
+  header[FRAME_ID] = internals.FrameId;
+  header[WIDTH] = static_cast<vtkTypeUInt32>(width);
+  header[HEIGHT] = static_cast<vtkTypeUInt32>(height);
+  header[COMPONENTS] = static_cast<vtkTypeUInt32>(comps);
+  header[TILE_SIZE] = static_cast<vtkTypeUInt32>(this->TileSize);
+
+  this->Output->SetNumberOfComponents(1);
+  unsigned char* out = this->Output->WritePointer(0, outputSize);
+  memcpy(out, header, sizeof(header));
+  out += sizeof(header);
+  for (int tile = 0; tile < numTiles; ++tile)
+  {
+    const vtkTypeUInt32 size = static_cast<vtkTypeUInt32>(internals.Tiles[tile].size());
+    memcpy(out, &size, sizeof(size));
+    out += sizeof(size);
+  }
+  for (int tile = 0; tile < numTiles; ++tile)
+  {
+    const std::vector<char>& data = internals.Tiles[tile];
+    if (!data.empty())
+    {
+      memcpy(out, &data[0], data.size());
+      out += data.size();
+    }
+  }
+  return VTK_OK;
+}
+
+//----------------------------------------------------------------------------
+int vtkLZ4DeltaCompressor::Decompress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot decompress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  vtkInternals& internals = *this->Internals;
+  const unsigned char* in = this->Input->GetPointer(0);
+  const vtkIdType inSize = this->Input->GetNumberOfTuples() * this->Input->GetNumberOfComponents();
+
+  vtkTypeUInt32 header[HEADER_SIZE];
+  if (inSize < static_cast<vtkIdType>(sizeof(header)))
+  {
+    vtkErrorMacro("Invalid compressed data.");
+    return VTK_ERROR;
+  }
+  memcpy(header, in, sizeof(header));
+
+  const int width = static_cast<int>(header[WIDTH]);
+  const int height = static_cast<int>(header[HEIGHT]);
+  const int comps = static_cast<int>(header[COMPONENTS]);
+  const int tileSize = static_cast<int>(header[TILE_SIZE]);
+  if (tileSize <= 0 || comps != this->Output->GetNumberOfComponents() ||
+    static_cast<vtkIdType>(width) * height != this->Output->GetNumberOfTuples())
+  {
+    vtkErrorMacro("Compressed data does not match the output image.");
+    return VTK_ERROR;
+  }
+  vtkTileLayout layout(width, height, comps, tileSize);
+
+  if (header[FLAGS] & KEY_FRAME)
+  {
+    internals.Reference.assign(layout.GetNumberOfBytes(), 0);
+    internals.Width = width;
+    internals.Height = height;
+    internals.Components = comps;
+  }
+  else if (internals.Width != width || internals.Height != height ||
+    internals.Components != comps || header[FRAME_ID] != internals.FrameId + 1)
+  {
+    vtkErrorMacro("Received a delta frame that does not follow the previous frame.");
+    return VTK_ERROR;
+  }
+
+  // Read the tile sizes.
+  const int numTiles = layout.GetNumberOfTiles();
+  const vtkIdType dataStart = (HEADER_SIZE + numTiles) * sizeof(vtkTypeUInt32);
+  if (inSize < dataStart)
+  {
+    vtkErrorMacro("Invalid compressed data.");
+    return VTK_ERROR;
+  }
+  std::vector<vtkIdType> offsets(numTiles + 1, dataStart);
+  this->NumberOfTiles = numTiles;
+  this->NumberOfChangedTiles = 0;
+  for (int tile = 0; tile < numTiles; ++tile)
+  {
+    vtkTypeUInt32 size;
+    memcpy(&size, in + sizeof(header) + tile * sizeof(size), sizeof(size));
+    offsets[tile + 1] = offsets[tile] + size;
+    this->NumberOfChangedTiles += size > 0 ? 1 : 0;
+  }
+  if (offsets[numTiles] > inSize)
+  {
+    vtkErrorMacro("Invalid compressed data.");
+    return VTK_ERROR;
+  }
+
+  std::vector<unsigned char> status(numTiles, 1);
+  vtkDecodeTiles worker(layout, offsets, status, internals.Scratch);
+  worker.Input = reinterpret_cast<const char*>(in);
+  worker.Reference = internals.Reference.empty() ? NULL : &internals.Reference[0];
+  vtkInternals::For(this->Threaded, numTiles, worker);
+  if (std::find(status.begin(), status.end(), 0) != status.end())
+  {
+    vtkErrorMacro("Failed to decompress tiles.");
+    // the reference is now corrupt, only a key frame can recover from this.
+    internals.Width = internals.Height = internals.Components = 0;
+    return VTK_ERROR;
+  }
+  internals.FrameId = header[FRAME_ID];
+
+  if (!internals.Reference.empty())
+  {
+    memcpy(this->Output->GetPointer(0), &internals.Reference[0], internals.Reference.size());
+  }
+  return VTK_OK;
+}
+
+//----------------------------------------------------------------------------
+void vtkLZ4DeltaCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "TileSize: " << this->TileSize << endl
+     << indent << "NumberOfTiles: " << this->NumberOfTiles << endl
+     << indent << "NumberOfChangedTiles: " << this->NumberOfChangedTiles << endl;
+}
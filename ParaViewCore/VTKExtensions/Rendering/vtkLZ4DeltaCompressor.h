@@ -0,0 +1,104 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkLZ4DeltaCompressor.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkLZ4DeltaCompressor
+ * @brief   Image compressor/decompressor that sends only the tiles that
+ * changed since the previous frame.
+ *
+ * vtkLZ4DeltaCompressor splits the image into square tiles and XORs each tile
+ * against the same tile of the previous frame. Unchanged tiles are skipped,
+ * while the remaining ones are compressed with LZ4 concurrently using
+ * vtkSMPTools. The previous frame is kept by both the compressor and the
+ * decompressor, hence the same instance must be used for all frames of a
+ * given stream, and every compressed frame must be decompressed, in order.
+ *
+ * A key frame, i.e. a frame that does not depend on the previous one, is
+ * generated for the first frame, whenever the image size or number of
+ * components changes, and after ForceKeyFrame() is called.
+ *
+ * The configuration is the same as vtkLZ4Compressor.
+*/
+
+#ifndef vtkLZ4DeltaCompressor_h
+#define vtkLZ4DeltaCompressor_h
+
+#include "vtkLZ4Compressor.h"
+#include "vtkPVVTKExtensionsRenderingModule.h" // needed for exports
+
+class VTKPVVTKEXTENSIONSRENDERING_EXPORT vtkLZ4DeltaCompressor : public vtkLZ4Compressor
+{
+public:
+  static vtkLZ4DeltaCompressor* New();
+  vtkTypeMacro(vtkLZ4DeltaCompressor, vtkLZ4Compressor);
+  void PrintSelf(ostream& os, vtkIndent indent) VTK_OVERRIDE;
+
+  //@{
+  /**
+   * Set the width and height, in pixels, of the tiles the image is split
+   * into. Only used when compressing, the tile size is recorded in the
+   * compressed data. Default is 64.
+   */
+  vtkSetClampMacro(TileSize, int, 8, 1024);
+  vtkGetMacro(TileSize, int);
+  //@}
+
+  /**
+   * Set the resolution of the images to compress. Tiles are square only when
+   * the resolution matches the number of pixels in the input.
+   */
+  void SetImageResolution(int width, int height) VTK_OVERRIDE;
+
+  /**
+   * Make the next call to Compress() generate a key frame.
+   */
+  void ForceKeyFrame();
+
+  //@{
+  /**
+   * Compress/Decompress data array on the objects input with results
+   * in the objects output. See also Set/GetInput/Output.
+   */
+  int Compress() VTK_OVERRIDE;
+  int Decompress() VTK_OVERRIDE;
+  //@}
+
+  //@{
+  /**
+   * Returns the number of tiles and the number of tiles that changed in the
+   * last frame compressed or decompressed.
+   */
+  vtkGetMacro(NumberOfTiles, int);
+  vtkGetMacro(NumberOfChangedTiles, int);
+  //@}
+
+protected:
+  vtkLZ4DeltaCompressor();
+  ~vtkLZ4DeltaCompressor() override;
+
+  int TileSize;
+  int ImageWidth;
+  int ImageHeight;
+  int NumberOfTiles;
+  int NumberOfChangedTiles;
+
+private:
+  vtkLZ4DeltaCompressor(const vtkLZ4DeltaCompressor&) = delete;
+  void operator=(const vtkLZ4DeltaCompressor&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
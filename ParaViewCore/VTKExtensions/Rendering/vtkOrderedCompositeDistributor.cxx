@@ -27,8 +27,13 @@
 
 #include "vtkBSPCuts.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSetSurfaceFilter.h"
+#include "vtkFieldData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -36,13 +41,29 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPKdTree.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
+#include "vtkWeakPointer.h"
 
 #ifdef PARAVIEW_USE_MPI
+#include "vtkCharArray.h"
 #include "vtkDistributedDataFilter.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMPIController.h"
+#include "vtkTable.h"
 #endif
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
 //-----------------------------------------------------------------------------
 #ifdef PARAVIEW_USE_MPI
 static void D3UpdateProgress(vtkObject* _D3, unsigned long, void* _distributor, void*)
@@ -57,6 +78,569 @@ static void D3UpdateProgress(vtkObject* _D3, unsigned long, void* _distributor,
 #endif
 //-----------------------------------------------------------------------------
 
+namespace
+{
+// Hashes buffers 8 bytes at a time, FNV-1a style.
+class vtkGeometryHasher
+{
+public:
+  vtkGeometryHasher()
+    : Hash(14695981039346656037ULL)
+  {
+  }
+
+  void Add(vtkTypeUInt64 value) { this->Hash = (this->Hash ^ value) * 1099511628211ULL; }
+
+  void Add(const void* data, size_t length)
+  {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    size_t cc = 0;
+    for (; cc + sizeof(vtkTypeUInt64) <= length; cc += sizeof(vtkTypeUInt64))
+    {
+      vtkTypeUInt64 word;
+      memcpy(&word, bytes + cc, sizeof(vtkTypeUInt64));
+      this->Add(word);
+    }
+    for (; cc < length; ++cc)
+    {
+      this->Add(static_cast<vtkTypeUInt64>(bytes[cc]));
+    }
+  }
+
+  void Add(vtkDataArray* array)
+  {
+    if (array == NULL)
+    {
+      this->Add(VTK_TYPE_UINT64_MAX);
+      return;
+    }
+    const vtkIdType numValues = array->GetNumberOfValues();
+    this->Add(static_cast<vtkTypeUInt64>(numValues));
+    if (numValues > 0)
+    {
+      this->Add(
+        array->GetVoidPointer(0), static_cast<size_t>(numValues) * array->GetDataTypeSize());
+    }
+  }
+
+  void Add(vtkCellArray* cells) { this->Add(cells ? cells->GetData() : NULL); }
+
+  void Add(vtkDataSet* ds)
+  {
+    this->Add(static_cast<vtkTypeUInt64>(ds->GetDataObjectType()));
+    this->Add(static_cast<vtkTypeUInt64>(ds->GetNumberOfPoints()));
+    this->Add(static_cast<vtkTypeUInt64>(ds->GetNumberOfCells()));
+    if (vtkPolyData* pd = vtkPolyData::SafeDownCast(ds))
+    {
+      this->Add(pd->GetPoints() ? pd->GetPoints()->GetData() : NULL);
+      this->Add(pd->GetVerts());
+      this->Add(pd->GetLines());
+      this->Add(pd->GetPolys());
+      this->Add(pd->GetStrips());
+    }
+    else if (vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(ds))
+    {
+      this->Add(ug->GetPoints() ? ug->GetPoints()->GetData() : NULL);
+      this->Add(ug->GetCellTypesArray());
+      this->Add(ug->GetCells());
+      this->Add(ug->GetFaces());
+    }
+    else
+    {
+      // changes of the attributes can't be told apart from changes of the
+      // geometry for other types.
+      this->Add(static_cast<vtkTypeUInt64>(ds->GetMTime()));
+    }
+  }
+
+  vtkTypeUInt64 Hash;
+};
+
+#ifdef PARAVIEW_USE_MPI
+const char* const SOURCE_CELL_ARRAY_NAME = "vtkOrderedCompositeDistributorSourceCell";
+static const int PLAN_EXCHANGE_TAG = 873451;
+
+//-----------------------------------------------------------------------------
+// Sends `send[cc]` to process `cc` and fills `recv[cc]` with what process `cc`
+// sent, for all processes. Returns false on all processes, without exchanging
+// anything, if a message is too large to be sent.
+template <typename T>
+bool vtkAllToAll(vtkMPIController* controller, const std::vector<std::vector<T> >& send,
+  std::vector<std::vector<T> >& recv)
+{
+  const int numProcs = controller->GetNumberOfProcesses();
+  const int myId = controller->GetLocalProcessId();
+
+  std::vector<vtkIdType> sizes(numProcs);
+  for (int cc = 0; cc < numProcs; ++cc)
+  {
+    sizes[cc] = static_cast<vtkIdType>(send[cc].size() * sizeof(T));
+  }
+  // allSizes[i * numProcs + j] is the size of the message from i to j.
+  std::vector<vtkIdType> allSizes(numProcs * numProcs);
+  controller->AllGather(&sizes[0], &allSizes[0], numProcs);
+  if (*std::max_element(allSizes.begin(), allSizes.end()) > VTK_INT_MAX)
+  {
+    return false;
+  }
+
+  recv.assign(numProcs, std::vector<T>());
+  std::vector<vtkMPICommunicator::Request> receives(numProcs);
+  for (int cc = 0; cc < numProcs; ++cc)
+  {
+    const vtkIdType size = allSizes[cc * numProcs + myId];
+    if (cc != myId && size > 0)
+    {
+      recv[cc].resize(static_cast<size_t>(size) / sizeof(T));
+      controller->NoBlockReceive(reinterpret_cast<char*>(&recv[cc][0]), static_cast<int>(size),
+        cc, PLAN_EXCHANGE_TAG, receives[cc]);
+    }
+  }
+
+  std::vector<vtkMPICommunicator::Request> sends(numProcs);
+  for (int cc = 0; cc < numProcs; ++cc)
+  {
+    if (cc != myId && sizes[cc] > 0)
+    {
+      controller->NoBlockSend(reinterpret_cast<const char*>(&send[cc][0]),
+        static_cast<int>(sizes[cc]), cc, PLAN_EXCHANGE_TAG, sends[cc]);
+    }
+  }
+
+  recv[myId] = send[myId];
+  for (int cc = 0; cc < numProcs; ++cc)
+  {
+    if (cc != myId && allSizes[cc * numProcs + myId] > 0)
+    {
+      receives[cc].Wait();
+    }
+    if (cc != myId && sizes[cc] > 0)
+    {
+      sends[cc].Wait();
+    }
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// Merges the rows of `tables`, the rows of `tables[cc]` going to the tuples
+// listed in `destinations[cc]`. Only arrays available in all tables are kept.
+void vtkMergeRows(const std::vector<vtkSmartPointer<vtkTable> >& tables,
+  const std::vector<std::vector<vtkIdType> >& destinations, vtkIdType numTuples,
+  vtkDataSetAttributes* input, vtkDataSetAttributes* output)
+{
+  std::vector<int> sources;
+  for (size_t cc = 0; cc < tables.size(); ++cc)
+  {
+    if (tables[cc] && tables[cc]->GetNumberOfRows() > 0 &&
+      tables[cc]->GetNumberOfRows() == static_cast<vtkIdType>(destinations[cc].size()))
+    {
+      sources.push_back(static_cast<int>(cc));
+    }
+  }
+  if (sources.empty())
+  {
+    return;
+  }
+
+  vtkDataSetAttributes::FieldList fields(static_cast<int>(sources.size()));
+  fields.InitializeFieldList(tables[sources[0]]->GetRowData());
+  for (size_t cc = 1; cc < sources.size(); ++cc)
+  {
+    fields.IntersectFieldList(tables[sources[cc]]->GetRowData());
+  }
+  output->CopyAllocate(fields, numTuples);
+  for (size_t cc = 0; cc < sources.size(); ++cc)
+  {
+    vtkDataSetAttributes* rows = tables[sources[cc]]->GetRowData();
+    const std::vector<vtkIdType>& ids = destinations[sources[cc]];
+    for (size_t kk = 0; kk < ids.size(); ++kk)
+    {
+      output->CopyData(fields, rows, static_cast<int>(cc), static_cast<vtkIdType>(kk), ids[kk]);
+    }
+  }
+
+  // the attribute designations do not survive the marshaling, restore them
+  // from the input.
+  for (int attr = 0; attr < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attr)
+  {
+    vtkAbstractArray* array = input->GetAbstractAttribute(attr);
+    if (array && array->GetName() && output->GetAbstractArray(array->GetName()))
+    {
+      output->SetActiveAttribute(array->GetName(), attr);
+    }
+  }
+}
+#endif
+}
+
+//*****************************************************************************
+class vtkOrderedCompositeDistributor::vtkInternals
+{
+public:
+  // What the plan was built for.
+  bool Valid;
+  vtkTypeUInt64 GeometryHash;
+  vtkWeakPointer<vtkPKdTree> Tree;
+  vtkMTimeType TreeMTime;
+  int BoundaryMode;
+
+#ifdef PARAVIEW_USE_MPI
+  // Per destination process, the input cells to copy the cell data of and,
+  // for each point, the input points and weights to interpolate the point
+  // data with.
+  std::vector<std::vector<vtkIdType> > SendCells;
+  std::vector<std::vector<vtkIdType> > SendPointOffsets;
+  std::vector<std::vector<vtkIdType> > SendPointIds;
+  std::vector<std::vector<double> > SendPointWeights;
+
+  // Per source process, the output cells and points the data goes to.
+  std::vector<std::vector<vtkIdType> > ReceiveCells;
+  std::vector<std::vector<vtkIdType> > ReceivePoints;
+
+  // The redistributed geometry, without point and cell data.
+  vtkSmartPointer<vtkDataSet> Structure;
+#endif
+
+  vtkInternals() { this->Reset(); }
+
+  void Reset()
+  {
+    this->Valid = false;
+    this->GeometryHash = 0;
+    this->Tree = NULL;
+    this->TreeMTime = 0;
+    this->BoundaryMode = -1;
+#ifdef PARAVIEW_USE_MPI
+    this->SendCells.clear();
+    this->SendPointOffsets.clear();
+    this->SendPointIds.clear();
+    this->SendPointWeights.clear();
+    this->ReceiveCells.clear();
+    this->ReceivePoints.clear();
+    this->Structure = NULL;
+#endif
+  }
+
+#ifdef PARAVIEW_USE_MPI
+  //---------------------------------------------------------------------------
+  // Collectively decides whether the plan can be used to redistribute `input`.
+  bool CanReuse(vtkMPIController* controller, vtkTypeUInt64 hash, vtkPKdTree* tree, int mode,
+    vtkDataSet* output)
+  {
+    int reuse = (this->Valid && this->GeometryHash == hash && tree != NULL &&
+                  this->Tree.GetPointer() == tree && this->TreeMTime == tree->GetMTime() &&
+                  this->BoundaryMode == mode && this->Structure != NULL &&
+                  this->Structure->GetDataObjectType() == output->GetDataObjectType())
+      ? 1
+      : 0;
+    int allReuse = 0;
+    controller->AllReduce(&reuse, &allReuse, 1, vtkCommunicator::MIN_OP);
+    return allReuse == 1;
+  }
+
+  //---------------------------------------------------------------------------
+  // Builds the plan from the output of the redistribution, which has the
+  // process and id of the input cell each cell comes from in the
+  // SOURCE_CELL_ARRAY_NAME array. The data of each output point comes from
+  // the input cell one of the cells using it comes from: points of that cell
+  // are copied, while the points created by splitting cells are interpolated
+  // in it by the process that owns it. Returns false on all processes on
+  // failure.
+  bool BuildPlan(vtkMPIController* controller, vtkDataSet* input, vtkDataSet* output)
+  {
+    const int numProcs = controller->GetNumberOfProcesses();
+    const vtkIdType numCells = output->GetNumberOfCells();
+    const vtkIdType numPoints = output->GetNumberOfPoints();
+
+    vtkIdTypeArray* sources =
+      vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray(SOURCE_CELL_ARRAY_NAME));
+    int valid = (numCells == 0 || (sources && sources->GetNumberOfComponents() == 2)) ? 1 : 0;
+
+    this->ReceiveCells.assign(numProcs, std::vector<vtkIdType>());
+    this->ReceivePoints.assign(numProcs, std::vector<vtkIdType>());
+    std::vector<vtkIdType> pointCells(numPoints, -1);
+    vtkNew<vtkIdList> ptIds;
+    for (vtkIdType cellId = 0; valid && cellId < numCells; ++cellId)
+    {
+      const vtkIdType source = sources->GetValue(2 * cellId);
+      if (source < 0 || source >= numProcs)
+      {
+        valid = 0;
+        break;
+      }
+      this->ReceiveCells[source].push_back(cellId);
+
+      output->GetCellPoints(cellId, ptIds.GetPointer());
+      for (vtkIdType cc = 0, max = ptIds->GetNumberOfIds(); cc < max; ++cc)
+      {
+        vtkIdType& pointCell = pointCells[ptIds->GetId(cc)];
+        pointCell = pointCell == -1 ? cellId : pointCell;
+      }
+    }
+    // points not used by any cell have nowhere to get their data from.
+    if (std::find(pointCells.begin(), pointCells.end(), -1) != pointCells.end())
+    {
+      valid = 0;
+    }
+    int allValid = 0;
+    controller->AllReduce(&valid, &allValid, 1, vtkCommunicator::MIN_OP);
+    if (allValid == 0)
+    {
+      return false;
+    }
+
+    // request, from each source process,
+    // [number of cells, cell ids..., (cell id, x, y, z)...].
+    std::vector<std::vector<double> > requests(numProcs);
+    for (int cc = 0; cc < numProcs; ++cc)
+    {
+      requests[cc].push_back(static_cast<double>(this->ReceiveCells[cc].size()));
+      for (vtkIdType cellId : this->ReceiveCells[cc])
+      {
+        requests[cc].push_back(static_cast<double>(sources->GetValue(2 * cellId + 1)));
+      }
+    }
+    double x[3];
+    for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+    {
+      const vtkIdType cellId = pointCells[ptId];
+      const vtkIdType source = sources->GetValue(2 * cellId);
+      output->GetPoint(ptId, x);
+      requests[source].push_back(static_cast<double>(sources->GetValue(2 * cellId + 1)));
+      requests[source].insert(requests[source].end(), x, x + 3);
+      this->ReceivePoints[source].push_back(ptId);
+    }
+
+    std::vector<std::vector<double> > received;
+    if (!vtkAllToAll(controller, requests, received))
+    {
+      return false;
+    }
+
+    // answer the requests.
+    this->SendCells.assign(numProcs, std::vector<vtkIdType>());
+    this->SendPointOffsets.assign(numProcs, std::vector<vtkIdType>(1, 0));
+    this->SendPointIds.assign(numProcs, std::vector<vtkIdType>());
+    this->SendPointWeights.assign(numProcs, std::vector<double>());
+
+    const vtkIdType numInputCells = input->GetNumberOfCells();
+    vtkNew<vtkGenericCell> cell;
+    std::vector<double> weights;
+    for (int cc = 0; valid && cc < numProcs; ++cc)
+    {
+      const std::vector<double>& request = received[cc];
+      const size_t numRequestedCells = request.empty() ? 0 : static_cast<size_t>(request[0]);
+      if (request.empty() || request.size() < 1 + numRequestedCells ||
+        (request.size() - 1 - numRequestedCells) % 4 != 0)
+      {
+        valid = 0;
+        break;
+      }
+
+      for (size_t kk = 1; kk <= numRequestedCells; ++kk)
+      {
+        const vtkIdType cellId = static_cast<vtkIdType>(request[kk]);
+        if (cellId < 0 || cellId >= numInputCells)
+        {
+          valid = 0;
+          break;
+        }
+        this->SendCells[cc].push_back(cellId);
+      }
+
+      for (size_t kk = 1 + numRequestedCells; valid && kk < request.size(); kk += 4)
+      {
+        const vtkIdType cellId = static_cast<vtkIdType>(request[kk]);
+        if (cellId < 0 || cellId >= numInputCells)
+        {
+          valid = 0;
+          break;
+        }
+        input->GetCell(cellId, cell.GetPointer());
+        const vtkIdType numCellPoints = cell->GetNumberOfPoints();
+        if (numCellPoints == 0)
+        {
+          valid = 0;
+          break;
+        }
+
+        std::copy(&request[kk + 1], &request[kk + 1] + 3, x);
+
+        // most points are points of the input cell, kept as is.
+        vtkIdType samePoint = -1;
+        for (vtkIdType pt = 0; pt < numCellPoints && samePoint == -1; ++pt)
+        {
+          double p[3];
+          cell->GetPoints()->GetPoint(pt, p);
+          samePoint = (p[0] == x[0] && p[1] == x[1] && p[2] == x[2]) ? pt : -1;
+        }
+        if (samePoint != -1)
+        {
+          this->SendPointIds[cc].push_back(cell->GetPointId(samePoint));
+          this->SendPointWeights[cc].push_back(1.0);
+          this->SendPointOffsets[cc].push_back(
+            static_cast<vtkIdType>(this->SendPointIds[cc].size()));
+          continue;
+        }
+
+        weights.assign(static_cast<size_t>(numCellPoints), 0.0);
+        double closest[3], pcoords[3], dist2;
+        int subId;
+        const int status =
+          cell->EvaluatePosition(x, closest, subId, pcoords, dist2, &weights[0]);
+        if (status == -1 ||
+          std::count(weights.begin(), weights.end(), 0.0) ==
+            static_cast<std::ptrdiff_t>(numCellPoints))
+        {
+          // degenerate cell, use its closest point.
+          vtkIdType closestPoint = 0;
+          double minDist2 = VTK_DOUBLE_MAX;
+          for (vtkIdType pt = 0; pt < numCellPoints; ++pt)
+          {
+            double p[3];
+            cell->GetPoints()->GetPoint(pt, p);
+            const double ptDist2 = vtkMath::Distance2BetweenPoints(p, x);
+            if (ptDist2 < minDist2)
+            {
+              minDist2 = ptDist2;
+              closestPoint = pt;
+            }
+          }
+          weights.assign(static_cast<size_t>(numCellPoints), 0.0);
+          weights[closestPoint] = 1.0;
+        }
+
+        for (vtkIdType pt = 0; pt < numCellPoints; ++pt)
+        {
+          if (weights[pt] != 0.0)
+          {
+            this->SendPointIds[cc].push_back(cell->GetPointId(pt));
+            this->SendPointWeights[cc].push_back(weights[pt]);
+          }
+        }
+        this->SendPointOffsets[cc].push_back(
+          static_cast<vtkIdType>(this->SendPointIds[cc].size()));
+      }
+    }
+    controller->AllReduce(&valid, &allValid, 1, vtkCommunicator::MIN_OP);
+    if (allValid == 0)
+    {
+      return false;
+    }
+
+    this->Structure.TakeReference(output->NewInstance());
+    this->Structure->CopyStructure(output);
+    return true;
+  }
+
+  //---------------------------------------------------------------------------
+  // Moves the point and cell data of `input` along the plan.
+  void ApplyPlan(vtkMPIController* controller, vtkDataSet* input, vtkDataSet* output)
+  {
+    const int numProcs = controller->GetNumberOfProcesses();
+    const int myId = controller->GetLocalProcessId();
+    vtkPointData* inPD = input->GetPointData();
+    vtkCellData* inCD = input->GetCellData();
+
+    // messages are [size of the point table, point table, cell table].
+    std::vector<vtkSmartPointer<vtkTable> > pointTables(numProcs);
+    std::vector<vtkSmartPointer<vtkTable> > cellTables(numProcs);
+    std::vector<std::vector<char> > messages(numProcs);
+    vtkNew<vtkIdList> ids;
+    for (int cc = 0; cc < numProcs; ++cc)
+    {
+      const std::vector<vtkIdType>& cells = this->SendCells[cc];
+      const std::vector<vtkIdType>& offsets = this->SendPointOffsets[cc];
+      if (cells.empty() && offsets.size() <= 1)
+      {
+        continue;
+      }
+
+      // points kept from the input are copied, only the points created by
+      // splitting cells are interpolated.
+      pointTables[cc] = vtkSmartPointer<vtkTable>::New();
+      vtkDataSetAttributes* pointData = pointTables[cc]->GetRowData();
+      pointData->CopyAllocate(inPD, static_cast<vtkIdType>(offsets.size() - 1));
+      for (size_t kk = 0; kk + 1 < offsets.size(); ++kk)
+      {
+        const vtkIdType count = offsets[kk + 1] - offsets[kk];
+        if (count == 1 && this->SendPointWeights[cc][offsets[kk]] == 1.0)
+        {
+          pointData->CopyData(
+            inPD, this->SendPointIds[cc][offsets[kk]], static_cast<vtkIdType>(kk));
+          continue;
+        }
+        ids->SetNumberOfIds(count);
+        std::copy(&this->SendPointIds[cc][offsets[kk]],
+          &this->SendPointIds[cc][offsets[kk]] + count, ids->GetPointer(0));
+        pointData->InterpolatePoint(inPD, static_cast<vtkIdType>(kk), ids.GetPointer(),
+          &this->SendPointWeights[cc][offsets[kk]]);
+      }
+
+      cellTables[cc] = vtkSmartPointer<vtkTable>::New();
+      vtkDataSetAttributes* cellData = cellTables[cc]->GetRowData();
+      cellData->CopyAllocate(inCD, static_cast<vtkIdType>(cells.size()));
+      for (size_t kk = 0; kk < cells.size(); ++kk)
+      {
+        cellData->CopyData(inCD, cells[kk], static_cast<vtkIdType>(kk));
+      }
+
+      if (cc != myId)
+      {
+        vtkNew<vtkCharArray> pointBuffer;
+        vtkNew<vtkCharArray> cellBuffer;
+        vtkCommunicator::MarshalDataObject(pointTables[cc], pointBuffer.GetPointer());
+        vtkCommunicator::MarshalDataObject(cellTables[cc], cellBuffer.GetPointer());
+        const vtkIdType pointSize = pointBuffer->GetNumberOfTuples();
+        const vtkIdType cellSize = cellBuffer->GetNumberOfTuples();
+        std::vector<char>& message = messages[cc];
+        message.resize(sizeof(vtkIdType) + pointSize + cellSize);
+        memcpy(&message[0], &pointSize, sizeof(vtkIdType));
+        memcpy(&message[sizeof(vtkIdType)], pointBuffer->GetPointer(0), pointSize);
+        memcpy(&message[sizeof(vtkIdType) + pointSize], cellBuffer->GetPointer(0), cellSize);
+        pointTables[cc] = NULL;
+        cellTables[cc] = NULL;
+      }
+    }
+
+    std::vector<std::vector<char> > received;
+    if (!vtkAllToAll(controller, messages, received))
+    {
+      vtkGenericWarningMacro("Failed to redistribute data along the redistribution plan.");
+      received.assign(numProcs, std::vector<char>());
+    }
+    for (int cc = 0; cc < numProcs; ++cc)
+    {
+      std::vector<char>& message = received[cc];
+      if (cc == myId || message.size() < sizeof(vtkIdType))
+      {
+        continue;
+      }
+      vtkIdType pointSize;
+      memcpy(&pointSize, &message[0], sizeof(vtkIdType));
+      const vtkIdType cellSize =
+        static_cast<vtkIdType>(message.size() - sizeof(vtkIdType)) - pointSize;
+
+      vtkNew<vtkCharArray> buffer;
+      buffer->SetArray(&message[sizeof(vtkIdType)], pointSize, 1);
+      pointTables[cc] = vtkSmartPointer<vtkTable>::New();
+      vtkCommunicator::UnMarshalDataObject(buffer.GetPointer(), pointTables[cc]);
+      buffer->SetArray(&message[sizeof(vtkIdType) + pointSize], cellSize, 1);
+      cellTables[cc] = vtkSmartPointer<vtkTable>::New();
+      vtkCommunicator::UnMarshalDataObject(buffer.GetPointer(), cellTables[cc]);
+    }
+
+    output->CopyStructure(this->Structure);
+    vtkMergeRows(pointTables, this->ReceivePoints, output->GetNumberOfPoints(), inPD,
+      output->GetPointData());
+    vtkMergeRows(
+      cellTables, this->ReceiveCells, output->GetNumberOfCells(), inCD, output->GetCellData());
+    output->GetFieldData()->ShallowCopy(input->GetFieldData());
+  }
+#endif
+};
+
 vtkStandardNewMacro(vtkOrderedCompositeDistributor);
 vtkCxxSetObjectMacro(vtkOrderedCompositeDistributor, PKdTree, vtkPKdTree);
 vtkCxxSetObjectMacro(vtkOrderedCompositeDistributor, Controller, vtkMultiProcessController);
@@ -67,8 +651,11 @@ vtkOrderedCompositeDistributor::vtkOrderedCompositeDistributor()
   this->PKdTree = NULL;
   this->Controller = NULL;
   this->PassThrough = false;
+  this->ReuseRedistributionPlan = false;
+  this->InputGeometryHash = 0;
   this->OutputType = NULL;
   this->SetController(vtkMultiProcessController::GetGlobalController());
+  this->Internals = new vtkInternals();
 }
 
 //-----------------------------------------------------------------------------
@@ -77,6 +664,46 @@ vtkOrderedCompositeDistributor::~vtkOrderedCompositeDistributor()
   this->SetPKdTree(NULL);
   this->SetController(NULL);
   this->SetOutputType(NULL);
+  delete this->Internals;
+}
+
+//-----------------------------------------------------------------------------
+void vtkOrderedCompositeDistributor::ReleaseRedistributionPlan()
+{
+  this->Internals->Reset();
+}
+
+//-----------------------------------------------------------------------------
+vtkTypeUInt64 vtkOrderedCompositeDistributor::ComputeGeometryHash(vtkDataObject* dobj)
+{
+  if (dobj == NULL)
+  {
+    return 0;
+  }
+
+  vtkGeometryHasher hasher;
+  if (vtkCompositeDataSet* cd = vtkCompositeDataSet::SafeDownCast(dobj))
+  {
+    vtkCompositeDataIterator* iter = cd->NewIterator();
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      if (vtkDataSet* ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+      {
+        hasher.Add(static_cast<vtkTypeUInt64>(iter->GetCurrentFlatIndex()));
+        hasher.Add(ds);
+      }
+    }
+    iter->Delete();
+  }
+  else if (vtkDataSet* ds = vtkDataSet::SafeDownCast(dobj))
+  {
+    hasher.Add(ds);
+  }
+  else
+  {
+    hasher.Add(static_cast<vtkTypeUInt64>(dobj->GetMTime()));
+  }
+  return hasher.Hash;
 }
 
 //-----------------------------------------------------------------------------
@@ -87,6 +714,8 @@ void vtkOrderedCompositeDistributor::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PKdTree: " << this->PKdTree << endl;
   os << indent << "Controller: " << this->Controller << endl;
   os << indent << "PassThrough: " << this->PassThrough << endl;
+  os << indent << "ReuseRedistributionPlan: " << this->ReuseRedistributionPlan << endl;
+  os << indent << "InputGeometryHash: " << this->InputGeometryHash << endl;
   os << indent << "OutputType: " << (this->OutputType ? this->OutputType : "(none)") << endl;
 }
 
@@ -195,6 +824,46 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
 
   this->UpdateProgress(0.01);
 
+  // when the geometry did not change, only move the point and cell data along
+  // the plan of the previous redistribution.
+  vtkMPIController* mpiController = vtkMPIController::SafeDownCast(this->Controller);
+  const bool usePlan = this->ReuseRedistributionPlan && mpiController != NULL;
+  vtkTypeUInt64 hash = 0;
+  if (usePlan)
+  {
+    hash = this->InputGeometryHash != 0
+      ? this->InputGeometryHash
+      : vtkOrderedCompositeDistributor::ComputeGeometryHash(input);
+  }
+  if (usePlan &&
+    this->Internals->CanReuse(mpiController, hash, this->PKdTree, this->BoundaryMode, output))
+  {
+    this->Internals->ApplyPlan(mpiController, input, output);
+    return 1;
+  }
+  this->Internals->Reset();
+
+  vtkSmartPointer<vtkDataSet> d3Input = input;
+  if (usePlan)
+  {
+    // tag the cells with where they come from to build the plan from the
+    // output.
+    d3Input.TakeReference(input->NewInstance());
+    d3Input->ShallowCopy(input);
+    const vtkIdType numCells = input->GetNumberOfCells();
+    const vtkIdType myId = this->Controller->GetLocalProcessId();
+    vtkNew<vtkIdTypeArray> sources;
+    sources->SetName(SOURCE_CELL_ARRAY_NAME);
+    sources->SetNumberOfComponents(2);
+    sources->SetNumberOfTuples(numCells);
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      sources->SetValue(2 * cellId, myId);
+      sources->SetValue(2 * cellId + 1, cellId);
+    }
+    d3Input->GetCellData()->AddArray(sources.GetPointer());
+  }
+
   vtkNew<vtkDistributedDataFilter> d3;
 
   // add progress observer.
@@ -214,7 +883,7 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
       d3->SetBoundaryModeToAssignToAllIntersectingRegions();
       break;
   }
-  d3->SetInputData(input);
+  d3->SetInputData(d3Input);
   d3->SetCuts(cuts);
 
   // We need to pass the region assignments from PKdTree to D3
@@ -248,6 +917,25 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
       return 0;
     }
   }
+  // field data is not distributed, each process keeps its own.
+  output->GetFieldData()->ShallowCopy(input->GetFieldData());
+
+  if (usePlan)
+  {
+    if (this->Internals->BuildPlan(mpiController, input, output))
+    {
+      this->Internals->Valid = true;
+      this->Internals->GeometryHash = hash;
+      this->Internals->Tree = this->PKdTree;
+      this->Internals->TreeMTime = this->PKdTree->GetMTime();
+      this->Internals->BoundaryMode = this->BoundaryMode;
+    }
+    else
+    {
+      this->Internals->Reset();
+    }
+    output->GetCellData()->RemoveArray(SOURCE_CELL_ARRAY_NAME);
+  }
 #endif
 
   return 1;
@@ -36,6 +36,12 @@
  * This class also has an optional pass through mode to make it easy to
  * turn ordered compositing on and off.
  *
+ * When ReuseRedistributionPlan is on, the distributor remembers where each
+ * output point and cell came from. If the next input has the same geometry and
+ * is distributed with the same kd-tree, e.g. when only the scalars of an
+ * animated dataset change, only its point and cell data is moved along that
+ * plan instead of redistributing the whole dataset again.
+ *
 */
 
 #ifndef vtkOrderedCompositeDistributor_h
@@ -113,6 +119,42 @@ public:
   vtkGetMacro(BoundaryMode, int);
   //@}
 
+  //@{
+  /**
+   * When on, the redistribution plan computed when distributing the input is
+   * kept and reused for following inputs with the same geometry, as long as
+   * the kd-tree and boundary mode did not change. Off by default.
+   */
+  vtkSetMacro(ReuseRedistributionPlan, bool);
+  vtkGetMacro(ReuseRedistributionPlan, bool);
+  vtkBooleanMacro(ReuseRedistributionPlan, bool);
+  //@}
+
+  /**
+   * Releases the redistribution plan, if any.
+   */
+  void ReleaseRedistributionPlan();
+
+  //@{
+  /**
+   * When ReuseRedistributionPlan is on, the hash of the input geometry tells
+   * whether the plan can be reused. Callers which already computed it with
+   * ComputeGeometryHash() can provide it here to avoid hashing the input
+   * again. It must then be updated along with the input. 0, the default, means
+   * the hash is computed on each execution.
+   */
+  vtkSetMacro(InputGeometryHash, vtkTypeUInt64);
+  vtkGetMacro(InputGeometryHash, vtkTypeUInt64);
+  //@}
+
+  /**
+   * Returns a hash of the points and cells of `dobj`, ignoring its point and
+   * cell data. Leaves of composite datasets are hashed in order. Only
+   * vtkPolyData and vtkUnstructuredGrid are hashed by content, the
+   * modification time is used for other types. Returns 0 for NULL.
+   */
+  static vtkTypeUInt64 ComputeGeometryHash(vtkDataObject* dobj);
+
 protected:
   vtkOrderedCompositeDistributor();
   ~vtkOrderedCompositeDistributor() override;
@@ -120,6 +162,8 @@ protected:
   int BoundaryMode;
   char* OutputType;
   bool PassThrough;
+  bool ReuseRedistributionPlan;
+  vtkTypeUInt64 InputGeometryHash;
   vtkPKdTree* PKdTree;
   vtkMultiProcessController* Controller;
 
@@ -131,6 +175,9 @@ protected:
 private:
   vtkOrderedCompositeDistributor(const vtkOrderedCompositeDistributor&) = delete;
   void operator=(const vtkOrderedCompositeDistributor&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
 };
 
 #endif // vtkOrderedCompositeDistributor_h
@@ -55,6 +55,8 @@
 #include "vtkPolygon.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridOutlineFilter.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSelectionNode.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -84,6 +86,9 @@ vtkInformationKeyMacro(vtkPVGeometryFilter, VERTS_OFFSETS, IntegerVector);
 vtkInformationKeyMacro(vtkPVGeometryFilter, LINES_OFFSETS, IntegerVector);
 vtkInformationKeyMacro(vtkPVGeometryFilter, POLYS_OFFSETS, IntegerVector);
 vtkInformationKeyMacro(vtkPVGeometryFilter, STRIPS_OFFSETS, IntegerVector);
+
+bool vtkPVGeometryFilter::ThreadedCompositeExecution = false;
+
 class vtkPVGeometryFilter::BoundsReductionOperation : public vtkCommunicator::Operation
 {
 public:
@@ -883,6 +888,71 @@ int vtkPVGeometryFilter::RequestAMRData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// Extracts the surfaces of a range of blocks. Each thread gets its own
+// vtkPVGeometryFilter, configured like the main one, so that the internal
+// filters are never shared between threads.
+class vtkPVGeometryFilter::CompositeBlockWorker
+{
+public:
+  CompositeBlockWorker(vtkPVGeometryFilter* self, const std::vector<vtkDataObject*>& blocks,
+    const int* wholeExtent)
+    : Self(self)
+    , Blocks(blocks)
+    , WholeExtent(wholeExtent)
+  {
+    this->Outputs.resize(blocks.size());
+    this->OutlineFlags.resize(blocks.size(), -1);
+  }
+
+  void Initialize()
+  {
+    vtkPVGeometryFilter* self = this->Self;
+    vtkPVGeometryFilter* filter = this->Filters.Local();
+    filter->SetController(self->Controller);
+    filter->SetUseOutline(self->UseOutline);
+    filter->SetGenerateFeatureEdges(self->GenerateFeatureEdges);
+    filter->SetBlockColorsDistinctValues(self->BlockColorsDistinctValues);
+    filter->SetForceUseStrips(self->ForceUseStrips);
+    filter->SetUseStrips(self->UseStrips);
+    filter->SetGenerateCellNormals(self->GenerateCellNormals);
+    filter->SetTriangulate(self->Triangulate);
+    filter->SetNonlinearSubdivisionLevel(self->NonlinearSubdivisionLevel);
+    filter->SetPassThroughCellIds(self->PassThroughCellIds);
+    filter->SetPassThroughPointIds(self->PassThroughPointIds);
+    filter->SetGenerateProcessIds(self->GenerateProcessIds);
+    filter->SetHideInternalAMRFaces(self->HideInternalAMRFaces);
+    filter->SetUseNonOverlappingAMRMetaDataForOutlines(
+      self->UseNonOverlappingAMRMetaDataForOutlines);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkPVGeometryFilter* filter = this->Filters.Local();
+    for (vtkIdType cc = begin; cc < end && !this->Self->AbortExecute; ++cc)
+    {
+      vtkSmartPointer<vtkPolyData> tmpOut = vtkSmartPointer<vtkPolyData>::New();
+      // not all code paths set the outline flag, -1 marks it as untouched.
+      filter->OutlineFlag = -1;
+      filter->ExecuteBlock(this->Blocks[cc], tmpOut, 0, 0, 1, 0, this->WholeExtent);
+      filter->CleanupOutputData(tmpOut, 0);
+      this->Outputs[cc] = tmpOut;
+      this->OutlineFlags[cc] = filter->OutlineFlag;
+    }
+  }
+
+  void Reduce() {}
+
+  std::vector<vtkSmartPointer<vtkPolyData> > Outputs;
+  std::vector<int> OutlineFlags;
+
+private:
+  vtkPVGeometryFilter* Self;
+  const std::vector<vtkDataObject*>& Blocks;
+  const int* WholeExtent;
+  vtkSMPThreadLocalObject<vtkPVGeometryFilter> Filters;
+};
+
 //----------------------------------------------------------------------------
 int vtkPVGeometryFilter::RequestCompositeData(
   vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -929,6 +999,53 @@ int vtkPVGeometryFilter::RequestCompositeData(
   unsigned int block_id = 0;
   iter->SkipEmptyNodesOff(); // since we want to a get an accurate block-id count to
                              // set vtkBlockColors correctly.
+
+  // In threaded mode, the surfaces of all blocks are extracted up front and
+  // then assigned to the output in the same order as the serial code path.
+  // Blocks appearing more than once in the input are not processed
+  // concurrently, since their lazily computed state (bounds, links, etc.)
+  // would be updated from several threads.
+  std::vector<vtkDataObject*> blocks;
+  std::vector<vtkSmartPointer<vtkPolyData> > blockOutputs;
+  if (vtkPVGeometryFilter::ThreadedCompositeExecution && totNumBlocks > 1)
+  {
+    blocks.reserve(totNumBlocks);
+    std::set<vtkDataObject*> uniqueBlocks;
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      if (vtkDataObject* block = iter->GetCurrentDataObject())
+      {
+        blocks.push_back(block);
+        uniqueBlocks.insert(block);
+      }
+    }
+    if (uniqueBlocks.size() != blocks.size())
+    {
+      blocks.clear();
+    }
+  }
+  if (!blocks.empty())
+  {
+    vtkTimerLog::MarkStartEvent("vtkPVGeometryFilter::ExecuteBlocksConcurrently");
+    // vtkTimerLog is not thread safe, suspend logging from the internal filters.
+    int logging = vtkTimerLog::GetLogging();
+    vtkTimerLog::LoggingOff();
+    CompositeBlockWorker worker(this, blocks, wholeExtent);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()), worker);
+    vtkTimerLog::SetLogging(logging);
+    vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::ExecuteBlocksConcurrently");
+
+    blockOutputs.swap(worker.Outputs);
+    for (size_t cc = 0; cc < worker.OutlineFlags.size(); ++cc)
+    {
+      if (worker.OutlineFlags[cc] != -1)
+      {
+        this->OutlineFlag = worker.OutlineFlags[cc];
+      }
+    }
+  }
+
+  size_t blockIndex = 0;
   for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++block_id)
   {
     vtkDataObject* block = iter->GetCurrentDataObject();
@@ -937,9 +1054,23 @@ int vtkPVGeometryFilter::RequestCompositeData(
       continue;
     }
 
-    vtkPolyData* tmpOut = vtkPolyData::New();
-    this->ExecuteBlock(block, tmpOut, 0, 0, 1, 0, wholeExtent);
-    this->CleanupOutputData(tmpOut, 0);
+    vtkPolyData* tmpOut;
+    if (!blockOutputs.empty())
+    {
+      tmpOut = blockOutputs[blockIndex++];
+      if (!tmpOut)
+      {
+        // execution was aborted before reaching this block.
+        continue;
+      }
+      tmpOut->Register(NULL);
+    }
+    else
+    {
+      tmpOut = vtkPolyData::New();
+      this->ExecuteBlock(block, tmpOut, 0, 0, 1, 0, wholeExtent);
+      this->CleanupOutputData(tmpOut, 0);
+    }
     // skip empty nodes.
     if (tmpOut->GetNumberOfPoints() > 0)
     {
@@ -1697,6 +1828,8 @@ void vtkPVGeometryFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "PassThroughCellIds: " << (this->PassThroughCellIds ? "On\n" : "Off\n");
   os << indent << "PassThroughPointIds: " << (this->PassThroughPointIds ? "On\n" : "Off\n");
+  os << indent << "ThreadedCompositeExecution: "
+     << (vtkPVGeometryFilter::ThreadedCompositeExecution ? "On\n" : "Off\n");
 }
 
 //----------------------------------------------------------------------------
@@ -206,6 +206,23 @@ public:
   vtkBooleanMacro(UseNonOverlappingAMRMetaDataForOutlines, bool);
   //@}
 
+  //@{
+  /**
+   * When set, the surfaces of the blocks of a (non-AMR) composite dataset are
+   * extracted concurrently using vtkSMPTools, each thread using its own copy
+   * of this filter, and then assembled in block order. The output is identical
+   * to the one produced serially. This is a global setting, off by default.
+   */
+  static void SetThreadedCompositeExecution(bool val)
+  {
+    vtkPVGeometryFilter::ThreadedCompositeExecution = val;
+  }
+  static bool GetThreadedCompositeExecution()
+  {
+    return vtkPVGeometryFilter::ThreadedCompositeExecution;
+  }
+  //@}
+
   // These keys are put in the output composite-data metadata for multipieces
   // since this filter merges multipieces together.
   static vtkInformationIntegerVectorKey* POINT_OFFSETS();
@@ -346,6 +363,9 @@ private:
   void AddHierarchicalIndex(vtkPolyData* pd, unsigned int level, unsigned int index);
   class BoundsReductionOperation;
   //@}
+
+  class CompositeBlockWorker;
+  static bool ThreadedCompositeExecution;
 };
 
 #endif
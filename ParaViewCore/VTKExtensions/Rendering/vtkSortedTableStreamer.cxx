@@ -28,6 +28,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkSelection.h"
 #include "vtkSelectionNode.h"
 #include "vtkSignedCharArray.h"
@@ -430,6 +431,36 @@ public:
       return *this; // Return ref for multiple assignment
     }
   };
+  // Sample of the sorted array of a process used to split the global order,
+  // i.e. by value, then process id and finally position in the sorted array.
+  // The value keeps the type of the array, as 64-bit integers above 2^53
+  // would not be ordered correctly once converted to double.
+  class Splitter
+  {
+  public:
+    T Value;
+    int ProcessId;
+    vtkIdType Position;
+
+    bool operator<(const Splitter& other) const
+    {
+      return other.IsAfter(this->Value, this->ProcessId, this->Position);
+    }
+
+    // Return true if the given item is before this splitter in the global order
+    bool IsAfter(T value, int processId, vtkIdType position) const
+    {
+      if (value != this->Value)
+      {
+        return value < this->Value;
+      }
+      if (processId != this->ProcessId)
+      {
+        return processId < this->ProcessId;
+      }
+      return position < this->Position;
+    }
+  };
   class ArraySorter
   {
   public:
@@ -497,25 +528,8 @@ public:
       for (vtkIdType i = 0; i < this->ArraySize; ++i)
       {
         this->Array[i].OriginalIndex = i;
-        double value = 0;
-        double tmp;
-        if (selectedComponent < 0)
-        {
-          // Compute magnitude
-          for (int k = 0; k < numComponents; k++)
-          {
-            tmp = static_cast<double>(dataPtr[k + i * numComponents]);
-            value += tmp * tmp;
-          }
-          value = sqrt(value) / sqrt(static_cast<double>(numComponents));
-          this->Array[i].Value = static_cast<T>(value);
-        }
-        else
-        {
-          this->Array[i].Value = dataPtr[selectedComponent + i * numComponents];
-          value = static_cast<double>(this->Array[i].Value);
-        }
-        this->Histo->AddValue(value);
+        this->Array[i].Value = GetValue(dataPtr, i, numComponents, selectedComponent);
+        this->Histo->AddValue(static_cast<double>(this->Array[i].Value));
       }
 
       // Sort it
@@ -529,6 +543,45 @@ public:
       }
     }
 
+    // Sort the values in ascending order without building any histogram.
+    // This is used to build the sorted index of the local table.
+    void Sort(T* dataPtr, vtkIdType numTuples, int numComponents, int selectedComponent)
+    {
+      // Clear memory if needed
+      this->Clear();
+
+      if (numComponents == 1 && selectedComponent < 0)
+      {
+        selectedComponent = 0; // We can not compute magnitude on scalar value
+      }
+
+      this->ArraySize = numTuples;
+      this->Array = new SortableArrayItem[this->ArraySize];
+      for (vtkIdType i = 0; i < this->ArraySize; ++i)
+      {
+        this->Array[i].OriginalIndex = i;
+        this->Array[i].Value = GetValue(dataPtr, i, numComponents, selectedComponent);
+      }
+      vtkSMPTools::Sort(
+        this->Array, this->Array + this->ArraySize, SortableArrayItem::Descendent);
+    }
+
+    static T GetValue(T* dataPtr, vtkIdType i, int numComponents, int selectedComponent)
+    {
+      if (selectedComponent < 0)
+      {
+        // Compute magnitude
+        double value = 0;
+        for (int k = 0; k < numComponents; k++)
+        {
+          double tmp = static_cast<double>(dataPtr[k + i * numComponents]);
+          value += tmp * tmp;
+        }
+        return static_cast<T>(sqrt(value) / sqrt(static_cast<double>(numComponents)));
+      }
+      return dataPtr[selectedComponent + i * numComponents];
+    }
+
     void SortProcessId(vtkIdType* dataPtr, vtkIdType numTuples, vtkIdType histogramSize,
       double* scalarRange, bool reverseOrder)
     {
@@ -568,7 +621,6 @@ public:
   {
     // Only used for testing
     this->LocalSorter = 0;
-    this->GlobalHistogram = 0;
     this->Debug = false;
   }
 
@@ -577,6 +629,8 @@ public:
     // Default values
     this->SelectedComponent = 0;
     this->NeedToBuildCache = true;
+    this->CacheIsSorted = false;
+    this->GlobalSize = 0;
     this->DataToSort = dataToSort;
 
     this->InputMTime = input->GetMTime();
@@ -593,15 +647,12 @@ public:
 
     // Create internal objects
     this->LocalSorter = new ArraySorter();
-    this->GlobalHistogram = new Histogram(HISTOGRAM_SIZE);
   }
 
   ~Internals() override
   {
     if (this->LocalSorter)
       delete this->LocalSorter;
-    if (this->GlobalHistogram)
-      delete this->GlobalHistogram;
   }
 
   // --------------------------------------------------------------------------
@@ -668,63 +719,166 @@ public:
   }
 
   // --------------------------------------------------------------------------
-  int BuildCache(bool sortableArray, bool invertOrder)
+  // Keep the local order, used when sorting on the process ids or when all the
+  // values are equal.
+  int BuildCache()
   {
     // We are building the cache so no need to build it next time
     this->NeedToBuildCache = false;
+    this->CacheIsSorted = false;
+    if (this->DataToSort)
+    {
+      this->LocalSorter->FillArray(this->DataToSort->GetNumberOfTuples());
+    }
+    return 1;
+  }
 
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
+  // --------------------------------------------------------------------------
+  // Build the distributed sorted index: the local table is sorted, then
+  // regular samples of every process are gathered and sorted to be used as
+  // splitters of the global order, i.e. by value, then process id and finally
+  // local position. The global position of each splitter is the sum of its
+  // local positions on every process. A block can then be located using only
+  // these positions, see FindLocalRange(). This is done once per array,
+  // component and input, the inverted order being the exact reverse.
+  int BuildSortedIndex(vtkIdType blockSize)
+  {
+    this->NeedToBuildCache = false;
+    this->CacheIsSorted = true;
+    this->LocalSplitterOffsets.clear();
+    this->GlobalSplitterOffsets.clear();
 
-    // Is there something to sort ???
-    if (!sortableArray)
+    vtkIdType localSize = 0;
+    if (this->DataToSort)
     {
-      // Keep the same order as the local one because all the values are equals
-      if (this->DataToSort)
-      {
-        this->LocalSorter->FillArray(this->DataToSort->GetNumberOfTuples());
-      }
+      localSize = this->DataToSort->GetNumberOfTuples();
+      this->LocalSorter->Sort(static_cast<T*>(this->DataToSort->GetVoidPointer(0)), localSize,
+        this->DataToSort->GetNumberOfComponents(), this->SelectedComponent);
     }
     else
     {
-      if (this->DataToSort)
-      {
-        // Sort and build local histogram
-        this->LocalSorter->Update(static_cast<T*>(this->DataToSort->GetVoidPointer(0)),
-          this->DataToSort->GetNumberOfTuples(), this->DataToSort->GetNumberOfComponents(),
-          this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, invertOrder);
-      }
-      else
-      {
-        // Build empty local histogram
-        this->LocalSorter->Clear();
-        this->LocalSorter->Histo = new Histogram(HISTOGRAM_SIZE);
-        this->LocalSorter->Histo->SetScalarRange(this->CommonRange);
-        this->LocalSorter->Histo->Inverted = invertOrder;
-      }
-
-      // Initialize the global histogram with same range
-      this->LocalSorter->Histo->CopyRangeTo(*this->GlobalHistogram);
-
-      // Make sure that the global histogram is properly initialized
-      this->GlobalHistogram->ClearHistogramValues();
-      this->GlobalHistogram->Inverted = invertOrder;
-
-      // Send local histogram and receive every histogram from everybody
-      this->MPI->AllGather(this->LocalSorter->Histo->Values, bufferHistogramValues, HISTOGRAM_SIZE);
+      this->LocalSorter->Clear();
+      this->LocalSorter->ArraySize = 0;
+    }
 
-      // Merge all histogram into the GlobalHistogram
-      for (int idx = 0, nb = this->NumProcs * HISTOGRAM_SIZE; idx < nb; ++idx)
-      {
-        this->GlobalHistogram->TotalValues += bufferHistogramValues[idx];
-        this->GlobalHistogram->Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
+    if (this->NumProcs == 1)
+    {
+      // The local positions are the global ones.
+      this->GlobalSize = localSize;
+      return 1;
+    }
+    this->MPI->AllReduce(&localSize, &this->GlobalSize, 1, vtkCommunicator::SUM_OP);
+
+    // Take about one sample per block, so that a block spans few buckets.
+    vtkIdType numSamples = localSize / (blockSize > 0 ? blockSize : 1);
+    numSamples = vtkMath::Max(numSamples, static_cast<vtkIdType>(1));
+    numSamples = vtkMath::Min(numSamples, static_cast<vtkIdType>(MAX_SAMPLES / this->NumProcs));
+    numSamples = vtkMath::Min(numSamples, localSize);
+
+    // The values are exchanged as raw bytes to keep them in the type of the
+    // array, the process ids and positions as vtkIdType.
+    std::vector<T> localValues(numSamples + 1);
+    std::vector<vtkIdType> localIds(2 * numSamples + 1);
+    for (vtkIdType k = 0; k < numSamples; ++k)
+    {
+      vtkIdType position = (k * localSize) / numSamples;
+      localValues[k] = this->LocalSorter->Array[position].Value;
+      localIds[2 * k] = this->Me;
+      localIds[2 * k + 1] = position;
+    }
+
+    std::vector<vtkIdType> numbersOfSamples(this->NumProcs);
+    this->MPI->AllGather(&numSamples, &numbersOfSamples[0], 1);
+    std::vector<vtkIdType> valueLengths(this->NumProcs);
+    std::vector<vtkIdType> valueOffsets(this->NumProcs);
+    std::vector<vtkIdType> idLengths(this->NumProcs);
+    std::vector<vtkIdType> idOffsets(this->NumProcs);
+    vtkIdType totalSamples = 0;
+    for (int i = 0; i < this->NumProcs; i++)
+    {
+      valueOffsets[i] = totalSamples * static_cast<vtkIdType>(sizeof(T));
+      valueLengths[i] = numbersOfSamples[i] * static_cast<vtkIdType>(sizeof(T));
+      idOffsets[i] = 2 * totalSamples;
+      idLengths[i] = 2 * numbersOfSamples[i];
+      totalSamples += numbersOfSamples[i];
+    }
+    if (totalSamples == 0)
+    {
+      return 1;
+    }
+    std::vector<T> allValues(totalSamples);
+    std::vector<vtkIdType> allIds(2 * totalSamples);
+    this->MPI->AllGatherV(reinterpret_cast<char*>(&localValues[0]),
+      reinterpret_cast<char*>(&allValues[0]), valueLengths[this->Me], &valueLengths[0],
+      &valueOffsets[0]);
+    this->MPI->AllGatherV(
+      &localIds[0], &allIds[0], idLengths[this->Me], &idLengths[0], &idOffsets[0]);
+
+    std::vector<Splitter> splitters(totalSamples);
+    for (size_t k = 0; k < splitters.size(); ++k)
+    {
+      splitters[k].Value = allValues[k];
+      splitters[k].ProcessId = static_cast<int>(allIds[2 * k]);
+      splitters[k].Position = allIds[2 * k + 1];
+    }
+    std::sort(splitters.begin(), splitters.end());
+
+    // Locate the splitters in the local sorted array
+    this->LocalSplitterOffsets.resize(splitters.size());
+    this->GlobalSplitterOffsets.resize(splitters.size());
+    for (size_t k = 0; k < splitters.size(); ++k)
+    {
+      vtkIdType lower = 0;
+      vtkIdType upper = localSize;
+      while (lower < upper)
+      {
+        vtkIdType middle = lower + (upper - lower) / 2;
+        if (splitters[k].IsAfter(this->LocalSorter->Array[middle].Value, this->Me, middle))
+        {
+          lower = middle + 1;
+        }
+        else
+        {
+          upper = middle;
+        }
       }
+      this->LocalSplitterOffsets[k] = lower;
     }
-
-    delete[] bufferHistogramValues;
+    this->MPI->AllReduce(&this->LocalSplitterOffsets[0], &this->GlobalSplitterOffsets[0],
+      static_cast<vtkIdType>(splitters.size()), vtkCommunicator::SUM_OP);
     return 1;
   }
 
+  // --------------------------------------------------------------------------
+  // Find the local range of the sorted array covering the global range
+  // [first, last) of the ascending order, using the splitters positions. The
+  // local ranges of all processes hold the same global range starting at
+  // globalFirst <= first.
+  void FindLocalRange(vtkIdType first, vtkIdType last, vtkIdType& localFirst,
+    vtkIdType& localLast, vtkIdType& globalFirst)
+  {
+    if (this->NumProcs == 1)
+    {
+      localFirst = globalFirst = first;
+      localLast = last;
+      return;
+    }
+
+    const std::vector<vtkIdType>& global = this->GlobalSplitterOffsets;
+    // last splitter at or before first, and first splitter at or after last.
+    vtkIdType lowerIdx = static_cast<vtkIdType>(
+      std::upper_bound(global.begin(), global.end(), first) - global.begin());
+    --lowerIdx;
+    vtkIdType upperIdx = static_cast<vtkIdType>(
+      std::lower_bound(global.begin(), global.end(), last) - global.begin());
+
+    localFirst = (lowerIdx < 0) ? 0 : this->LocalSplitterOffsets[lowerIdx];
+    globalFirst = (lowerIdx < 0) ? 0 : global[lowerIdx];
+    localLast = (upperIdx >= static_cast<vtkIdType>(global.size()))
+      ? this->LocalSorter->ArraySize
+      : this->LocalSplitterOffsets[upperIdx];
+  }
+
   // --------------------------------------------------------------------------
   // The sorting is based on processId and the current order
   int Extract(vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize,
@@ -735,9 +889,9 @@ public:
     //    This will sort the local array, that's why we don't want to do it
     //    at each execution. Specially when we only change the requested block.
     // ------------------------------------------------------------------------
-    if (this->NeedToBuildCache)
+    if (this->NeedToBuildCache || this->CacheIsSorted)
     {
-      this->BuildCache(false, revertOrder);
+      this->BuildCache();
     }
 
     // Build empty local table with empty arrays so they stay in the same order
@@ -864,195 +1018,136 @@ public:
     bool revertOrder) override
   {
     // ------------------------------------------------------------------------
-    // Make sure that the Cache is built
+    // Make sure that the sorted index is built
     //    This will sort the local array, that's why we don't want to do it
     //    at each execution. Specially when we only change the requested block.
     // ------------------------------------------------------------------------
-    if (this->NeedToBuildCache)
+    if (this->NeedToBuildCache || !this->CacheIsSorted)
     {
-      this->BuildCache(true, revertOrder);
+      this->BuildSortedIndex(blockSize);
     }
 
     // ------------------------------------------------------------------------
-    // Search for lower bound
+    // Requested range in the ascending order
     // ------------------------------------------------------------------------
-    vtkIdType nbElementsToRemoveFromHead = 0;
-    vtkIdType localOffset = 0;
-    vtkIdType nbElementsInBar = 0;
-    this->SearchGlobalIndexLocation((block * blockSize), this->LocalSorter->Histo,
-      this->GlobalHistogram, nbElementsToRemoveFromHead, localOffset, nbElementsInBar);
-
-    // ------------------------------------------------------------------------
-    // Search for upper bound
-    // ------------------------------------------------------------------------
-    vtkIdType upperOffset = 0;
-    vtkIdType globalUpperOffset = 0;
-    vtkIdType searchIdx = (this->GlobalHistogram->TotalValues < (block + 1) * blockSize)
-      ? this->GlobalHistogram->TotalValues
-      : ((block + 1) * blockSize);
-    searchIdx--; // It is not a size it is an index (so -1)
-
-    this->SearchGlobalIndexLocation(searchIdx, this->LocalSorter->Histo, this->GlobalHistogram,
-      globalUpperOffset, upperOffset, nbElementsInBar);
+    vtkIdType last = vtkMath::Min((block + 1) * blockSize, this->GlobalSize);
+    vtkIdType first = vtkMath::Min(block * blockSize, last);
+    if (revertOrder)
+    {
+      vtkIdType reversedFirst = this->GlobalSize - last;
+      last = this->GlobalSize - first;
+      first = reversedFirst;
+    }
 
-    // We have to include our searched index (so +1)
-    vtkIdType localSize = (upperOffset + nbElementsInBar) - localOffset + 1;
+    vtkIdType localOffset = 0;
+    vtkIdType localEnd = 0;
+    vtkIdType globalOffset = 0;
+    this->FindLocalRange(first, last, localOffset, localEnd, globalOffset);
+    vtkIdType nbElementsToRemoveFromHead = first - globalOffset;
 
     // ------------------------------------------------------------------------
     // Build local subset table
     // ------------------------------------------------------------------------
     vtkSmartPointer<vtkTable> localSubset;
     localSubset.TakeReference(
-      this->NewSubsetTable(input, this->LocalSorter, localOffset, localSize));
-
-    // ------------------------------------------------------------------------
-    // Find the process that will merge all subset table
-    // ------------------------------------------------------------------------
-    int mergePid = GetMergingProcessId(localSubset.GetPointer());
-
-    // ------------------------------------------------------------------------
-    // Add local meta-data in case of merge process
-    // ------------------------------------------------------------------------
-    if (this->NumProcs > 1 && this->Me == mergePid)
+      this->NewSubsetTable(input, this->LocalSorter, localOffset, localEnd - localOffset));
+    if (this->NumProcs > 1)
     {
       vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
       processIdArray->SetName("vtkOriginalProcessIds");
       processIdArray->SetNumberOfComponents(1);
-      processIdArray->Allocate((blockSize < localSize) ? localSize : blockSize);
-      for (vtkIdType idx = 0; idx < localSubset->GetNumberOfRows(); idx++)
-      {
-        processIdArray->InsertNextTuple1(mergePid);
-      }
+      processIdArray->SetNumberOfTuples(localSubset->GetNumberOfRows());
+      processIdArray->FillComponent(0, this->Me);
       localSubset->GetRowData()->AddArray(processIdArray);
     }
 
+    // ------------------------------------------------------------------------
+    // Find the process that will merge all subset table
+    // ------------------------------------------------------------------------
+    int mergePid = GetMergingProcessId(localSubset.GetPointer());
+
     // ------------------------------------------------------------------------
     // Send local subset array to process mergePid
     // ------------------------------------------------------------------------
     if (this->Me != mergePid)
     {
       this->MPI->Send(localSubset.GetPointer(), mergePid, VTK_TABLE_EXCHANGE_TAG);
+
+      // Ask other processes to provide metadata for table decoration
+      this->DecorateTable(input, NULL, mergePid);
+      return 1;
     }
 
     // ------------------------------------------------------------------------
-    // Merging procedure only on process mergePid
+    // Merging procedure only on process mergePid, subsets are merged in
+    // process order so that equal values are ordered by process id and then
+    // local position.
     // ------------------------------------------------------------------------
-    if (this->Me == mergePid)
+    vtkSmartPointer<vtkTable> mergedSubset = localSubset;
+    if (this->NumProcs > 1)
     {
-      vtkSmartPointer<vtkTable> tmp = vtkSmartPointer<vtkTable>::New();
+      std::vector<vtkSmartPointer<vtkTable> > subsets(this->NumProcs);
       for (int i = 0; i < this->NumProcs; i++)
       {
         if (i == mergePid)
+        {
+          subsets[i] = localSubset;
           continue;
-
-        this->MPI->Receive(tmp.GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
-        this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), blockSize);
+        }
+        subsets[i] = vtkSmartPointer<vtkTable>::New();
+        this->MPI->Receive(subsets[i].GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
       }
-
-      // Sort new table/array
-      if (!this->DataToSort)
+      mergedSubset = vtkSmartPointer<vtkTable>::New();
+      vtkIdType mergedSize = 0;
+      for (int i = 0; i < this->NumProcs; i++)
       {
-        // This mean that no output can be provided
-        // cout << "ERROR the merge process have no DataArray." << endl;
-        return 1;
+        mergedSize += subsets[i]->GetNumberOfRows();
       }
-      vtkDataArray* subsetArray =
-        vtkDataArray::SafeDownCast(localSubset->GetColumnByName(this->DataToSort->GetName()));
-
-      if (!subsetArray)
+      for (int i = 0; i < this->NumProcs; i++)
       {
-        vtkSortedTableStreamer::PrintInfo(localSubset.GetPointer());
+        this->MergeTable(-1, subsets[i].GetPointer(), mergedSubset.GetPointer(), mergedSize);
       }
-
-      ArraySorter sorter;
-      sorter.Update(static_cast<T*>(subsetArray->GetVoidPointer(0)),
-        subsetArray->GetNumberOfTuples(), subsetArray->GetNumberOfComponents(),
-        this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, revertOrder);
-
-      // trim it (remove head and tail that don't belong to the result)
-      localSubset.TakeReference(this->NewSubsetTable(
-        localSubset.GetPointer(), &sorter, nbElementsToRemoveFromHead, blockSize));
-
-      // Add extra information such as structured indices, block number...
-      this->DecorateTable(input, localSubset.GetPointer(), mergePid);
-
-      // ShallowCopy it to the output
-      output->ShallowCopy(localSubset.GetPointer());
     }
-    else
+
+    // Sort new table/array
+    if (!this->DataToSort)
     {
-      // Ask other processes to provide metadata for table decoration
+      // This mean that no output can be provided
       this->DecorateTable(input, NULL, mergePid);
+      return 1;
     }
+    vtkDataArray* subsetArray =
+      vtkDataArray::SafeDownCast(mergedSubset->GetColumnByName(this->DataToSort->GetName()));
 
-    return 1;
-  }
-
-  // --------------------------------------------------------------------------
-  // nbGlobalToSkip is the number of elements that should be skipped at the end
-  // if you exactly want to reach the searchedGlobalIndex.
-  // localOffset is the corresponding local index in the sorted table to the
-  // global index of (searchedGlobalIndex - nbGlobalToSkip)
-  // nbInLocalBar is the local number of elements that are available
-  // in the histogram bar where the searchedGlobalIndex has been found.
-  // nbInLocalBar is used when you want to get an upper bound that
-  // will include the searchedGlobalIndex.
-  void SearchGlobalIndexLocation(vtkIdType searchedGlobalIndex, Histogram* localHistogram,
-    Histogram* globalHistogram, vtkIdType& nbGlobalToSkip, vtkIdType& localOffset,
-    vtkIdType& nbInLocalBar)
-  {
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
-
-    // Local internal working var
-    vtkIdType histogramBarIdx = -1;
-    double currentRange[2];
-    vtkIdType idx, idxEnd;
-
-    // Setup initial histogram range and values
-    Histogram _globalHistogram;
-    Histogram _localHistogram;
-    localHistogram->CopyTo(_localHistogram);
-    globalHistogram->CopyTo(_globalHistogram);
-
-    // Reset local offsets
-    localOffset = 0;
-    nbGlobalToSkip = searchedGlobalIndex;
-
-    do
+    if (!subsetArray)
     {
-      nbGlobalToSkip -= _globalHistogram.GetNewRange(nbGlobalToSkip, histogramBarIdx, currentRange);
-
-      localOffset += _localHistogram.GetNumberOfElements(0, histogramBarIdx);
-      nbInLocalBar = _localHistogram.GetNumberOfElements(histogramBarIdx, histogramBarIdx + 1);
-
-      // Based on a narrowed range, build local histogram to get closer to the
-      // real index of the object
-      _localHistogram.SetScalarRange(currentRange);
-      _localHistogram.ClearHistogramValues();
+      vtkSortedTableStreamer::PrintInfo(mergedSubset.GetPointer());
+      this->DecorateTable(input, NULL, mergePid);
+      return 1;
+    }
 
-      idxEnd = localOffset + nbInLocalBar;
-      for (idx = localOffset; idx < idxEnd; ++idx)
-      {
-        _localHistogram.AddValue(this->LocalSorter->Array[idx].Value);
-      }
+    ArraySorter sorter;
+    sorter.Update(static_cast<T*>(subsetArray->GetVoidPointer(0)),
+      subsetArray->GetNumberOfTuples(), subsetArray->GetNumberOfComponents(),
+      this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, false);
 
-      // Exchange local histo with everyone
-      this->MPI->AllGather(_localHistogram.Values, bufferHistogramValues, HISTOGRAM_SIZE);
+    // trim it (remove head and tail that don't belong to the result)
+    vtkIdType blockEnd =
+      vtkMath::Min(nbElementsToRemoveFromHead + (last - first), sorter.ArraySize);
+    if (revertOrder && nbElementsToRemoveFromHead < blockEnd)
+    {
+      std::reverse(sorter.Array + nbElementsToRemoveFromHead, sorter.Array + blockEnd);
+    }
+    mergedSubset.TakeReference(this->NewSubsetTable(mergedSubset.GetPointer(), &sorter,
+      nbElementsToRemoveFromHead, blockEnd - nbElementsToRemoveFromHead));
 
-      // Build global histogram
-      _globalHistogram.SetScalarRange(currentRange);
-      _globalHistogram.ClearHistogramValues();
+    // Add extra information such as structured indices, block number...
+    this->DecorateTable(input, mergedSubset.GetPointer(), mergePid);
 
-      idxEnd = this->NumProcs * HISTOGRAM_SIZE;
-      for (idx = 0; idx < idxEnd; ++idx)
-      {
-        _globalHistogram.TotalValues += bufferHistogramValues[idx];
-        _globalHistogram.Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
-      }
-    } while (nbGlobalToSkip > 0 && _globalHistogram.CanBeReduced());
+    // ShallowCopy it to the output
+    output->ShallowCopy(mergedSubset.GetPointer());
 
-    delete[] bufferHistogramValues;
+    return 1;
   }
 
   // --------------------------------------------------------------------------
@@ -1321,15 +1416,20 @@ private:
   vtkMTimeType DataMTime;     // Keep the original data MTime
   vtkDataArray* DataToSort;   // DataArray to sort
   ArraySorter* LocalSorter;   // Local ArraySorter based on global range
-  Histogram* GlobalHistogram; // Globaly merged Histogram based on global range
   double CommonRange[2];      // Scalar range used across processes
   int Me;                     // Current process ID
   int NumProcs;               // Number of processes involved
   vtkCommunicator* MPI;       // MPI communicator to send/receive/gather
   int SelectedComponent;      // Component used to sort array
   bool NeedToBuildCache;
+  bool CacheIsSorted; // Whether the cache is the sorted index or the local order
   bool Debug;
 
+  // Distributed sorted index, see BuildSortedIndex()
+  vtkIdType GlobalSize;
+  std::vector<vtkIdType> LocalSplitterOffsets;
+  std::vector<vtkIdType> GlobalSplitterOffsets;
+
   const static int VTK_TABLE_EXCHANGE_TAG = 50;
   // HISTOGRAM_SIZE could be computed dynamically based on the type of the
   // array to sort but to make sure that unsigned char won't be distributed
@@ -1338,6 +1438,9 @@ private:
   // Maybe make some test on huge cluster to see which histogram size is
   // the best.
   const static int HISTOGRAM_SIZE = 256;
+  // Maximum number of samples gathered from all processes to build the
+  // splitters of the distributed sorted index.
+  const static int MAX_SAMPLES = 1 << 20;
 };
 //****************************************************************************
 vtkStandardNewMacro(vtkSortedTableStreamer);
@@ -1354,6 +1457,8 @@ vtkSortedTableStreamer::vtkSortedTableStreamer()
   this->BlockSize = 1024;
   this->Internal = 0;
   this->SelectedComponent = 0;
+  this->MergedInput = 0;
+  this->MergedInputMTime = 0;
   this->SetController(vtkMultiProcessController::GetGlobalController());
 }
 
@@ -1362,6 +1467,11 @@ vtkSortedTableStreamer::~vtkSortedTableStreamer()
 {
   this->SetColumnToSort(0);
   this->SetController(0);
+  if (this->MergedInput)
+  {
+    this->MergedInput->Delete();
+    this->MergedInput = 0;
+  }
   if (this->Internal)
   {
     delete this->Internal;
@@ -1391,6 +1501,12 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
 
   bool orderInverted = this->InvertOrder > 0;
 
+  // Reuse the vtkTable built from a composite input if it did not change.
+  if (!input && this->MergedInput && inputDO->GetMTime() == this->MergedInputMTime)
+  {
+    input = this->MergedInput;
+  }
+
   // Convert a composite dataset into a vtkTable input.
   if (!input)
   {
@@ -1470,6 +1586,14 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
       }
     }
     iter->Delete();
+
+    if (this->MergedInput)
+    {
+      this->MergedInput->Delete();
+    }
+    this->MergedInput = input;
+    this->MergedInput->Register(this);
+    this->MergedInputMTime = inputDO->GetMTime();
   }
 
   // Get input data
@@ -1541,16 +1665,8 @@ void vtkSortedTableStreamer::SetColumnNameToSort(const char* columnName)
 //----------------------------------------------------------------------------
 void vtkSortedTableStreamer::SetInvertOrder(int newValue)
 {
-  bool changed = this->InvertOrder != newValue;
-  bool removeInternal = changed && strcmp("vtkOriginalProcessIds", this->GetColumnToSort()) != 0;
-
-  if (removeInternal && this->Internal)
-  {
-    delete this->Internal;
-    this->Internal = 0;
-  }
-
-  if (changed)
+  // The sorted index is kept as the inverted order is its exact reverse.
+  if (this->InvertOrder != newValue)
   {
     this->InvertOrder = newValue;
     this->Modified();
@@ -20,6 +20,12 @@
  * This filter is used quickly get a sorted subset of a given vtkTable.
  * By sorted we mean a subset build from a global sort even if some optimisation
  * allow us to skip a global table sorting.
+ *
+ * Each process sorts its local table once, and a sample sort is used to
+ * split the global order in buckets whose positions are known on every
+ * process. This sorted index is kept until the input, the column, or the
+ * component to sort changes, so that extracting a block only requires to
+ * gather the rows of the buckets spanned by the block.
 */
 
 #ifndef vtkSortedTableStreamer_h
@@ -126,6 +132,11 @@ protected:
   int SelectedComponent;
   int InvertOrder;
 
+  // Table merged from a composite input. It is kept until the input changes
+  // so that the sorted index built for it is reused across blocks.
+  vtkTable* MergedInput;
+  vtkMTimeType MergedInputMTime;
+
 private:
   vtkSortedTableStreamer(const vtkSortedTableStreamer&) = delete;
   void operator=(const vtkSortedTableStreamer&) = delete;
@@ -19,9 +19,14 @@
 #include "vtkSquirtCompressor.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
+
 #include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 vtkStandardNewMacro(vtkSquirtCompressor);
 
@@ -36,6 +41,225 @@ vtkSquirtCompressor::~vtkSquirtCompressor()
 {
 }
 
+//-----------------------------------------------------------------------------
+namespace
+{
+// The compressed data starts with a header made of the number of bands
+// followed by the number of 32-bit words of each band. Bands are contiguous
+// ranges of pixels that are encoded independently.
+
+// Load the RGB pixel at `p` as a 32-bit word with a 0 alpha byte.
+inline unsigned int vtkSquirtLoadRGB(const unsigned char* p)
+{
+  unsigned int color = 0;
+  unsigned char* c = reinterpret_cast<unsigned char*>(&color);
+  c[0] = p[0];
+  c[1] = p[1];
+  c[2] = p[2];
+  return color;
+}
+
+// Encode RGBA pixels [begin, end) into `out`. Returns the number of words
+// written, which never exceeds the number of pixels.
+vtkIdType vtkSquirtEncodeRGBA(const unsigned int* in, vtkIdType begin, vtkIdType end,
+  unsigned int compress_mask, unsigned int* out)
+{
+  vtkIdType index = begin;
+  vtkIdType comp_index = 0;
+  while (index < end)
+  {
+    // Record color
+    const unsigned int current_color = out[comp_index] = in[index];
+    const unsigned int masked_color = current_color & compress_mask;
+    unsigned char opacity = *(reinterpret_cast<const unsigned char*>(&current_color) + 3);
+    index++;
+
+    // Compute Run
+    const vtkIdType run_end = std::min(end, index + 0x0F);
+    const vtkIdType run_start = index;
+    while (index < run_end && (in[index] & compress_mask) == masked_color)
+    {
+      index++;
+    }
+    int count = static_cast<int>(index - run_start);
+    if (opacity > 0)
+    {
+      opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
+      opacity = opacity << 4;
+      count |= opacity;
+    }
+
+    // Record Run length
+    *(reinterpret_cast<unsigned char*>(out + comp_index) + 3) = static_cast<unsigned char>(count);
+    comp_index++;
+  }
+  return comp_index;
+}
+
+// Encode RGB pixels [begin, end) into `out`. Returns the number of words
+// written, which never exceeds the number of pixels.
+vtkIdType vtkSquirtEncodeRGB(const unsigned char* in, vtkIdType begin, vtkIdType end,
+  unsigned int compress_mask, unsigned int* out)
+{
+  vtkIdType index = begin;
+  vtkIdType comp_index = 0;
+  while (index < end)
+  {
+    // Record color
+    const unsigned int current_color = out[comp_index] = vtkSquirtLoadRGB(in + 3 * index);
+    const unsigned int masked_color = current_color & compress_mask;
+    index++;
+
+    // Compute Run
+    const vtkIdType run_end = std::min(end, index + 255);
+    const vtkIdType run_start = index;
+    while (index < run_end && (vtkSquirtLoadRGB(in + 3 * index) & compress_mask) == masked_color)
+    {
+      index++;
+    }
+
+    // Record Run length
+    reinterpret_cast<unsigned char*>(out + comp_index)[3] =
+      static_cast<unsigned char>(index - run_start);
+    comp_index++;
+  }
+  return comp_index;
+}
+
+// Decode `numWords` words into RGBA pixels starting at `out`, writing no more
+// than `maxPixels` pixels.
+void vtkSquirtDecodeRGBA(
+  const unsigned int* in, vtkIdType numWords, unsigned int* out, vtkIdType maxPixels)
+{
+  vtkIdType index = 0;
+  for (vtkIdType i = 0; i < numWords; i++)
+  {
+    // Get color and count
+    unsigned int current_color = in[i];
+
+    // Get run length count;
+    int count = *(reinterpret_cast<unsigned char*>(&current_color) + 3);
+
+    if (count > 0x0f)
+    {
+      // we have some opacity.
+      unsigned char opacity = (count & 0xF0);
+      opacity = opacity >> 4;
+      opacity *= 16;
+      *(reinterpret_cast<unsigned char*>(&current_color) + 3) = opacity;
+    }
+    else
+    {
+      *(reinterpret_cast<unsigned char*>(&current_color) + 3) = 0;
+    }
+    count &= 0x0F;
+
+    // Blast color into color buffer
+    const vtkIdType run_end = std::min(maxPixels, index + count + 1);
+    std::fill(out + index, out + run_end, current_color);
+    index = run_end;
+  }
+}
+
+// Decode `numWords` words into RGB pixels starting at `out`, writing no more
+// than `maxPixels` pixels.
+void vtkSquirtDecodeRGB(
+  const unsigned int* in, vtkIdType numWords, unsigned char* out, vtkIdType maxPixels)
+{
+  vtkIdType index = 0;
+  for (vtkIdType i = 0; i < numWords; i++)
+  {
+    // Get color and count
+    const unsigned int current_color = in[i];
+    const unsigned char* rgb = reinterpret_cast<const unsigned char*>(&current_color);
+    const vtkIdType run_end = std::min(maxPixels, index + rgb[3] + 1);
+    for (; index < run_end; ++index)
+    {
+      out[3 * index] = rgb[0];
+      out[3 * index + 1] = rgb[1];
+      out[3 * index + 2] = rgb[2];
+    }
+  }
+}
+
+class vtkSquirtEncodeWorker
+{
+public:
+  vtkUnsignedCharArray* Input;
+  unsigned int* Output;
+  vtkIdType NumberOfPixels;
+  int NumberOfBands;
+  unsigned int CompressMask;
+  std::vector<vtkIdType>& BandSizes;
+
+  vtkSquirtEncodeWorker(std::vector<vtkIdType>& sizes)
+    : BandSizes(sizes)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType band = begin; band < end; ++band)
+    {
+      const vtkIdType first =
+        vtkImageCompressor::GetBandStart(this->NumberOfPixels, this->NumberOfBands, band);
+      const vtkIdType last =
+        vtkImageCompressor::GetBandStart(this->NumberOfPixels, this->NumberOfBands, band + 1);
+
+      // Each band writes at its worst-case offset, i.e. one word per pixel.
+      if (this->Input->GetNumberOfComponents() == 4)
+      {
+        this->BandSizes[band] =
+          vtkSquirtEncodeRGBA(reinterpret_cast<const unsigned int*>(this->Input->GetPointer(0)),
+            first, last, this->CompressMask, this->Output + first);
+      }
+      else
+      {
+        this->BandSizes[band] = vtkSquirtEncodeRGB(
+          this->Input->GetPointer(0), first, last, this->CompressMask, this->Output + first);
+      }
+    }
+  }
+};
+
+class vtkSquirtDecodeWorker
+{
+public:
+  const unsigned int* Input;
+  vtkUnsignedCharArray* Output;
+  vtkIdType NumberOfPixels;
+  int NumberOfBands;
+  const std::vector<vtkIdType>& BandOffsets;
+
+  vtkSquirtDecodeWorker(const std::vector<vtkIdType>& offsets)
+    : BandOffsets(offsets)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType band = begin; band < end; ++band)
+    {
+      const vtkIdType first =
+        vtkImageCompressor::GetBandStart(this->NumberOfPixels, this->NumberOfBands, band);
+      const vtkIdType last =
+        vtkImageCompressor::GetBandStart(this->NumberOfPixels, this->NumberOfBands, band + 1);
+      const unsigned int* words = this->Input + this->BandOffsets[band];
+      const vtkIdType numWords = this->BandOffsets[band + 1] - this->BandOffsets[band];
+      if (this->Output->GetNumberOfComponents() == 4)
+      {
+        vtkSquirtDecodeRGBA(words, numWords,
+          reinterpret_cast<unsigned int*>(this->Output->GetPointer(0)) + first, last - first);
+      }
+      else
+      {
+        vtkSquirtDecodeRGB(words, numWords, this->Output->GetPointer(0) + 3 * first, last - first);
+      }
+    }
+  }
+};
+}
+
 //-----------------------------------------------------------------------------
 int vtkSquirtCompressor::Compress()
 {
@@ -53,12 +277,7 @@ int vtkSquirtCompressor::Compress()
     return VTK_ERROR;
   }
 
-  int count = 0;
-  int index = 0;
-  int comp_index = 0;
-  int end_index;
   int compress_level = this->LossLessMode ? 0 : this->SquirtLevel;
-  unsigned int current_color;
   unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
     { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
     { 0xE0, 0xF0, 0xE0, 0xE0 } };
@@ -74,99 +293,36 @@ int vtkSquirtCompressor::Compress()
   // I shifted the level by one so that 0 means no compression.
   memcpy(&compress_mask, &compress_masks[compress_level], 4);
 
-  // Access raw arrays directly
-  if (input->GetNumberOfComponents() == 4)
+  const vtkIdType numPixels = input->GetNumberOfTuples();
+  const int numBands = this->GetNumberOfBands(numPixels);
+  const vtkIdType headerSize = 1 + numBands;
+
+  // Allocate for the worst case, i.e. one word per pixel.
+  unsigned int* _rawCompressedBuffer = reinterpret_cast<unsigned int*>(
+    this->Output->WritePointer(0, 4 * (headerSize + numPixels)));
+
+  std::vector<vtkIdType> bandSizes(numBands);
+  vtkSquirtEncodeWorker worker(bandSizes);
+  worker.Input = input;
+  worker.Output = _rawCompressedBuffer + headerSize;
+  worker.NumberOfPixels = numPixels;
+  worker.NumberOfBands = numBands;
+  worker.CompressMask = compress_mask;
+  vtkSMPTools::For(0, numBands, 1, worker);
+
+  // Write the header and pack the bands.
+  _rawCompressedBuffer[0] = static_cast<unsigned int>(numBands);
+  vtkIdType comp_index = headerSize;
+  for (int band = 0; band < numBands; ++band)
   {
-    unsigned int* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned int*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < end_index) && (comp_index < end_index))
+    _rawCompressedBuffer[1 + band] = static_cast<unsigned int>(bandSizes[band]);
+    unsigned int* bandData = _rawCompressedBuffer + headerSize +
+      vtkImageCompressor::GetBandStart(numPixels, numBands, band);
+    if (bandData != _rawCompressedBuffer + comp_index)
     {
-
-      // Record color
-      current_color = _rawCompressedBuffer[comp_index] = _rawColorBuffer[index];
-      unsigned char opacity = *(((unsigned char*)&current_color) + 3);
-      index++;
-
-      // Compute Run
-      while ((index < end_index) && (count < 0x0F) &&
-        ((current_color & compress_mask) == (_rawColorBuffer[index] & compress_mask)))
-      {
-        index++;
-        count++;
-      }
-      if (opacity > 0)
-      {
-        opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
-        opacity = opacity << 4;
-        count |= opacity;
-      }
-
-      // Record Run length
-      *((unsigned char*)_rawCompressedBuffer + comp_index * 4 + 3) = (unsigned char)count;
-      comp_index++;
-
-      count = 0;
-    }
-  }
-  else if (input->GetNumberOfComponents() == 3)
-  {
-    unsigned char* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned char*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < 3 * numPixels) && (comp_index < end_index))
-    {
-
-      int next_color = 0;
-      // Record color
-      unsigned char* p = (unsigned char*)&current_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      _rawCompressedBuffer[comp_index] = current_color;
-      index += 3;
-
-      p = (unsigned char*)&next_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      // Compute Run
-      while (((current_color & compress_mask) == (next_color & compress_mask)) &&
-        (index < 3 * numPixels) && (count < 255))
-      {
-        index += 3;
-        count++;
-        if (index < 3 * numPixels)
-        {
-          p = (unsigned char*)&next_color;
-          *p++ = _rawColorBuffer[index];
-          *p++ = _rawColorBuffer[index + 1];
-          *p++ = _rawColorBuffer[index + 2];
-          *p = 0x0;
-        }
-      }
-
-      // Record Run length
-      reinterpret_cast<unsigned char*>(_rawCompressedBuffer)[comp_index * 4 + 3] =
-        static_cast<unsigned char>(count);
-      comp_index++;
-
-      count = 0;
+      memmove(_rawCompressedBuffer + comp_index, bandData, 4 * bandSizes[band]);
     }
+    comp_index += bandSizes[band];
   }
 
   // Back to vtk arrays :)
@@ -203,102 +359,56 @@ int vtkSquirtCompressor::Decompress()
 }
 
 //-----------------------------------------------------------------------------
-int vtkSquirtCompressor::DecompressRGBA()
+int vtkSquirtCompressor::DecompressBands()
 {
   vtkUnsignedCharArray* in = this->GetInput();
   vtkUnsignedCharArray* out = this->GetOutput();
-  assert(out->GetNumberOfComponents() == 4);
-
-  int count = 0;
-  int index = 0;
-  unsigned int current_color;
-  unsigned int* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
 
   // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
-
-  // Access raw arrays directly
-  _rawColorBuffer = (unsigned int*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
-
-  // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
+  const vtkIdType compSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
+  const unsigned int* _rawCompressedBuffer =
+    reinterpret_cast<const unsigned int*>(in->GetPointer(0));
+  if (compSize < 1 || compSize < 1 + static_cast<vtkIdType>(_rawCompressedBuffer[0]))
   {
-    // Get color and count
-    current_color = _rawCompressedBuffer[i];
-
-    // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
-
-    if (count > 0x0f)
-    {
-      // we have some opacity.
-      unsigned char opacity = (count & 0xF0);
-      opacity = opacity >> 4;
-      opacity *= 16;
-      *((unsigned char*)&current_color + 3) = opacity;
-    }
-    else
-    {
-      *((unsigned char*)&current_color + 3) = 0;
-    }
-    count &= 0x0F;
-
-    // Set color
-    _rawColorBuffer[index++] = current_color;
+    vtkErrorMacro("Invalid compressed data.");
+    return VTK_ERROR;
+  }
 
-    // Blast color into color buffer
-    for (int j = 0; j < count; j++)
-    {
-      _rawColorBuffer[index++] = current_color;
-    }
+  // Read the header.
+  const int numBands = static_cast<int>(_rawCompressedBuffer[0]);
+  const vtkIdType headerSize = 1 + numBands;
+  std::vector<vtkIdType> bandOffsets(numBands + 1, 0);
+  for (int band = 0; band < numBands; ++band)
+  {
+    bandOffsets[band + 1] = bandOffsets[band] + _rawCompressedBuffer[1 + band];
+  }
+  if (headerSize + bandOffsets[numBands] > compSize)
+  {
+    vtkErrorMacro("Invalid compressed data.");
+    return VTK_ERROR;
   }
+
+  vtkSquirtDecodeWorker worker(bandOffsets);
+  worker.Input = _rawCompressedBuffer + headerSize;
+  worker.Output = out;
+  worker.NumberOfPixels = out->GetNumberOfTuples();
+  worker.NumberOfBands = numBands;
+  vtkSMPTools::For(0, numBands, 1, worker);
   return VTK_OK;
 }
 
 //-----------------------------------------------------------------------------
-int vtkSquirtCompressor::DecompressRGB()
+int vtkSquirtCompressor::DecompressRGBA()
 {
-  vtkUnsignedCharArray* in = this->GetInput();
-  vtkUnsignedCharArray* out = this->GetOutput();
-  assert(out->GetNumberOfComponents() == 3);
-
-  int count = 0;
-  unsigned int current_color;
-  unsigned char* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
-
-  // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
-
-  // Access raw arrays directly
-  _rawColorBuffer = (unsigned char*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
-
-  // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
-  {
-    // Get color and count
-    current_color = _rawCompressedBuffer[i];
-
-    // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
-
-    *((unsigned char*)&current_color + 3) = 0xff;
+  assert(this->GetOutput()->GetNumberOfComponents() == 4);
+  return this->DecompressBands();
+}
 
-    unsigned char current_color_rgb[3];
-    std::copy(reinterpret_cast<const unsigned char*>(&current_color),
-      reinterpret_cast<const unsigned char*>(&current_color) + 3, current_color_rgb);
-    std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-    _rawColorBuffer += 3;
-    for (int j = 0; j < count; j++)
-    {
-      std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-      _rawColorBuffer += 3;
-    }
-  }
-  return VTK_OK;
+//-----------------------------------------------------------------------------
+int vtkSquirtCompressor::DecompressRGB()
+{
+  assert(this->GetOutput()->GetNumberOfComponents() == 3);
+  return this->DecompressBands();
 }
 
 //-----------------------------------------------------------------------------
@@ -44,6 +44,9 @@
  * The compressor uses a modified SQUIRT implementation where encode 4-bit
  * opacity information as well. This is needed to improve background color
  * blending for translucent renderings in ParaView.
+ *
+ * The image is split into horizontal bands that are encoded and decoded
+ * concurrently, see vtkImageCompressor::SetThreaded().
  * @par Thanks:
  * Thanks to Sandia National Laboratories for this compression technique
 */
@@ -98,6 +101,7 @@ protected:
   ~vtkSquirtCompressor() override;
   int DecompressRGB();
   int DecompressRGBA();
+  int DecompressBands();
 
   int SquirtLevel;
 
@@ -15,9 +15,14 @@
 #include "vtkZlibImageCompressor.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtk_zlib.h"
+
+#include <atomic>
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 vtkStandardNewMacro(vtkZlibImageCompressor);
 
@@ -334,6 +339,104 @@ void vtkZlibImageCompressor::SetStripAlpha(int status)
   this->Modified();
 }
 
+//-----------------------------------------------------------------------------
+namespace
+{
+// The compressed data is laid out as follows: 1 byte for the number of
+// components of the pre-processed image, a 32-bit number of bands, the 32-bit
+// compressed size of each band and finally the zlib stream of each band. Bands
+// are contiguous ranges of pixels that are (de)compressed independently.
+const size_t vtkZlibBandSizeOffset = 1 + sizeof(vtkTypeUInt32);
+
+// Worst case zlib output, 100.1% + 16.
+uLongf vtkZlibBound(vtkIdType size)
+{
+  return static_cast<uLongf>(1.001 * size + 17);
+}
+
+class vtkZlibCompressWorker
+{
+public:
+  const unsigned char* Input;
+  int NumberOfComponents;
+  vtkIdType NumberOfPixels;
+  int NumberOfBands;
+  int CompressionLevel;
+  std::vector<std::vector<unsigned char> >& Bands;
+  std::atomic<bool> Failed;
+
+  vtkZlibCompressWorker(std::vector<std::vector<unsigned char> >& bands)
+    : Bands(bands)
+    , Failed(false)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType band = begin; band < end && !this->Failed; ++band)
+    {
+      const vtkIdType first =
+        vtkImageCompressor::GetBandStart(this->NumberOfPixels, this->NumberOfBands, band);
+      const vtkIdType last =
+        vtkImageCompressor::GetBandStart(this->NumberOfPixels, this->NumberOfBands, band + 1);
+      const vtkIdType size = (last - first) * this->NumberOfComponents;
+      std::vector<unsigned char>& out = this->Bands[band];
+      uLongf outSize = vtkZlibBound(size);
+      out.resize(outSize);
+      if (compress2(reinterpret_cast<Bytef*>(&out[0]), &outSize,
+            reinterpret_cast<const Bytef*>(this->Input + first * this->NumberOfComponents), size,
+            this->CompressionLevel) != Z_OK)
+      {
+        this->Failed = true;
+        return;
+      }
+      out.resize(outSize);
+    }
+  }
+};
+
+class vtkZlibDecompressWorker
+{
+public:
+  const unsigned char* Input;
+  unsigned char* Output;
+  int NumberOfComponents;
+  vtkIdType NumberOfPixels;
+  int NumberOfBands;
+  const std::vector<vtkIdType>& BandOffsets;
+  std::atomic<bool> Failed;
+
+  vtkZlibDecompressWorker(const std::vector<vtkIdType>& offsets)
+    : BandOffsets(offsets)
+    , Failed(false)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType band = begin; band < end && !this->Failed; ++band)
+    {
+      const vtkIdType first =
+        vtkImageCompressor::GetBandStart(this->NumberOfPixels, this->NumberOfBands, band);
+      const vtkIdType last =
+        vtkImageCompressor::GetBandStart(this->NumberOfPixels, this->NumberOfBands, band + 1);
+      const uLongf bandSize = static_cast<uLongf>((last - first) * this->NumberOfComponents);
+      uLongf outSize = bandSize;
+      // A band that does not fill its range exactly is as corrupt as one
+      // zlib rejects.
+      if (uncompress(reinterpret_cast<Bytef*>(this->Output + first * this->NumberOfComponents),
+            &outSize, reinterpret_cast<const Bytef*>(this->Input + this->BandOffsets[band]),
+            static_cast<uLong>(this->BandOffsets[band + 1] - this->BandOffsets[band])) != Z_OK ||
+        outSize != bandSize)
+      {
+        this->Failed = true;
+        return;
+      }
+    }
+  }
+};
+}
+
 //-----------------------------------------------------------------------------
 int vtkZlibImageCompressor::Compress()
 {
@@ -351,17 +454,50 @@ int vtkZlibImageCompressor::Compress()
   this->Conditioner->PreProcess(this->Input, inImage, inImageComps, inImageSize, freeInImage);
 
   // Compress
-  uLongf outImageSize = static_cast<uLongf>(1.001 * inImageSize + 17);
-  // zlib requires 100.1% + 16, 1 byte for strip alpha
+  const vtkIdType numPixels = this->Input->GetNumberOfTuples();
+  const int numBands = this->GetNumberOfBands(numPixels);
+  std::vector<std::vector<unsigned char> > bands(numBands);
+  vtkZlibCompressWorker worker(bands);
+  worker.Input = inImage;
+  worker.NumberOfComponents = inImageComps;
+  worker.NumberOfPixels = numPixels;
+  worker.NumberOfBands = numBands;
+  worker.CompressionLevel = this->CompressionLevel;
+  vtkSMPTools::For(0, numBands, 1, worker);
+  if (worker.Failed)
+  {
+    if (freeInImage)
+    {
+      free(inImage);
+    }
+    vtkErrorMacro("Failed to compress the image.");
+    return VTK_ERROR;
+  }
+
+  // Package compressed data in a vtk object.
+  const size_t headerSize = vtkZlibBandSizeOffset + numBands * sizeof(vtkTypeUInt32);
+  size_t outImageSize = headerSize;
+  for (int band = 0; band < numBands; ++band)
+  {
+    outImageSize += bands[band].size();
+  }
   unsigned char* outImage = static_cast<unsigned char*>(malloc(outImageSize));
   outImage[0] = inImageComps;
-  compress2((Bytef*)(outImage + 1), &outImageSize, (const Bytef*)inImage, inImageSize,
-    this->CompressionLevel);
+  const vtkTypeUInt32 numBandsOut = static_cast<vtkTypeUInt32>(numBands);
+  memcpy(outImage + 1, &numBandsOut, sizeof(vtkTypeUInt32));
+  unsigned char* outPtr = outImage + headerSize;
+  for (int band = 0; band < numBands; ++band)
+  {
+    const vtkTypeUInt32 bandSize = static_cast<vtkTypeUInt32>(bands[band].size());
+    memcpy(outImage + vtkZlibBandSizeOffset + band * sizeof(vtkTypeUInt32), &bandSize,
+      sizeof(vtkTypeUInt32));
+    memcpy(outPtr, &bands[band][0], bandSize);
+    outPtr += bandSize;
+  }
 
-  // Package compressed data in a vtk object.
-  this->Output->SetArray(outImage, outImageSize + 1, 0);
+  this->Output->SetArray(outImage, static_cast<vtkIdType>(outImageSize), 0);
   this->Output->SetNumberOfComponents(1);
-  this->Output->SetNumberOfTuples(outImageSize + 1);
+  this->Output->SetNumberOfTuples(static_cast<vtkIdType>(outImageSize));
 
   // Clean up after pre-proccesosor.
   if (freeInImage)
@@ -382,18 +518,54 @@ int vtkZlibImageCompressor::Decompress()
   }
 
   // size input.
-  unsigned char* compIm = this->Input->GetPointer(1);
-  const vtkIdType compImSize = this->Input->GetNumberOfTuples() - 1;
+  const unsigned char* compIm = this->Input->GetPointer(0);
+  const vtkIdType compImSize = this->Input->GetNumberOfTuples();
+  vtkTypeUInt32 numBands = 0;
+  if (compImSize >= static_cast<vtkIdType>(vtkZlibBandSizeOffset))
+  {
+    memcpy(&numBands, compIm + 1, sizeof(vtkTypeUInt32));
+  }
+  const vtkIdType headerSize =
+    static_cast<vtkIdType>(vtkZlibBandSizeOffset + numBands * sizeof(vtkTypeUInt32));
+  if (numBands == 0 || compImSize < headerSize)
+  {
+    vtkErrorMacro("Invalid compressed data.");
+    return VTK_ERROR;
+  }
+
+  // Read the header.
+  std::vector<vtkIdType> bandOffsets(numBands + 1, headerSize);
+  for (vtkTypeUInt32 band = 0; band < numBands; ++band)
+  {
+    vtkTypeUInt32 bandSize;
+    memcpy(&bandSize, compIm + vtkZlibBandSizeOffset + band * sizeof(vtkTypeUInt32),
+      sizeof(vtkTypeUInt32));
+    bandOffsets[band + 1] = bandOffsets[band] + bandSize;
+  }
+  if (bandOffsets[numBands] > compImSize)
+  {
+    vtkErrorMacro("Invalid compressed data.");
+    return VTK_ERROR;
+  }
 
   // decompress.
-  uLongf decompImSize =
-    static_cast<uLongf>(this->Output->GetNumberOfComponents() * this->Output->GetNumberOfTuples());
+  const int decompImComps = compIm[0];
   unsigned char* decompIm = this->Output->GetPointer(0);
-  uncompress((Bytef*)decompIm, &decompImSize, (const Bytef*)compIm, compImSize);
+  vtkZlibDecompressWorker worker(bandOffsets);
+  worker.Input = compIm;
+  worker.Output = decompIm;
+  worker.NumberOfComponents = decompImComps;
+  worker.NumberOfPixels = this->Output->GetNumberOfTuples();
+  worker.NumberOfBands = static_cast<int>(numBands);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBands), 1, worker);
+  if (worker.Failed)
+  {
+    vtkErrorMacro("Failed to decompress the image.");
+    return VTK_ERROR;
+  }
 
   // undo pre-proccssing.
-  const int decompImComps = (this->GetStripAlpha() ? 3 : 4);
-  unsigned char const* decompImEnd = decompIm + decompImSize;
+  unsigned char const* decompImEnd = decompIm + decompImComps * this->Output->GetNumberOfTuples();
   this->Conditioner->PostProcess(decompIm, decompImEnd, decompImComps, this->Output);
 
   return VTK_OK;
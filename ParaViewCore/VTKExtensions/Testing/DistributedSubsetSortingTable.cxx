@@ -13,14 +13,18 @@
 
 =========================================================================*/
 
-// Test simple sorting on a distributed wavelet
+// Test simple sorting on a distributed wavelet, and the sorting of 64-bit
+// integer keys that can not be told apart as doubles.
 // This test requires 4 MPI processes.
 
 #include "vtkAttributeDataToTableFilter.h"
+#include "vtkCommunicator.h"
 #include "vtkDistributedDataFilter.h"
 #include "vtkFloatArray.h"
 #include "vtkImageData.h"
 #include "vtkMPIController.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPieceScalars.h"
 #include "vtkRTAnalyticSource.h"
@@ -28,6 +32,7 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
 #include "vtkTestUtilities.h"
+#include "vtkTypeInt64Array.h"
 #include "vtkUnstructuredGrid.h"
 /*
 ** This test only builds if MPI is in use
@@ -36,6 +41,93 @@
 
 #include "vtkProcess.h"
 
+namespace
+{
+// Sorts 64-bit keys above 2^53, which differ by less than the spacing of the
+// doubles around them, so that the distributed sort has to compare them as
+// integers to order them. Checks every block in both orders.
+bool TestLargeIntegerKeys(vtkMultiProcessController* controller)
+{
+  const vtkTypeInt64 base = static_cast<vtkTypeInt64>(1) << 60;
+  const vtkIdType localSize = 1000;
+  const vtkIdType blockSize = 256;
+  int me = controller->GetLocalProcessId();
+  int nbProc = controller->GetNumberOfProcesses();
+  vtkIdType globalSize = localSize * nbProc;
+
+  // The keys are a permutation of base + [0, globalSize) spread over all the
+  // processes.
+  vtkNew<vtkTypeInt64Array> keys;
+  keys->SetName("Key");
+  keys->SetNumberOfTuples(localSize);
+  for (vtkIdType i = 0; i < localSize; i++)
+  {
+    vtkIdType id = me * localSize + i;
+    keys->SetValue(i, base + (id * 7919) % globalSize);
+  }
+  vtkNew<vtkTable> table;
+  table->AddColumn(keys.GetPointer());
+
+  vtkNew<vtkSortedTableStreamer> sortFilter;
+  sortFilter->SetInputData(table.GetPointer());
+  sortFilter->SetColumnNameToSort("Key");
+  sortFilter->SetSelectedComponent(0);
+  sortFilter->SetBlockSize(blockSize);
+
+  int ok = 1;
+  for (int invert = 0; invert < 2; invert++)
+  {
+    sortFilter->SetInvertOrder(invert);
+    for (vtkIdType block = 0; block * blockSize < globalSize; block++)
+    {
+      sortFilter->SetBlock(block);
+      sortFilter->UpdatePiece(me, nbProc, 0);
+
+      vtkTable* output = sortFilter->GetOutput();
+      vtkIdType nbRows = output->GetNumberOfRows();
+      vtkTypeInt64Array* sorted =
+        vtkTypeInt64Array::SafeDownCast(output->GetColumnByName("Key"));
+      if (nbRows > 0 && !sorted)
+      {
+        cout << "ERROR: the sorted keys are missing." << endl;
+        ok = 0;
+        nbRows = 0;
+      }
+      for (vtkIdType row = 0; row < nbRows; row++)
+      {
+        vtkIdType rank = block * blockSize + row;
+        vtkTypeInt64 expected = base + (invert ? globalSize - 1 - rank : rank);
+        if (sorted->GetValue(row) != expected)
+        {
+          cout << "ERROR: key " << sorted->GetValue(row) << " at row " << row << " of block "
+               << block << " instead of " << expected << " with invert order " << invert
+               << endl;
+          ok = 0;
+          break;
+        }
+      }
+
+      vtkIdType allRows = 0;
+      controller->AllReduce(&nbRows, &allRows, 1, vtkCommunicator::SUM_OP);
+      vtkIdType expectedRows = vtkMath::Min(blockSize, globalSize - block * blockSize);
+      if (allRows != expectedRows)
+      {
+        if (me == 0)
+        {
+          cout << "ERROR: block " << block << " has " << allRows << " rows instead of "
+               << expectedRows << endl;
+        }
+        ok = 0;
+      }
+    }
+  }
+
+  int allOk = 0;
+  controller->AllReduce(&ok, &allOk, 1, vtkCommunicator::MIN_OP);
+  return allOk == 1;
+}
+}
+
 class MyProcess : public vtkProcess
 {
 public:
@@ -127,6 +219,11 @@ void MyProcess::Execute()
   ps->Delete();
   sortFilter->Delete();
   dsToTableFilter->Delete();
+
+  if (!TestLargeIntegerKeys(this->Controller))
+  {
+    this->ReturnValue = 0;
+  }
 }
 
 int main(int argc, char** argv)
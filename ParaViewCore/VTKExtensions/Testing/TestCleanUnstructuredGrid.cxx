@@ -0,0 +1,127 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestCleanUnstructuredGrid.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAppendFilter.h"
+#include "vtkCleanUnstructuredGrid.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vector>
+
+namespace
+{
+// Checks that the cells of output reference points with the same coordinates
+// and scalars as the ones of the input.
+bool SameCells(vtkUnstructuredGrid* input, vtkUnstructuredGrid* output)
+{
+  if (input->GetNumberOfCells() != output->GetNumberOfCells())
+  {
+    return false;
+  }
+  vtkDataArray* inScalars = input->GetPointData()->GetScalars();
+  vtkDataArray* outScalars = output->GetPointData()->GetScalars();
+  vtkNew<vtkIdList> inIds;
+  vtkNew<vtkIdList> outIds;
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    input->GetCellPoints(cellId, inIds.GetPointer());
+    output->GetCellPoints(cellId, outIds.GetPointer());
+    if (input->GetCellType(cellId) != output->GetCellType(cellId) ||
+      inIds->GetNumberOfIds() != outIds->GetNumberOfIds())
+    {
+      return false;
+    }
+    for (vtkIdType cc = 0; cc < inIds->GetNumberOfIds(); ++cc)
+    {
+      double inPt[3], outPt[3];
+      input->GetPoint(inIds->GetId(cc), inPt);
+      output->GetPoint(outIds->GetId(cc), outPt);
+      if (static_cast<float>(inPt[0]) != outPt[0] || static_cast<float>(inPt[1]) != outPt[1] ||
+        static_cast<float>(inPt[2]) != outPt[2] ||
+        inScalars->GetTuple1(inIds->GetId(cc)) != outScalars->GetTuple1(outIds->GetId(cc)))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestCleanUnstructuredGrid(int, char* [])
+{
+  // Two wavelets sharing a face, appended without merging their points.
+  vtkNew<vtkRTAnalyticSource> wavelet1;
+  wavelet1->SetWholeExtent(0, 10, 0, 10, 0, 10);
+  vtkNew<vtkRTAnalyticSource> wavelet2;
+  wavelet2->SetWholeExtent(10, 20, 0, 10, 0, 10);
+  vtkNew<vtkAppendFilter> append;
+  append->AddInputConnection(wavelet1->GetOutputPort());
+  append->AddInputConnection(wavelet2->GetOutputPort());
+  append->Update();
+  vtkUnstructuredGrid* input = append->GetOutput();
+
+  // Reference merging, in input order, using a locator.
+  vtkNew<vtkPoints> refPoints;
+  vtkNew<vtkMergePoints> locator;
+  locator->InitPointInsertion(refPoints.GetPointer(), input->GetBounds());
+  for (vtkIdType id = 0; id < input->GetNumberOfPoints(); ++id)
+  {
+    vtkIdType newId;
+    locator->InsertUniquePoint(input->GetPoint(id), newId);
+  }
+
+  vtkNew<vtkCleanUnstructuredGrid> clean;
+  clean->SetInputData(input);
+  for (int ordering = vtkCleanUnstructuredGrid::INPUT_ORDER;
+       ordering <= vtkCleanUnstructuredGrid::SPATIAL_ORDER; ++ordering)
+  {
+    clean->SetPointOrdering(ordering);
+    clean->Update();
+    vtkUnstructuredGrid* output = clean->GetOutput();
+    if (output->GetNumberOfPoints() != refPoints->GetNumberOfPoints())
+    {
+      cerr << "ERROR: expected " << refPoints->GetNumberOfPoints() << " points, got "
+           << output->GetNumberOfPoints() << " with ordering " << ordering << endl;
+      return EXIT_FAILURE;
+    }
+    if (!SameCells(input, output))
+    {
+      cerr << "ERROR: cells differ from the input with ordering " << ordering << endl;
+      return EXIT_FAILURE;
+    }
+    if (ordering == vtkCleanUnstructuredGrid::INPUT_ORDER)
+    {
+      for (vtkIdType id = 0; id < refPoints->GetNumberOfPoints(); ++id)
+      {
+        double refPt[3], pt[3];
+        refPoints->GetPoint(id, refPt);
+        output->GetPoint(id, pt);
+        if (refPt[0] != pt[0] || refPt[1] != pt[1] || refPt[2] != pt[2])
+        {
+          cerr << "ERROR: point " << id << " is not in input order." << endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -16,11 +16,115 @@
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
 #include "vtkExtractHistogram.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
 #include "vtkIntArray.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSphereSource.h"
 #include "vtkTable.h"
 
+#include <vector>
+
+namespace
+{
+/// Test the counts and averages of the threaded binning on enough values to
+/// be split between threads. The values are integers, so that the totals do
+/// not depend on the order in which the threads add them up.
+int TestThreadedBinning()
+{
+  const int bin_count = 10;
+  const int dim = 100;
+  const vtkIdType num_values = dim * dim * dim;
+
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(dim, dim, dim);
+  vtkSmartPointer<vtkIntArray> values = vtkSmartPointer<vtkIntArray>::New();
+  values->SetName("values");
+  values->SetNumberOfTuples(num_values);
+  vtkSmartPointer<vtkDoubleArray> weights = vtkSmartPointer<vtkDoubleArray>::New();
+  weights->SetName("weights");
+  weights->SetNumberOfComponents(2);
+  weights->SetNumberOfTuples(num_values);
+  for (vtkIdType i = 0; i < num_values; ++i)
+  {
+    values->SetValue(i, static_cast<int>(i % 100));
+    weights->SetComponent(i, 0, static_cast<double>(i % 7));
+    weights->SetComponent(i, 1, static_cast<double>((3 * i) % 5));
+  }
+  image->GetPointData()->AddArray(values);
+  image->GetPointData()->AddArray(weights);
+
+  // the values range from 0 to 99.
+  const double bin_delta = 99.0 / bin_count;
+  std::vector<vtkIdType> counts(bin_count, 0);
+  std::vector<double> totals(2 * bin_count, 0.0);
+  for (vtkIdType i = 0; i < num_values; ++i)
+  {
+    int bin = static_cast<int>(values->GetValue(i) / bin_delta);
+    bin = bin < bin_count ? bin : bin_count - 1;
+    ++counts[bin];
+    totals[2 * bin] += weights->GetComponent(i, 0);
+    totals[2 * bin + 1] += weights->GetComponent(i, 1);
+  }
+
+  vtkSMPTools::Initialize(4);
+  vtkSmartPointer<vtkExtractHistogram> extraction = vtkSmartPointer<vtkExtractHistogram>::New();
+  extraction->SetInputData(image);
+  extraction->SetInputArrayToProcess(
+    0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "values");
+  extraction->SetBinCount(bin_count);
+  extraction->SetCalculateAverages(1);
+  extraction->Update();
+
+  vtkTable* const histogram = extraction->GetOutput();
+  vtkIdTypeArray* const bin_values =
+    vtkIdTypeArray::SafeDownCast(histogram->GetRowData()->GetArray("bin_values"));
+  vtkDoubleArray* const weights_total =
+    vtkDoubleArray::SafeDownCast(histogram->GetRowData()->GetArray("weights_total"));
+  vtkDoubleArray* const weights_average =
+    vtkDoubleArray::SafeDownCast(histogram->GetRowData()->GetArray("weights_average"));
+  if (!bin_values || !weights_total || !weights_average)
+  {
+    vtkGenericWarningMacro("Missing bin values or averages.");
+    return 1;
+  }
+  if (histogram->GetRowData()->GetArray("values_total"))
+  {
+    vtkGenericWarningMacro("The binned array must not be averaged.");
+    return 1;
+  }
+  if (weights_total->GetNumberOfComponents() != 2 ||
+    weights_average->GetNumberOfComponents() != 2)
+  {
+    vtkGenericWarningMacro("Averages must have the components of the averaged array.");
+    return 1;
+  }
+
+  for (int bin = 0; bin < bin_count; ++bin)
+  {
+    if (bin_values->GetValue(bin) != counts[bin])
+    {
+      vtkGenericWarningMacro("Incorrect count " << bin_values->GetValue(bin) << " in bin " << bin
+                                                << ", expected " << counts[bin] << ".");
+      return 1;
+    }
+    for (int comp = 0; comp < 2; ++comp)
+    {
+      const double total = totals[2 * bin + comp];
+      if (weights_total->GetComponent(bin, comp) != total ||
+        weights_average->GetComponent(bin, comp) != total / counts[bin])
+      {
+        vtkGenericWarningMacro("Incorrect total or average in bin " << bin << ".");
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+}
+
 /// Test the output of the vtkExtractHistogram filter in a simple serial case
 int TestExtractHistogram(int, char* [])
 {
@@ -59,8 +163,8 @@ int TestExtractHistogram(int, char* [])
     return 1;
   }
 
-  vtkIntArray* const bin_values =
-    vtkIntArray::SafeDownCast(histogram->GetRowData()->GetArray((int)1));
+  vtkIdTypeArray* const bin_values =
+    vtkIdTypeArray::SafeDownCast(histogram->GetRowData()->GetArray((int)1));
   if (!bin_values)
   {
     vtkGenericWarningMacro("cell data missing.");
@@ -92,5 +196,5 @@ int TestExtractHistogram(int, char* [])
     vtkGenericWarningMacro("incorrect bin value.");
     return 1;
   }
-  return 0;
+  return TestThreadedBinning();
 }
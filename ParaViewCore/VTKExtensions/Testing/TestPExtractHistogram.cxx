@@ -0,0 +1,192 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPExtractHistogram.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Test the reduction of the bin counts and of the averages of
+// vtkPExtractHistogram, with an averaged array missing on one process.
+// This test requires at least 2 MPI processes.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkPExtractHistogram.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+
+#include <vector>
+
+namespace
+{
+const int BIN_COUNT = 10;
+const vtkIdType PIECE_SIZE = 10000;
+
+// The array is averaged on all the processes but process 1.
+bool HasPartial(int piece)
+{
+  return piece != 1;
+}
+
+double Weight(vtkIdType id)
+{
+  return static_cast<double>(id % 7);
+}
+
+double Partial(vtkIdType id)
+{
+  return static_cast<double>((3 * id) % 5);
+}
+
+// The values of the pieces range from 0 to 99, the values of the other
+// arrays are integers, so that their totals do not depend on the order in
+// which the processes add them up.
+vtkSmartPointer<vtkImageData> MakePiece(int piece)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(100, PIECE_SIZE / 100, 1);
+  vtkSmartPointer<vtkIntArray> values = vtkSmartPointer<vtkIntArray>::New();
+  values->SetName("values");
+  values->SetNumberOfTuples(PIECE_SIZE);
+  vtkSmartPointer<vtkDoubleArray> weights = vtkSmartPointer<vtkDoubleArray>::New();
+  weights->SetName("weights");
+  weights->SetNumberOfTuples(PIECE_SIZE);
+  vtkSmartPointer<vtkDoubleArray> partial = vtkSmartPointer<vtkDoubleArray>::New();
+  partial->SetName("partial");
+  partial->SetNumberOfTuples(PIECE_SIZE);
+  for (vtkIdType i = 0; i < PIECE_SIZE; ++i)
+  {
+    vtkIdType id = piece * PIECE_SIZE + i;
+    values->SetValue(i, static_cast<int>((id * 13) % 100));
+    weights->SetValue(i, Weight(id));
+    partial->SetValue(i, Partial(id));
+  }
+  image->GetPointData()->AddArray(values);
+  image->GetPointData()->AddArray(weights);
+  if (HasPartial(piece))
+  {
+    image->GetPointData()->AddArray(partial);
+  }
+  return image;
+}
+
+bool CheckArray(vtkTable* histogram, const char* name, const std::vector<double>& expected)
+{
+  vtkDataArray* array = histogram->GetRowData()->GetArray(name);
+  if (!array || array->GetNumberOfTuples() != BIN_COUNT || array->GetNumberOfComponents() != 1)
+  {
+    cerr << "ERROR: " << name << " is missing or has a wrong size." << endl;
+    return false;
+  }
+  for (int bin = 0; bin < BIN_COUNT; ++bin)
+  {
+    if (array->GetTuple1(bin) != expected[bin])
+    {
+      cerr << "ERROR: " << name << " is " << array->GetTuple1(bin) << " in bin " << bin
+           << " instead of " << expected[bin] << "." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  int me = contr->GetLocalProcessId();
+  int numProcs = contr->GetNumberOfProcesses();
+
+  int status = 1;
+  if (numProcs < 2)
+  {
+    if (me == 0)
+    {
+      cerr << "ERROR: this test requires at least 2 MPI processes." << endl;
+    }
+    status = 0;
+  }
+
+  vtkSmartPointer<vtkPExtractHistogram> extraction =
+    vtkSmartPointer<vtkPExtractHistogram>::New();
+  extraction->SetInputData(MakePiece(me));
+  extraction->SetInputArrayToProcess(
+    0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "values");
+  extraction->SetBinCount(BIN_COUNT);
+  extraction->SetCalculateAverages(1);
+  extraction->Update();
+
+  if (status && me == 0)
+  {
+    // the histogram of all the pieces.
+    const double bin_delta = 99.0 / BIN_COUNT;
+    std::vector<double> counts(BIN_COUNT, 0.0);
+    std::vector<double> weights_total(BIN_COUNT, 0.0);
+    std::vector<double> partial_total(BIN_COUNT, 0.0);
+    for (int piece = 0; piece < numProcs; ++piece)
+    {
+      for (vtkIdType i = 0; i < PIECE_SIZE; ++i)
+      {
+        vtkIdType id = piece * PIECE_SIZE + i;
+        int bin = static_cast<int>(((id * 13) % 100) / bin_delta);
+        bin = bin < BIN_COUNT ? bin : BIN_COUNT - 1;
+        counts[bin] += 1;
+        weights_total[bin] += Weight(id);
+        partial_total[bin] += HasPartial(piece) ? Partial(id) : 0.0;
+      }
+    }
+    // the averages are over all the values of a bin, including those of the
+    // process without the array.
+    std::vector<double> weights_average(BIN_COUNT, 0.0);
+    std::vector<double> partial_average(BIN_COUNT, 0.0);
+    for (int bin = 0; bin < BIN_COUNT; ++bin)
+    {
+      weights_average[bin] = counts[bin] ? weights_total[bin] / counts[bin] : 0.0;
+      partial_average[bin] = counts[bin] ? partial_total[bin] / counts[bin] : 0.0;
+    }
+
+    vtkTable* histogram = extraction->GetOutput();
+    if (!vtkIdTypeArray::SafeDownCast(histogram->GetRowData()->GetArray("bin_values")))
+    {
+      cerr << "ERROR: bin_values must be a vtkIdTypeArray." << endl;
+      status = 0;
+    }
+    else if (!CheckArray(histogram, "bin_values", counts) ||
+      !CheckArray(histogram, "weights_total", weights_total) ||
+      !CheckArray(histogram, "weights_average", weights_average) ||
+      !CheckArray(histogram, "partial_total", partial_total) ||
+      !CheckArray(histogram, "partial_average", partial_average))
+    {
+      status = 0;
+    }
+  }
+  else if (me != 0 && extraction->GetOutput()->GetNumberOfRows() != 0)
+  {
+    cerr << "ERROR: process " << me << " must have an empty histogram." << endl;
+    status = 0;
+  }
+
+  int allStatus = 0;
+  contr->AllReduce(&status, &allStatus, 1, vtkCommunicator::MIN_OP);
+
+  extraction = NULL;
+  vtkMultiProcessController::SetGlobalController(NULL);
+  contr->Finalize();
+  contr->Delete();
+  return allStatus ? 0 : 1;
+}
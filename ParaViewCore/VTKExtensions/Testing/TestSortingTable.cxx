@@ -164,6 +164,54 @@ int sortMagnitudeOnUnsignedCharVector()
   return EXIT_SUCCESS;
 }
 
+// ----------------------------------------------------------------------------
+// Walk the blocks in both orders, the sorted index being reused between
+// blocks and between orders.
+int sortBlocksInBothOrders(bool debug)
+{
+  const int size = 10;
+  const int blockSize = 3;
+  double dataArray[size] = { 5, 1, 8, 1, 9, 0, 3, 7, 2, 6 };
+  double sortedArray[size] = { 0, 1, 1, 2, 3, 5, 6, 7, 8, 9 };
+
+  vtkSmartPointer<vtkDoubleArray> dataToSort = vtkSmartPointer<vtkDoubleArray>::New();
+  fillArray(dataToSort.GetPointer(), dataArray, size, "data");
+
+  vtkSmartPointer<vtkTable> input = vtkSmartPointer<vtkTable>::New();
+  input->AddColumn(dataToSort);
+
+  vtkSmartPointer<vtkSortedTableStreamer> sortingfilter =
+    vtkSmartPointer<vtkSortedTableStreamer>::New();
+  sortingfilter->SetInputData(input.GetPointer());
+  sortingfilter->SetSelectedComponent(0);
+  sortingfilter->SetColumnNameToSort("data");
+  sortingfilter->SetBlockSize(blockSize);
+
+  for (int invert = 0; invert < 2; invert++)
+  {
+    sortingfilter->SetInvertOrder(invert);
+    for (int block = 0; block * blockSize < size; block++)
+    {
+      sortingfilter->SetBlock(block);
+      sortingfilter->Update();
+
+      double expected[blockSize];
+      int count = 0;
+      for (int i = block * blockSize; i < size && count < blockSize; i++, count++)
+      {
+        expected[count] = sortedArray[invert ? size - 1 - i : i];
+      }
+      if (!compareArray(sortingfilter->GetOutput(), "data", expected, count, debug))
+      {
+        cout << "Wrong block " << block << (invert ? " in inverted order" : "") << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
 // ----------------------------------------------------------------------------
 int TestSortingTable(int vtkNotUsed(argc), char** vtkNotUsed(argv))
 {
@@ -183,6 +231,9 @@ int TestSortingTable(int vtkNotUsed(argc), char** vtkNotUsed(argv))
   cout << "Testing sorting with magnitude on unsigned char: "
        << ((result += sortMagnitudeOnUnsignedCharVector()) ? "FAILED" : "SUCCESS") << endl;
   // --------------------------------------------------------------------------
+  cout << "Testing sorting blocks in both orders: "
+       << ((result += sortBlocksInBothOrders(debug)) ? "FAILED" : "SUCCESS") << endl;
+  // --------------------------------------------------------------------------
   // --------------------------------------------------------------------------
 
   // Delete Fake MPI controller
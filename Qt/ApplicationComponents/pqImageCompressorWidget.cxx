@@ -42,7 +42,8 @@ static const int NO_COMPRESSION = 0;
 static const int LZ4_COMPRESSION = 1;
 static const int SQUIRT_COMPRESSION = 2;
 static const int ZLIB_COMPRESSION = 3;
-static const int NVPIPE_COMPRESSION = 4;
+static const int LZ4_DELTA_COMPRESSION = 4;
+static const int NVPIPE_COMPRESSION = 5;
 //-----------------------------------------------------------------------------
 
 class pqImageCompressorWidget::pqInternals
@@ -122,6 +123,12 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
                     "\\s+"     // space
                     "([0-9]+)" // num-of-bits.
                     "$");
+  QRegExp lz4DeltaRegExp("^vtkLZ4DeltaCompressor"
+                         "\\s+"     // space
+                         "0"        // 0
+                         "\\s+"     // space
+                         "([0-9]+)" // num-of-bits.
+                         "$");
   QRegExp nvpipeRegExp("^vtkNvPipeCompressor"
                        "\\s+"     // space
                        "0"        // 0
@@ -135,6 +142,12 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
     ui.compressionType->setCurrentIndex(LZ4_COMPRESSION);
     ui.squirtColorSpace->setValue(numBits);
   }
+  else if (lz4DeltaRegExp.exactMatch(value))
+  {
+    int numBits = lz4DeltaRegExp.cap(1).toInt();
+    ui.compressionType->setCurrentIndex(LZ4_DELTA_COMPRESSION);
+    ui.squirtColorSpace->setValue(numBits);
+  }
   else if (squirtRegExp.exactMatch(value))
   {
     int numBits = squirtRegExp.cap(1).toInt();
@@ -172,6 +185,9 @@ QString pqImageCompressorWidget::compressorConfig() const
     case LZ4_COMPRESSION:
       return QString("vtkLZ4Compressor 0 %1").arg(ui.squirtColorSpace->value());
 
+    case LZ4_DELTA_COMPRESSION:
+      return QString("vtkLZ4DeltaCompressor 0 %1").arg(ui.squirtColorSpace->value());
+
     case SQUIRT_COMPRESSION: // squirt
       return QString("vtkSquirtCompressor 0 %1").arg(ui.squirtColorSpace->value());
 
@@ -192,8 +208,10 @@ QString pqImageCompressorWidget::compressorConfig() const
 void pqImageCompressorWidget::currentIndexChanged(int index)
 {
   Ui::ImageCompressorWidget& ui = this->Internals->Ui;
-  ui.squirtLabel->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
-  ui.squirtColorSpace->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
+  const bool squirtLike = (index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION ||
+    index == LZ4_DELTA_COMPRESSION);
+  ui.squirtLabel->setVisible(squirtLike);
+  ui.squirtColorSpace->setVisible(squirtLike);
 
   ui.zlibLabel1->setVisible(index == ZLIB_COMPRESSION);
   ui.zlibLabel2->setVisible(index == ZLIB_COMPRESSION);
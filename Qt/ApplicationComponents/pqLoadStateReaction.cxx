@@ -118,6 +118,13 @@ void pqLoadStateReaction::loadState(const QString& filename, bool dialogBlocked,
       pqPVApplicationCore::instance()->setLoadingState(false);
     }
   }
+  else if (filename.endsWith(".pvsmb"))
+  {
+    // binary state files do not support relocating data files.
+    pqPVApplicationCore::instance()->loadState(filename.toLocal8Bit().data(), server);
+    pqStandardRecentlyUsedResourceLoaderImplementation::addStateFileToRecentResources(
+      server, filename);
+  }
   else
   { // python file
 #ifdef PARAVIEW_ENABLE_PYTHON
@@ -134,7 +141,7 @@ void pqLoadStateReaction::loadState(const QString& filename, bool dialogBlocked,
 void pqLoadStateReaction::loadState()
 {
   pqFileDialog fileDialog(NULL, pqCoreUtilities::mainWidget(), tr("Load State File"), QString(),
-    "ParaView state file (*.pvsm"
+    "ParaView state file (*.pvsm *.pvsmb"
 #ifdef PARAVIEW_ENABLE_PYTHON
     " *.py"
 #endif
@@ -75,9 +75,11 @@ void pqSaveStateReaction::updateEnableState()
 bool pqSaveStateReaction::saveState()
 {
 #ifdef PARAVIEW_ENABLE_PYTHON
-  QString fileExt = tr("ParaView state file (*.pvsm);;Python state file (*.py);;All files (*)");
+  QString fileExt = tr("ParaView state file (*.pvsm);;ParaView binary state file (*.pvsmb);;"
+                       "Python state file (*.py);;All files (*)");
 #else
-  QString fileExt = tr("ParaView state file (*.pvsm);;All files (*)");
+  QString fileExt =
+    tr("ParaView state file (*.pvsm);;ParaView binary state file (*.pvsmb);;All files (*)");
 #endif
   pqFileDialog fileDialog(
     NULL, pqCoreUtilities::mainWidget(), tr("Save State File"), QString(), fileExt);
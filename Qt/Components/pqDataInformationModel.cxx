@@ -471,6 +471,9 @@ QVariant pqDataInformationModel::headerData(
 //-----------------------------------------------------------------------------
 void pqDataInformationModel::dataUpdated(pqPipelineSource* changedSource)
 {
+  // request the data information of all the ports at once.
+  changedSource->getSourceProxy()->GatherDataInformationAsync();
+
   QList<pqSourceInfo>::iterator iter;
   int row_no = 0;
   for (iter = this->Internal->Sources.begin(); iter != this->Internal->Sources.end();
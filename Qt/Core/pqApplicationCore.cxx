@@ -74,6 +74,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "pqXMLUtil.h"
 #include "vtkCommand.h"
 #include "vtkInitializationHelper.h"
+#include "vtkNew.h"
 #include "vtkPVGeneralSettings.h"
 #include "vtkPVPluginTracker.h"
 #include "vtkPVSynchronizedRenderWindows.h"
@@ -102,6 +103,42 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "pqQVTKWidgetBase.h"
 #include <QSurfaceFormat>
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Reads a state file, either XML or binary (see
+// vtkSMSessionProxyManager::SaveBinaryState()). Returns NULL on failure.
+vtkSmartPointer<vtkPVXMLElement> pqReadStateFile(const QString& filename)
+{
+  vtkSmartPointer<vtkPVXMLElement> root;
+  QFile qfile(filename);
+  if (!qfile.open(QIODevice::ReadOnly))
+  {
+    qCritical() << "Failed to open state file: " << filename;
+    return root;
+  }
+  const QByteArray contents = qfile.readAll();
+  if (vtkSMSessionProxyManager::IsBinaryState(contents.data(), contents.size()))
+  {
+    root.TakeReference(
+      vtkSMSessionProxyManager::NewStateFromBinary(contents.data(), contents.size()));
+    if (!root)
+    {
+      qCritical() << "Invalid binary state file: " << filename;
+    }
+  }
+  else
+  {
+    vtkNew<vtkPVXMLParser> parser;
+    if (parser->Parse(contents.data(), static_cast<unsigned int>(contents.size())))
+    {
+      root = parser->GetRootElement();
+    }
+  }
+  return root;
+}
+}
+
 //-----------------------------------------------------------------------------
 class pqApplicationCore::pqInternals
 {
@@ -362,7 +399,14 @@ void pqApplicationCore::saveState(const QString& filename)
   vtkSMSessionProxyManager* pxm =
     vtkSMProxyManager::GetProxyManager()->GetActiveSessionProxyManager();
 
-  pxm->SaveXMLState(filename.toLocal8Bit().data());
+  if (filename.endsWith(".pvsmb"))
+  {
+    pxm->SaveBinaryState(filename.toLocal8Bit().data());
+  }
+  else
+  {
+    pxm->SaveXMLState(filename.toLocal8Bit().data());
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -385,10 +429,10 @@ void pqApplicationCore::loadState(const char* filename, pqServer* server, vtkSMS
     return;
   }
 
-  QFile qfile(filename);
-  if (qfile.open(QIODevice::ReadOnly | QIODevice::Text))
+  vtkSmartPointer<vtkPVXMLElement> root = pqReadStateFile(filename);
+  if (root)
   {
-    this->loadStateFromString(qfile.readAll().data(), server, loader);
+    this->loadState(root, server, loader);
   }
 }
 
@@ -462,11 +506,11 @@ void pqApplicationCore::loadStateIncremental(
   {
     return;
   }
-  vtkPVXMLParser* parser = vtkPVXMLParser::New();
-  parser->SetFileName(filename.toLocal8Bit().data());
-  parser->Parse();
-  this->loadStateIncremental(parser->GetRootElement(), server, loader);
-  parser->Delete();
+  vtkSmartPointer<vtkPVXMLElement> root = pqReadStateFile(filename);
+  if (root)
+  {
+    this->loadStateIncremental(root, server, loader);
+  }
 }
 
 //-----------------------------------------------------------------------------
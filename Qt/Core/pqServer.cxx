@@ -79,6 +79,9 @@ public:
 
   QTimer ServerLifeTimeTimer;
 
+  // Used to process the replies to asynchronous requests.
+  QTimer PendingRequestsTimer;
+
   // remaining time in minutes
   int RemainingLifeTime{ -1 };
 
@@ -118,6 +121,14 @@ pqServer::pqServer(vtkIdType connectionID, vtkPVOptions* options, QObject* _pare
   QObject::connect(
     &this->IdleCollaborationTimer, SIGNAL(timeout()), this, SLOT(processServerNotification()));
 
+  // Process the replies to asynchronous requests as they arrive.
+  this->Internals->PendingRequestsTimer.setInterval(10);
+  this->Internals->PendingRequestsTimer.setSingleShot(true);
+  QObject::connect(&this->Internals->PendingRequestsTimer, SIGNAL(timeout()), this,
+    SLOT(processPendingRequests()));
+  this->Internals->VTKConnect->Connect(this->Session, vtkSMSession::RequestSentEvent,
+    &this->Internals->PendingRequestsTimer, SLOT(start()));
+
   // Monitor server crash for better error management
   this->Internals->VTKConnect->Connect(this->Session, vtkPVSessionBase::ConnectionLost, this,
     SLOT(onConnectionLost(vtkObject*, ulong, void*, void*)));
@@ -435,6 +446,24 @@ void pqServer::processServerNotification()
   this->IdleCollaborationTimer.start();
 }
 
+//-----------------------------------------------------------------------------
+void pqServer::processPendingRequests()
+{
+  vtkSMSessionClient* sessionClient = vtkSMSessionClient::SafeDownCast(this->Session);
+  if (!sessionClient || !sessionClient->HasPendingRequests())
+  {
+    return;
+  }
+  if (sessionClient->IsNotBusy())
+  {
+    sessionClient->ProcessPendingRequests();
+  }
+  if (sessionClient->HasPendingRequests())
+  {
+    this->Internals->PendingRequestsTimer.start();
+  }
+}
+
 //-----------------------------------------------------------------------------
 void pqServer::onCollaborationCommunication(
   vtkObject* vtkNotUsed(src), unsigned long event_, void* vtkNotUsed(method), void* data)
@@ -260,6 +260,13 @@ protected slots:
   */
   void processServerNotification();
 
+  /**
+  * Called after asynchronous requests were sent to the server (see
+  * vtkSMSession::GatherInformationAsync()) to process their replies from the
+  * event loop, so that the application remains responsive meanwhile.
+  */
+  void processPendingRequests();
+
   /**
   * Called by vtkSMCollaborationManager when associated message happen.
   * This will convert the given parameter into vtkSMMessage and
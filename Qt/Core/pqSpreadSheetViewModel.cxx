@@ -98,6 +98,7 @@ public:
   QItemSelectionModel SelectionModel;
   pqTimer Timer;
   pqTimer SelectionTimer;
+  pqTimer PrefetchTimer;
   int DecimalPrecision;
   bool FixedRepresentation;
   vtkIdType LastRowCount;
@@ -130,6 +131,11 @@ pqSpreadSheetViewModel::pqSpreadSheetViewModel(vtkSMProxy* view, QObject* parent
   this->Internal->Timer.setInterval(500); // milliseconds.
   QObject::connect(&this->Internal->Timer, SIGNAL(timeout()), this, SLOT(delayedUpdate()));
 
+  this->Internal->PrefetchTimer.setSingleShot(true);
+  this->Internal->PrefetchTimer.setInterval(200); // milliseconds.
+  QObject::connect(
+    &this->Internal->PrefetchTimer, SIGNAL(timeout()), this, SLOT(prefetchBlocks()));
+
   this->Internal->SelectionTimer.setSingleShot(true);
   this->Internal->SelectionTimer.setInterval(100); // milliseconds.
   QObject::connect(
@@ -210,6 +216,7 @@ void pqSpreadSheetViewModel::forceUpdate()
   this->Internal->SelectionModel.clear();
   this->Internal->Timer.stop();
   this->Internal->SelectionTimer.stop();
+  this->Internal->PrefetchTimer.stop();
 
   vtkIdType& rows = this->Internal->LastRowCount;
   vtkIdType& columns = this->Internal->LastColumnCount;
@@ -243,6 +250,25 @@ void pqSpreadSheetViewModel::delayedUpdate()
   if (this->Internal->ActiveRegion[0] >= 0)
   {
     this->Internal->VTKView->GetValue(this->Internal->ActiveRegion[0], 0);
+    // the active region may span two blocks.
+    if (this->Internal->ActiveRegion[1] > this->Internal->ActiveRegion[0] &&
+      this->Internal->ActiveRegion[1] < this->rowCount())
+    {
+      this->Internal->VTKView->GetValue(this->Internal->ActiveRegion[1], 0);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void pqSpreadSheetViewModel::prefetchBlocks()
+{
+  // fetch one block at a time so that the UI stays responsive, and go on only
+  // if nothing else needs to be done.
+  if (this->Internal->ActiveRegion[0] >= 0 && !this->Internal->Timer.isActive() &&
+    this->Internal->VTKView->PrefetchBlocks(
+      this->Internal->ActiveRegion[0], this->Internal->ActiveRegion[1]))
+  {
+    this->Internal->PrefetchTimer.start();
   }
 }
 
@@ -285,6 +311,8 @@ void pqSpreadSheetViewModel::onDataFetched(vtkObject*, unsigned long, void*, voi
   this->dataChanged(topLeft, bottomRight);
   // we always invalidate header data, just to be on a safe side.
   this->headerDataChanged(Qt::Horizontal, 0, this->columnCount() - 1);
+
+  this->Internal->PrefetchTimer.start();
 }
 namespace
 {
@@ -213,6 +213,11 @@ private slots:
   */
   void delayedUpdate();
 
+  /**
+  * called when idle to fetch the blocks next to the active region.
+  */
+  void prefetchBlocks();
+
   void triggerSelectionChanged();
 
   /**
@@ -0,0 +1,122 @@
+'''
+geometryfilter is a benchmark for the surface extraction of multiblock
+datasets by vtkPVGeometryFilter. It builds a multiblock dataset of
+tetrahedralized Wavelet blocks and extracts its surface serially and with the
+threaded composite execution enabled, checks that both outputs are identical
+and reports the average time per extraction.
+
+The number of threads used is the one of the vtkSMPTools backend ParaView
+was built with, e.g. set OMP_NUM_THREADS or TBB's default. Run it with::
+
+    pvpython -m paraview.benchmark.geometryfilter -b 64 -o log
+'''
+from __future__ import print_function
+import datetime as dt
+
+MODES = [('serial', False), ('threaded', True)]
+
+
+def create_dataset(nblocks, extent):
+    from vtkmodules.vtkCommonDataModel import vtkMultiBlockDataSet
+    from vtkmodules.vtkFiltersGeneral import vtkDataSetTriangleFilter
+    from vtkmodules.vtkImagingCore import vtkRTAnalyticSource
+
+    data = vtkMultiBlockDataSet()
+    for i in range(nblocks):
+        wavelet = vtkRTAnalyticSource()
+        wavelet.SetWholeExtent(i * extent, (i + 1) * extent,
+                               0, extent, 0, extent)
+        tetrahedralize = vtkDataSetTriangleFilter()
+        tetrahedralize.SetInputConnection(wavelet.GetOutputPort())
+        tetrahedralize.Update()
+        data.SetBlock(i, tetrahedralize.GetOutput())
+    return data
+
+
+def extract(data, threaded):
+    from vtkmodules.vtkPVVTKExtensionsRendering import vtkPVGeometryFilter
+
+    vtkPVGeometryFilter.SetThreadedCompositeExecution(threaded)
+    f = vtkPVGeometryFilter()
+    f.SetUseOutline(0)
+    f.SetInputData(data)
+    t0 = dt.datetime.now()
+    f.Update()
+    seconds = (dt.datetime.now() - t0).total_seconds()
+    return f.GetOutputDataObject(0), seconds
+
+
+def summarize(output):
+    '''Returns, per leaf, the number of points and cells and the coordinates
+    of the points, used to compare outputs.'''
+    summary = []
+    iterator = output.NewIterator()
+    iterator.SkipEmptyNodesOff()
+    iterator.InitTraversal()
+    while not iterator.IsDoneWithTraversal():
+        block = iterator.GetCurrentDataObject()
+        if block is None:
+            summary.append(None)
+        else:
+            points = [block.GetPoint(i) for i in range(block.GetNumberOfPoints())]
+            summary.append((block.GetNumberOfCells(), points))
+        iterator.GoToNextItem()
+    return summary
+
+
+def run(output_basename=None, nblocks=64, extent=24, iterations=5):
+    '''Runs the benchmark. Results are printed and, if output_basename is
+    specified, appended as csv to <output_basename>.csv with the columns
+    number of blocks, mode, seconds per extraction.'''
+    from vtkmodules.vtkPVVTKExtensionsRendering import vtkPVGeometryFilter
+
+    data = create_dataset(nblocks, extent)
+    initial_mode = vtkPVGeometryFilter.GetThreadedCompositeExecution()
+
+    results = []
+    outputs = []
+    for name, threaded in MODES:
+        # warm up to exclude one-time costs from the measurement.
+        output, seconds = extract(data, threaded)
+        total = 0.0
+        for i in range(iterations):
+            output, seconds = extract(data, threaded)
+            total += seconds
+        spe = total / iterations
+        print('%d blocks, %s: %g secs/extraction' % (nblocks, name, spe))
+        results.append((nblocks, name, spe))
+        outputs.append(summarize(output))
+
+    vtkPVGeometryFilter.SetThreadedCompositeExecution(initial_mode)
+
+    if outputs[0] != outputs[1]:
+        raise RuntimeError('threaded output differs from the serial one')
+    print('speedup: %g' % (results[0][2] / results[1][2]))
+
+    if output_basename:
+        with open(output_basename + '.csv', 'a') as ofile:
+            for r in results:
+                ofile.write('%d, %s, %g\n' % r)
+    return results
+
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(
+        description='Benchmark threaded surface extraction of multiblock datasets')
+    parser.add_argument('-o', '--output-basename', default=None, type=str,
+                        help='Basename to use for the generated csv file')
+    parser.add_argument('-b', '--blocks', default=64, type=int,
+                        help='Number of blocks in the dataset')
+    parser.add_argument('-e', '--extent', default=24, type=int,
+                        help='Number of cells along each axis of a block')
+    parser.add_argument('-i', '--iterations', default=5, type=int,
+                        help='Number of extractions to average over per mode')
+
+    args = parser.parse_args(argv)
+    run(output_basename=args.output_basename, nblocks=args.blocks,
+        extent=args.extent, iterations=args.iterations)
+
+if __name__ == "__main__":
+    import sys
+    main(sys.argv[1:])
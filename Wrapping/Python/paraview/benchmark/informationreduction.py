@@ -0,0 +1,89 @@
+'''
+informationreduction is a scaling benchmark for the gathering of
+vtkPVInformation objects across MPI ranks. It repeatedly gathers data
+information for a distributed Wavelet source using each of the reduction modes
+supported by vtkPVSessionCore (gather-to-root and tree reduction) and reports
+the average time per gather.
+
+Run it with pvbatch under mpiexec for increasing numbers of ranks to obtain
+the scaling curve, e.g.::
+
+    mpiexec -np 1024 pvbatch -m paraview.benchmark.informationreduction -o log
+'''
+from __future__ import print_function
+import datetime as dt
+from paraview import servermanager
+from paraview.simple import *
+
+MODES = [('gather-to-root', 0), ('tree', 1)]
+
+
+def gather(session, proxy, info_class):
+    info = info_class()
+    session.GatherInformation(servermanager.vtkSMSession.DATA_SERVER,
+                              info, proxy.GetGlobalID())
+    return info
+
+
+def time_mode(session, proxy, info_class, mode, iterations):
+    servermanager.vtkPVSessionCore.SetInformationReductionMode(mode)
+    # warm up to exclude one-time costs from the measurement.
+    gather(session, proxy, info_class)
+    t0 = dt.datetime.now()
+    for i in range(iterations):
+        gather(session, proxy, info_class)
+    return (dt.datetime.now() - t0).total_seconds() / iterations
+
+
+def run(output_basename=None, extent=32, iterations=20):
+    '''Runs the benchmark. Results are printed and, if output_basename is
+    specified, appended as csv to <output_basename>.csv with the columns
+    number of ranks, mode, seconds per gather.'''
+    from vtkmodules.vtkParallelCore import vtkMultiProcessController
+
+    servermanager.SetProgressPrintingEnabled(0)
+
+    controller = vtkMultiProcessController.GetGlobalController()
+    nranks = controller.GetNumberOfProcesses() if controller else 1
+
+    w = Wavelet(WholeExtent=[-extent, extent, -extent, extent, -extent, extent])
+    w.UpdatePipeline()
+
+    session = servermanager.ActiveConnection.Session
+    initial_mode = servermanager.vtkPVSessionCore.GetInformationReductionMode()
+
+    results = []
+    for name, mode in MODES:
+        tpg = time_mode(session, w.SMProxy,
+                        servermanager.vtkPVDataInformation, mode, iterations)
+        print('%d ranks, %s: %g secs/gather' % (nranks, name, tpg))
+        results.append((nranks, name, tpg))
+
+    servermanager.vtkPVSessionCore.SetInformationReductionMode(initial_mode)
+    Delete(w)
+
+    if output_basename:
+        with open(output_basename + '.csv', 'a') as ofile:
+            for r in results:
+                ofile.write('%d, %s, %g\n' % r)
+    return results
+
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(
+        description='Benchmark gathering of information across MPI ranks')
+    parser.add_argument('-o', '--output-basename', default=None, type=str,
+                        help='Basename to use for the generated csv file')
+    parser.add_argument('-e', '--extent', default=32, type=int,
+                        help='Half-size of the Wavelet whole extent')
+    parser.add_argument('-i', '--iterations', default=20, type=int,
+                        help='Number of gathers to average over per mode')
+
+    args = parser.parse_args(argv)
+    run(output_basename=args.output_basename, extent=args.extent,
+        iterations=args.iterations)
+
+if __name__ == "__main__":
+    import sys
+    main(sys.argv[1:])
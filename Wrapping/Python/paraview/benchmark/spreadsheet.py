@@ -0,0 +1,113 @@
+'''
+spreadsheet is a benchmark for the scrolling of the spreadsheet view through a
+wide table. It shows a table with many columns, of which only a few are
+visible, and scrolls through it the way the GUI does: it requests the rows
+shown at each scroll step and, between steps, lets the view prefetch the
+blocks next to them. For each block size and prefetch setting, it reports the
+time spent waiting for rows and the hit rate of the view's block cache. It is
+most useful when connected to a remote server. Run it with::
+
+    pvpython -m paraview.benchmark.spreadsheet -c 200 -r 100000 -o log
+'''
+from __future__ import print_function
+import datetime as dt
+
+TABLE_SCRIPT = '''
+import numpy as np
+from vtkmodules.numpy_interface import dataset_adapter as dsa
+output = dsa.WrapDataObject(self.GetOutput())
+rows = np.arange(%(rows)d, dtype=np.float64)
+for i in range(%(columns)d):
+    output.RowData.append(np.sin(rows * (i + 1)), 'column%%d' %% i)
+'''
+
+
+def create_view(nrows, ncolumns, nvisible):
+    '''Creates a spreadsheet view showing a table of nrows x ncolumns, of
+    which only the first nvisible columns are visible.'''
+    from paraview import simple
+
+    source = simple.ProgrammableSource(OutputDataSetType='vtkTable')
+    source.Script = TABLE_SCRIPT % {'rows': nrows, 'columns': ncolumns}
+    view = simple.CreateView('SpreadSheetView')
+    view.FieldAssociation = 'Row Data'
+    view.HiddenColumnLabels = ['column%d' % i for i in range(nvisible, ncolumns)]
+    simple.Show(source, view)
+    simple.Render(view)
+    return view
+
+
+def scroll(view, visible_rows, step, prefetch):
+    '''Scrolls through all the rows, visible_rows at a time, moving by step
+    rows. Returns the seconds spent waiting for the visible rows.'''
+    ss = view.GetClientSideObject()
+    nrows = ss.GetNumberOfRows()
+    waiting = 0.0
+    for top in range(0, nrows - visible_rows, step):
+        bottom = top + visible_rows - 1
+        t0 = dt.datetime.now()
+        ss.GetValue(top, 0)
+        ss.GetValue(bottom, 0)
+        waiting += (dt.datetime.now() - t0).total_seconds()
+        # what the GUI does when idle.
+        while prefetch and ss.PrefetchBlocks(top, bottom):
+            pass
+    return waiting
+
+
+def run(output_basename=None, nrows=100000, ncolumns=200, nvisible=5,
+        block_sizes=(256, 1024, 4096), visible_rows=40, step=20):
+    '''Runs the benchmark. Results are printed and, if output_basename is
+    specified, appended as csv to <output_basename>.csv with the columns
+    block size, number of prefetched blocks, seconds waiting, cache hit
+    rate.'''
+    from paraview import simple
+
+    view = create_view(nrows, ncolumns, nvisible)
+    ss = view.GetClientSideObject()
+    results = []
+    try:
+        for block_size in block_sizes:
+            for prefetch in (0, 1):
+                view.BlockSize = block_size
+                view.NumberOfPrefetchBlocks = prefetch
+                simple.Render(view)
+                ss.ClearCache()
+                ss.ResetCacheStatistics()
+                seconds = scroll(view, visible_rows, step, prefetch > 0)
+                rate = ss.GetCacheHitRate()
+                print('block size %d, %d prefetched blocks: %g secs waiting, hit rate %g' %
+                      (block_size, prefetch, seconds, rate))
+                results.append((block_size, prefetch, seconds, rate))
+    finally:
+        simple.Delete(view)
+
+    if output_basename:
+        with open(output_basename + '.csv', 'a') as ofile:
+            for r in results:
+                ofile.write('%d, %d, %g, %g\n' % r)
+    return results
+
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(
+        description='Benchmark scrolling through a wide table in the spreadsheet view')
+    parser.add_argument('-o', '--output-basename', default=None, type=str,
+                        help='Basename to use for the generated csv file')
+    parser.add_argument('-r', '--rows', default=100000, type=int,
+                        help='Number of rows in the table')
+    parser.add_argument('-c', '--columns', default=200, type=int,
+                        help='Number of columns in the table')
+    parser.add_argument('-v', '--visible-columns', default=5, type=int,
+                        help='Number of columns that are not hidden')
+    parser.add_argument('-b', '--block-sizes', default=[256, 1024, 4096], type=int, nargs='+',
+                        help='Block sizes to try')
+
+    args = parser.parse_args(argv)
+    run(output_basename=args.output_basename, nrows=args.rows, ncolumns=args.columns,
+        nvisible=args.visible_columns, block_sizes=args.block_sizes)
+
+if __name__ == "__main__":
+    import sys
+    main(sys.argv[1:])
@@ -0,0 +1,238 @@
+'''
+spyplotreader is a benchmark for the decoding of the cell arrays of SpyPlot
+(CTH) files by vtkSpyPlotReader. It writes a synthetic spy file holding a grid
+of AMR blocks, each with run-length encoded arrays, reads it with the
+pipelined decoding disabled and enabled, checks that both outputs are
+identical and reports the average time per read.
+
+The number of threads used to decode is the one of the vtkSMPTools backend
+ParaView was built with, e.g. set OMP_NUM_THREADS or TBB's default. Run it
+with::
+
+    pvpython -m paraview.benchmark.spyplotreader -b 16 -o log
+'''
+from __future__ import print_function
+import datetime as dt
+import math
+import struct
+
+MODES = [('serial', False), ('pipelined', True)]
+
+# the second variable is down converted to unsigned char by the reader.
+VARIABLES = ['Density', 'Volume Fraction - 1', 'Pressure']
+
+SPY_FILE_VERSION = 102
+
+
+def _run_length(values, i):
+    j = i
+    while j < len(values) and j - i < 127 and values[j] == values[i]:
+        j += 1
+    return j - i
+
+
+def _encode_run_length(values):
+    '''Run-length encodes floats the way CTH does: a byte n < 128 followed by
+    a float repeated n times, or a byte 128 + n followed by n floats.'''
+    out = []
+    i = 0
+    while i < len(values):
+        n = _run_length(values, i)
+        if n >= 3:
+            out.append(struct.pack('>Bf', n, values[i]))
+            i += n
+            continue
+        j = i
+        while j < len(values) and j - i < 127 and _run_length(values, j) < 3:
+            j += 1
+        out.append(struct.pack('>B%df' % (j - i), 128 + j - i, *values[i:j]))
+        i = j
+    return b''.join(out)
+
+
+def _encode_coordinates(start, delta, count):
+    '''Encodes count coordinates start + i * delta.'''
+    return struct.pack('>ffBf', start, delta, count, 0.0)
+
+
+def _plane_values(variable, extent, z):
+    n = extent + 2
+    values = []
+    for y in range(n):
+        for x in range(n):
+            if variable == 1:
+                # mostly constant, as volume fractions are.
+                values.append(1.0 if x + y + z < n else 0.0)
+            else:
+                values.append(float('%.3f' % (math.sin(0.3 * x + variable) *
+                                              math.cos(0.2 * y + 0.1 * z) + 2.0)))
+    return values
+
+
+def write_spy_file(filename, nblocks, extent):
+    '''Writes a single time step spy file with nblocks x nblocks x nblocks
+    blocks of extent^3 cells plus a layer of ghost cells, and the cell arrays
+    listed in VARIABLES.'''
+    dims = extent + 2
+    nb = nblocks * nblocks * nblocks
+    spacing = 1.0 / extent
+
+    out = bytearray()
+    out += struct.pack('>8s128s', b'spydata', b'paraview.benchmark.spyplotreader')
+    # version, pointer size, compression, processor id, number of processors,
+    # coordinate system (3D cartesian), dimensions, materials, max materials
+    out += struct.pack('>9i', SPY_FILE_VERSION, 64, 1, 0, 1, 30, 3, 1, 1)
+    out += struct.pack('>6d', 0, 0, 0, nblocks, nblocks, nblocks)
+    out += struct.pack('>2i', nb, 1)
+    out += struct.pack('>i', len(VARIABLES))
+    for i, name in enumerate(VARIABLES):
+        out += struct.pack('>30s80si', ('var%d' % i).encode(), name.encode(), i)
+    # no material fields
+    out += struct.pack('>i', 0)
+
+    # group header with a single dump whose offset is patched below
+    out += struct.pack('>d', len(out) + 8)
+    out += struct.pack('>i', 1)
+    out += struct.pack('>100i', *([0] * 100))
+    out += struct.pack('>100d', *([0.0] * 100))
+    out += struct.pack('>100d', *([0.0] * 100))
+    dump_offset_position = len(out)
+    out += struct.pack('>100d', *([0.0] * 100))
+    struct.pack_into('>d', out, dump_offset_position, len(out))
+
+    out += struct.pack('>i', len(VARIABLES))
+    out += struct.pack('>%di' % len(VARIABLES), *range(len(VARIABLES)))
+    variable_offsets_position = len(out)
+    out += struct.pack('>%dd' % len(VARIABLES), *([0.0] * len(VARIABLES)))
+    # no tracers nor indicators
+    out += struct.pack('>2i', 0, 0)
+    out += struct.pack('>i', nb)
+    for b in range(nb):
+        # dimensions, allocated, active, level
+        out += struct.pack('>6i', dims, dims, dims, 1, 1, 0)
+    for b in range(nb):
+        ijk = (b % nblocks, (b // nblocks) % nblocks, b // (nblocks * nblocks))
+        for component in range(3):
+            data = _encode_coordinates(ijk[component] - spacing, spacing, dims + 1)
+            out += struct.pack('>i', len(data)) + data
+
+    for v in range(len(VARIABLES)):
+        struct.pack_into('>d', out, variable_offsets_position + 8 * v, len(out))
+        planes = []
+        for z in range(dims):
+            data = _encode_run_length(_plane_values(v, extent, z))
+            planes.append(struct.pack('>i', len(data)) + data)
+        block = b''.join(planes)
+        for b in range(nb):
+            out += block
+
+    with open(filename, 'wb') as ofile:
+        ofile.write(out)
+    return len(out)
+
+
+def read(filename, pipelined):
+    from vtkmodules.vtkPVVTKExtensionsDefault import vtkSpyPlotReader
+
+    reader = vtkSpyPlotReader()
+    reader.SetFileName(filename)
+    reader.SetPipelinedDecoding(pipelined)
+    reader.UpdateInformation()
+    reader.GetCellDataArraySelection().EnableAllArrays()
+    t0 = dt.datetime.now()
+    reader.Update()
+    seconds = (dt.datetime.now() - t0).total_seconds()
+    return reader.GetOutputDataObject(0), seconds
+
+
+def summarize(output):
+    '''Returns, per leaf, the number of cells and a digest of each cell
+    array, used to compare outputs.'''
+    import hashlib
+    from vtkmodules.util.numpy_support import vtk_to_numpy
+
+    summary = []
+    iterator = output.NewIterator()
+    iterator.InitTraversal()
+    while not iterator.IsDoneWithTraversal():
+        block = iterator.GetCurrentDataObject()
+        cd = block.GetCellData()
+        arrays = []
+        for i in range(cd.GetNumberOfArrays()):
+            array = cd.GetArray(i)
+            arrays.append((array.GetName(),
+                           hashlib.md5(vtk_to_numpy(array).tobytes()).hexdigest()))
+        summary.append((block.GetNumberOfCells(), sorted(arrays)))
+        iterator.GoToNextItem()
+    return summary
+
+
+def run(output_basename=None, nblocks=16, extent=8, iterations=5, filename=None):
+    '''Runs the benchmark. Results are printed and, if output_basename is
+    specified, appended as csv to <output_basename>.csv with the columns
+    number of blocks, mode, seconds per read.'''
+    import os
+    import tempfile
+
+    if filename is None:
+        fd, filename = tempfile.mkstemp(suffix='.spcth')
+        os.close(fd)
+        remove = True
+    else:
+        remove = False
+
+    try:
+        size = write_spy_file(filename, nblocks, extent)
+        nb = nblocks * nblocks * nblocks
+        print('%d blocks, %g MiB' % (nb, size / float(1 << 20)))
+
+        results = []
+        outputs = []
+        for name, pipelined in MODES:
+            # warm up the file system cache.
+            output, seconds = read(filename, pipelined)
+            total = 0.0
+            for i in range(iterations):
+                output, seconds = read(filename, pipelined)
+                total += seconds
+            spr = total / iterations
+            print('%d blocks, %s: %g secs/read' % (nb, name, spr))
+            results.append((nb, name, spr))
+            outputs.append(summarize(output))
+    finally:
+        if remove:
+            os.remove(filename)
+
+    if outputs[0] != outputs[1]:
+        raise RuntimeError('pipelined output differs from the serial one')
+    print('speedup: %g' % (results[0][2] / results[1][2]))
+
+    if output_basename:
+        with open(output_basename + '.csv', 'a') as ofile:
+            for r in results:
+                ofile.write('%d, %s, %g\n' % r)
+    return results
+
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(
+        description='Benchmark pipelined decoding of SpyPlot files')
+    parser.add_argument('-o', '--output-basename', default=None, type=str,
+                        help='Basename to use for the generated csv file')
+    parser.add_argument('-b', '--blocks', default=16, type=int,
+                        help='Number of blocks along each axis of the dataset')
+    parser.add_argument('-e', '--extent', default=8, type=int,
+                        help='Number of cells along each axis of a block')
+    parser.add_argument('-i', '--iterations', default=5, type=int,
+                        help='Number of reads to average over per mode')
+    parser.add_argument('-f', '--filename', default=None, type=str,
+                        help='Where to write the synthetic spy file, kept after the run')
+
+    args = parser.parse_args(argv)
+    run(output_basename=args.output_basename, nblocks=args.blocks,
+        extent=args.extent, iterations=args.iterations, filename=args.filename)
+
+if __name__ == "__main__":
+    import sys
+    main(sys.argv[1:])
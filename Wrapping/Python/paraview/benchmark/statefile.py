@@ -0,0 +1,129 @@
+'''
+statefile is a benchmark for the loading of large state files. It builds a
+synthetic state of sources and filters, saves it as an XML state file (.pvsm)
+and as a binary one (.pvsmb), then for each format reports the time to read
+the file into XML elements and the time to load the state, i.e. to read it
+and create the proxies. It checks that both formats restore the same
+proxies. Run it with::
+
+    pvpython -m paraview.benchmark.statefile -n 10000 -o log
+'''
+from __future__ import print_function
+import datetime as dt
+
+FORMATS = [('xml', '.pvsm'), ('binary', '.pvsmb')]
+
+
+def build_state(nproxies):
+    '''Creates nproxies pipeline proxies: spheres, each with a shrink filter
+    referring to it, so that loading has proxy references to resolve.'''
+    from paraview import simple
+
+    for i in range(nproxies // 2):
+        sphere = simple.Sphere(ThetaResolution=8 + i % 8)
+        simple.Shrink(Input=sphere, ShrinkFactor=0.5)
+
+
+def registered_sources():
+    '''Returns the sorted (name, xml name) of the registered sources, used to
+    compare the loaded states.'''
+    from paraview import servermanager
+
+    proxies = servermanager.ProxyManager().GetProxiesInGroup('sources')
+    return sorted((name, proxy.GetXMLName()) for (name, id), proxy in proxies.items())
+
+
+def read(filename):
+    '''Reads the state file into XML elements, without creating proxies.'''
+    from paraview.servermanager import vtkPVXMLParser, vtkSMSessionProxyManager
+
+    t0 = dt.datetime.now()
+    with open(filename, 'rb') as ifile:
+        contents = ifile.read()
+    if vtkSMSessionProxyManager.IsBinaryState(contents, len(contents)):
+        root = vtkSMSessionProxyManager.NewStateFromBinary(contents, len(contents))
+    else:
+        parser = vtkPVXMLParser()
+        parser.Parse(contents, len(contents))
+        root = parser.GetRootElement()
+    seconds = (dt.datetime.now() - t0).total_seconds()
+    if root is None:
+        raise RuntimeError('failed to read %s' % filename)
+    return seconds
+
+
+def load(filename):
+    '''Loads the state file in a new session.'''
+    from paraview import servermanager, simple
+
+    simple.ResetSession()
+    t0 = dt.datetime.now()
+    servermanager.ProxyManager().LoadState(filename)
+    return (dt.datetime.now() - t0).total_seconds()
+
+
+def run(output_basename=None, nproxies=10000, iterations=3, directory=None):
+    '''Runs the benchmark. Results are printed and, if output_basename is
+    specified, appended as csv to <output_basename>.csv with the columns
+    number of proxies, format, file size in bytes, seconds per read, seconds
+    per load.'''
+    import os
+    import shutil
+    import tempfile
+    from paraview import servermanager, simple
+
+    tmpdir = tempfile.mkdtemp() if directory is None else directory
+    try:
+        simple.ResetSession()
+        build_state(nproxies)
+        expected = registered_sources()
+        filenames = []
+        for name, extension in FORMATS:
+            filename = os.path.join(tmpdir, 'statefile' + extension)
+            servermanager.ProxyManager().SaveState(filename)
+            filenames.append(filename)
+
+        results = []
+        for (name, extension), filename in zip(FORMATS, filenames):
+            size = os.path.getsize(filename)
+            spr = sum(read(filename) for i in range(iterations)) / iterations
+            spl = sum(load(filename) for i in range(iterations)) / iterations
+            if registered_sources() != expected:
+                raise RuntimeError('loading the %s state did not restore the proxies' % name)
+            print('%d proxies, %s: %g MiB, %g secs/read, %g secs/load' %
+                  (nproxies, name, size / float(1 << 20), spr, spl))
+            results.append((nproxies, name, size, spr, spl))
+    finally:
+        if directory is None:
+            shutil.rmtree(tmpdir)
+
+    print('read speedup: %g, load speedup: %g' %
+          (results[0][3] / results[1][3], results[0][4] / results[1][4]))
+
+    if output_basename:
+        with open(output_basename + '.csv', 'a') as ofile:
+            for r in results:
+                ofile.write('%d, %s, %d, %g, %g\n' % r)
+    return results
+
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(
+        description='Benchmark loading large XML and binary state files')
+    parser.add_argument('-o', '--output-basename', default=None, type=str,
+                        help='Basename to use for the generated csv file')
+    parser.add_argument('-n', '--proxies', default=10000, type=int,
+                        help='Number of pipeline proxies in the state')
+    parser.add_argument('-i', '--iterations', default=3, type=int,
+                        help='Number of reads and loads to average over per format')
+    parser.add_argument('-d', '--directory', default=None, type=str,
+                        help='Where to write the state files, kept after the run')
+
+    args = parser.parse_args(argv)
+    run(output_basename=args.output_basename, nproxies=args.proxies,
+        iterations=args.iterations, directory=args.directory)
+
+if __name__ == "__main__":
+    import sys
+    main(sys.argv[1:])
@@ -1799,7 +1799,10 @@ class ProxyManager(object):
         self.SMProxyManager.LoadXMLState(filename, loader)
 
     def SaveState(self, filename):
-        self.SMProxyManager.SaveXMLState(filename)
+        if filename.endswith('.pvsmb'):
+            self.SMProxyManager.SaveBinaryState(filename)
+        else:
+            self.SMProxyManager.SaveXMLState(filename)
 
 class PropertyIterator(object):
     """Wrapper for a vtkSMPropertyIterator class to satisfy
@@ -421,9 +421,14 @@ def LoadState(filename, connection=None, **extraArgs):
     RemoveViewsAndLayouts()
 
     pxm = servermanager.ProxyManager()
-    proxy = pxm.NewProxy('options', 'LoadStateOptions')
+    if filename.endswith('.pvsmb'):
+        # binary state files do not support relocating data files.
+        pxm.LoadState(filename)
+        proxy = None
+    else:
+        proxy = pxm.NewProxy('options', 'LoadStateOptions')
 
-    if ((proxy is not None) & proxy.PrepareToLoad(filename)):
+    if ((proxy is not None) and proxy.PrepareToLoad(filename)):
         if (proxy.HasDataFiles() and (extraArgs is not None)):
             pyproxy = servermanager._getPyProxy(proxy)
             SetProperties(pyproxy, **extraArgs)